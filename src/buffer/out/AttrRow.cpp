@@ -9,12 +9,14 @@
 // Arguments:
 // - cchRowWidth - the length of the default text attribute
 // - attr - the default text attribute
+// - table - the attribute table of the buffer this row belongs to
 // Return Value:
 // - constructed object
 // Note: will throw exception if unable to allocate memory for text attribute storage
-ATTR_ROW::ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr)
+ATTR_ROW::ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr, TextAttributeTable& table) :
+    _pTable{ &table }
 {
-    _list.push_back(TextAttributeRun(cchRowWidth, attr));
+    _list.push_back(TextAttributeIdRun(cchRowWidth, _pTable->Intern(attr)));
     _cchRowWidth = cchRowWidth;
 }
 
@@ -24,8 +26,9 @@ ATTR_ROW::ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr)
 // - attr - The default text attributes to use on text in this row.
 void ATTR_ROW::Reset(const TextAttribute attr)
 {
+    const auto attrId = _pTable->Intern(attr);
     _list.clear();
-    _list.push_back(TextAttributeRun(_cchRowWidth, attr));
+    _list.push_back(TextAttributeIdRun(_cchRowWidth, attrId));
 }
 
 // Routine Description:
@@ -108,7 +111,7 @@ TextAttribute ATTR_ROW::GetAttrByColumn(const size_t column,
 {
     THROW_HR_IF(E_INVALIDARG, column >= _cchRowWidth);
     const auto runPos = FindAttrIndex(column, pApplies);
-    return _list[runPos].GetAttributes();
+    return _pTable->Lookup(_list[runPos].GetAttributeId());
 }
 
 // Routine Description:
@@ -120,6 +123,36 @@ size_t ATTR_ROW::GetNumberOfRuns() const noexcept
     return _list.size();
 }
 
+// Routine Description:
+// - retrieves a run by its position in the run-length encoded list
+// - paired with FindAttrIndex, this lets callers walk the row one run at a time
+//   instead of re-scanning from the start of the row for every column
+// Arguments:
+// - runIndex - which run to retrieve. must be less than GetNumberOfRuns()
+// Return Value:
+// - the run, with its attribute resolved from the buffer's attribute table
+// Note:
+// - will throw on error
+TextAttributeRun ATTR_ROW::GetRunAt(const size_t runIndex) const
+{
+    const auto& run = _list.at(runIndex);
+    return TextAttributeRun(run.GetLength(), _pTable->Lookup(run.GetAttributeId()));
+}
+
+// Routine Description:
+// - retrieves the interned attribute ID of a run.
+// - two runs in the same buffer have equal attributes if and only if their IDs are equal.
+// Arguments:
+// - runIndex - which run to inspect. must be less than GetNumberOfRuns()
+// Return Value:
+// - the ID of the run's attribute within the buffer's attribute table
+// Note:
+// - will throw on error
+TextAttributeTable::id_type ATTR_ROW::GetAttrIdAt(const size_t runIndex) const
+{
+    return _list.at(runIndex).GetAttributeId();
+}
+
 // Routine Description:
 // - This routine finds the nth attribute in this ATTR_ROW.
 // Arguments:
@@ -220,13 +253,37 @@ void ATTR_ROW::ReplaceLegacyAttrs(_In_ WORD wToBeReplacedAttr, _In_ WORD wReplac
 // - <none>
 void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAttribute& replaceWith) noexcept
 {
-    for (auto& run : _list)
+    try
     {
-        if (run.GetAttributes() == toBeReplacedAttr)
+        // If the attribute was never interned, no run can be using it.
+        const auto toBeReplacedId = _pTable->Find(toBeReplacedAttr);
+        if (!toBeReplacedId.has_value())
         {
-            run.SetAttributes(replaceWith);
+            return;
+        }
+
+        const auto replaceWithId = _pTable->Intern(replaceWith);
+        for (auto& run : _list)
+        {
+            if (run.GetAttributeId() == toBeReplacedId.value())
+            {
+                run.SetAttributeId(replaceWithId);
+            }
         }
     }
+    CATCH_LOG();
+}
+
+// Routine Description:
+// - Flags every attribute ID used by this row. Used when sweeping the buffer's attribute table.
+// Arguments:
+// - inUse - indexed by attribute ID. Entries for IDs used by this row are set to true.
+void ATTR_ROW::MarkAttrIdsInUse(std::vector<bool>& inUse) const
+{
+    for (const auto& run : _list)
+    {
+        inUse.at(run.GetAttributeId()) = true;
+    }
 }
 
 // Routine Description:
@@ -270,11 +327,11 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
     if (newAttrs.size() == 1)
     {
         // Get the new color attribute we're trying to apply
-        const TextAttribute NewAttr = newAttrs.at(0).GetAttributes();
+        const auto NewAttr = _pTable->Intern(newAttrs.at(0).GetAttributes());
 
         // If the existing run was only 1 element...
         // ...and the new color is the same as the old, we don't have to do anything and can exit quick.
-        if (_list.size() == 1 && _list.at(0).GetAttributes() == NewAttr)
+        if (_list.size() == 1 && _list.at(0).GetAttributeId() == NewAttr)
         {
             return S_OK;
         }
@@ -291,7 +348,7 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
         else if (_list.size() == 2 && newAttrs.at(0).GetLength() == 1)
         {
             auto left = _list.begin();
-            if (iStart == left->GetLength() && NewAttr == left->GetAttributes())
+            if (iStart == left->GetLength() && NewAttr == left->GetAttributeId())
             {
                 auto right = left + 1;
                 left->IncrementLength();
@@ -307,11 +364,19 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
         }
     }
 
+    // Intern the attributes we were given so everything from here on only deals in IDs.
+    std::vector<TextAttributeIdRun> insertRuns;
+    insertRuns.reserve(newAttrs.size());
+    for (const auto& run : newAttrs)
+    {
+        insertRuns.emplace_back(run.GetLength(), _pTable->Intern(run.GetAttributes()));
+    }
+
     // If we're about to cover the entire existing run with a new one, we can also make an optimization.
     if (iStart == 0 && iEnd == iLastBufferCol)
     {
         // Just dump what we're given over what we have and call it a day.
-        _list.assign(newAttrs.cbegin(), newAttrs.cend());
+        _list.swap(insertRuns);
 
         return S_OK;
     }
@@ -323,8 +388,8 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
     // becomes R3->B2->Y2->B1->G2.
     // The original run was 3 long. The insertion run was 1 long. We need 1 more for the
     // fact that an existing piece of the run was split in half (to hold the latter half).
-    const size_t cNewRun = _list.size() + newAttrs.size() + 1;
-    std::vector<TextAttributeRun> newRun;
+    const size_t cNewRun = _list.size() + insertRuns.size() + 1;
+    std::vector<TextAttributeIdRun> newRun;
     newRun.resize(cNewRun);
 
     // We will start analyzing from the beginning of our existing run.
@@ -334,8 +399,8 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
     const auto existingRun = _list.begin();
     auto pExistingRunPos = existingRun;
     const auto pExistingRunEnd = existingRun + _list.size();
-    auto pInsertRunPos = newAttrs.begin();
-    size_t cInsertRunRemaining = newAttrs.size();
+    auto pInsertRunPos = insertRuns.cbegin();
+    size_t cInsertRunRemaining = insertRuns.size();
     auto pNewRunPos = newRun.begin();
     size_t iExistingRunCoverage = 0;
 
@@ -389,7 +454,7 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
         // Now we're still on that "last cell copied" into the new run.
         // If the color of that existing copied cell matches the color of the first segment
         // of the run we're about to insert, we can just increment the length to extend the coverage.
-        if (pNewRunPos->GetAttributes() == pInsertRunPos->GetAttributes())
+        if (pNewRunPos->GetAttributeId() == pInsertRunPos->GetAttributeId())
         {
             length += pInsertRunPos->GetLength();
 
@@ -454,7 +519,7 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
             // This case is slightly off from the example above. This case is for if the B2 above was actually Y2.
             // That Y2 from the existing run is the same color as the Y2 we just filled a few columns left in the final run
             // so we can just adjust the final run's column count instead of adding another segment here.
-            if (pNewRunPos->GetAttributes() == pExistingRunPos->GetAttributes())
+            if (pNewRunPos->GetAttributeId() == pExistingRunPos->GetAttributeId())
             {
                 size_t length = pNewRunPos->GetLength();
                 length += (iExistingRunCoverage - (iEnd + 1));
@@ -469,7 +534,7 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
                 pNewRunPos++;
 
                 // Copy the existing run's color information to the new run
-                pNewRunPos->SetAttributes(pExistingRunPos->GetAttributes());
+                pNewRunPos->SetAttributeId(pExistingRunPos->GetAttributeId());
 
                 // Adjust the length of that copied color to cover only the reduced number of columns needed
                 // now that some have been replaced by the insert run.
@@ -491,7 +556,7 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
         // New Run desired when done = R3 -> B7
         // Existing run pointer is on B2.
         // We want to merge the 2 from the B2 into the B5 so we get B7.
-        else if (pNewRunPos->GetAttributes() == pExistingRunPos->GetAttributes())
+        else if (pNewRunPos->GetAttributeId() == pExistingRunPos->GetAttributeId())
         {
             // Add the value from the existing run into the current new run position.
             size_t length = pNewRunPos->GetLength();
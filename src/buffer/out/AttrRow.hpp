@@ -28,7 +28,7 @@ class ATTR_ROW final
 public:
     using const_iterator = typename AttrRowIterator;
 
-    ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr);
+    ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr, TextAttributeTable& table);
 
     void Reset(const TextAttribute attr);
 
@@ -37,6 +37,8 @@ public:
                                   size_t* const pApplies) const;
 
     size_t GetNumberOfRuns() const noexcept;
+    TextAttributeRun GetRunAt(const size_t runIndex) const;
+    TextAttributeTable::id_type GetAttrIdAt(const size_t runIndex) const;
 
     size_t FindAttrIndex(const size_t index,
                          size_t* const pApplies) const;
@@ -47,6 +49,8 @@ public:
 
     void Resize(const size_t newWidth);
 
+    void MarkAttrIdsInUse(std::vector<bool>& inUse) const;
+
     [[nodiscard]] HRESULT InsertAttrRuns(const std::basic_string_view<TextAttributeRun> newAttrs,
                                          const size_t iStart,
                                          const size_t iEnd,
@@ -64,8 +68,9 @@ public:
     friend class AttrRowIterator;
 
 private:
-    std::vector<TextAttributeRun> _list;
+    std::vector<TextAttributeIdRun> _list;
     size_t _cchRowWidth;
+    TextAttributeTable* _pTable; // non ownership pointer
 
 #ifdef UNIT_TESTING
     friend class AttrRowTests;
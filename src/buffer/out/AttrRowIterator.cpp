@@ -84,12 +84,22 @@ AttrRowIterator AttrRowIterator::operator--(int)
 
 const TextAttribute* AttrRowIterator::operator->() const
 {
-    return &_run->GetAttributes();
+    return &_pAttrRow->_pTable->Lookup(_run->GetAttributeId());
 }
 
 const TextAttribute& AttrRowIterator::operator*() const
 {
-    return _run->GetAttributes();
+    return _pAttrRow->_pTable->Lookup(_run->GetAttributeId());
+}
+
+// Routine Description:
+// - retrieves the interned ID of the attribute the iterator points to.
+// - cheaper than comparing full attributes when looking for where a run of color ends.
+// Return Value:
+// - the attribute ID within the owning buffer's attribute table
+TextAttributeTable::id_type AttrRowIterator::GetAttributeId() const
+{
+    return _run->GetAttributeId();
 }
 
 // Routine Description:
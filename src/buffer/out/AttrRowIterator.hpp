@@ -50,10 +50,12 @@ public:
     const TextAttribute* operator->() const;
     const TextAttribute& operator*() const;
 
+    TextAttributeTable::id_type GetAttributeId() const;
+
 private:
-    std::vector<TextAttributeRun>::const_iterator _run;
+    std::vector<TextAttributeIdRun>::const_iterator _run;
     const ATTR_ROW* _pAttrRow;
-    size_t _currentAttributeIndex; // index of TextAttribute within the current TextAttributeRun
+    size_t _currentAttributeIndex; // index of TextAttribute within the current TextAttributeIdRun
 
     void _increment(size_t count);
     void _decrement(size_t count);
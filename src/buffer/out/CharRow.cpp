@@ -273,6 +273,74 @@ std::wstring CharRow::GetTextRaw() const
     return wstr;
 }
 
+// Routine Description:
+// - returns string with exactly one code unit for each column, so that an
+//   index into it is also a column of the row. Both halves of a wide glyph
+//   are included, and a glyph longer than one code unit gives its first one.
+// Arguments:
+// - none
+// Return Value:
+// - text of the row, one code unit per column
+// - Note: will throw exception if out of memory
+std::wstring CharRow::GetColumnText() const
+{
+    std::wstring wstr;
+    wstr.reserve(_data.size());
+    for (size_t i = 0; i < _data.size(); ++i)
+    {
+        const auto& cell = _data[i];
+        wstr.push_back(cell.DbcsAttr().IsGlyphStored() ? *GlyphAt(i).begin() : cell.Char());
+    }
+    return wstr;
+}
+
+// Routine Description:
+// - counts the code units that GetText would produce for a span of columns.
+//   Trailing halves of wide glyphs contribute nothing, the same as GetText.
+// Arguments:
+// - startIndex - the first column to measure
+// - endIndex - one past the last column to measure
+// Return Value:
+// - the length of the text in the columns, in code units
+size_t CharRow::MeasureText(const size_t startIndex, const size_t endIndex) const
+{
+    size_t length = 0;
+    for (size_t i = startIndex; i < std::min(endIndex, _data.size()); ++i)
+    {
+        if (!DbcsAttrAt(i).IsTrailing())
+        {
+            length += static_cast<std::wstring_view>(GlyphAt(i)).size();
+        }
+    }
+    return length;
+}
+
+// Routine Description:
+// - copies the text of a span of columns into a caller provided buffer, in
+//   the same form as GetText but without allocating.
+// Arguments:
+// - startIndex - the first column to copy
+// - endIndex - one past the last column to copy
+// - dest - the buffer to copy into. Text that doesn't fit is cut off.
+// Return Value:
+// - the number of code units written to dest
+size_t CharRow::CopyText(const size_t startIndex, const size_t endIndex, gsl::span<wchar_t> dest) const
+{
+    const size_t destLength = gsl::narrow<size_t>(dest.size());
+    size_t written = 0;
+    for (size_t i = startIndex; i < std::min(endIndex, _data.size()) && written < destLength; ++i)
+    {
+        if (!DbcsAttrAt(i).IsTrailing())
+        {
+            const std::wstring_view glyph = GlyphAt(i);
+            const size_t count = std::min(glyph.size(), destLength - written);
+            std::copy_n(glyph.data(), count, dest.data() + written);
+            written += count;
+        }
+    }
+    return written;
+}
+
 std::wstring CharRow::GetText() const
 {
     std::wstring wstr;
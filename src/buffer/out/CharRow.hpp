@@ -67,6 +67,13 @@ public:
     // other functions implemented at the template class level
     std::wstring GetTextRaw() const;
 
+    // returns one code unit per column, so that an index into the text is a column
+    std::wstring GetColumnText() const;
+
+    // measures and copies the GetText() text of a span of columns without building a string
+    size_t MeasureText(const size_t startIndex, const size_t endIndex) const;
+    size_t CopyText(const size_t startIndex, const size_t endIndex, gsl::span<wchar_t> dest) const;
+
     // working with glyphs
     const reference GlyphAt(const size_t column) const;
     reference GlyphAt(const size_t column);
@@ -6,6 +6,7 @@
 #include "CharRow.hpp"
 #include "textBuffer.hpp"
 #include "../types/inc/convert.hpp"
+#include "../types/inc/ConsoleMetrics.hpp"
 
 // Routine Description:
 // - constructor
@@ -20,7 +21,7 @@ ROW::ROW(const SHORT rowId, const short rowWidth, const TextAttribute fillAttrib
     _id{ rowId },
     _rowWidth{ gsl::narrow<size_t>(rowWidth) },
     _charRow{ gsl::narrow<size_t>(rowWidth), this },
-    _attrRow{ gsl::narrow<UINT>(rowWidth), fillAttribute },
+    _attrRow{ gsl::narrow<UINT>(rowWidth), fillAttribute, pParent->GetAttributeTable() },
     _pParent{ pParent }
 {
 }
@@ -160,6 +161,8 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
     // If we're given a right-side column limit, use it. Otherwise, the write limit is the final column index available in the char row.
     const auto finalColumnInRow = limitRight.value_or(_charRow.size() - 1);
 
+    Microsoft::Console::Metrics::Add(Microsoft::Console::Metrics::Counter::BufferRowsWritten);
+
     while (it && currentIndex <= finalColumnInRow)
     {
         // Fill the color if the behavior isn't set to keeping the current color.
@@ -219,3 +222,149 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
 
     return it;
 }
+
+// Routine Description:
+// - copies a span of this row out as legacy CHAR_INFO cells.
+// - characters are copied column by column, but each attribute run is only
+//   converted to its legacy form once and then filled across its columns.
+// Arguments:
+// - index - column in row to start reading from
+// - target - where to put the cells. one CHAR_INFO is filled in per column.
+// - generateLegacyAttributes - converts a text attribute to its legacy color form
+// Return Value:
+// - <none>
+// Note:
+// - will throw on error
+void ROW::ReadCharInfos(const size_t index,
+                        gsl::span<CHAR_INFO> target,
+                        const std::function<WORD(const TextAttribute&)>& generateLegacyAttributes) const
+{
+    const auto count = gsl::narrow<size_t>(target.size());
+    THROW_HR_IF(E_INVALIDARG, index > _charRow.size());
+    THROW_HR_IF(E_INVALIDARG, count > _charRow.size() - index);
+
+    auto targetIt = target.begin();
+    auto cellIt = _charRow.cbegin() + index;
+    for (size_t column = index; column < index + count; ++column, ++cellIt, ++targetIt)
+    {
+        const auto dbcsAttr = cellIt->DbcsAttr();
+
+        // Only glyphs that didn't fit in the cell have to be looked up elsewhere.
+        targetIt->Char.UnicodeChar = dbcsAttr.IsGlyphStored() ? Utf16ToUcs2(_charRow.GlyphAt(column)) : cellIt->Char();
+        targetIt->Attributes = dbcsAttr.GeneratePublicApiAttributeFormat();
+    }
+
+    size_t applies = 0;
+    auto runIndex = _attrRow.FindAttrIndex(index, &applies);
+    targetIt = target.begin();
+    size_t remaining = count;
+    while (remaining > 0)
+    {
+        const WORD legacyAttr = generateLegacyAttributes(_attrRow.GetRunAt(runIndex).GetAttributes());
+        const auto fill = std::min(applies, remaining);
+        for (size_t i = 0; i < fill; ++i, ++targetIt)
+        {
+            targetIt->Attributes |= legacyAttr;
+        }
+        remaining -= fill;
+
+        if (remaining > 0)
+        {
+            ++runIndex;
+            applies = _attrRow.GetRunAt(runIndex).GetLength();
+        }
+    }
+}
+
+// Routine Description:
+// - writes legacy CHAR_INFO cells to the row.
+// - this follows the same rules as WriteCells for double byte characters that
+//   don't fit at the edges of the row, but it stores the characters directly
+//   and merges all of the colors into the attribute row at once.
+// Arguments:
+// - source - the cells to write, one per column
+// - index - column in row to start writing at
+// - setWrap - set the wrap flag if we fill the last column of the row.
+// Return Value:
+// - the number of cells from source that were written to this row.
+// Note:
+// - will throw on error
+size_t ROW::WriteCharInfos(const gsl::span<const CHAR_INFO> source, const size_t index, const bool setWrap)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    const auto finalColumnInRow = _charRow.size() - 1;
+    const auto sourceSize = gsl::narrow<size_t>(source.size());
+
+    Microsoft::Console::Metrics::Add(Microsoft::Console::Metrics::Counter::BufferRowsWritten);
+
+    // Adjacent cells usually share their color, so this is one run per color change, not per cell.
+    std::vector<TextAttributeRun> attrRuns;
+    WORD lastLegacyAttr = 0;
+
+    size_t consumed = 0;
+    size_t currentIndex = index;
+    auto cellIt = _charRow.begin() + index;
+    while (consumed < sourceSize && currentIndex <= finalColumnInRow)
+    {
+        const auto& charInfo = *(source.begin() + consumed);
+
+        const WORD legacyAttr = static_cast<WORD>(charInfo.Attributes & ~COMMON_LVB_SBCSDBCS);
+        if (!attrRuns.empty() && legacyAttr == lastLegacyAttr)
+        {
+            attrRuns.back().IncrementLength();
+        }
+        else
+        {
+            attrRuns.emplace_back(1, TextAttribute{ legacyAttr });
+            lastLegacyAttr = legacyAttr;
+        }
+
+        DbcsAttribute dbcsAttr;
+        if (WI_IsFlagSet(charInfo.Attributes, COMMON_LVB_LEADING_BYTE))
+        {
+            dbcsAttr.SetLeading();
+        }
+        else if (WI_IsFlagSet(charInfo.Attributes, COMMON_LVB_TRAILING_BYTE))
+        {
+            dbcsAttr.SetTrailing();
+        }
+
+        const bool fillingLastColumn = currentIndex == finalColumnInRow;
+
+        // A trailing byte in the first column or a leading byte in the last one
+        // is padded out the same way WriteCells does it.
+        if (currentIndex == 0 && dbcsAttr.IsTrailing())
+        {
+            cellIt->Reset();
+        }
+        else if (fillingLastColumn && dbcsAttr.IsLeading())
+        {
+            cellIt->Reset();
+            _charRow.SetDoubleBytePadded(true);
+        }
+        else
+        {
+            *cellIt = CharRowCell{ charInfo.Char.UnicodeChar, dbcsAttr };
+            ++consumed;
+        }
+
+        if (setWrap && fillingLastColumn)
+        {
+            _charRow.SetWrapForced(true);
+        }
+
+        ++cellIt;
+        ++currentIndex;
+    }
+
+    if (currentIndex > index)
+    {
+        LOG_IF_FAILED(_attrRow.InsertAttrRuns({ attrRuns.data(), attrRuns.size() },
+                                              index,
+                                              currentIndex - 1,
+                                              _charRow.size()));
+    }
+
+    return consumed;
+}
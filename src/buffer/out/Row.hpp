@@ -59,6 +59,11 @@ public:
 
     OutputCellIterator WriteCells(OutputCellIterator it, const size_t index, const bool setWrap, std::optional<size_t> limitRight = std::nullopt);
 
+    void ReadCharInfos(const size_t index,
+                       gsl::span<CHAR_INFO> target,
+                       const std::function<WORD(const TextAttribute&)>& generateLegacyAttributes) const;
+    size_t WriteCharInfos(const gsl::span<const CHAR_INFO> source, const size_t index, const bool setWrap);
+
     friend bool operator==(const ROW& a, const ROW& b) noexcept;
 
 #ifdef UNIT_TESTING
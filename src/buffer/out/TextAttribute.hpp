@@ -161,6 +161,8 @@ private:
     TextColor _background;
     bool _isBold;
 
+    friend struct std::hash<TextAttribute>;
+
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
     friend class TextAttributeTests;
@@ -21,6 +21,7 @@ Revision History:
 #pragma once
 
 #include "TextAttribute.hpp"
+#include "TextAttributeTable.hpp"
 
 class TextAttributeRun final
 {
@@ -45,3 +46,58 @@ private:
     friend class AttrRowTests;
 #endif
 };
+
+// A run as it is stored inside an ATTR_ROW. The attribute itself lives in the
+// owning buffer's TextAttributeTable and the run only carries its ID.
+class TextAttributeIdRun final
+{
+public:
+    constexpr TextAttributeIdRun() noexcept :
+        _cchLength{ 0 },
+        _attrId{ 0 }
+    {
+    }
+
+    constexpr TextAttributeIdRun(const size_t cchLength, const TextAttributeTable::id_type attrId) noexcept :
+        _cchLength{ static_cast<uint16_t>(cchLength) },
+        _attrId{ attrId }
+    {
+    }
+
+    constexpr size_t GetLength() const noexcept
+    {
+        return _cchLength;
+    }
+
+    constexpr void SetLength(const size_t cchLength) noexcept
+    {
+        _cchLength = static_cast<uint16_t>(cchLength);
+    }
+
+    constexpr void IncrementLength() noexcept
+    {
+        _cchLength++;
+    }
+
+    constexpr void DecrementLength() noexcept
+    {
+        _cchLength--;
+    }
+
+    constexpr TextAttributeTable::id_type GetAttributeId() const noexcept
+    {
+        return _attrId;
+    }
+
+    constexpr void SetAttributeId(const TextAttributeTable::id_type attrId) noexcept
+    {
+        _attrId = attrId;
+    }
+
+private:
+    // rows are at most SHORT_MAX wide, so a run never needs more than 16 bits of length.
+    uint16_t _cchLength;
+    TextAttributeTable::id_type _attrId;
+};
+
+static_assert(sizeof(TextAttributeIdRun) == 8, "A stored run should only need 2B of length and 4B of attribute ID");
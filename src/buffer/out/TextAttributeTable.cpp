@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "TextAttributeTable.hpp"
+
+// Routine Description:
+// - Constructs an empty table
+TextAttributeTable::TextAttributeTable() :
+    _attributes{},
+    _ids{},
+    _freeIds{},
+    _sweepThreshold{ MinSweepThreshold }
+{
+}
+
+// Routine Description:
+// - Retrieves the ID for the given attribute, adding it to the table if it isn't there yet.
+// - The attribute is always stored exactly. Slots freed by Sweep are reused before the
+//   table grows.
+// Arguments:
+// - attr - the attribute to intern
+// Return Value:
+// - the ID that now represents attr
+// Note:
+// - will throw if unable to allocate memory
+TextAttributeTable::id_type TextAttributeTable::Intern(const TextAttribute& attr)
+{
+    const auto found = _ids.find(attr);
+    if (found != _ids.end())
+    {
+        return found->second;
+    }
+
+    if (!_freeIds.empty())
+    {
+        const auto id = _freeIds.back();
+        _ids.emplace(attr, id);
+        _freeIds.pop_back();
+        _attributes[id] = attr;
+        return id;
+    }
+
+    THROW_HR_IF(E_OUTOFMEMORY, _attributes.size() > std::numeric_limits<id_type>::max());
+
+    const auto id = gsl::narrow_cast<id_type>(_attributes.size());
+    _attributes.push_back(attr);
+    try
+    {
+        _ids.emplace(attr, id);
+    }
+    catch (...)
+    {
+        _attributes.pop_back();
+        throw;
+    }
+    return id;
+}
+
+// Routine Description:
+// - Retrieves the ID for the given attribute without adding it to the table.
+// Arguments:
+// - attr - the attribute to look for
+// Return Value:
+// - the ID representing attr, or nullopt if it hasn't been interned
+std::optional<TextAttributeTable::id_type> TextAttributeTable::Find(const TextAttribute& attr) const
+{
+    const auto found = _ids.find(attr);
+    if (found != _ids.end())
+    {
+        return found->second;
+    }
+    return std::nullopt;
+}
+
+// Routine Description:
+// - Retrieves the attribute represented by the given ID.
+// - IDs only ever come from Intern on this same table, so they're always in range.
+// Arguments:
+// - id - the ID to look up
+// Return Value:
+// - reference to the attribute. Valid for as long as the ID is in use: Sweep
+//   never moves an attribute that is still referenced.
+const TextAttribute& TextAttributeTable::Lookup(const id_type id) const noexcept
+{
+    return _attributes[id];
+}
+
+// Routine Description:
+// - Reports how many distinct attributes are currently stored
+size_t TextAttributeTable::Size() const noexcept
+{
+    return _ids.size();
+}
+
+// Routine Description:
+// - Reports how many IDs have been handed out so far, including freed ones.
+//   Every ID in use is less than this.
+size_t TextAttributeTable::SlotCount() const noexcept
+{
+    return _attributes.size();
+}
+
+// Routine Description:
+// - Reports whether the table has grown enough since the last sweep that the
+//   owner should look for attributes that are no longer referenced.
+// - This is checked on every write, so it's only a comparison. The threshold
+//   doubles with the number of attributes that survive a sweep, so a buffer
+//   that really holds many attributes isn't swept over and over.
+bool TextAttributeTable::ShouldSweep() const noexcept
+{
+    return _ids.size() >= _sweepThreshold;
+}
+
+// Routine Description:
+// - Frees the ID of every attribute that is no longer referenced, so that
+//   Intern can reuse it. IDs that are still in use keep their value and their
+//   attribute, so the owner doesn't need to rewrite anything.
+// Arguments:
+// - inUse - indexed by ID, true for every ID still referenced by the owner
+// Note:
+// - will throw if unable to allocate memory. The table stays consistent if
+//   it throws, with some unused IDs possibly still allocated.
+void TextAttributeTable::Sweep(const std::vector<bool>& inUse)
+{
+    _freeIds.reserve(_attributes.size());
+
+    for (auto it = _ids.begin(); it != _ids.end();)
+    {
+        const auto id = it->second;
+        if (id < inUse.size() && inUse[id])
+        {
+            ++it;
+        }
+        else
+        {
+            _freeIds.push_back(id);
+            it = _ids.erase(it);
+        }
+    }
+
+    _sweepThreshold = std::max(MinSweepThreshold, _ids.size() * 2);
+}
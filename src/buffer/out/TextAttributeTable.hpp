@@ -0,0 +1,97 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- TextAttributeTable.hpp
+
+Abstract:
+- interning table for the text attributes used within one text buffer.
+- attribute runs store a 32-bit ID into this table instead of a full
+  TextAttribute, so runs stay small and comparing two runs is an integer compare.
+--*/
+
+#pragma once
+
+#include "TextAttribute.hpp"
+
+#include <deque>
+#include <unordered_map>
+
+// std::unordered_map needs help to know how to hash a TextColor and a TextAttribute
+namespace std
+{
+    template<>
+    struct hash<TextColor>
+    {
+        // Routine Description:
+        // - hashes a color. the type and the three color bytes fit in the lower bits of a size_t.
+        // Arguments:
+        // - color - the color to hash
+        // Return Value:
+        // - the hashed color
+        constexpr size_t operator()(const TextColor& color) const noexcept
+        {
+            return (static_cast<size_t>(color._meta) << 24) |
+                   (static_cast<size_t>(color._red) << 16) |
+                   (static_cast<size_t>(color._green) << 8) |
+                   static_cast<size_t>(color._blue);
+        }
+    };
+
+    template<>
+    struct hash<TextAttribute>
+    {
+        // Routine Description:
+        // - hashes an attribute by mixing the hashes of both colors with the meta attributes.
+        // Arguments:
+        // - attr - the attribute to hash
+        // Return Value:
+        // - the hashed attribute
+        size_t operator()(const TextAttribute& attr) const noexcept
+        {
+            const hash<TextColor> colorHash;
+            size_t retVal = colorHash(attr._foreground);
+            retVal = (retVal * 31) ^ colorHash(attr._background);
+            retVal = (retVal * 31) ^ attr._wAttrLegacy;
+            retVal = (retVal * 31) ^ static_cast<size_t>(attr._isBold);
+            return retVal;
+        }
+    };
+}
+
+class TextAttributeTable final
+{
+public:
+    // A buffer is at most SHORT_MAX by SHORT_MAX cells, so even if every cell
+    // had its own attribute, 32 bits would be enough to give each one an ID.
+    using id_type = uint32_t;
+
+    // Unused attributes aren't looked for until the table holds this many,
+    // and after each sweep, until it holds twice as many as survived.
+    static constexpr size_t MinSweepThreshold = 4096;
+
+    TextAttributeTable();
+
+    id_type Intern(const TextAttribute& attr);
+    std::optional<id_type> Find(const TextAttribute& attr) const;
+    const TextAttribute& Lookup(const id_type id) const noexcept;
+
+    size_t Size() const noexcept;
+    size_t SlotCount() const noexcept;
+
+    bool ShouldSweep() const noexcept;
+    void Sweep(const std::vector<bool>& inUse);
+
+private:
+    // deque so references handed out by Lookup stay valid as the table grows.
+    // slots are never moved or removed, only reused once they've been freed.
+    std::deque<TextAttribute> _attributes;
+    std::unordered_map<TextAttribute, id_type> _ids;
+    std::vector<id_type> _freeIds;
+    size_t _sweepThreshold;
+
+#ifdef UNIT_TESTING
+    friend class TextAttributeTableTests;
+#endif
+};
@@ -7,6 +7,7 @@
 #include "CharRow.hpp"
 
 #include "../types/inc/convert.hpp"
+#include "../types/inc/ConsoleMetrics.hpp"
 
 #pragma hdrstop
 
@@ -26,6 +27,7 @@ TextBuffer::TextBuffer(const COORD screenBufferSize,
                        const TextAttribute defaultAttributes,
                        const UINT cursorSize,
                        Microsoft::Console::Render::IRenderTarget& renderTarget) :
+    _attributeTable{},
     _firstRow{ 0 },
     _currentAttributes{ defaultAttributes },
     _cursor{ cursorSize, *this },
@@ -360,6 +362,8 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
         return givenIt;
     }
 
+    _SweepAttributeTable();
+
     //  Get the row and write the cells
     ROW& row = GetRowByOffset(target.Y);
     const auto newIt = row.WriteCells(givenIt, target.X, setWrap, limitRight);
@@ -372,6 +376,42 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
     return newIt;
 }
 
+// Routine Description:
+// - Writes legacy CHAR_INFO cells to the output buffer, moving on to the next line
+//   if they don't fit on the first one.
+// - This is the bulk counterpart of Write for callers that already have CHAR_INFOs,
+//   so each cell doesn't have to be turned into a view and its color merged on its own.
+// Arguments:
+// - source - the cells to write
+// - target - the row/column to start writing the cells to
+// Return Value:
+// - The number of cells that were written
+size_t TextBuffer::WriteCharInfos(const gsl::span<const CHAR_INFO> source,
+                                  const COORD target)
+{
+    const auto size = GetSize();
+    const auto sourceSize = gsl::narrow<size_t>(source.size());
+
+    auto lineTarget = target;
+    size_t consumed = 0;
+    while (consumed < sourceSize && size.IsInBounds(lineTarget))
+    {
+        _SweepAttributeTable();
+
+        ROW& row = GetRowByOffset(lineTarget.Y);
+        const auto written = row.WriteCharInfos(source.subspan(gsl::narrow<ptrdiff_t>(consumed)), lineTarget.X, true);
+
+        const Viewport paint = Viewport::FromDimensions(lineTarget, { gsl::narrow<SHORT>(written), 1 });
+        _NotifyPaint(paint);
+
+        consumed += written;
+        lineTarget.X = 0;
+        ++lineTarget.Y;
+    }
+
+    return consumed;
+}
+
 //Routine Description:
 // - Inserts one codepoint into the buffer at the current cursor position and advances the cursor as appropriate.
 //Arguments:
@@ -388,6 +428,8 @@ bool TextBuffer::InsertCharacter(const std::wstring_view chars,
     // Ensure consistent buffer state for double byte characters based on the character type we're about to insert
     bool fSuccess = _PrepareForDoubleByteSequence(dbcsAttribute);
 
+    _SweepAttributeTable();
+
     if (fSuccess)
     {
         // Get the current cursor position
@@ -539,6 +581,8 @@ bool TextBuffer::IncrementCircularBuffer()
     // to the logical position 0 in the window (cursor coordinates and all other coordinates).
     _renderTarget.TriggerCircling();
 
+    Microsoft::Console::Metrics::Add(Microsoft::Console::Metrics::Counter::BufferCircularIncrements);
+
     // First, clean out the old "first row" as it will become the "last row" of the buffer after the circle is performed.
     bool fSuccess = _storage.at(_firstRow).Reset(_currentAttributes);
     if (fSuccess)
@@ -836,6 +880,37 @@ UnicodeStorage& TextBuffer::GetUnicodeStorage()
     return _unicodeStorage;
 }
 
+const TextAttributeTable& TextBuffer::GetAttributeTable() const noexcept
+{
+    return _attributeTable;
+}
+
+TextAttributeTable& TextBuffer::GetAttributeTable() noexcept
+{
+    return _attributeTable;
+}
+
+// Routine Description:
+// - Once the attribute table has grown enough since it was last swept, frees the
+//   attributes that are no longer referenced by any row so their IDs can be reused.
+// - Attributes still in use keep their IDs, so no row has to be rewritten.
+// - Most of the time this is a single comparison.
+void TextBuffer::_SweepAttributeTable()
+{
+    if (!_attributeTable.ShouldSweep())
+    {
+        return;
+    }
+
+    std::vector<bool> inUse(_attributeTable.SlotCount(), false);
+    for (const auto& row : _storage)
+    {
+        row.GetAttrRow().MarkAttrIdsInUse(inUse);
+    }
+
+    _attributeTable.Sweep(inUse);
+}
+
 // Routine Description:
 // - Method to help refresh all the Row IDs after manipulating the row
 //   by shuffling pointers around.
@@ -921,110 +996,687 @@ Microsoft::Console::Render::IRenderTarget& TextBuffer::GetRenderTarget()
 }
 
 // Routine Description:
-// - Retrieves the text data from the selected region and presents it in a clipboard-ready format (given little post-processing).
+// - Appends the UTF-8 encoding of the given text onto the end of the output string.
+// - Converts in place into the tail of the string so no intermediate buffer is allocated.
 // Arguments:
-// - lineSelection - true if entire line is being selected. False otherwise (box selection)
-// - trimTrailingWhitespace - setting flag removes trailing whitespace at the end of each row in selection
-// - selectionRects - the selection regions from which the data will be extracted from the buffer
-// - GetForegroundColor - function used to map TextAttribute to RGB COLORREF for foreground color
-// - GetBackgroundColor - function used to map TextAttribute to RGB COLORREF for foreground color
-// Return Value:
-// - The text, background color, and foreground color data of the selected region of the text buffer.
-const TextBuffer::TextAndColor TextBuffer::GetTextForClipboard(const bool lineSelection,
-                                                               const bool trimTrailingWhitespace,
-                                                               const std::vector<SMALL_RECT>& selectionRects,
-                                                               std::function<COLORREF(TextAttribute&)> GetForegroundColor,
-                                                               std::function<COLORREF(TextAttribute&)> GetBackgroundColor) const
-{
-    TextAndColor data;
-
-    // preallocate our vectors to reduce reallocs
-    size_t const rows = selectionRects.size();
-    data.text.reserve(rows);
-    data.FgAttr.reserve(rows);
-    data.BkAttr.reserve(rows);
-
-    // for each row in the selection
-    for (UINT i = 0; i < rows; i++)
+// - text - UTF-16 text to convert
+// - out - string to append to
+static void _AppendUtf8(const std::wstring_view text, std::string& out)
+{
+    if (text.empty())
     {
-        const UINT iRow = selectionRects.at(i).Top;
+        return;
+    }
 
-        const Viewport highlight = Viewport::FromInclusive(selectionRects.at(i));
+    const int cchText = gsl::narrow<int>(text.size());
+    const int cbNeeded = WideCharToMultiByte(CP_UTF8, 0, text.data(), cchText, nullptr, 0, nullptr, nullptr);
+    THROW_LAST_ERROR_IF(0 == cbNeeded);
 
-        // retrieve the data from the screen buffer
-        auto it = GetCellDataAt(highlight.Origin(), highlight);
+    const size_t offset = out.size();
+    out.resize(offset + cbNeeded);
+    THROW_LAST_ERROR_IF(0 == WideCharToMultiByte(CP_UTF8, 0, text.data(), cchText, out.data() + offset, cbNeeded, nullptr, nullptr));
+}
 
-        // allocate a string buffer
-        std::wstring selectionText;
-        std::vector<COLORREF> selectionFgAttr;
-        std::vector<COLORREF> selectionBkAttr;
+// Routine Description:
+// - Appends the given text as HTML, escaping markup characters along the way.
+// Arguments:
+// - text - UTF-16 text to convert
+// - out - string to append to
+static void _AppendHtmlEscaped(const std::wstring_view text, std::string& out)
+{
+    size_t pending = 0;
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        const char* escaped = nullptr;
+        switch (text[i])
+        {
+        case L'<':
+            escaped = "&lt;";
+            break;
+        case L'>':
+            escaped = "&gt;";
+            break;
+        case L'&':
+            escaped = "&amp;";
+            break;
+        default:
+            continue;
+        }
 
-        // preallocate to avoid reallocs
-        selectionText.reserve(highlight.Width() + 2); // + 2 for \r\n if we munged it
-        selectionFgAttr.reserve(highlight.Width() + 2);
-        selectionBkAttr.reserve(highlight.Width() + 2);
+        _AppendUtf8(text.substr(pending, i - pending), out);
+        out.append(escaped);
+        pending = i + 1;
+    }
+    _AppendUtf8(text.substr(pending), out);
+}
 
-        // copy char data into the string buffer, skipping trailing bytes
-        while (it)
+// Routine Description:
+// - Appends the given text as the body of an RTF document, escaping control characters
+//   and encoding anything outside of 7-bit ASCII as \uN? escapes.
+// Arguments:
+// - text - UTF-16 text to convert
+// - out - string to append to
+static void _AppendRtfEscaped(const std::wstring_view text, std::string& out)
+{
+    for (const wchar_t wch : text)
+    {
+        if (wch == L'\\' || wch == L'{' || wch == L'}')
+        {
+            out.push_back('\\');
+            out.push_back(static_cast<char>(wch));
+        }
+        else if (wch == UNICODE_CARRIAGERETURN)
+        {
+            // line breaks are emitted by the caller as \line
+        }
+        else if (wch == UNICODE_LINEFEED)
+        {
+            out.append("\\line ");
+        }
+        else if (wch < 0x80)
+        {
+            out.push_back(static_cast<char>(wch));
+        }
+        else
         {
-            const auto& cell = *it;
-            auto cellData = cell.TextAttr();
-            COLORREF const CellFgAttr = GetForegroundColor(cellData);
-            COLORREF const CellBkAttr = GetBackgroundColor(cellData);
+            // RTF wants signed 16-bit values for \u, followed by a fallback character for old readers.
+            out.append("\\u");
+            out.append(std::to_string(static_cast<short>(wch)));
+            out.push_back('?');
+        }
+    }
+}
 
-            if (!cell.DbcsAttr().IsTrailing())
+// Routine Description:
+// - Walks the selected region of the buffer one attribute run at a time.
+// - Text for each run is gathered into a scratch buffer no wider than one row and
+//   handed to runFn along with the attribute that applies to it. Trailing halves of
+//   double-width characters are skipped.
+// - Line breaks are reported through lineBreakFn where a CR/LF belongs in the copied text.
+// Arguments:
+// - lineSelection - true if entire line is being selected. False otherwise (box selection)
+// - trimTrailingWhitespace - setting flag removes trailing whitespace at the end of each row in selection
+// - selectionRects - the selection regions from which the data will be extracted from the buffer
+// - runFn - called as runFn(std::wstring_view text, const TextAttribute& attr) for each run
+// - lineBreakFn - called with no arguments for each line break
+template<typename TRunFn, typename TLineBreakFn>
+void TextBuffer::_WalkSelection(const bool lineSelection,
+                                const bool trimTrailingWhitespace,
+                                const std::vector<SMALL_RECT>& selectionRects,
+                                TRunFn runFn,
+                                TLineBreakFn lineBreakFn) const
+{
+    std::wstring runText;
+
+    for (size_t i = 0; i < selectionRects.size(); ++i)
+    {
+        const auto& rect = selectionRects.at(i);
+        const ROW& row = GetRowByOffset(rect.Top);
+        const CharRow& charRow = row.GetCharRow();
+        const ATTR_ROW& attrRow = row.GetAttrRow();
+
+        // FOR LINE SELECTION ONLY: if the row was wrapped, don't remove the spaces at the end
+        // and don't apply CR/LF.
+        const bool wrapContinues = lineSelection && charRow.WasWrapForced();
+
+        const size_t left = gsl::narrow<size_t>(std::max<SHORT>(rect.Left, 0));
+        size_t right = std::min(gsl::narrow<size_t>(std::max<SHORT>(rect.Right, -1) + 1), charRow.size());
+
+        // trim trailing spaces if SHIFT key not held
+        if (trimTrailingWhitespace && !wrapContinues)
+        {
+            while (right > left)
             {
-                selectionText.append(cell.Chars());
-                for (const wchar_t wch : cell.Chars())
+                const auto& cell = *(charRow.cbegin() + (right - 1));
+                if (!cell.IsSpace() || cell.DbcsAttr().IsTrailing())
                 {
-                    selectionFgAttr.push_back(CellFgAttr);
-                    selectionBkAttr.push_back(CellBkAttr);
+                    break;
                 }
+                --right;
             }
-            it++;
         }
 
-        // trim trailing spaces if SHIFT key not held
-        if (trimTrailingWhitespace)
+        size_t column = left;
+        if (column < right)
         {
-            const ROW& Row = GetRowByOffset(iRow);
+            size_t applies = 0;
+            size_t runIndex = attrRow.FindAttrIndex(column, &applies);
 
-            // FOR LINE SELECTION ONLY: if the row was wrapped, don't remove the spaces at the end.
-            if (!lineSelection || !Row.GetCharRow().WasWrapForced())
+            while (column < right)
             {
-                while (!selectionText.empty() && selectionText.back() == UNICODE_SPACE)
+                const auto& run = attrRow.GetRunAt(runIndex);
+                const size_t runEnd = std::min(column + applies, right);
+
+                runText.clear();
+                for (; column < runEnd; ++column)
                 {
-                    selectionText.pop_back();
-                    selectionFgAttr.pop_back();
-                    selectionBkAttr.pop_back();
+                    if (!charRow.DbcsAttrAt(column).IsTrailing())
+                    {
+                        runText.append(static_cast<std::wstring_view>(charRow.GlyphAt(column)));
+                    }
                 }
-            }
 
-            // apply CR/LF to the end of the final string, unless we're the last line.
-            // a.k.a if we're earlier than the bottom, then apply CR/LF.
-            if (i < selectionRects.size() - 1)
-            {
-                // FOR LINE SELECTION ONLY: if the row was wrapped, do not apply CR/LF.
-                // a.k.a. if the row was NOT wrapped, then we can assume a CR/LF is proper
-                // always apply \r\n for box selection
-                if (!lineSelection || !GetRowByOffset(iRow).GetCharRow().WasWrapForced())
+                if (!runText.empty())
+                {
+                    runFn(std::wstring_view{ runText }, run.GetAttributes());
+                }
+
+                if (++runIndex < attrRow.GetNumberOfRuns())
                 {
-                    COLORREF const Blackness = RGB(0x00, 0x00, 0x00); // cant see CR/LF so just use black FG & BK
-
-                    selectionText.push_back(UNICODE_CARRIAGERETURN);
-                    selectionText.push_back(UNICODE_LINEFEED);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
+                    applies = attrRow.GetRunAt(runIndex).GetLength();
                 }
             }
         }
 
-        data.text.emplace_back(std::move(selectionText));
-        data.FgAttr.emplace_back(std::move(selectionFgAttr));
-        data.BkAttr.emplace_back(std::move(selectionBkAttr));
+        // apply CR/LF to the end of the final string, unless we're the last line.
+        // a.k.a if we're earlier than the bottom, then apply CR/LF.
+        // always apply \r\n for box selection
+        if (trimTrailingWhitespace && i < selectionRects.size() - 1 && !wrapContinues)
+        {
+            lineBreakFn();
+        }
+    }
+}
+
+// Routine Description:
+// - Estimates the length of the plain text of a selection, for the common case of
+//   one wchar_t per cell plus CR/LF per row.
+// Arguments:
+// - selectionRects - the selection regions
+// Return Value:
+// - the number of characters to reserve
+static size_t _EstimatePlainTextLength(const std::vector<SMALL_RECT>& selectionRects) noexcept
+{
+    size_t cchEstimate = 0;
+    for (const auto& rect : selectionRects)
+    {
+        cchEstimate += std::max(rect.Right - rect.Left + 1, 0) + 2;
+    }
+    return cchEstimate;
+}
+
+// Routine Description:
+// - Retrieves the text data from the selected region as one clipboard-ready string.
+// Arguments:
+// - lineSelection - true if entire line is being selected. False otherwise (box selection)
+// - trimTrailingWhitespace - setting flag removes trailing whitespace at the end of each row in selection
+// - selectionRects - the selection regions from which the data will be extracted from the buffer
+// Return Value:
+// - The text of the selected region of the text buffer, rows separated by CR/LF.
+std::wstring TextBuffer::GetPlainText(const bool lineSelection,
+                                      const bool trimTrailingWhitespace,
+                                      const std::vector<SMALL_RECT>& selectionRects) const
+{
+    std::wstring text;
+    text.reserve(_EstimatePlainTextLength(selectionRects));
+
+    _WalkSelection(
+        lineSelection,
+        trimTrailingWhitespace,
+        selectionRects,
+        [&](const std::wstring_view runText, const TextAttribute&) {
+            text.append(runText);
+        },
+        [&]() {
+            text.push_back(UNICODE_CARRIAGERETURN);
+            text.push_back(UNICODE_LINEFEED);
+        });
+
+    return text;
+}
+
+// Routine Description:
+// - Finds the background color of the first selected cell, which the HTML copy
+//   uses as the background of the whole selection.
+// Arguments:
+// - buffer - the buffer the selection is in
+// - selectionRects - the selection regions
+// - GetBackgroundColor - function used to map TextAttribute to RGB COLORREF for background color
+// Return Value:
+// - the background of the first selected cell, or black if nothing is selected
+static COLORREF _GetSelectionBackground(const TextBuffer& buffer,
+                                        const std::vector<SMALL_RECT>& selectionRects,
+                                        const std::function<COLORREF(TextAttribute&)>& GetBackgroundColor)
+{
+    if (selectionRects.empty())
+    {
+        return RGB(0x00, 0x00, 0x00);
+    }
+
+    const auto& first = selectionRects.front();
+    TextAttribute firstAttr = buffer.GetRowByOffset(first.Top).GetAttrRow().GetAttrByColumn(std::max<SHORT>(first.Left, 0));
+    return GetBackgroundColor(firstAttr);
+}
+
+// Builds a CF_HTML document out of the runs of a selection, with one span per
+// change in color.
+class HtmlBuilder final
+{
+public:
+    HtmlBuilder(const COLORREF outerBackground, const int fontHeightPoints, const std::wstring_view fontFaceName);
+
+    void AppendRun(const std::wstring_view text, const COLORREF foreground, const COLORREF background);
+    void AppendLineBreak();
+    std::string Finish();
+
+private:
+    // when formats are expanded, there will be 157 bytes in the header.
+    static constexpr size_t _cbHeader = 157;
+    static constexpr std::string_view _htmlHeader = "<!DOCTYPE><HTML><HEAD><TITLE>Windows Console Host</TITLE></HEAD><BODY>";
+    static constexpr std::string_view _htmlFragStart = "<!--StartFragment -->";
+    static constexpr std::string_view _htmlFragEnd = "<!--EndFragment -->";
+    static constexpr std::string_view _htmlFooter = "</BODY></HTML>";
+    static constexpr std::string_view _spanEnd = "</SPAN>";
+    static constexpr std::string_view _divEnd = "</DIV>";
+
+    void _AppendColor(const COLORREF color);
+
+    std::string _html;
+    bool _hasColor;
+    COLORREF _foreground;
+    COLORREF _background;
+};
+
+// Routine Description:
+// - Starts the document with space for the CF_HTML header, which can only be
+//   filled in once the length of everything after it is known.
+// Arguments:
+// - outerBackground - the background of the whole selection
+// - fontHeightPoints - the unscaled font height in points
+// - fontFaceName - the name of the font face, if any
+HtmlBuilder::HtmlBuilder(const COLORREF outerBackground, const int fontHeightPoints, const std::wstring_view fontFaceName) :
+    _hasColor{ false },
+    _foreground{ RGB(0x00, 0x00, 0x00) },
+    _background{ RGB(0x00, 0x00, 0x00) }
+{
+    // reserve space for a header we fill in later
+    _html.append(_cbHeader, 'H');
+    _html.append(_htmlHeader);
+    _html.append(_htmlFragStart);
+
+    _html.append(R"X(<DIV STYLE="background-color:)X");
+    _AppendColor(outerBackground);
+    _html.append(R"X(;white-space:pre;">)X");
+
+    _html.append(R"X(<SPAN STYLE="font-family: )X");
+    if (!fontFaceName.empty())
+    {
+        _html.push_back('\'');
+        _AppendUtf8(fontFaceName, _html);
+        _html.append("', ");
+    }
+    _html.append(R"X(monospace">)X");
+
+    _html.append(R"X(<SPAN STYLE="font-size: )X");
+    _html.append(std::to_string(fontHeightPoints));
+    _html.append(R"X(pt">)X");
+}
+
+void HtmlBuilder::_AppendColor(const COLORREF color)
+{
+    char colorBuffer[8]; // "#RRGGBB" + null
+    sprintf_s(colorBuffer, "#%02x%02x%02x", GetRValue(color), GetGValue(color), GetBValue(color));
+    _html.append(colorBuffer);
+}
+
+// Routine Description:
+// - Appends one run of text, opening a new span if its colors differ from the last run's.
+void HtmlBuilder::AppendRun(const std::wstring_view text, const COLORREF foreground, const COLORREF background)
+{
+    if (!_hasColor || foreground != _foreground || background != _background)
+    {
+        if (_hasColor)
+        {
+            _html.append(_spanEnd);
+        }
+
+        _html.append(R"X(<SPAN STYLE="color:)X");
+        _AppendColor(foreground);
+        _html.append(";background-color:");
+        _AppendColor(background);
+        _html.append(R"X(">)X");
+
+        _foreground = foreground;
+        _background = background;
+        _hasColor = true;
+    }
+
+    _AppendHtmlEscaped(text, _html);
+}
+
+void HtmlBuilder::AppendLineBreak()
+{
+    _html.append("\r\n");
+}
+
+// Routine Description:
+// - Closes the document and fills in the CF_HTML header.
+// Return Value:
+// - the null terminated CF_HTML document
+std::string HtmlBuilder::Finish()
+{
+    if (_hasColor)
+    {
+        _html.append(_spanEnd);
+    }
+
+    // after we have copied all text we must wrap up
+    // with a standard set of HTML boilerplate required
+    // by CF_HTML
+
+    // end font size span, font face span and background div
+    _html.append(_spanEnd);
+    _html.append(_spanEnd);
+    _html.append(_divEnd);
+
+    _html.append(_htmlFragEnd);
+    _html.append(_htmlFooter);
+
+    // null terminate the clipboard data
+    _html.push_back('\0');
+
+    // we are done generating formatting & building HTML for the selection
+    // prepare the header text with the byte counts now that we know them
+    const size_t cbHtmlStart = _cbHeader; // bytecount to start of HTML context
+    const size_t cbHtmlEnd = _html.size() - 1; // don't count the null at the end
+    const size_t cbFragStart = _cbHeader + _htmlHeader.size(); // bytecount to start of selection fragment
+    const size_t cbFragEnd = cbHtmlEnd - _htmlFooter.size();
+
+    // push the values into the required HTML 0.9 header format
+    char header[_cbHeader + 1]; // add room for a null
+    sprintf_s(header,
+              "Version:0.9\r\n"
+              "StartHTML:%010zu\r\n"
+              "EndHTML:%010zu\r\n"
+              "StartFragment:%010zu\r\n"
+              "EndFragment:%010zu\r\n"
+              "StartSelection:%010zu\r\n"
+              "EndSelection:%010zu\r\n",
+              cbHtmlStart,
+              cbHtmlEnd,
+              cbFragStart,
+              cbFragEnd,
+              cbFragStart,
+              cbFragEnd);
+
+    // overwrite the reserved space with the actual header & offsets we calculated
+    _html.replace(0, _cbHeader, header, _cbHeader);
+
+    return std::move(_html);
+}
+
+// Builds an RTF document out of the runs of a selection. The color table is
+// collected while the body is written, and the header is put in front of the
+// body once the body is done.
+class RtfBuilder final
+{
+public:
+    RtfBuilder(const int fontHeightPoints, const std::wstring_view fontFaceName);
+
+    void AppendRun(const std::wstring_view text, const COLORREF foreground, const COLORREF background);
+    void AppendLineBreak();
+    std::string Finish();
+
+private:
+    size_t _ColorIndex(const COLORREF color);
+
+    const int _fontHeightPoints;
+    const std::wstring_view _fontFaceName;
+
+    // the color table is typically tiny, a linear search beats any map here.
+    std::vector<COLORREF> _colorTable;
+
+    std::string _rtf;
+    bool _hasColor;
+    COLORREF _foreground;
+    COLORREF _background;
+};
+
+// Arguments:
+// - fontHeightPoints - the unscaled font height in points
+// - fontFaceName - the name of the font face, if any. Must outlive the builder.
+RtfBuilder::RtfBuilder(const int fontHeightPoints, const std::wstring_view fontFaceName) :
+    _fontHeightPoints{ fontHeightPoints },
+    _fontFaceName{ fontFaceName.empty() ? std::wstring_view{ L"Consolas" } : fontFaceName },
+    _hasColor{ false },
+    _foreground{ RGB(0x00, 0x00, 0x00) },
+    _background{ RGB(0x00, 0x00, 0x00) }
+{
+}
+
+size_t RtfBuilder::_ColorIndex(const COLORREF color)
+{
+    const auto found = std::find(_colorTable.cbegin(), _colorTable.cend(), color);
+    if (found != _colorTable.cend())
+    {
+        return (found - _colorTable.cbegin()) + 1;
+    }
+    _colorTable.push_back(color);
+    return _colorTable.size(); // RTF color indices are 1-based; 0 is "auto"
+}
+
+// Routine Description:
+// - Appends one run of text, switching colors first if they differ from the last run's.
+void RtfBuilder::AppendRun(const std::wstring_view text, const COLORREF foreground, const COLORREF background)
+{
+    if (!_hasColor || foreground != _foreground || background != _background)
+    {
+        _rtf.append("\\cf");
+        _rtf.append(std::to_string(_ColorIndex(foreground)));
+        _rtf.append("\\chshdng0\\chcbpat");
+        _rtf.append(std::to_string(_ColorIndex(background)));
+        _rtf.append("\\cb");
+        _rtf.append(std::to_string(_ColorIndex(background)));
+        _rtf.push_back(' ');
+
+        _foreground = foreground;
+        _background = background;
+        _hasColor = true;
+    }
+
+    _AppendRtfEscaped(text, _rtf);
+}
+
+void RtfBuilder::AppendLineBreak()
+{
+    _rtf.append("\\line ");
+}
+
+// Routine Description:
+// - Puts the header, with the color table that's now complete, in front of the body.
+// Return Value:
+// - the RTF document
+std::string RtfBuilder::Finish()
+{
+    // RTF header and font table. The face name is written as \u escapes so any
+    // characters outside of ASCII survive.
+    std::string header;
+    header.append("{\\rtf1\\ansi\\ansicpg65001\\deff0{\\fonttbl{\\f0\\fmodern ");
+    _AppendRtfEscaped(_fontFaceName, header);
+    header.append(";}}");
+
+    header.append("{\\colortbl ;");
+    for (const auto color : _colorTable)
+    {
+        header.append("\\red");
+        header.append(std::to_string(GetRValue(color)));
+        header.append("\\green");
+        header.append(std::to_string(GetGValue(color)));
+        header.append("\\blue");
+        header.append(std::to_string(GetBValue(color)));
+        header.push_back(';');
+    }
+    header.append("}");
+
+    // font size is measured in half-points
+    header.append("\\f0\\fs");
+    header.append(std::to_string(_fontHeightPoints * 2));
+    header.push_back(' ');
+
+    _rtf.reserve(header.size() + _rtf.size() + 1);
+    _rtf.insert(0, header);
+    _rtf.push_back('}');
+
+    return std::move(_rtf);
+}
+
+// Routine Description:
+// - Generates a CF_HTML compliant structure from the selected region of the buffer.
+// - One span is emitted per change in color, driven by the attribute runs of each row.
+// Arguments:
+// - lineSelection - true if entire line is being selected. False otherwise (box selection)
+// - trimTrailingWhitespace - setting flag removes trailing whitespace at the end of each row in selection
+// - selectionRects - the selection regions from which the data will be extracted from the buffer
+// - fontHeightPoints - the unscaled font height in points
+// - fontFaceName - the name of the font face, if any
+// - GetForegroundColor - function used to map TextAttribute to RGB COLORREF for foreground color
+// - GetBackgroundColor - function used to map TextAttribute to RGB COLORREF for background color
+// Return Value:
+// - string containing the generated HTML, or empty on failure
+std::string TextBuffer::GenHTML(const bool lineSelection,
+                                const bool trimTrailingWhitespace,
+                                const std::vector<SMALL_RECT>& selectionRects,
+                                const int fontHeightPoints,
+                                const std::wstring_view fontFaceName,
+                                std::function<COLORREF(TextAttribute&)> GetForegroundColor,
+                                std::function<COLORREF(TextAttribute&)> GetBackgroundColor) const
+{
+    try
+    {
+        HtmlBuilder html{ _GetSelectionBackground(*this, selectionRects, GetBackgroundColor), fontHeightPoints, fontFaceName };
+
+        _WalkSelection(
+            lineSelection,
+            trimTrailingWhitespace,
+            selectionRects,
+            [&](const std::wstring_view runText, const TextAttribute& attr) {
+                TextAttribute runAttr = attr;
+                html.AppendRun(runText, GetForegroundColor(runAttr), GetBackgroundColor(runAttr));
+            },
+            [&]() {
+                html.AppendLineBreak();
+            });
+
+        return html.Finish();
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return {}; // dont return a partial html fragment...
+    }
+}
+
+// Routine Description:
+// - Generates an RTF document from the selected region of the buffer.
+// Arguments:
+// - lineSelection - true if entire line is being selected. False otherwise (box selection)
+// - trimTrailingWhitespace - setting flag removes trailing whitespace at the end of each row in selection
+// - selectionRects - the selection regions from which the data will be extracted from the buffer
+// - fontHeightPoints - the unscaled font height in points
+// - fontFaceName - the name of the font face, if any
+// - GetForegroundColor - function used to map TextAttribute to RGB COLORREF for foreground color
+// - GetBackgroundColor - function used to map TextAttribute to RGB COLORREF for background color
+// Return Value:
+// - string containing the generated RTF, or empty on failure
+std::string TextBuffer::GenRTF(const bool lineSelection,
+                               const bool trimTrailingWhitespace,
+                               const std::vector<SMALL_RECT>& selectionRects,
+                               const int fontHeightPoints,
+                               const std::wstring_view fontFaceName,
+                               std::function<COLORREF(TextAttribute&)> GetForegroundColor,
+                               std::function<COLORREF(TextAttribute&)> GetBackgroundColor) const
+{
+    try
+    {
+        RtfBuilder rtf{ fontHeightPoints, fontFaceName };
+
+        _WalkSelection(
+            lineSelection,
+            trimTrailingWhitespace,
+            selectionRects,
+            [&](const std::wstring_view runText, const TextAttribute& attr) {
+                TextAttribute runAttr = attr;
+                rtf.AppendRun(runText, GetForegroundColor(runAttr), GetBackgroundColor(runAttr));
+            },
+            [&]() {
+                rtf.AppendLineBreak();
+            });
+
+        return rtf.Finish();
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return {};
+    }
+}
+
+// Routine Description:
+// - Generates everything a copy puts on the clipboard in one pass over the selection:
+//   the plain text and, if asked for, the HTML and RTF versions of it.
+// Arguments:
+// - lineSelection - true if entire line is being selected. False otherwise (box selection)
+// - trimTrailingWhitespace - setting flag removes trailing whitespace at the end of each row in selection
+// - selectionRects - the selection regions from which the data will be extracted from the buffer
+// - includeFormatting - true to also generate the HTML and RTF
+// - fontHeightPoints - the unscaled font height in points
+// - fontFaceName - the name of the font face, if any
+// - GetForegroundColor - function used to map TextAttribute to RGB COLORREF for foreground color
+// - GetBackgroundColor - function used to map TextAttribute to RGB COLORREF for background color
+// Return Value:
+// - the plain text, HTML and RTF. The HTML and RTF are empty if they weren't asked
+//   for or couldn't be generated; the plain text is still returned in that case.
+// Note:
+// - will throw if the plain text couldn't be retrieved
+TextBuffer::ClipboardData TextBuffer::GenClipboardData(const bool lineSelection,
+                                                       const bool trimTrailingWhitespace,
+                                                       const std::vector<SMALL_RECT>& selectionRects,
+                                                       const bool includeFormatting,
+                                                       const int fontHeightPoints,
+                                                       const std::wstring_view fontFaceName,
+                                                       std::function<COLORREF(TextAttribute&)> GetForegroundColor,
+                                                       std::function<COLORREF(TextAttribute&)> GetBackgroundColor) const
+{
+    if (includeFormatting)
+    {
+        try
+        {
+            ClipboardData data;
+            data.text.reserve(_EstimatePlainTextLength(selectionRects));
+
+            HtmlBuilder html{ _GetSelectionBackground(*this, selectionRects, GetBackgroundColor), fontHeightPoints, fontFaceName };
+            RtfBuilder rtf{ fontHeightPoints, fontFaceName };
+
+            _WalkSelection(
+                lineSelection,
+                trimTrailingWhitespace,
+                selectionRects,
+                [&](const std::wstring_view runText, const TextAttribute& attr) {
+                    data.text.append(runText);
+
+                    TextAttribute runAttr = attr;
+                    const COLORREF foreground = GetForegroundColor(runAttr);
+                    const COLORREF background = GetBackgroundColor(runAttr);
+                    html.AppendRun(runText, foreground, background);
+                    rtf.AppendRun(runText, foreground, background);
+                },
+                [&]() {
+                    data.text.push_back(UNICODE_CARRIAGERETURN);
+                    data.text.push_back(UNICODE_LINEFEED);
+                    html.AppendLineBreak();
+                    rtf.AppendLineBreak();
+                });
+
+            data.html = html.Finish();
+            data.rtf = rtf.Finish();
+            return data;
+        }
+        catch (...)
+        {
+            // Still copy the plain text, rather than nothing at all.
+            LOG_HR(wil::ResultFromCaughtException());
+        }
     }
 
-    return data;
+    return { GetPlainText(lineSelection, trimTrailingWhitespace, selectionRects), {}, {} };
 }
@@ -52,6 +52,7 @@ filling in the last row, and updating the screen.
 #include "cursor.h"
 #include "Row.hpp"
 #include "TextAttribute.hpp"
+#include "TextAttributeTable.hpp"
 #include "UnicodeStorage.hpp"
 #include "../types/inc/Viewport.hpp"
 
@@ -96,6 +97,9 @@ public:
                                  const bool setWrap = false,
                                  const std::optional<size_t> limitRight = std::nullopt);
 
+    size_t WriteCharInfos(const gsl::span<const CHAR_INFO> source,
+                          const COORD target);
+
     bool InsertCharacter(const wchar_t wch, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool InsertCharacter(const std::wstring_view chars, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool IncrementCursor();
@@ -128,23 +132,51 @@ public:
     const UnicodeStorage& GetUnicodeStorage() const;
     UnicodeStorage& GetUnicodeStorage();
 
+    const TextAttributeTable& GetAttributeTable() const noexcept;
+    TextAttributeTable& GetAttributeTable() noexcept;
+
     Microsoft::Console::Render::IRenderTarget& GetRenderTarget();
 
-    class TextAndColor
+    std::wstring GetPlainText(const bool lineSelection,
+                              const bool trimTrailingWhitespace,
+                              const std::vector<SMALL_RECT>& selectionRects) const;
+
+    std::string GenHTML(const bool lineSelection,
+                        const bool trimTrailingWhitespace,
+                        const std::vector<SMALL_RECT>& selectionRects,
+                        const int fontHeightPoints,
+                        const std::wstring_view fontFaceName,
+                        std::function<COLORREF(TextAttribute&)> GetForegroundColor,
+                        std::function<COLORREF(TextAttribute&)> GetBackgroundColor) const;
+
+    std::string GenRTF(const bool lineSelection,
+                       const bool trimTrailingWhitespace,
+                       const std::vector<SMALL_RECT>& selectionRects,
+                       const int fontHeightPoints,
+                       const std::wstring_view fontFaceName,
+                       std::function<COLORREF(TextAttribute&)> GetForegroundColor,
+                       std::function<COLORREF(TextAttribute&)> GetBackgroundColor) const;
+
+    struct ClipboardData
     {
-    public:
-        std::vector<std::wstring> text;
-        std::vector<std::vector<COLORREF>> FgAttr;
-        std::vector<std::vector<COLORREF>> BkAttr;
+        std::wstring text;
+        std::string html;
+        std::string rtf;
     };
 
-    const TextAndColor GetTextForClipboard(const bool lineSelection,
-                                           const bool trimTrailingWhitespace,
-                                           const std::vector<SMALL_RECT>& selectionRects,
-                                           std::function<COLORREF(TextAttribute&)> GetForegroundColor,
-                                           std::function<COLORREF(TextAttribute&)> GetBackgroundColor) const;
+    ClipboardData GenClipboardData(const bool lineSelection,
+                                   const bool trimTrailingWhitespace,
+                                   const std::vector<SMALL_RECT>& selectionRects,
+                                   const bool includeFormatting,
+                                   const int fontHeightPoints,
+                                   const std::wstring_view fontFaceName,
+                                   std::function<COLORREF(TextAttribute&)> GetForegroundColor,
+                                   std::function<COLORREF(TextAttribute&)> GetBackgroundColor) const;
 
 private:
+    // interned attributes referenced by the runs of every row. must be constructed before the rows.
+    TextAttributeTable _attributeTable;
+
     std::deque<ROW> _storage;
     Cursor _cursor;
 
@@ -157,6 +189,8 @@ private:
 
     void _RefreshRowIDs(std::optional<SHORT> newRowWidth);
 
+    void _SweepAttributeTable();
+
     Microsoft::Console::Render::IRenderTarget& _renderTarget;
 
     void _SetFirstRowIndex(const SHORT FirstRowIndex);
@@ -175,6 +209,13 @@ private:
     ROW& _GetFirstRow();
     ROW& _GetPrevRowNoWrap(const ROW& row);
 
+    template<typename TRunFn, typename TLineBreakFn>
+    void _WalkSelection(const bool lineSelection,
+                        const bool trimTrailingWhitespace,
+                        const std::vector<SMALL_RECT>& selectionRects,
+                        TRunFn runFn,
+                        TLineBreakFn lineBreakFn) const;
+
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
     friend class UiaTextRangeTests;
@@ -265,3 +265,14 @@ const OutputCellView* TextBufferCellIterator::operator->() const noexcept
 {
     return &_view;
 }
+
+// Routine Description:
+// - Retrieves the interned ID of the attribute at the current position.
+// - Within one buffer, two cells have the same attribute if and only if their IDs match,
+//   so this is a cheap way to find where a run of color ends.
+// Return Value:
+// - ID of the attribute within the buffer's attribute table
+TextAttributeTable::id_type TextBufferCellIterator::GetAttributeId() const
+{
+    return _attrIter.GetAttributeId();
+}
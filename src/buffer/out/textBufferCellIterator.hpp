@@ -49,6 +49,8 @@ public:
     const OutputCellView& operator*() const noexcept;
     const OutputCellView* operator->() const noexcept;
 
+    TextAttributeTable::id_type GetAttributeId() const;
+
 protected:
     void _SetPos(const COORD newPos);
     void _GenerateView();
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../TextAttributeTable.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class TextAttributeTableTests
+{
+    TEST_CLASS(TextAttributeTableTests);
+
+    TEST_METHOD(InternReturnsSameIdForEqualAttributes)
+    {
+        TextAttributeTable table;
+        const TextAttribute red{ FOREGROUND_RED };
+        const TextAttribute blue{ FOREGROUND_BLUE };
+
+        const auto redId = table.Intern(red);
+        const auto blueId = table.Intern(blue);
+        VERIFY_ARE_NOT_EQUAL(redId, blueId);
+        VERIFY_ARE_EQUAL(redId, table.Intern(TextAttribute{ FOREGROUND_RED }));
+        VERIFY_ARE_EQUAL(2u, table.Size());
+
+        VERIFY_IS_TRUE(table.Lookup(redId) == red);
+        VERIFY_IS_TRUE(table.Lookup(blueId) == blue);
+    }
+
+    TEST_METHOD(FindDoesNotIntern)
+    {
+        TextAttributeTable table;
+        const TextAttribute rgb{ RGB(1, 2, 3), RGB(4, 5, 6) };
+
+        VERIFY_IS_FALSE(table.Find(rgb).has_value());
+        VERIFY_ARE_EQUAL(0u, table.Size());
+
+        const auto id = table.Intern(rgb);
+        const auto found = table.Find(rgb);
+        VERIFY_IS_TRUE(found.has_value());
+        VERIFY_ARE_EQUAL(id, found.value());
+    }
+
+    TEST_METHOD(SweepFreesUnusedAndKeepsLiveIds)
+    {
+        TextAttributeTable table;
+        const TextAttribute first{ FOREGROUND_RED };
+        const TextAttribute second{ FOREGROUND_GREEN };
+        const TextAttribute third{ FOREGROUND_BLUE };
+
+        const auto firstId = table.Intern(first);
+        const auto secondId = table.Intern(second);
+        const auto thirdId = table.Intern(third);
+        const auto& secondRef = table.Lookup(secondId);
+
+        std::vector<bool> inUse(table.SlotCount(), true);
+        inUse.at(firstId) = false;
+
+        table.Sweep(inUse);
+        VERIFY_ARE_EQUAL(2u, table.Size());
+        VERIFY_IS_FALSE(table.Find(first).has_value());
+        VERIFY_IS_TRUE(table.Lookup(secondId) == second);
+        VERIFY_IS_TRUE(table.Lookup(thirdId) == third);
+        VERIFY_ARE_EQUAL(&secondRef, &table.Lookup(secondId));
+
+        // the freed ID is handed out again before the table grows
+        const TextAttribute fourth{ BACKGROUND_RED };
+        VERIFY_ARE_EQUAL(firstId, table.Intern(fourth));
+        VERIFY_ARE_EQUAL(3u, table.SlotCount());
+        VERIFY_IS_TRUE(table.Lookup(firstId) == fourth);
+    }
+
+    TEST_METHOD(ManyDistinctAttributesAreKeptExactly)
+    {
+        TextAttributeTable table;
+
+        // more distinct truecolor attributes than a 16-bit ID could tell apart
+        constexpr size_t count = 70000;
+        std::vector<TextAttributeTable::id_type> ids;
+        ids.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto red = gsl::narrow_cast<BYTE>(i & 0xff);
+            const auto green = gsl::narrow_cast<BYTE>((i >> 8) & 0xff);
+            const auto blue = gsl::narrow_cast<BYTE>(i >> 16);
+            ids.push_back(table.Intern(TextAttribute{ RGB(red, green, blue), RGB(0, 0, 0) }));
+        }
+        VERIFY_ARE_EQUAL(count, table.Size());
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto red = gsl::narrow_cast<BYTE>(i & 0xff);
+            const auto green = gsl::narrow_cast<BYTE>((i >> 8) & 0xff);
+            const auto blue = gsl::narrow_cast<BYTE>(i >> 16);
+            VERIFY_IS_TRUE(table.Lookup(ids.at(i)) == TextAttribute(RGB(red, green, blue), RGB(0, 0, 0)));
+        }
+    }
+
+    TEST_METHOD(SweepThresholdGrowsWithLiveAttributes)
+    {
+        TextAttributeTable table;
+
+        for (size_t i = 0; i + 1 < TextAttributeTable::MinSweepThreshold; ++i)
+        {
+            table.Intern(TextAttribute{ RGB(i & 0xff, i >> 8, 0), RGB(0, 0, 0) });
+        }
+        VERIFY_IS_FALSE(table.ShouldSweep());
+
+        table.Intern(TextAttribute{ RGB(0, 0, 1), RGB(0, 0, 0) });
+        VERIFY_IS_TRUE(table.ShouldSweep());
+
+        // everything is still in use, so the next sweep waits until the table doubles
+        table.Sweep(std::vector<bool>(table.SlotCount(), true));
+        VERIFY_ARE_EQUAL(TextAttributeTable::MinSweepThreshold, table.Size());
+        VERIFY_IS_FALSE(table.ShouldSweep());
+    }
+};
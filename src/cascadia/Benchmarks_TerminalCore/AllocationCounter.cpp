@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "AllocationCounter.hpp"
+
+using namespace Microsoft::Terminal::Core::Benchmarks;
+
+static std::atomic<size_t> s_allocationCount{ 0 };
+static std::atomic<size_t> s_allocationBytes{ 0 };
+
+AllocationCounts Microsoft::Terminal::Core::Benchmarks::GetAllocationCounts() noexcept
+{
+    return { s_allocationCount.load(std::memory_order_relaxed), s_allocationBytes.load(std::memory_order_relaxed) };
+}
+
+// The array and nothrow forms of new and delete call these, so replacing
+// these two covers all of them.
+void* __cdecl operator new(size_t size)
+{
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    s_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+
+    // malloc(0) may return null, but new has to return a unique pointer.
+    void* const p = malloc(size == 0 ? 1 : size);
+    if (!p)
+    {
+        throw std::bad_alloc{};
+    }
+    return p;
+}
+
+void __cdecl operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void __cdecl operator delete(void* p, size_t /*size*/) noexcept
+{
+    free(p);
+}
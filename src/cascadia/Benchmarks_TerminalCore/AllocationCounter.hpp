@@ -0,0 +1,24 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- AllocationCounter.hpp
+
+Abstract:
+- Counts every allocation made through operator new in this process, by
+  replacing the global operator new and delete.
+--*/
+
+#pragma once
+
+namespace Microsoft::Terminal::Core::Benchmarks
+{
+    struct AllocationCounts
+    {
+        size_t count;
+        size_t bytes;
+    };
+
+    AllocationCounts GetAllocationCounts() noexcept;
+}
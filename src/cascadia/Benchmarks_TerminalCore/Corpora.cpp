@@ -0,0 +1,386 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "Corpora.hpp"
+
+#include "../../types/inc/convert.hpp"
+
+using namespace Microsoft::Terminal::Core::Benchmarks;
+
+namespace
+{
+    constexpr std::wstring_view Csi{ L"\x1b[" };
+
+    // The engine's output is fully specified by the standard, unlike the
+    // distributions', so the corpora are the same with every STL.
+    class Random
+    {
+    public:
+        explicit Random(const uint32_t seed) :
+            _engine{ seed }
+        {
+        }
+
+        size_t Next(const size_t bound)
+        {
+            return _engine() % bound;
+        }
+
+        template<typename T, size_t N>
+        const T& Pick(const std::array<T, N>& values)
+        {
+            return values.at(Next(N));
+        }
+
+    private:
+        std::minstd_rand _engine;
+    };
+
+    constexpr std::array<std::wstring_view, 8> Words{ L"buffer", L"cursor", L"render", L"viewport", L"attribute", L"size_t", L"result", L"columns" };
+    constexpr std::array<std::wstring_view, 6> Keywords{ L"const", L"auto", L"return", L"if", L"for", L"static" };
+    constexpr std::array<std::wstring_view, 6> Directories{ L"src/buffer/out", L"src/host", L"src/renderer/base", L"src/terminal/parser", L"src/types", L"src/cascadia/TerminalCore" };
+
+    // Text that is wide, made of surrogate pairs, or made of several code
+    // points that make up one glyph.
+    constexpr std::array<std::wstring_view, 10> Clusters{ L"\U0001F600",
+                                                          L"\U0001F680",
+                                                          L"\U0001F44D\U0001F3FD",
+                                                          L"\U0001F468\u200D\U0001F469\u200D\U0001F467",
+                                                          L"\u4E2D\u6587",
+                                                          L"\u65E5\u672C\u8A9E",
+                                                          L"\uD55C\uAE00",
+                                                          L"e\u0301",
+                                                          L"\u2764\uFE0F",
+                                                          L"na\u00EFve" };
+
+    void AppendPadded(std::wstring& text, const size_t value, const size_t width)
+    {
+        const auto digits = std::to_wstring(value);
+        if (digits.size() < width)
+        {
+            text.append(width - digits.size(), L' ');
+        }
+        text.append(digits);
+    }
+
+    void AppendSgr(std::wstring& text, const std::wstring_view parameters)
+    {
+        text.append(Csi);
+        text.append(parameters);
+        text.push_back(L'm');
+    }
+
+    // row and column are 1-based, as they are in the sequence.
+    void AppendCursorPosition(std::wstring& text, const size_t row, const size_t column)
+    {
+        text.append(Csi);
+        text.append(std::to_wstring(row));
+        text.push_back(L';');
+        text.append(std::to_wstring(column));
+        text.push_back(L'H');
+    }
+
+    void AppendEraseCharacters(std::wstring& text, const size_t count)
+    {
+        if (count > 0)
+        {
+            text.append(Csi);
+            text.append(std::to_wstring(count));
+            text.push_back(L'X');
+        }
+    }
+
+    // Compiler output: lines of plain text that scroll the whole buffer,
+    // with the occasional colored warning.
+    std::wstring GenerateBuildLog(Random& random, const size_t targetLength)
+    {
+        std::wstring text;
+        size_t step = 0;
+        while (text.size() < targetLength)
+        {
+            const auto& directory = random.Pick(Directories);
+            const auto& word = random.Pick(Words);
+
+            text.push_back(L'[');
+            AppendPadded(text, step++ % 101, 3);
+            text.append(L"%] Building CXX object ");
+            text.append(directory);
+            text.push_back(L'/');
+            text.append(word);
+            text.append(std::to_wstring(random.Next(100)));
+            text.append(L".cpp.obj\r\n");
+
+            if (random.Next(16) == 0)
+            {
+                AppendSgr(text, L"1");
+                text.append(directory);
+                text.push_back(L'/');
+                text.append(word);
+                text.append(L".cpp(");
+                text.append(std::to_wstring(random.Next(2000)));
+                text.append(L"): ");
+                AppendSgr(text, L"35");
+                text.append(L"warning C4");
+                AppendPadded(text, random.Next(1000), 3);
+                AppendSgr(text, L"0");
+                text.append(L": conversion from 'size_t' to '");
+                text.append(random.Pick(Words));
+                text.append(L"', possible loss of data\r\n");
+            }
+        }
+        return text;
+    }
+
+    // A full-screen editor: every line of the viewport is repainted in place
+    // with syntax coloring, then the status line and the cursor.
+    std::wstring GenerateEditor(Random& random, const COORD viewportSize, const size_t targetLength)
+    {
+        const size_t width = viewportSize.X - 1;
+        const size_t height = viewportSize.Y;
+
+        std::wstring text;
+        size_t top = 1;
+        while (text.size() < targetLength)
+        {
+            top += random.Next(height);
+            for (size_t row = 1; row < height; ++row)
+            {
+                AppendCursorPosition(text, row, 1);
+
+                AppendSgr(text, L"33");
+                AppendPadded(text, top + row, 5);
+                text.push_back(L' ');
+                AppendSgr(text, L"0");
+                size_t column = 6;
+
+                const auto indent = std::min(random.Next(4) * 4, width - column);
+                text.append(indent, L' ');
+                column += indent;
+
+                while (random.Next(8) != 0)
+                {
+                    const auto kind = random.Next(3);
+                    const auto& token = kind == 0 ? random.Pick(Keywords) : random.Pick(Words);
+                    const auto length = token.size() + (kind == 2 ? 2 : 0) + 1;
+                    if (column + length > width)
+                    {
+                        break;
+                    }
+
+                    if (kind == 0)
+                    {
+                        AppendSgr(text, L"34");
+                        text.append(token);
+                        AppendSgr(text, L"39");
+                    }
+                    else if (kind == 1)
+                    {
+                        text.append(token);
+                    }
+                    else
+                    {
+                        AppendSgr(text, L"31");
+                        text.push_back(L'"');
+                        text.append(token);
+                        text.push_back(L'"');
+                        AppendSgr(text, L"39");
+                    }
+                    text.push_back(L' ');
+                    column += length;
+                }
+
+                AppendEraseCharacters(text, width - column);
+            }
+
+            AppendCursorPosition(text, height, 1);
+            AppendSgr(text, L"7");
+            std::wstring status{ L" NORMAL  Terminal.cpp  line " };
+            status.append(std::to_wstring(top));
+            status.resize(width, L' ');
+            text.append(status);
+            AppendSgr(text, L"27");
+
+            AppendCursorPosition(text, 1 + random.Next(height - 1), 7 + random.Next(width - 7));
+        }
+        return text;
+    }
+
+    // A process monitor: colored meters and a table that is repainted from
+    // the top of the viewport, with one highlighted row.
+    std::wstring GenerateMonitor(Random& random, const COORD viewportSize, const size_t targetLength)
+    {
+        const size_t width = viewportSize.X - 1;
+        const size_t height = viewportSize.Y;
+        const size_t meters = std::min<size_t>(8, height / 3);
+        const size_t barWidth = width > 20 ? width - 20 : 1;
+
+        std::wstring text;
+        while (text.size() < targetLength)
+        {
+            for (size_t meter = 0; meter < meters; ++meter)
+            {
+                AppendCursorPosition(text, meter + 1, 1);
+
+                const auto user = random.Next(barWidth / 2 + 1);
+                const auto system = random.Next(barWidth - user + 1);
+                AppendPadded(text, meter, 3);
+                text.append(L"  [");
+                AppendSgr(text, L"32");
+                text.append(user, L'|');
+                AppendSgr(text, L"31");
+                text.append(system, L'|');
+                AppendSgr(text, L"0");
+                text.append(barWidth - user - system, L' ');
+                AppendPadded(text, (user + system) * 100 / barWidth, 5);
+                text.append(L".0%]");
+                text.append(width - barWidth - 15, L' ');
+            }
+
+            std::wstring header{ L"  PID USER      PRI  NI  VIRT   RES  CPU% MEM%  Command" };
+            header.resize(width, L' ');
+            AppendCursorPosition(text, meters + 2, 1);
+            AppendSgr(text, L"30;42");
+            text.append(header);
+            AppendSgr(text, L"0");
+
+            const auto selected = meters + 3 + random.Next(height - meters - 2);
+            for (size_t row = meters + 3; row <= height; ++row)
+            {
+                std::wstring line;
+                AppendPadded(line, 1000 + random.Next(60000), 5);
+                line.append(L" user     ");
+                AppendPadded(line, 20, 4);
+                AppendPadded(line, 0, 4);
+                AppendPadded(line, random.Next(4096), 5);
+                line.append(L"M");
+                AppendPadded(line, random.Next(1024), 5);
+                line.append(L"M");
+                AppendPadded(line, random.Next(100), 5);
+                AppendPadded(line, random.Next(100), 5);
+                line.append(L"  ");
+                line.append(random.Pick(Directories));
+                line.push_back(L'/');
+                line.append(random.Pick(Words));
+                line.resize(width, L' ');
+
+                AppendCursorPosition(text, row, 1);
+                if (row == selected)
+                {
+                    AppendSgr(text, L"30;46");
+                    text.append(line);
+                    AppendSgr(text, L"0");
+                }
+                else
+                {
+                    text.append(line);
+                }
+            }
+        }
+        return text;
+    }
+
+    // Lines that mix ASCII with emoji, CJK and combining characters, left to
+    // wrap wherever they happen to reach the edge.
+    std::wstring GenerateEmoji(Random& random, const size_t targetLength)
+    {
+        std::wstring text;
+        while (text.size() < targetLength)
+        {
+            const auto tokens = 4 + random.Next(24);
+            for (size_t i = 0; i < tokens; ++i)
+            {
+                text.append(random.Next(2) == 0 ? random.Pick(Clusters) : random.Pick(Words));
+                text.push_back(L' ');
+            }
+            text.append(L"\r\n");
+        }
+        return text;
+    }
+
+    // Half-block art where every cell has its own truecolor foreground and
+    // background, repainted from the top of the viewport.
+    std::wstring GenerateTruecolor(const COORD viewportSize, const size_t targetLength)
+    {
+        const size_t width = viewportSize.X - 1;
+        const size_t height = viewportSize.Y;
+
+        std::wstring text;
+        size_t frame = 0;
+        while (text.size() < targetLength)
+        {
+            text.append(Csi);
+            text.push_back(L'H');
+            for (size_t row = 0; row < height; ++row)
+            {
+                for (size_t column = 0; column < width; ++column)
+                {
+                    const auto red = (column * 255 / width + frame * 8) % 256;
+                    const auto green = row * 255 / height;
+                    const auto blue = (red + green + frame) % 256;
+
+                    std::wstring parameters{ L"38;2;" };
+                    parameters.append(std::to_wstring(red));
+                    parameters.push_back(L';');
+                    parameters.append(std::to_wstring(green));
+                    parameters.push_back(L';');
+                    parameters.append(std::to_wstring(blue));
+                    parameters.append(L";48;2;");
+                    parameters.append(std::to_wstring(255 - red));
+                    parameters.push_back(L';');
+                    parameters.append(std::to_wstring(green));
+                    parameters.push_back(L';');
+                    parameters.append(std::to_wstring(255 - blue));
+                    AppendSgr(text, parameters);
+                    text.push_back(L'\u2580'); // upper half block
+                }
+
+                AppendSgr(text, L"0");
+                if (row + 1 < height)
+                {
+                    text.append(L"\r\n");
+                }
+            }
+            ++frame;
+        }
+        return text;
+    }
+}
+
+// Function Description:
+// - Generates the built-in corpora.
+// Arguments:
+// - viewportSize: the size of the terminal the corpora will be written to.
+//   The full-screen ones are laid out to fit it exactly.
+// - targetLength: roughly how many characters each corpus should have.
+// Return Value:
+// - the corpora
+std::vector<Corpus> Microsoft::Terminal::Core::Benchmarks::GenerateCorpora(const COORD viewportSize, const size_t targetLength)
+{
+    THROW_HR_IF(E_INVALIDARG, viewportSize.X < 40 || viewportSize.Y < 10);
+
+    Random random{ 0x5eed };
+    std::vector<Corpus> corpora;
+    corpora.push_back({ L"build-log", GenerateBuildLog(random, targetLength) });
+    corpora.push_back({ L"editor", GenerateEditor(random, viewportSize, targetLength) });
+    corpora.push_back({ L"monitor", GenerateMonitor(random, viewportSize, targetLength) });
+    corpora.push_back({ L"emoji", GenerateEmoji(random, targetLength) });
+    corpora.push_back({ L"truecolor", GenerateTruecolor(viewportSize, targetLength) });
+    return corpora;
+}
+
+// Function Description:
+// - Loads recorded output from a file, such as a capture of a program's
+//   output to a pty. The file is read as UTF-8.
+// Arguments:
+// - path: the file to load
+// Return Value:
+// - the corpus, named after the file
+Corpus Microsoft::Terminal::Core::Benchmarks::LoadCorpus(const std::filesystem::path& path)
+{
+    std::ifstream stream{ path, std::ios::binary };
+    THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_OPEN_FAILED), !stream);
+
+    const std::string bytes{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+    return { path.filename().wstring(), ConvertToW(CP_UTF8, bytes) };
+}
@@ -0,0 +1,28 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- Corpora.hpp
+
+Abstract:
+- The text the benchmark writes to the terminal. Recorded output can be
+  loaded from UTF-8 files; otherwise there are generators that imitate a few
+  kinds of output with very different costs: a scrolling build log, a
+  full-screen editor, a process monitor, emoji and wide text, and truecolor
+  art. The generators are seeded, so each run writes exactly the same text.
+--*/
+
+#pragma once
+
+namespace Microsoft::Terminal::Core::Benchmarks
+{
+    struct Corpus
+    {
+        std::wstring name;
+        std::wstring text;
+    };
+
+    std::vector<Corpus> GenerateCorpora(const COORD viewportSize, const size_t targetLength);
+    Corpus LoadCorpus(const std::filesystem::path& path);
+}
@@ -0,0 +1,245 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "CountingRenderEngine.hpp"
+
+using namespace Microsoft::Console::Render;
+using namespace Microsoft::Terminal::Core::Benchmarks;
+
+static constexpr SMALL_RECT EmptyRect{ 0, 0, 0, 0 };
+
+CountingRenderEngine::CountingRenderEngine(const COORD viewportSize) noexcept :
+    _viewportSize{ viewportSize },
+    _dirty{ EmptyRect },
+    _paintDirty{ EmptyRect },
+    _counts{}
+{
+}
+
+const FrameCounts& CountingRenderEngine::GetCounts() const noexcept
+{
+    return _counts;
+}
+
+// Method Description:
+// - Adds a region to the area that the next frame has to paint, clipped to
+//   the viewport.
+// Arguments:
+// - region: the region, in exclusive viewport coordinates.
+void CountingRenderEngine::_InvalidateExclusive(const SMALL_RECT& region) noexcept
+{
+    SMALL_RECT clipped{ std::max<SHORT>(region.Left, 0),
+                        std::max<SHORT>(region.Top, 0),
+                        std::min(region.Right, _viewportSize.X),
+                        std::min(region.Bottom, _viewportSize.Y) };
+    if (clipped.Right <= clipped.Left || clipped.Bottom <= clipped.Top)
+    {
+        return;
+    }
+
+    if (_dirty.Right <= _dirty.Left)
+    {
+        _dirty = clipped;
+    }
+    else
+    {
+        _dirty.Left = std::min(_dirty.Left, clipped.Left);
+        _dirty.Top = std::min(_dirty.Top, clipped.Top);
+        _dirty.Right = std::max(_dirty.Right, clipped.Right);
+        _dirty.Bottom = std::max(_dirty.Bottom, clipped.Bottom);
+    }
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::Invalidate(const SMALL_RECT* const psrRegion) noexcept
+{
+    _InvalidateExclusive(*psrRegion);
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::InvalidateCursor(const COORD* const pcoordCursor) noexcept
+{
+    _InvalidateExclusive({ pcoordCursor->X,
+                           pcoordCursor->Y,
+                           gsl::narrow_cast<SHORT>(pcoordCursor->X + 1),
+                           gsl::narrow_cast<SHORT>(pcoordCursor->Y + 1) });
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::InvalidateSystem(const RECT* const /*prcDirtyClient*/) noexcept
+{
+    return InvalidateAll();
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept
+{
+    for (const auto& rect : rectangles)
+    {
+        _InvalidateExclusive({ rect.Left,
+                               rect.Top,
+                               gsl::narrow_cast<SHORT>(rect.Right + 1),
+                               gsl::narrow_cast<SHORT>(rect.Bottom + 1) });
+    }
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::InvalidateScroll(const COORD* const pcoordDelta) noexcept
+{
+    // Like the DX engine, a scroll repaints everything.
+    if (pcoordDelta->X != 0 || pcoordDelta->Y != 0)
+    {
+        return InvalidateAll();
+    }
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::InvalidateAll() noexcept
+{
+    _InvalidateExclusive({ 0, 0, _viewportSize.X, _viewportSize.Y });
+    return S_OK;
+}
+
+// Method Description:
+// - The buffer is about to circle. A real engine might paint here, but this is
+//   called while the terminal is locked for writing, so we never ask to.
+[[nodiscard]] HRESULT CountingRenderEngine::InvalidateCircling(_Out_ bool* const pForcePaint) noexcept
+{
+    *pForcePaint = false;
+    return InvalidateAll();
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept
+{
+    *pForcePaint = false;
+    return S_OK;
+}
+
+// Method Description:
+// - Starts a frame, if anything was invalidated since the last one.
+// Return Value:
+// - S_OK if there's something to paint, S_FALSE otherwise.
+[[nodiscard]] HRESULT CountingRenderEngine::StartPaint() noexcept
+{
+    if (_dirty.Right <= _dirty.Left && !_titleChanged)
+    {
+        return S_FALSE;
+    }
+
+    _paintDirty = std::exchange(_dirty, EmptyRect);
+    ++_counts.frames;
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::EndPaint() noexcept
+{
+    _paintDirty = EmptyRect;
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::Present() noexcept
+{
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::ScrollFrame() noexcept
+{
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::PaintBackground() noexcept
+{
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::PaintBufferLine(const std::basic_string_view<Cluster> clusters,
+                                                            const COORD /*coord*/,
+                                                            const bool /*trimLeft*/) noexcept
+{
+    ++_counts.lines;
+    for (const auto& cluster : clusters)
+    {
+        _counts.cells += cluster.GetColumns();
+    }
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::PaintBufferGridLines(GridLines const /*lines*/,
+                                                                 COLORREF const /*color*/,
+                                                                 size_t const /*cchLine*/,
+                                                                 COORD const /*coordTarget*/) noexcept
+{
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::PaintSelection(const SMALL_RECT /*rect*/) noexcept
+{
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::PaintCursor(const CursorOptions& /*options*/) noexcept
+{
+    ++_counts.cursors;
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::UpdateDrawingBrushes(COLORREF const /*colorForeground*/,
+                                                                 COLORREF const /*colorBackground*/,
+                                                                 const WORD /*legacyColorAttribute*/,
+                                                                 const bool /*isBold*/,
+                                                                 bool const /*isSettingDefaultBrushes*/) noexcept
+{
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::UpdateFont(const FontInfoDesired& /*fiFontInfoDesired*/, FontInfo& /*fiFontInfo*/) noexcept
+{
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::UpdateDpi(int const /*iDpi*/) noexcept
+{
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::UpdateViewport(const SMALL_RECT srNewViewport) noexcept
+{
+    const COORD size{ gsl::narrow_cast<SHORT>(srNewViewport.Right - srNewViewport.Left + 1),
+                      gsl::narrow_cast<SHORT>(srNewViewport.Bottom - srNewViewport.Top + 1) };
+    if (size.X != _viewportSize.X || size.Y != _viewportSize.Y)
+    {
+        _viewportSize = size;
+        return InvalidateAll();
+    }
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::GetProposedFont(const FontInfoDesired& /*fiFontInfoDesired*/, FontInfo& /*fiFontInfo*/, int const /*iDpi*/) noexcept
+{
+    return S_OK;
+}
+
+SMALL_RECT CountingRenderEngine::GetDirtyRectInChars()
+{
+    // The renderer wants this inclusive.
+    return { _paintDirty.Left,
+             _paintDirty.Top,
+             gsl::narrow_cast<SHORT>(_paintDirty.Right - 1),
+             gsl::narrow_cast<SHORT>(_paintDirty.Bottom - 1) };
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::GetFontSize(_Out_ COORD* const pFontSize) noexcept
+{
+    *pFontSize = { 1, 1 };
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::IsGlyphWideByFont(const std::wstring_view /*glyph*/, _Out_ bool* const pResult) noexcept
+{
+    *pResult = false;
+    return S_OK;
+}
+
+[[nodiscard]] HRESULT CountingRenderEngine::_DoUpdateTitle(_In_ const std::wstring& /*newTitle*/) noexcept
+{
+    return S_OK;
+}
@@ -0,0 +1,113 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- CountingRenderEngine.hpp
+
+Abstract:
+- A render engine that draws nothing, and only counts what the renderer asks
+  it to draw. It tracks invalidation the way a real engine does, so that the
+  renderer walks the same rows and clusters it would for a window.
+- Also contains ManualRenderThread, which stands in for the render thread so
+  that frames are only painted when the benchmark asks for them.
+--*/
+
+#pragma once
+
+#include "../../renderer/inc/RenderEngineBase.hpp"
+#include "../../renderer/inc/IRenderThread.hpp"
+
+namespace Microsoft::Terminal::Core::Benchmarks
+{
+    struct FrameCounts
+    {
+        size_t frames;
+        size_t lines;
+        size_t cells;
+        size_t cursors;
+    };
+
+    class CountingRenderEngine final : public Microsoft::Console::Render::RenderEngineBase
+    {
+    public:
+        CountingRenderEngine(const COORD viewportSize) noexcept;
+        ~CountingRenderEngine() override = default;
+
+        const FrameCounts& GetCounts() const noexcept;
+
+        // IRenderEngine Members
+        [[nodiscard]] HRESULT Invalidate(const SMALL_RECT* const psrRegion) noexcept override;
+        [[nodiscard]] HRESULT InvalidateCursor(const COORD* const pcoordCursor) noexcept override;
+        [[nodiscard]] HRESULT InvalidateSystem(const RECT* const prcDirtyClient) noexcept override;
+        [[nodiscard]] HRESULT InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept override;
+        [[nodiscard]] HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept override;
+        [[nodiscard]] HRESULT InvalidateAll() noexcept override;
+        [[nodiscard]] HRESULT InvalidateCircling(_Out_ bool* const pForcePaint) noexcept override;
+        [[nodiscard]] HRESULT PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept override;
+
+        [[nodiscard]] HRESULT StartPaint() noexcept override;
+        [[nodiscard]] HRESULT EndPaint() noexcept override;
+        [[nodiscard]] HRESULT Present() noexcept override;
+
+        [[nodiscard]] HRESULT ScrollFrame() noexcept override;
+
+        [[nodiscard]] HRESULT PaintBackground() noexcept override;
+        [[nodiscard]] HRESULT PaintBufferLine(const std::basic_string_view<Microsoft::Console::Render::Cluster> clusters,
+                                              const COORD coord,
+                                              const bool trimLeft) noexcept override;
+        [[nodiscard]] HRESULT PaintBufferGridLines(GridLines const lines, COLORREF const color, size_t const cchLine, COORD const coordTarget) noexcept override;
+        [[nodiscard]] HRESULT PaintSelection(const SMALL_RECT rect) noexcept override;
+
+        [[nodiscard]] HRESULT PaintCursor(const CursorOptions& options) noexcept override;
+
+        [[nodiscard]] HRESULT UpdateDrawingBrushes(COLORREF const colorForeground,
+                                                   COLORREF const colorBackground,
+                                                   const WORD legacyColorAttribute,
+                                                   const bool isBold,
+                                                   bool const isSettingDefaultBrushes) noexcept override;
+        [[nodiscard]] HRESULT UpdateFont(const FontInfoDesired& fiFontInfoDesired, FontInfo& fiFontInfo) noexcept override;
+        [[nodiscard]] HRESULT UpdateDpi(int const iDpi) noexcept override;
+        [[nodiscard]] HRESULT UpdateViewport(const SMALL_RECT srNewViewport) noexcept override;
+
+        [[nodiscard]] HRESULT GetProposedFont(const FontInfoDesired& fiFontInfoDesired, FontInfo& fiFontInfo, int const iDpi) noexcept override;
+
+        SMALL_RECT GetDirtyRectInChars() override;
+        [[nodiscard]] HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept override;
+        [[nodiscard]] HRESULT IsGlyphWideByFont(const std::wstring_view glyph, _Out_ bool* const pResult) noexcept override;
+
+    protected:
+        [[nodiscard]] HRESULT _DoUpdateTitle(_In_ const std::wstring& newTitle) noexcept override;
+
+    private:
+        void _InvalidateExclusive(const SMALL_RECT& region) noexcept;
+
+        COORD _viewportSize;
+
+        // The union of everything invalidated since the last frame, in
+        // exclusive viewport coordinates. Empty when Right <= Left.
+        SMALL_RECT _dirty;
+        SMALL_RECT _paintDirty;
+
+        FrameCounts _counts;
+    };
+
+    // The renderer asks its thread for a frame whenever something is
+    // invalidated. This one only remembers that it was asked, and the
+    // benchmark decides when to paint.
+    class ManualRenderThread final : public Microsoft::Console::Render::IRenderThread
+    {
+    public:
+        void NotifyPaint() override { _paintRequested = true; }
+        void EnablePainting() override {}
+        void WaitForPaintCompletionAndDisable(const DWORD /*dwTimeoutMs*/) override {}
+
+        bool ConsumePaintRequest() noexcept
+        {
+            return std::exchange(_paintRequested, false);
+        }
+
+    private:
+        bool _paintRequested = false;
+    };
+}
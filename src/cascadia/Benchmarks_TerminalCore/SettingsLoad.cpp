@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "SettingsLoad.hpp"
+
+#include "../inc/SettingsHash.h"
+
+using namespace Microsoft::Terminal;
+using namespace Microsoft::Terminal::Core::Benchmarks;
+
+namespace
+{
+    std::string MakeColor(std::mt19937& rng)
+    {
+        char color[8];
+        sprintf_s(color, "#%06X", static_cast<unsigned int>(rng() & 0xFFFFFF));
+        return color;
+    }
+
+    std::string MakeGuid(std::mt19937& rng)
+    {
+        char guid[39];
+        sprintf_s(guid,
+                  "{%08X-%04X-%04X-%04X-%04X%08X}",
+                  static_cast<unsigned int>(rng()),
+                  static_cast<unsigned int>(rng() & 0xFFFF),
+                  static_cast<unsigned int>(rng() & 0xFFFF),
+                  static_cast<unsigned int>(rng() & 0xFFFF),
+                  static_cast<unsigned int>(rng() & 0xFFFF),
+                  static_cast<unsigned int>(rng()));
+        return guid;
+    }
+
+    // A profile with the keys Profile::ToJson writes. Every other one has its
+    // own color table instead of a scheme, and a background image.
+    Json::Value MakeProfile(std::mt19937& rng, const size_t index)
+    {
+        Json::Value profile;
+        profile["guid"] = MakeGuid(rng);
+        profile["name"] = "Profile " + std::to_string(index);
+        if (index % 2 == 0)
+        {
+            profile["colorScheme"] = "Campbell";
+        }
+        else
+        {
+            Json::Value colorTable{ Json::arrayValue };
+            for (int i = 0; i < 16; ++i)
+            {
+                colorTable.append(MakeColor(rng));
+            }
+            profile["colorTable"] = colorTable;
+            profile["backgroundImage"] = "C:\\Users\\Public\\Pictures\\background" + std::to_string(index) + ".png";
+        }
+        profile["historySize"] = 9001;
+        profile["snapOnInput"] = true;
+        profile["cursorColor"] = MakeColor(rng);
+        profile["cursorShape"] = "bar";
+        profile["commandline"] = "powershell.exe -NoLogo -Command \"Set-Location C:\\src\\project" + std::to_string(index) + "\"";
+        profile["fontFace"] = "Consolas";
+        profile["fontSize"] = 10 + static_cast<int>(index % 6);
+        profile["acrylicOpacity"] = 0.5;
+        profile["useAcrylic"] = index % 3 == 0;
+        profile["closeOnExit"] = true;
+        profile["padding"] = "8, 8, 8, 8";
+        profile["icon"] = "ms-appx:///ProfileIcons/{61c54bbd-c2c6-5271-96e7-009a87ff44bf}.png";
+        profile["startingDirectory"] = "%USERPROFILE%";
+        return profile;
+    }
+
+    // Reads every value as its type and builds a new tree from them, the way
+    // loading a profile and serializing it again would.
+    Json::Value Reserialize(const Json::Value& value)
+    {
+        switch (value.type())
+        {
+        case Json::objectValue:
+        {
+            Json::Value object{ Json::objectValue };
+            for (const auto& name : value.getMemberNames())
+            {
+                object[name] = Reserialize(value[name]);
+            }
+            return object;
+        }
+        case Json::arrayValue:
+        {
+            Json::Value array{ Json::arrayValue };
+            for (const auto& element : value)
+            {
+                array.append(Reserialize(element));
+            }
+            return array;
+        }
+        case Json::stringValue:
+            return value.asString();
+        case Json::intValue:
+            return value.asInt();
+        case Json::uintValue:
+            return value.asUInt();
+        case Json::realValue:
+            return value.asDouble();
+        case Json::booleanValue:
+            return value.asBool();
+        default:
+            return value;
+        }
+    }
+}
+
+namespace Microsoft::Terminal::Core::Benchmarks
+{
+    // Function Description:
+    // - Generates a profiles.json with the given number of profiles, written
+    //   the same way CascadiaSettings::SaveAll writes it. It's seeded, so it's
+    //   the same file every time.
+    // Arguments:
+    // - profileCount: how many profiles to put in the file.
+    // Return Value:
+    // - the contents of the file.
+    std::string GenerateSettings(const size_t profileCount)
+    {
+        std::mt19937 rng{ 0x5E77 };
+
+        Json::Value profiles{ Json::arrayValue };
+        for (size_t i = 0; i < profileCount; ++i)
+        {
+            profiles.append(MakeProfile(rng, i));
+        }
+
+        Json::Value globals;
+        globals["defaultProfile"] = profiles[0]["guid"];
+        globals["alwaysShowTabs"] = true;
+        globals["initialRows"] = 30;
+        globals["initialCols"] = 120;
+        globals["requestedTheme"] = "system";
+        globals["showTabsInTitlebar"] = true;
+
+        Json::Value scheme;
+        scheme["name"] = "Campbell";
+        scheme["foreground"] = "#F2F2F2";
+        scheme["background"] = "#0C0C0C";
+        Json::Value schemes{ Json::arrayValue };
+        schemes.append(scheme);
+
+        Json::Value root;
+        root["globals"] = globals;
+        root["profiles"] = profiles;
+        root["schemes"] = schemes;
+
+        Json::StreamWriterBuilder wbuilder;
+        wbuilder.settings_["indentation"] = "    ";
+        return Json::writeString(wbuilder, root);
+    }
+
+    // Function Description:
+    // - Loads the settings the given number of times, after one warm-up run,
+    //   and times each phase.
+    // Arguments:
+    // - settings: the contents of the settings file.
+    // - iterations: how many runs to average over.
+    // Return Value:
+    // - the average time of each phase.
+    SettingsLoadTimes TimeSettingsLoad(const std::string& settings, const size_t iterations)
+    {
+        const std::unique_ptr<Json::CharReader> reader{ Json::CharReaderBuilder{}.newCharReader() };
+        const auto expectedHash = SettingsHash::HashContent(settings);
+
+        SettingsLoadTimes times{ settings.size() };
+        for (size_t i = 0; i <= iterations; ++i)
+        {
+            // The first run warms up the caches and the heap, and isn't counted.
+            const auto counted = i > 0;
+
+            auto start = std::chrono::steady_clock::now();
+            Json::Value root;
+            std::string errs;
+            THROW_HR_IF(E_INVALIDARG, !reader->parse(settings.data(), settings.data() + settings.size(), &root, &errs));
+            if (counted)
+            {
+                times.parse += std::chrono::steady_clock::now() - start;
+            }
+
+            start = std::chrono::steady_clock::now();
+            const auto reserialized = Reserialize(root);
+            THROW_HR_IF(E_UNEXPECTED, reserialized != root);
+            if (counted)
+            {
+                times.reserialize += std::chrono::steady_clock::now() - start;
+            }
+
+            start = std::chrono::steady_clock::now();
+            THROW_HR_IF(E_UNEXPECTED, SettingsHash::HashContent(settings) != expectedHash);
+            if (counted)
+            {
+                times.hash += std::chrono::steady_clock::now() - start;
+            }
+        }
+
+        times.parse /= iterations;
+        times.reserialize /= iterations;
+        times.hash /= iterations;
+        return times;
+    }
+}
@@ -0,0 +1,34 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- SettingsLoad.hpp
+
+Abstract:
+- Times what loading profiles.json costs at startup: parsing it, and then
+  either checking it against our schema (serializing the settings again and
+  comparing that to what was parsed) or only hashing it and comparing that to
+  the hash saved next to the file.
+- CascadiaSettings lives in the TerminalApp dll, so it can't be linked in
+  here. The schema check is imitated by reading every value out of the parsed
+  json as its type and building a new json tree from that, which touches the
+  same values that Profile::FromJson and Profile::ToJson do.
+--*/
+
+#pragma once
+
+namespace Microsoft::Terminal::Core::Benchmarks
+{
+    // Average times of each phase, over every run.
+    struct SettingsLoadTimes
+    {
+        size_t bytes;
+        std::chrono::nanoseconds parse;
+        std::chrono::nanoseconds reserialize;
+        std::chrono::nanoseconds hash;
+    };
+
+    std::string GenerateSettings(const size_t profileCount);
+    SettingsLoadTimes TimeSettingsLoad(const std::string& settings, const size_t iterations);
+}
@@ -0,0 +1,459 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "AllocationCounter.hpp"
+#include "Corpora.hpp"
+#include "CountingRenderEngine.hpp"
+#include "SettingsLoad.hpp"
+
+#include "../TerminalCore/Terminal.hpp"
+#include "../../renderer/base/renderer.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+#include "../../types/inc/convert.hpp"
+
+using namespace Microsoft::Console::Render;
+using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Terminal::Core::Benchmarks;
+
+namespace
+{
+    struct Options
+    {
+        COORD viewportSize{ 120, 30 };
+        SHORT scrollback = 9001;
+        size_t chunkLength = 4096;
+        size_t writesPerFrame = 1;
+        size_t iterations = 5;
+        size_t corpusLength = 4 * 1024 * 1024;
+        size_t profileCount = 200;
+        bool settings = false;
+        bool csv = false;
+        std::vector<std::filesystem::path> files;
+    };
+
+    // What the buffer holds once everything was written. Truecolor output
+    // splits rows into many short attribute runs, and this shows what that
+    // costs in memory.
+    struct BufferCounts
+    {
+        size_t rows;
+        size_t runs;
+        size_t runBytes;
+        size_t attributes;
+    };
+
+    struct Result
+    {
+        std::chrono::nanoseconds writeTime{ 0 };
+        std::vector<int64_t> writeLatencies; // in nanoseconds
+        std::vector<int64_t> frameLatencies; // in nanoseconds
+        AllocationCounts writeAllocations{};
+        AllocationCounts frameAllocations{};
+        FrameCounts frames{};
+        BufferCounts buffer{};
+    };
+
+    void PrintUsage()
+    {
+        wprintf(L"Usage: Terminal.Core.Benchmarks [options] [file...]\n"
+                L"\n"
+                L"Writes each file (UTF-8, as recorded from a pty) to a headless Terminal and\n"
+                L"reports how long the writes took and how many attribute runs the buffer ends\n"
+                L"up with. Without files, generated corpora are used.\n"
+                L"\n"
+                L"  -c <columns>     viewport width (default 120)\n"
+                L"  -r <rows>        viewport height (default 30)\n"
+                L"  -s <lines>       scrollback (default 9001)\n"
+                L"  -k <chars>       characters per write (default 4096)\n"
+                L"  -f <writes>      paint a frame after this many writes (default 1);\n"
+                L"                   0 writes to a null render target and paints nothing\n"
+                L"  -n <count>       measured runs per corpus, after one warm-up (default 5)\n"
+                L"  -l <chars>       length of each generated corpus (default 4194304)\n"
+                L"  --settings       time loading a generated profiles.json instead\n"
+                L"  -p <profiles>    profiles in the generated profiles.json (default 200)\n"
+                L"  --csv            print comma-separated values\n");
+    }
+
+    std::optional<Options> ParseOptions(const int argc, const WCHAR* const argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::wstring_view arg{ argv[i] };
+            if (arg == L"--csv")
+            {
+                options.csv = true;
+                continue;
+            }
+            if (arg == L"--settings")
+            {
+                options.settings = true;
+                continue;
+            }
+            if (arg == L"-h" || arg == L"-?" || arg == L"--help")
+            {
+                return std::nullopt;
+            }
+            if (arg.size() != 2 || arg[0] != L'-')
+            {
+                options.files.emplace_back(arg);
+                continue;
+            }
+            if (i + 1 >= argc)
+            {
+                return std::nullopt;
+            }
+
+            const auto value = std::stoul(argv[++i]);
+            switch (arg[1])
+            {
+            case L'c':
+                options.viewportSize.X = gsl::narrow<SHORT>(value);
+                break;
+            case L'r':
+                options.viewportSize.Y = gsl::narrow<SHORT>(value);
+                break;
+            case L's':
+                options.scrollback = gsl::narrow<SHORT>(value);
+                break;
+            case L'k':
+                options.chunkLength = std::max<size_t>(value, 1);
+                break;
+            case L'f':
+                options.writesPerFrame = value;
+                break;
+            case L'n':
+                options.iterations = std::max<size_t>(value, 1);
+                break;
+            case L'l':
+                options.corpusLength = value;
+                break;
+            case L'p':
+                options.profileCount = value;
+                break;
+            default:
+                return std::nullopt;
+            }
+        }
+        return options;
+    }
+
+    BufferCounts CountBuffer(const TextBuffer& buffer)
+    {
+        BufferCounts counts{};
+        counts.rows = buffer.TotalRowCount();
+        for (size_t i = 0; i < counts.rows; ++i)
+        {
+            counts.runs += buffer.GetRowByOffset(i).GetAttrRow().GetNumberOfRuns();
+        }
+        counts.runBytes = counts.runs * sizeof(TextAttributeIdRun);
+        counts.attributes = buffer.GetAttributeTable().Size();
+        return counts;
+    }
+
+    AllocationCounts operator-(const AllocationCounts& after, const AllocationCounts& before) noexcept
+    {
+        return { after.count - before.count, after.bytes - before.bytes };
+    }
+
+    void operator+=(AllocationCounts& total, const AllocationCounts& delta) noexcept
+    {
+        total.count += delta.count;
+        total.bytes += delta.bytes;
+    }
+
+    // Method Description:
+    // - Writes the text to a new Terminal, a chunk at a time, the way the
+    //   connection would hand it over.
+    // Arguments:
+    // - options: the terminal's size, how to chunk the text and when to paint.
+    // - text: the text to write.
+    // - result: if not null, receives the timings and counts for this run.
+    void Run(const Options& options, const std::wstring_view text, Result* const result)
+    {
+        CountingRenderEngine engine{ options.viewportSize };
+        DummyRenderTarget nullTarget;
+        ManualRenderThread* thread = nullptr;
+        std::unique_ptr<Renderer> renderer;
+        Terminal terminal;
+
+        if (options.writesPerFrame > 0)
+        {
+            auto renderThread = std::make_unique<ManualRenderThread>();
+            thread = renderThread.get();
+            IRenderEngine* engines[]{ &engine };
+            renderer = std::make_unique<Renderer>(&terminal, engines, 1, std::move(renderThread));
+            terminal.Create(options.viewportSize, options.scrollback, *renderer);
+        }
+        else
+        {
+            terminal.Create(options.viewportSize, options.scrollback, nullTarget);
+        }
+
+        // Only paints if something was invalidated since the last frame,
+        // just as the render thread would.
+        const auto paint = [&]() {
+            if (!renderer || !thread->ConsumePaintRequest())
+            {
+                return;
+            }
+
+            const auto allocationsBefore = GetAllocationCounts();
+            const auto start = std::chrono::steady_clock::now();
+            LOG_IF_FAILED(renderer->PaintFrame());
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+
+            if (result)
+            {
+                result->frameLatencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+                result->frameAllocations += GetAllocationCounts() - allocationsBefore;
+            }
+        };
+
+        size_t writes = 0;
+        for (size_t offset = 0; offset < text.size();)
+        {
+            auto length = std::min(options.chunkLength, text.size() - offset);
+
+            // Don't split a surrogate pair across two writes.
+            if (offset + length < text.size() && IS_HIGH_SURROGATE(text.at(offset + length - 1)))
+            {
+                ++length;
+            }
+
+            const auto chunk = text.substr(offset, length);
+            offset += length;
+
+            const auto allocationsBefore = GetAllocationCounts();
+            const auto start = std::chrono::steady_clock::now();
+            terminal.Write(chunk);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+
+            if (result)
+            {
+                result->writeAllocations += GetAllocationCounts() - allocationsBefore;
+                result->writeTime += elapsed;
+                result->writeLatencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+
+            if (options.writesPerFrame > 0 && ++writes % options.writesPerFrame == 0)
+            {
+                paint();
+            }
+        }
+        paint();
+
+        if (result)
+        {
+            // Every run paints the same frames and ends with the same
+            // buffer, so these are per run.
+            result->frames = engine.GetCounts();
+            result->buffer = CountBuffer(terminal.GetTextBuffer());
+        }
+    }
+
+    // Returns the value at the given fraction of the way through the sorted
+    // values, in microseconds.
+    double Percentile(std::vector<int64_t> values, const double fraction)
+    {
+        if (values.empty())
+        {
+            return 0.0;
+        }
+
+        const auto index = static_cast<size_t>(fraction * (values.size() - 1) + 0.5);
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values.at(index) / 1000.0;
+    }
+
+    void PrintHeader(const Options& options)
+    {
+        if (options.csv)
+        {
+            wprintf(L"corpus,mib,mib_per_s,writes,write_p50_us,write_p99_us,allocations,allocated_kib,frames,frame_p50_us,frame_p99_us,frame_allocations,cells_painted,attribute_runs,runs_per_row,run_kib,attributes\n");
+            return;
+        }
+
+        wprintf(L"%dx%d viewport, %d lines of scrollback, %zu characters per write, ",
+                options.viewportSize.X,
+                options.viewportSize.Y,
+                options.scrollback,
+                options.chunkLength);
+        if (options.writesPerFrame > 0)
+        {
+            wprintf(L"a frame every %zu writes, ", options.writesPerFrame);
+        }
+        else
+        {
+            wprintf(L"no rendering, ");
+        }
+        wprintf(L"%zu runs\n\n", options.iterations);
+
+        wprintf(L"%-16s %8s %9s %8s %9s %9s %12s %8s %11s %11s %9s %8s %8s\n",
+                L"corpus",
+                L"MiB",
+                L"MiB/s",
+                L"writes",
+                L"p50 us",
+                L"p99 us",
+                L"allocs/MiB",
+                L"frames",
+                L"frame p50",
+                L"frame p99",
+                L"runs/row",
+                L"run KiB",
+                L"attrs");
+    }
+
+    void PrintResult(const Options& options, const Corpus& corpus, const size_t bytes, const Result& result)
+    {
+        // Allocations and latencies are collected over every run, and
+        // reported per run.
+        const auto runs = options.iterations;
+        const auto mebibytes = bytes / (1024.0 * 1024.0);
+        const auto seconds = std::chrono::duration<double>(result.writeTime).count();
+        const auto throughput = seconds > 0 ? mebibytes * runs / seconds : 0.0;
+        const auto writes = result.writeLatencies.size() / runs;
+        const auto allocations = result.writeAllocations.count / runs;
+        const auto runsPerRow = result.buffer.rows > 0 ? static_cast<double>(result.buffer.runs) / result.buffer.rows : 0.0;
+
+        if (options.csv)
+        {
+            wprintf(L"%s,%.3f,%.3f,%zu,%.3f,%.3f,%zu,%zu,%zu,%.3f,%.3f,%zu,%zu,%zu,%.3f,%zu,%zu\n",
+                    corpus.name.c_str(),
+                    mebibytes,
+                    throughput,
+                    writes,
+                    Percentile(result.writeLatencies, 0.5),
+                    Percentile(result.writeLatencies, 0.99),
+                    allocations,
+                    result.writeAllocations.bytes / runs / 1024,
+                    result.frames.frames,
+                    Percentile(result.frameLatencies, 0.5),
+                    Percentile(result.frameLatencies, 0.99),
+                    result.frameAllocations.count / runs,
+                    result.frames.cells,
+                    result.buffer.runs,
+                    runsPerRow,
+                    result.buffer.runBytes / 1024,
+                    result.buffer.attributes);
+            return;
+        }
+
+        wprintf(L"%-16s %8.2f %9.2f %8zu %9.1f %9.1f %12.0f %8zu %11.1f %11.1f %9.2f %8zu %8zu\n",
+                corpus.name.c_str(),
+                mebibytes,
+                throughput,
+                writes,
+                Percentile(result.writeLatencies, 0.5),
+                Percentile(result.writeLatencies, 0.99),
+                mebibytes > 0 ? allocations / mebibytes : 0.0,
+                result.frames.frames,
+                Percentile(result.frameLatencies, 0.5),
+                Percentile(result.frameLatencies, 0.99),
+                runsPerRow,
+                result.buffer.runBytes / 1024,
+                result.buffer.attributes);
+    }
+
+    // Method Description:
+    // - Times loading a generated profiles.json on a cold start: with the
+    //   schema check that runs when there's no saved hash (or it doesn't
+    //   match), and with only the hash check that replaces it otherwise.
+    // Arguments:
+    // - options: how many profiles to generate, how many runs to average over.
+    void RunSettingsLoad(const Options& options)
+    {
+        const auto settings = GenerateSettings(options.profileCount);
+        const auto times = TimeSettingsLoad(settings, options.iterations);
+
+        const auto us = [](const std::chrono::nanoseconds time) {
+            return std::chrono::duration<double, std::micro>(time).count();
+        };
+        const auto parse = us(times.parse);
+        const auto reserialize = us(times.reserialize);
+        const auto hash = us(times.hash);
+
+        if (options.csv)
+        {
+            wprintf(L"profiles,kib,parse_us,reserialize_us,hash_us,unhashed_load_us,hashed_load_us\n");
+            wprintf(L"%zu,%zu,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+                    options.profileCount,
+                    times.bytes / 1024,
+                    parse,
+                    reserialize,
+                    hash,
+                    parse + reserialize,
+                    parse + hash);
+            return;
+        }
+
+        wprintf(L"%zu profiles, %zu KiB, %zu runs\n\n", options.profileCount, times.bytes / 1024, options.iterations);
+        wprintf(L"%-28s %12s\n", L"phase", L"us");
+        wprintf(L"%-28s %12.1f\n", L"parse", parse);
+        wprintf(L"%-28s %12.1f\n", L"reserialize and compare", reserialize);
+        wprintf(L"%-28s %12.1f\n", L"hash", hash);
+        wprintf(L"%-28s %12.1f\n", L"load without a saved hash", parse + reserialize);
+        wprintf(L"%-28s %12.1f\n", L"load with a saved hash", parse + hash);
+    }
+}
+
+int __cdecl wmain(int argc, WCHAR* argv[])
+{
+    try
+    {
+        const auto options = ParseOptions(argc, argv);
+        if (!options)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        if (options->settings)
+        {
+            RunSettingsLoad(*options);
+            return 0;
+        }
+
+        std::vector<Corpus> corpora;
+        if (options->files.empty())
+        {
+            corpora = GenerateCorpora(options->viewportSize, options->corpusLength);
+        }
+        else
+        {
+            for (const auto& file : options->files)
+            {
+                corpora.push_back(LoadCorpus(file));
+            }
+        }
+
+        PrintHeader(*options);
+
+        for (const auto& corpus : corpora)
+        {
+            // The first run warms up the caches and the heap, and isn't counted.
+            Run(*options, corpus.text, nullptr);
+
+            Result result;
+            const auto writesPerRun = corpus.text.size() / options->chunkLength + 1;
+            result.writeLatencies.reserve(writesPerRun * options->iterations);
+            result.frameLatencies.reserve(writesPerRun * options->iterations);
+            for (size_t i = 0; i < options->iterations; ++i)
+            {
+                Run(*options, corpus.text, &result);
+            }
+
+            PrintResult(*options, corpus, GetALengthFromW(CP_UTF8, corpus.text), result);
+        }
+
+        return 0;
+    }
+    catch (...)
+    {
+        fwprintf(stderr, L"The benchmark failed: 0x%08x\n", wil::ResultFromCaughtException());
+        return 1;
+    }
+}
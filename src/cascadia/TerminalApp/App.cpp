@@ -31,6 +31,9 @@ namespace winrt
     using IInspectable = Windows::Foundation::IInspectable;
 }
 
+// How long the settings file has to go without changing before we reload it.
+static constexpr DWORD SettingsReloadDelayMs = 200;
+
 namespace winrt::TerminalApp::implementation
 {
     App::App() :
@@ -43,14 +46,27 @@ namespace winrt::TerminalApp::implementation
         _settings{},
         _tabs{},
         _loadedInitialSettings{ false },
+        _dynamicProfiles{},
         _settingsLoadedResult{ S_OK },
-        _dialogLock{}
+        _dialogLock{},
+        _pendingReloads{ 0 }
     {
         // For your own sanity, it's better to do setup outside the ctor.
         // If you do any setup in the ctor that ends up throwing an exception,
         // then it might look like App just failed to activate, which will
         // cause you to chase down the rabbit hole of "why is App not
         // registered?" when it definitely is.
+
+        // The one exception: if this is the first launch, the default settings
+        // need the PowerShell Core and WSL profiles, and finding the WSL
+        // distributions can take a while. Start looking now, so that's done by
+        // the time the settings are loaded. If this fails, loading the
+        // settings will look for them itself.
+        try
+        {
+            _dynamicProfiles = CascadiaSettings::DetectDynamicProfiles();
+        }
+        CATCH_LOG();
     }
 
     // Method Description:
@@ -502,16 +518,26 @@ namespace winrt::TerminalApp::implementation
     // - saveOnLoad: If true, after loading the settings, we should re-write
     //   them to the file, to make sure the schema is updated. See
     //   `CascadiaSettings::LoadAll` for details.
+    // - previousSettings: if provided, receives the settings that were replaced,
+    //   so the caller can tell what changed.
     // Return Value:
     // - S_OK if we successfully parsed the settings, otherwise an appropriate HRESULT.
-    [[nodiscard]] HRESULT App::_TryLoadSettings(const bool saveOnLoad) noexcept
+    [[nodiscard]] HRESULT App::_TryLoadSettings(const bool saveOnLoad,
+                                                std::unique_ptr<CascadiaSettings>* const previousSettings) noexcept
     {
         HRESULT hr = E_FAIL;
 
         try
         {
-            auto newSettings = CascadiaSettings::LoadAll(saveOnLoad);
-            _settings = std::move(newSettings);
+            // Only the first load gets the profiles we started detecting at
+            // construction. Later ones look again, in case something was
+            // installed in the meantime.
+            auto newSettings = CascadiaSettings::LoadAll(saveOnLoad, std::exchange(_dynamicProfiles, {}));
+            _settings.swap(newSettings);
+            if (previousSettings)
+            {
+                *previousSettings = std::move(newSettings);
+            }
             hr = S_OK;
         }
         catch (const winrt::hresult_error& e)
@@ -562,7 +588,7 @@ namespace winrt::TerminalApp::implementation
 
     // Method Description:
     // - Registers for changes to the settings folder and upon a updated settings
-    //      profile calls _ReloadSettings().
+    //      profile calls _ReloadSettings(), once the changes settle down.
     // Arguments:
     // - <none>
     // Return Value:
@@ -573,6 +599,14 @@ namespace winrt::TerminalApp::implementation
         std::filesystem::path settingsPath{ CascadiaSettings::GetSettingsPath() };
         const auto folder = settingsPath.parent_path();
 
+        _reloadTimer.reset(CreateThreadpoolTimer(
+            [](PTP_CALLBACK_INSTANCE /*instance*/, PVOID context, PTP_TIMER /*timer*/) {
+                static_cast<App*>(context)->_RunReloads();
+            },
+            this,
+            nullptr));
+        THROW_LAST_ERROR_IF(!_reloadTimer);
+
         _reader.create(folder.c_str(),
                        false,
                        wil::FolderChangeEvents::All,
@@ -595,11 +629,68 @@ namespace winrt::TerminalApp::implementation
 
                            if (settingsBasename == modifiedBasename)
                            {
-                               this->_ReloadSettings();
+                               this->_ScheduleReloadSettings();
                            }
                        });
     }
 
+    // Method Description:
+    // - Reloads the settings a short while from now. Editors often save a file
+    //   in several writes (or write it and then rename it), and each of those
+    //   shows up as its own change. Every call pushes the reload back, so a
+    //   burst of changes results in a single reload once it's over.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void App::_ScheduleReloadSettings() noexcept
+    {
+        // A negative due time is relative to now, in 100ns units.
+        LARGE_INTEGER delay;
+        delay.QuadPart = -static_cast<LONGLONG>(SettingsReloadDelayMs) * 10000;
+        FILETIME dueTime{ delay.LowPart, static_cast<DWORD>(delay.HighPart) };
+        SetThreadpoolTimer(_reloadTimer.get(), &dueTime, 0, 0);
+    }
+
+    // Method Description:
+    // - Called by the reload timer. Threadpool callbacks can overlap, so a
+    //   change that comes in while a slow reload is still running would
+    //   otherwise start a second reload alongside it. Instead, only one
+    //   callback reloads at a time: the others just count their request, and
+    //   the one that's reloading goes around again until it has covered all of
+    //   them. Any number of requests made during a reload are covered by a
+    //   single reload after it.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void App::_RunReloads() noexcept
+    {
+        if (_pendingReloads.fetch_add(1) != 0)
+        {
+            // Another callback is reloading, and will reload again for us.
+            return;
+        }
+
+        for (;;)
+        {
+            // Every request counted so far was made before this reload reads
+            // the file, so this reload handles all of them.
+            const auto handled = _pendingReloads.load();
+
+            try
+            {
+                _ReloadSettings();
+            }
+            CATCH_LOG();
+
+            if (_pendingReloads.fetch_sub(handled) == handled)
+            {
+                return;
+            }
+        }
+    }
+
     // Method Description:
     // - Reloads the settings from the profile.json.
     void App::_ReloadSettings()
@@ -609,7 +700,8 @@ namespace winrt::TerminalApp::implementation
         //  - don't change the settings (and don't actually apply the new settings)
         //  - don't persist them.
         //  - display a loading error
-        _settingsLoadedResult = _TryLoadSettings(false);
+        std::unique_ptr<CascadiaSettings> previousSettings;
+        _settingsLoadedResult = _TryLoadSettings(false, &previousSettings);
 
         if (FAILED(_settingsLoadedResult))
         {
@@ -631,10 +723,24 @@ namespace winrt::TerminalApp::implementation
 
         // Refresh UI elements
 
-        auto profiles = _settings->GetProfiles();
-        for (auto& profile : profiles)
+        // Only the terminals of profiles that actually changed get new
+        // settings, so saving the file without changes doesn't make every
+        // pane re-apply its settings and repaint.
+        std::vector<GUID> changedProfiles;
+        if (previousSettings)
+        {
+            changedProfiles = _settings->FindChangedProfiles(*previousSettings);
+        }
+        else
+        {
+            for (const auto& profile : _settings->GetProfiles())
+            {
+                changedProfiles.push_back(profile.GetGuid());
+            }
+        }
+
+        for (const auto& profileGuid : changedProfiles)
         {
-            const GUID profileGuid = profile.GetGuid();
             TerminalSettings settings = _settings->MakeSettings(profileGuid);
 
             for (auto& tab : _tabs)
@@ -65,8 +65,20 @@ namespace winrt::TerminalApp::implementation
         HRESULT _settingsLoadedResult;
 
         bool _loadedInitialSettings;
+        // Started when we're constructed, and handed to the first load of the
+        // settings in case it has to create the defaults.
+        std::shared_future<::TerminalApp::CascadiaSettings::DynamicProfiles> _dynamicProfiles;
         std::shared_mutex _dialogLock;
 
+        // Reloads requested by the timer that haven't been handled yet. Only
+        // the callback that raises this from zero reloads; see _RunReloads.
+        // Declared before the timer, which waits for its callbacks when it's
+        // torn down.
+        std::atomic<uint32_t> _pendingReloads;
+
+        // Declared before _reader, so that the reader (which arms the
+        // timer) is torn down first.
+        wil::unique_threadpool_timer _reloadTimer;
         wil::unique_folder_change_reader_nothrow _reader;
 
         void _Create();
@@ -78,13 +90,16 @@ namespace winrt::TerminalApp::implementation
         void _ShowOkDialog(const winrt::hstring& titleKey, const winrt::hstring& contentKey);
         void _ShowAboutDialog();
 
-        [[nodiscard]] HRESULT _TryLoadSettings(const bool saveOnLoad) noexcept;
+        [[nodiscard]] HRESULT _TryLoadSettings(const bool saveOnLoad,
+                                               std::unique_ptr<::TerminalApp::CascadiaSettings>* const previousSettings = nullptr) noexcept;
         void _LoadSettings();
         void _OpenSettings();
 
         void _HookupKeyBindings(TerminalApp::AppKeyBindings bindings) noexcept;
 
         void _RegisterSettingsChange();
+        void _ScheduleReloadSettings() noexcept;
+        void _RunReloads() noexcept;
         void _ReloadSettings();
 
         void _SettingsButtonOnClick(const IInspectable& sender, const Windows::UI::Xaml::RoutedEventArgs& eventArgs);
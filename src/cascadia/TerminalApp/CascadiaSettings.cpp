@@ -24,6 +24,9 @@ static constexpr std::wstring_view PACKAGED_PROFILE_ICON_PATH{ L"ms-appx:///Prof
 static constexpr std::wstring_view PACKAGED_PROFILE_ICON_EXTENSION{ L".png" };
 static constexpr std::wstring_view DEFAULT_LINUX_ICON_GUID{ L"{9acb9455-ca41-5af7-950f-6bca1bc9722f}" };
 
+// How long we'll wait for `wsl.exe --list` before giving up on WSL profiles.
+static constexpr DWORD WSL_LIST_TIMEOUT_MS = 5000;
+
 CascadiaSettings::CascadiaSettings() :
     _globals{},
     _profiles{}
@@ -192,8 +195,19 @@ void CascadiaSettings::_CreateDefaultSchemes()
 //    * one for powershell.exe (inbox Windows Powershell)
 //    * if Powershell Core (pwsh.exe) is installed, we'll create another for
 //      Powershell Core.
-void CascadiaSettings::_CreateDefaultProfiles()
+//   followed by one for each installed WSL distribution.
+// Arguments:
+// - dynamicProfiles: the PowerShell Core and WSL profiles, if the caller
+//   already started looking for them. Otherwise we look for them now.
+void CascadiaSettings::_CreateDefaultProfiles(std::shared_future<DynamicProfiles> dynamicProfiles)
 {
+    if (!dynamicProfiles.valid())
+    {
+        // Start looking for PowerShell Core and WSL first, so that the
+        // detection runs while we build the built-in profiles.
+        dynamicProfiles = DetectDynamicProfiles();
+    }
+
     auto cmdProfile{ _CreateDefaultProfile(L"cmd") };
     cmdProfile.SetFontFace(L"Consolas");
     cmdProfile.SetCommandline(L"cmd.exe");
@@ -209,20 +223,15 @@ void CascadiaSettings::_CreateDefaultProfiles()
     powershellProfile.SetDefaultBackground(POWERSHELL_BLUE);
     powershellProfile.SetUseAcrylic(false);
 
+    const auto& detected = dynamicProfiles.get();
+
     // If the user has installed PowerShell Core, we add PowerShell Core as a default.
-    // PowerShell Core default folder is "%PROGRAMFILES%\PowerShell\[Version]\".
-    std::filesystem::path psCoreCmdline{};
-    if (_isPowerShellCoreInstalled(psCoreCmdline))
+    if (detected.powershellCore)
     {
-        auto pwshProfile{ _CreateDefaultProfile(L"PowerShell Core") };
-        pwshProfile.SetCommandline(psCoreCmdline);
-        pwshProfile.SetStartingDirectory(DEFAULT_STARTING_DIRECTORY);
-        pwshProfile.SetColorScheme({ L"Campbell" });
-
         // If powershell core is installed, we'll use that as the default.
         // Otherwise, we'll use normal Windows Powershell as the default.
-        _profiles.emplace_back(pwshProfile);
-        _globals.SetDefaultProfile(pwshProfile.GetGuid());
+        _profiles.emplace_back(detected.powershellCore.value());
+        _globals.SetDefaultProfile(detected.powershellCore->GetGuid());
     }
     else
     {
@@ -231,11 +240,57 @@ void CascadiaSettings::_CreateDefaultProfiles()
 
     _profiles.emplace_back(powershellProfile);
     _profiles.emplace_back(cmdProfile);
+    _profiles.insert(_profiles.end(), detected.wslDistributions.begin(), detected.wslDistributions.end());
+}
+
+// Function Description:
+// - Starts looking for what's installed on this machine on a background
+//   thread, and returns a future for the generated profiles. Every call scans
+//   again, so a distribution installed since the last call shows up.
+// - The app starts this as early as it can, so that creating the default
+//   settings on first launch doesn't have to wait on wsl.exe for long.
+// Arguments:
+// - <none>
+// Return Value:
+// - a future for the generated profiles. Unlike one from std::async, it
+//   doesn't block when it's dropped before the detection is done.
+std::shared_future<CascadiaSettings::DynamicProfiles> CascadiaSettings::DetectDynamicProfiles()
+{
+    std::packaged_task<DynamicProfiles()> detection{ &_GenerateDynamicProfiles };
+    auto dynamicProfiles{ detection.get_future().share() };
+    std::thread{ std::move(detection) }.detach();
+    return dynamicProfiles;
+}
+
+// Function Description:
+// - Looks for PowerShell Core and the installed WSL distributions, and
+//   creates a profile for each one found.
+// Arguments:
+// - <none>
+// Return Value:
+// - the generated profiles
+CascadiaSettings::DynamicProfiles CascadiaSettings::_GenerateDynamicProfiles()
+{
+    DynamicProfiles result;
+
+    // PowerShell Core default folder is "%PROGRAMFILES%\PowerShell\[Version]\".
+    std::filesystem::path psCoreCmdline{};
+    if (_isPowerShellCoreInstalled(psCoreCmdline))
+    {
+        auto pwshProfile{ _CreateDefaultProfile(L"PowerShell Core") };
+        pwshProfile.SetCommandline(psCoreCmdline);
+        pwshProfile.SetStartingDirectory(DEFAULT_STARTING_DIRECTORY);
+        pwshProfile.SetColorScheme({ L"Campbell" });
+        result.powershellCore = std::move(pwshProfile);
+    }
+
     try
     {
-        _AppendWslProfiles(_profiles);
+        _AppendWslProfiles(result.wslDistributions);
     }
     CATCH_LOG()
+
+    return result;
 }
 
 // Method Description:
@@ -343,12 +398,13 @@ void CascadiaSettings::_CreateDefaultKeybindings()
 // Method Description:
 // - Initialize this object with default color schemes, profiles, and keybindings.
 // Arguments:
-// - <none>
+// - dynamicProfiles: the result of an earlier call to DetectDynamicProfiles,
+//   if there was one. Otherwise, we look for the dynamic profiles now.
 // Return Value:
 // - <none>
-void CascadiaSettings::CreateDefaults()
+void CascadiaSettings::CreateDefaults(std::shared_future<DynamicProfiles> dynamicProfiles)
 {
-    _CreateDefaultProfiles();
+    _CreateDefaultProfiles(std::move(dynamicProfiles));
     _CreateDefaultSchemes();
     _CreateDefaultKeybindings();
 }
@@ -373,6 +429,57 @@ const Profile* CascadiaSettings::FindProfile(GUID profileGuid) const noexcept
     return nullptr;
 }
 
+// Method Description:
+// - Compares these settings to the ones they're replacing, to find the
+//   profiles whose terminals need to be given new settings. That's every
+//   profile that's new, that changed, or whose color scheme changed - or all
+//   of them, if a global that's applied to every terminal changed.
+// Arguments:
+// - previous: the settings that these are replacing.
+// Return Value:
+// - the GUIDs of the profiles whose TerminalSettings may have changed.
+std::vector<GUID> CascadiaSettings::FindChangedProfiles(const CascadiaSettings& previous) const
+{
+    const bool globalsChanged = _globals.AppliesDifferentSettings(previous._globals);
+
+    // Returns true if the scheme with the given name is different (or
+    // missing) in one of the two settings.
+    auto schemeChanged = [&](const std::wstring_view schemeName) {
+        auto findScheme = [schemeName](const std::vector<ColorScheme>& schemes) -> const ColorScheme* {
+            for (const auto& scheme : schemes)
+            {
+                if (scheme.GetName() == schemeName)
+                {
+                    return &scheme;
+                }
+            }
+            return nullptr;
+        };
+        const auto* const newScheme = findScheme(_globals.GetColorSchemes());
+        const auto* const oldScheme = findScheme(previous._globals.GetColorSchemes());
+        if (newScheme == nullptr || oldScheme == nullptr)
+        {
+            return newScheme != oldScheme;
+        }
+        return newScheme->ToJson() != oldScheme->ToJson();
+    };
+
+    std::vector<GUID> changedProfiles;
+    for (const auto& profile : _profiles)
+    {
+        const auto* const oldProfile = previous.FindProfile(profile.GetGuid());
+        const bool changed = globalsChanged ||
+                             oldProfile == nullptr ||
+                             profile.ToJson() != oldProfile->ToJson() ||
+                             (!profile.GetSchemeName().empty() && schemeChanged(profile.GetSchemeName()));
+        if (changed)
+        {
+            changedProfiles.push_back(profile.GetGuid());
+        }
+    }
+    return changedProfiles;
+}
+
 // Method Description:
 // - Create a TerminalSettings object from the given profile.
 //      If the profileGuidArg is not provided, this method will use the default
@@ -509,12 +616,16 @@ void CascadiaSettings::_AppendWslProfiles(std::vector<TerminalApp::Profile>& pro
                                              nullptr,
                                              &si,
                                              &pi));
-    switch (WaitForSingleObject(pi.hProcess, INFINITE))
+    switch (WaitForSingleObject(pi.hProcess, WSL_LIST_TIMEOUT_MS))
     {
     case WAIT_OBJECT_0:
         break;
-    case WAIT_ABANDONED:
     case WAIT_TIMEOUT:
+        // Don't let a wedged WSL service hold up creating the rest of the
+        // settings. We'll just go without the WSL profiles.
+        LOG_IF_WIN32_BOOL_FALSE(TerminateProcess(pi.hProcess, ERROR_TIMEOUT));
+        THROW_HR(ERROR_CHILD_NOT_COMPLETE);
+    case WAIT_ABANDONED:
         THROW_HR(ERROR_CHILD_NOT_COMPLETE);
     case WAIT_FAILED:
         THROW_LAST_ERROR();
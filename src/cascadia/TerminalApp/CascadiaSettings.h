@@ -19,6 +19,8 @@ Author(s):
 #include <winrt/Microsoft.Terminal.TerminalControl.h>
 #include "GlobalAppSettings.h"
 #include "Profile.h"
+#include <future>
+#include <thread>
 
 namespace TerminalApp
 {
@@ -31,7 +33,17 @@ public:
     CascadiaSettings();
     ~CascadiaSettings();
 
-    static std::unique_ptr<CascadiaSettings> LoadAll(const bool saveOnLoad = true);
+    // The profiles that depend on what's installed on this machine.
+    struct DynamicProfiles
+    {
+        std::optional<Profile> powershellCore;
+        std::vector<Profile> wslDistributions;
+    };
+
+    static std::shared_future<DynamicProfiles> DetectDynamicProfiles();
+
+    static std::unique_ptr<CascadiaSettings> LoadAll(const bool saveOnLoad = true,
+                                                     std::shared_future<DynamicProfiles> dynamicProfiles = {});
     void SaveAll() const;
 
     winrt::Microsoft::Terminal::Settings::TerminalSettings MakeSettings(std::optional<GUID> profileGuid) const;
@@ -48,8 +60,9 @@ public:
     static std::wstring GetSettingsPath();
 
     const Profile* FindProfile(GUID profileGuid) const noexcept;
+    std::vector<GUID> FindChangedProfiles(const CascadiaSettings& previous) const;
 
-    void CreateDefaults();
+    void CreateDefaults(std::shared_future<DynamicProfiles> dynamicProfiles = {});
 
 private:
     GlobalAppSettings _globals;
@@ -57,11 +70,18 @@ private:
 
     void _CreateDefaultKeybindings();
     void _CreateDefaultSchemes();
-    void _CreateDefaultProfiles();
+    void _CreateDefaultProfiles(std::shared_future<DynamicProfiles> dynamicProfiles);
 
     static bool _IsPackaged();
     static void _WriteSettings(const std::string_view content);
     static std::optional<std::string> _ReadSettings();
+    static std::filesystem::path _GetSettingsHashPath();
+    static std::optional<uint64_t> _ReadSettingsHash();
+    static void _WriteSettingsHash(const std::string_view content) noexcept;
+    static std::shared_ptr<const Json::Value> _ParseSettings(const std::string& data, bool& schemaCurrent);
+    static void _CacheSettings(std::string data, std::shared_ptr<const Json::Value> root, const bool schemaCurrent);
+
+    static DynamicProfiles _GenerateDynamicProfiles();
 
     static bool _isPowerShellCoreInstalledInPath(const std::wstring_view programFileEnv, std::filesystem::path& cmdline);
     static bool _isPowerShellCoreInstalled(std::filesystem::path& cmdline);
@@ -6,6 +6,7 @@
 #include "CascadiaSettings.h"
 #include "AppKeyBindingsSerialization.h"
 #include "../../types/inc/utils.hpp"
+#include "../inc/SettingsHash.h"
 #include <appmodel.h>
 #include <shlobj.h>
 
@@ -15,6 +16,7 @@ using namespace winrt::TerminalApp;
 using namespace ::Microsoft::Console;
 
 static constexpr std::wstring_view SettingsFilename{ L"profiles.json" };
+static constexpr std::wstring_view SettingsHashFilename{ L"profiles.json.hash" };
 static constexpr std::wstring_view UnpackagedSettingsFolderName{ L"Microsoft\\Windows Terminal\\" };
 
 static constexpr std::string_view ProfilesKey{ "profiles" };
@@ -24,6 +26,20 @@ static constexpr std::string_view SchemesKey{ "schemes" };
 
 static constexpr std::string_view Utf8Bom{ u8"\uFEFF" };
 
+// The contents of the settings file we last parsed or wrote, along with the
+// json they parsed to. Loading a file that's byte-for-byte the same (which is
+// what happens when we're notified about our own write, or when an editor
+// touches the file more than once per save) skips parsing it entirely.
+// This only lives as long as the process; across restarts, the hash saved in
+// SettingsHashFilename is what lets us skip checking the file's schema again.
+static struct
+{
+    std::mutex lock;
+    std::string data;
+    std::shared_ptr<const Json::Value> root;
+    bool schemaCurrent = false;
+} s_lastSettings;
+
 // Method Description:
 // - Creates a CascadiaSettings from whatever's saved on disk, or instantiates
 //      a new one with the default values. If we're running as a packaged app,
@@ -33,9 +49,13 @@ static constexpr std::string_view Utf8Bom{ u8"\uFEFF" };
 // Arguments:
 // - saveOnLoad: If true, we'll write the settings back out after we load them,
 //   to make sure the schema is updated.
+// - dynamicProfiles: the result of an earlier call to DetectDynamicProfiles,
+//   used if there's no file and we have to create the defaults. If it's
+//   empty, we look for the dynamic profiles then.
 // Return Value:
 // - a unique_ptr containing a new CascadiaSettings object.
-std::unique_ptr<CascadiaSettings> CascadiaSettings::LoadAll(const bool saveOnLoad)
+std::unique_ptr<CascadiaSettings> CascadiaSettings::LoadAll(const bool saveOnLoad,
+                                                            std::shared_future<DynamicProfiles> dynamicProfiles)
 {
     std::unique_ptr<CascadiaSettings> resultPtr;
     std::optional<std::string> fileData = _ReadSettings();
@@ -43,44 +63,42 @@ std::unique_ptr<CascadiaSettings> CascadiaSettings::LoadAll(const bool saveOnLoa
     const bool foundFile = fileData.has_value();
     if (foundFile)
     {
-        const auto actualData = fileData.value();
-
-        // Ignore UTF-8 BOM
-        auto actualDataStart = actualData.c_str();
-        if (actualData.compare(0, Utf8Bom.size(), Utf8Bom) == 0)
-        {
-            actualDataStart += Utf8Bom.size();
-        }
-
-        // Parse the json data.
-        Json::Value root;
-        std::unique_ptr<Json::CharReader> reader{ Json::CharReaderBuilder::CharReaderBuilder().newCharReader() };
-        std::string errs; // This string will recieve any error text from failing to parse.
-        // `parse` will return false if it fails.
-        if (!reader->parse(actualDataStart, actualData.c_str() + actualData.size(), &root, &errs))
-        {
-            // TODO:GH#990 display this exception text to the user, in a
-            //      copy-pasteable way.
-            throw winrt::hresult_error(WEB_E_INVALID_JSON_STRING, winrt::to_hstring(errs));
-        }
-        resultPtr = FromJson(root);
-
-        if (saveOnLoad)
+        bool schemaCurrent = false;
+        const auto root = _ParseSettings(fileData.value(), schemaCurrent);
+        resultPtr = FromJson(*root);
+
+        // If we've already seen that this exact file matches our schema
+        // (or we wrote it ourselves), there's nothing to check. That's also
+        // the case if the hash saved next to the file (by an earlier run)
+        // says so.
+        if (saveOnLoad && !schemaCurrent)
         {
-            // Logically compare the json we've parsed from the file to what
-            // we'd serialize at runtime. If the values are different, then
-            // write the updated schema back out.
-            const Json::Value reserialized = resultPtr->ToJson();
-            if (reserialized != root)
+            if (_ReadSettingsHash() == SettingsHash::HashContent(fileData.value()))
+            {
+                _CacheSettings(std::move(fileData.value()), root, true);
+            }
+            else
             {
-                resultPtr->SaveAll();
+                // Logically compare the json we've parsed from the file to what
+                // we'd serialize at runtime. If the values are different, then
+                // write the updated schema back out.
+                const Json::Value reserialized = resultPtr->ToJson();
+                if (reserialized != *root)
+                {
+                    resultPtr->SaveAll();
+                }
+                else
+                {
+                    _WriteSettingsHash(fileData.value());
+                    _CacheSettings(std::move(fileData.value()), root, true);
+                }
             }
         }
     }
     else
     {
         resultPtr = std::make_unique<CascadiaSettings>();
-        resultPtr->CreateDefaults();
+        resultPtr->CreateDefaults(std::move(dynamicProfiles));
 
         // The settings file does not exist. Let's commit one.
         resultPtr->SaveAll();
@@ -99,13 +117,79 @@ std::unique_ptr<CascadiaSettings> CascadiaSettings::LoadAll(const bool saveOnLoa
 // - <none>
 void CascadiaSettings::SaveAll() const
 {
-    const auto json = ToJson();
+    auto json = std::make_shared<Json::Value>(ToJson());
     Json::StreamWriterBuilder wbuilder;
     // Use 4 spaces to indent instead of \t
     wbuilder.settings_["indentation"] = "    ";
-    const auto serializedString = Json::writeString(wbuilder, json);
+    auto serializedString = Json::writeString(wbuilder, *json);
 
     _WriteSettings(serializedString);
+    _WriteSettingsHash(serializedString);
+
+    // Writing the file will make us reload it, so remember what we wrote.
+    _CacheSettings(std::move(serializedString), std::move(json), true);
+}
+
+// Method Description:
+// - Parses the contents of the settings file into json, or returns the
+//   previous result if the contents haven't changed since we last saw them.
+// Arguments:
+// - data: the contents of the settings file
+// - schemaCurrent: receives true if these contents are already known to
+//   match what we'd serialize ourselves
+// Return Value:
+// - the parsed json
+//   This will throw an exception if the data isn't valid json.
+std::shared_ptr<const Json::Value> CascadiaSettings::_ParseSettings(const std::string& data, bool& schemaCurrent)
+{
+    {
+        std::lock_guard<std::mutex> lock{ s_lastSettings.lock };
+        if (s_lastSettings.root && s_lastSettings.data == data)
+        {
+            schemaCurrent = s_lastSettings.schemaCurrent;
+            return s_lastSettings.root;
+        }
+    }
+
+    // Ignore UTF-8 BOM
+    auto actualDataStart = data.c_str();
+    if (data.compare(0, Utf8Bom.size(), Utf8Bom) == 0)
+    {
+        actualDataStart += Utf8Bom.size();
+    }
+
+    // Parse the json data.
+    auto root = std::make_shared<Json::Value>();
+    std::unique_ptr<Json::CharReader> reader{ Json::CharReaderBuilder::CharReaderBuilder().newCharReader() };
+    std::string errs; // This string will recieve any error text from failing to parse.
+    // `parse` will return false if it fails.
+    if (!reader->parse(actualDataStart, data.c_str() + data.size(), root.get(), &errs))
+    {
+        // TODO:GH#990 display this exception text to the user, in a
+        //      copy-pasteable way.
+        throw winrt::hresult_error(WEB_E_INVALID_JSON_STRING, winrt::to_hstring(errs));
+    }
+
+    schemaCurrent = false;
+    _CacheSettings(data, root, false);
+    return root;
+}
+
+// Method Description:
+// - Remembers the contents of the settings file and the json they parse to,
+//   for _ParseSettings.
+// Arguments:
+// - data: the contents of the settings file
+// - root: the json that data parses to
+// - schemaCurrent: true if data is exactly what we'd serialize ourselves
+// Return Value:
+// - <none>
+void CascadiaSettings::_CacheSettings(std::string data, std::shared_ptr<const Json::Value> root, const bool schemaCurrent)
+{
+    std::lock_guard<std::mutex> lock{ s_lastSettings.lock };
+    s_lastSettings.data = std::move(data);
+    s_lastSettings.root = std::move(root);
+    s_lastSettings.schemaCurrent = schemaCurrent;
 }
 
 // Method Description:
@@ -282,6 +366,58 @@ std::optional<std::string> CascadiaSettings::_ReadSettings()
     return { utf8string };
 }
 
+// Method Description:
+// - Returns the path to the file that holds the hash of the settings file,
+//   next to the settings file.
+// Arguments:
+// - <none>
+// Return Value:
+// - the full path to the settings hash file
+std::filesystem::path CascadiaSettings::_GetSettingsHashPath()
+{
+    return std::filesystem::path{ GetSettingsPath() }.replace_filename(SettingsHashFilename);
+}
+
+// Method Description:
+// - Reads the hash of the settings file that was last known to match our
+//   schema, as saved by _WriteSettingsHash.
+// Arguments:
+// - <none>
+// Return Value:
+// - the saved hash, or an empty optional if there's none we can read.
+std::optional<uint64_t> CascadiaSettings::_ReadSettingsHash()
+{
+    try
+    {
+        std::ifstream file{ _GetSettingsHashPath() };
+        uint64_t hash = 0;
+        if (file >> std::hex >> hash)
+        {
+            return hash;
+        }
+    }
+    CATCH_LOG();
+    return std::nullopt;
+}
+
+// Method Description:
+// - Saves the hash of the given settings file contents next to the settings
+//   file, once they're known to match our schema. The hash only saves us
+//   work on the next start, so failing to write it is logged and ignored.
+// Arguments:
+// - content: the contents of the settings file
+// Return Value:
+// - <none>
+void CascadiaSettings::_WriteSettingsHash(const std::string_view content) noexcept
+{
+    try
+    {
+        std::ofstream file{ _GetSettingsHashPath(), std::ios::trunc };
+        file << std::hex << SettingsHash::HashContent(content);
+    }
+    CATCH_LOG();
+}
+
 // function Description:
 // - Returns the full path to the settings file, either within the application
 //   package, or in its unpackaged location.
@@ -130,6 +130,21 @@ void GlobalAppSettings::ApplyToSettings(TerminalSettings& settings) const noexce
     settings.InitialCols(_initialCols);
 }
 
+// Method Description:
+// - Returns true if ApplyToSettings would put different values into a
+//   TerminalSettings than other's ApplyToSettings would.
+// Arguments:
+// - other: the globals to compare to.
+// Return Value:
+// - true iff terminals would need new settings to pick up the difference
+bool GlobalAppSettings::AppliesDifferentSettings(const GlobalAppSettings& other) const
+{
+    // Every load creates new keybindings, so compare what's in them.
+    return _initialRows != other._initialRows ||
+           _initialCols != other._initialCols ||
+           AppKeyBindingsSerialization::ToJson(_keybindings) != AppKeyBindingsSerialization::ToJson(other._keybindings);
+}
+
 // Method Description:
 // - Serialize this object to a JsonObject.
 // Arguments:
@@ -53,6 +53,7 @@ public:
     static GlobalAppSettings FromJson(const Json::Value& json);
 
     void ApplyToSettings(winrt::Microsoft::Terminal::Settings::TerminalSettings& settings) const noexcept;
+    bool AppliesDifferentSettings(const GlobalAppSettings& other) const;
 
 private:
     GUID _defaultProfile;
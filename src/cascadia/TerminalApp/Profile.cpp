@@ -508,6 +508,17 @@ std::wstring_view Profile::GetName() const noexcept
     return _name;
 }
 
+// Method Description:
+// - Returns the name of the color scheme this profile uses.
+// Arguments:
+// - <none>
+// Return Value:
+// - the name of our color scheme, or an empty string if we don't use one
+std::wstring_view Profile::GetSchemeName() const noexcept
+{
+    return _schemeName ? std::wstring_view{ _schemeName.value() } : std::wstring_view{};
+}
+
 bool Profile::GetCloseOnExit() const noexcept
 {
     return _closeOnExit;
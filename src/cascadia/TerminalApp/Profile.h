@@ -36,6 +36,7 @@ public:
 
     GUID GetGuid() const noexcept;
     std::wstring_view GetName() const noexcept;
+    std::wstring_view GetSchemeName() const noexcept;
 
     void SetFontFace(std::wstring fontFace) noexcept;
     void SetColorScheme(std::optional<std::wstring> schemeName) noexcept;
@@ -51,3 +51,4 @@ TRACELOGGING_DECLARE_PROVIDER(g_hTerminalWin32Provider);
 
 #include <shellapi.h>
 #include <filesystem>
+#include <fstream>
@@ -38,6 +38,9 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
         _desiredFont{ DEFAULT_FONT_FACE.c_str(), 0, 10, { 0, DEFAULT_FONT_SIZE }, CP_UTF8 },
         _actualFont{ DEFAULT_FONT_FACE.c_str(), 0, 10, { 0, DEFAULT_FONT_SIZE }, CP_UTF8, false },
         _touchAnchor{ std::nullopt },
+        _lastMouseClickTimestamp{ 0 },
+        _lastMouseClickPos{ 0, 0 },
+        _wordSelected{ false },
         _leadingSurrogate{},
         _cursorTimer{}
     {
@@ -98,6 +101,7 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
         _controlRoot.Content(_root);
 
         _ApplyUISettings();
+        _ApplyFontSettings();
         _ApplyConnectionSettings();
 
         // These are important:
@@ -127,22 +131,36 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
     // - <none>
     void TermControl::UpdateSettings(Settings::IControlSettings newSettings)
     {
+        const auto oldSettings = _settings;
         _settings = newSettings;
 
         // Dispatch a call to the UI thread to apply the new settings to the
         // terminal.
-        _root.Dispatcher().RunAsync(CoreDispatcherPriority::Normal, [this]() {
+        _root.Dispatcher().RunAsync(CoreDispatcherPriority::Normal, [this, oldSettings]() {
+            // Only the font and the padding decide how big our cells are and
+            // how many of them fit. If neither changed, we can keep our font
+            // and our buffer as they are, and only repaint if the colors changed.
+            const bool fontChanged = !oldSettings ||
+                                     oldSettings.FontFace() != _settings.FontFace() ||
+                                     oldSettings.FontSize() != _settings.FontSize();
+            const bool paddingChanged = !oldSettings ||
+                                        oldSettings.Padding() != _settings.Padding();
+
             // Update our control settings
             _ApplyUISettings();
             // Update the terminal core with its new Core settings
             _terminal->UpdateSettings(_settings);
 
-            // Refresh our font with the renderer
-            _UpdateFont();
+            if (fontChanged)
+            {
+                // Refresh our font with the renderer
+                _ApplyFontSettings();
+                _UpdateFont();
+            }
 
             const auto width = _swapChainPanel.ActualWidth();
             const auto height = _swapChainPanel.ActualHeight();
-            if (width != 0 && height != 0)
+            if ((fontChanged || paddingChanged) && width != 0 && height != 0)
             {
                 // If the font size changed, or the _swapchainPanel's size changed
                 // for any reason, we'll need to make sure to also resize the
@@ -150,9 +168,51 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
                 auto lock = _terminal->LockForWriting();
                 _DoResize(width, height);
             }
+            else if (_initializedTerminal && _RenderedSettingsChanged(oldSettings, _settings))
+            {
+                _renderer->TriggerRedrawAll();
+            }
         });
     }
 
+    // Method Description:
+    // - Checks whether any of the settings that change what the renderer draws,
+    //   without changing the size of the cells, differ between the two settings.
+    //   That's the colors, the cursor and the scrollbar.
+    // Arguments:
+    // - oldSettings: the settings we were using before. May be null.
+    // - newSettings: the settings we're switching to.
+    // Return Value:
+    // - true if the terminal has to be repainted for the new settings.
+    bool TermControl::_RenderedSettingsChanged(const Settings::IControlSettings& oldSettings,
+                                               const Settings::IControlSettings& newSettings)
+    {
+        if (!oldSettings)
+        {
+            return true;
+        }
+
+        if (oldSettings.DefaultForeground() != newSettings.DefaultForeground() ||
+            oldSettings.DefaultBackground() != newSettings.DefaultBackground() ||
+            oldSettings.CursorColor() != newSettings.CursorColor() ||
+            oldSettings.CursorShape() != newSettings.CursorShape() ||
+            oldSettings.CursorHeight() != newSettings.CursorHeight() ||
+            oldSettings.ScrollState() != newSettings.ScrollState())
+        {
+            return true;
+        }
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            if (oldSettings.GetColorTableEntry(i) != newSettings.GetColorTableEntry(i))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     // Method Description:
     // - Style our UI elements based on the values in our _settings, and set up
     //   other control-specific settings. This method will be called whenever
@@ -161,6 +221,7 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
     //     for the control's background
     //   * Calls _BackgroundColorChanged to style the background of the control
     // - Core settings will be passed to the terminal in _InitializeTerminal
+    // - The font is set up separately, by _ApplyFontSettings
     // Arguments:
     // - <none>
     // Return Value:
@@ -175,7 +236,18 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
         // Apply padding to the root Grid
         auto thickness = _ParseThicknessFromPadding(_settings.Padding());
         _root.Padding(thickness);
+    }
 
+    // Method Description:
+    // - Set up the font we'd like to use from the values in our _settings. The
+    //   renderer only picks it up in _UpdateFont (or _InitializeTerminal).
+    //   This also resets any zooming that was done with the mouse wheel.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void TermControl::_ApplyFontSettings()
+    {
         // Initialize our font information.
         const auto* fontFace = _settings.FontFace().c_str();
         const short fontHeight = gsl::narrow<short>(_settings.FontSize());
@@ -703,8 +775,30 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
                 const auto cursorPosition = point.Position();
                 const auto terminalPosition = _GetTerminalPosition(cursorPosition);
 
-                // save location before rendering
-                _terminal->SetSelectionAnchor(terminalPosition);
+                // A second click on the same cell, within the system's double
+                // click time, selects the word under it.
+                const auto timestamp = point.Timestamp();
+                const bool doubleClick = timestamp - _lastMouseClickTimestamp <= GetDoubleClickTime() * 1000ull &&
+                                         terminalPosition.X == _lastMouseClickPos.X &&
+                                         terminalPosition.Y == _lastMouseClickPos.Y;
+                if (doubleClick)
+                {
+                    auto lock = _terminal->LockForReading();
+                    _terminal->DoubleClickSelection(terminalPosition);
+
+                    // A third click starts over with a new selection.
+                    _lastMouseClickTimestamp = 0;
+                    _wordSelected = true;
+                }
+                else
+                {
+                    // save location before rendering
+                    _terminal->SetSelectionAnchor(terminalPosition);
+
+                    _lastMouseClickTimestamp = timestamp;
+                    _lastMouseClickPos = terminalPosition;
+                    _wordSelected = false;
+                }
 
                 // handle ALT key
                 _terminal->SetBoxSelection(altEnabled);
@@ -759,9 +853,19 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
                 const auto cursorPosition = point.Position();
                 const auto terminalPosition = _GetTerminalPosition(cursorPosition);
 
-                // save location (for rendering) + render
-                _terminal->SetEndSelectionPosition(terminalPosition);
-                _renderer->TriggerSelection();
+                // Moving around inside the double clicked cell shouldn't shrink
+                // the word that was selected back down to that cell.
+                const bool onSelectedWord = _wordSelected &&
+                                            terminalPosition.X == _lastMouseClickPos.X &&
+                                            terminalPosition.Y == _lastMouseClickPos.Y;
+                if (!onSelectedWord)
+                {
+                    _wordSelected = false;
+
+                    // save location (for rendering) + render
+                    _terminal->SetEndSelectionPosition(terminalPosition);
+                    _renderer->TriggerSelection();
+                }
             }
         }
         else if (ptr.PointerDeviceType() == Windows::Devices::Input::PointerDeviceType::Touch && _touchAnchor)
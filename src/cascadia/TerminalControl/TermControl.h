@@ -97,6 +97,14 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
         //      viewport via touch input.
         std::optional<winrt::Windows::Foundation::Point> _touchAnchor;
 
+        // The time (in microseconds, as the pointer reports it) and the cell
+        //      of the last left click, to recognize a double click.
+        uint64_t _lastMouseClickTimestamp;
+        COORD _lastMouseClickPos;
+        // Set when a double click selects a word, until the mouse is dragged
+        //      off the cell that was clicked.
+        bool _wordSelected;
+
         // Event revokers -- we need to deregister ourselves before we die,
         // lest we get callbacks afterwards.
         winrt::Windows::UI::Xaml::Controls::Control::SizeChanged_revoker _sizeChangedRevoker;
@@ -107,6 +115,7 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
 
         void _Create();
         void _ApplyUISettings();
+        void _ApplyFontSettings();
         void _InitializeBackgroundBrush();
         void _BackgroundColorChanged(const uint32_t color);
         void _ApplyConnectionSettings();
@@ -139,6 +148,8 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
 
         void _ScrollbarUpdater(Windows::UI::Xaml::Controls::Primitives::ScrollBar scrollbar, const int viewTop, const int viewHeight, const int bufferSize);
         static Windows::UI::Xaml::Thickness _ParseThicknessFromPadding(const hstring padding);
+        static bool _RenderedSettingsChanged(const Settings::IControlSettings& oldSettings,
+                                             const Settings::IControlSettings& newSettings);
 
         Settings::KeyModifiers _GetPressedModifierKeys() const;
 
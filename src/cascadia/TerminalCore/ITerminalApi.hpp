@@ -26,6 +26,11 @@ namespace Microsoft::Terminal::Core
 
         virtual bool EraseCharacters(const unsigned int numChars) = 0;
 
+        virtual bool HorizontalTabSet() = 0;
+        virtual bool ForwardTab(const SHORT numTabs) = 0;
+        virtual bool BackwardsTab(const SHORT numTabs) = 0;
+        virtual bool TabClear(const bool clearAll) = 0;
+
         virtual bool SetWindowTitle(std::wstring_view title) = 0;
 
         virtual bool SetColorTableEntry(const size_t tableIndex, const DWORD dwColor) = 0;
@@ -73,6 +73,9 @@ void Terminal::Create(COORD viewportSize, SHORT scrollbackLines, IRenderTarget&
     const TextAttribute attr{};
     const UINT cursorSize = 12;
     _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, renderTarget);
+
+    _tabStops.ClearAll();
+    _tabStops.SetEvery(TabStops::DefaultInterval, 0, gsl::narrow<size_t>(viewportSize.X));
 }
 
 // Method Description:
@@ -162,6 +165,19 @@ void Terminal::UpdateSettings(winrt::Microsoft::Terminal::Settings::ICoreSetting
     COORD bufferSize{ viewportSize.X, newBufferHeight };
     RETURN_IF_FAILED(_buffer->ResizeTraditional(bufferSize));
 
+    // Columns that are new to the buffer get the default tab stops. The
+    // ones that are already set (or cleared) are kept.
+    if (viewportSize.X > oldDimensions.X)
+    {
+        try
+        {
+            _tabStops.SetEvery(TabStops::DefaultInterval,
+                               gsl::narrow<size_t>(oldDimensions.X),
+                               gsl::narrow<size_t>(viewportSize.X));
+        }
+        CATCH_RETURN();
+    }
+
     auto proposedTop = oldTop;
     const auto newView = Viewport::FromDimensions({ 0, proposedTop }, viewportSize);
     const auto proposedBottom = newView.BottomExclusive();
@@ -300,6 +316,24 @@ int Terminal::_VisibleStartIndex() const noexcept
     return std::max(0, _ViewStartIndex() - _scrollOffset);
 }
 
+// Method Description:
+// - Finds the column a tab from the given column moves to: the next tab stop,
+//   or the last column if there isn't one before it.
+// Arguments:
+// - column: the column the tab starts from
+// Return Value:
+// - the column to move to
+short Terminal::_GetForwardTabColumn(const short column) const noexcept
+{
+    const auto lastColumn = _buffer->GetSize().RightInclusive();
+    const auto nextStop = _tabStops.Next(gsl::narrow_cast<size_t>(std::max<short>(column, 0)));
+    if (nextStop.has_value() && nextStop.value() < gsl::narrow_cast<size_t>(lastColumn))
+    {
+        return gsl::narrow_cast<short>(nextStop.value());
+    }
+    return lastColumn;
+}
+
 Viewport Terminal::_GetVisibleViewport() const noexcept
 {
     const COORD origin{ 0, gsl::narrow<short>(_VisibleStartIndex()) };
@@ -335,6 +369,10 @@ void Terminal::_WriteBuffer(const std::wstring_view& stringView)
         {
             proposedCursorPosition.X = 0;
         }
+        else if (wch == UNICODE_TAB)
+        {
+            proposedCursorPosition.X = _GetForwardTabColumn(cursorPosBefore.X);
+        }
         else if (wch == UNICODE_BACKSPACE)
         {
             if (cursorPosBefore.X == 0)
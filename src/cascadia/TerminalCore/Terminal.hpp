@@ -11,6 +11,8 @@
 #include "../../terminal/input/terminalInput.hpp"
 
 #include "../../types/inc/Viewport.hpp"
+#include "../../types/inc/TabStops.hpp"
+#include "../../types/inc/DelimiterClassTable.hpp"
 #include "../../cascadia/terminalcore/ITerminalApi.hpp"
 #include "../../cascadia/terminalcore/ITerminalInput.hpp"
 
@@ -67,6 +69,10 @@ public:
     bool SetCursorPosition(short x, short y) override;
     COORD GetCursorPosition() override;
     bool EraseCharacters(const unsigned int numChars) override;
+    bool HorizontalTabSet() override;
+    bool ForwardTab(const SHORT numTabs) override;
+    bool BackwardsTab(const SHORT numTabs) override;
+    bool TabClear(const bool clearAll) override;
     bool SetWindowTitle(std::wstring_view title) override;
     bool SetColorTableEntry(const size_t tableIndex, const COLORREF dwColor) override;
     bool SetCursorStyle(const ::Microsoft::Console::VirtualTerminal::DispatchTypes::CursorStyle cursorStyle) override;
@@ -122,6 +128,7 @@ public:
     const bool IsSelectionActive() const noexcept;
     void SetSelectionAnchor(const COORD position);
     void SetEndSelectionPosition(const COORD position);
+    void DoubleClickSelection(const COORD position);
     void SetBoxSelection(const bool isEnabled) noexcept;
     void ClearSelection() noexcept;
 
@@ -152,12 +159,14 @@ private:
     bool _selectionActive;
     SHORT _selectionAnchor_YOffset;
     SHORT _endSelectionPosition_YOffset;
+    Microsoft::Console::Types::DelimiterClassTable _wordDelimiters;
 
     std::shared_mutex _readWriteLock;
 
     // TODO: These members are not shared by an alt-buffer. They should be
     //      encapsulated, such that a Terminal can have both a main and alt buffer.
     std::unique_ptr<TextBuffer> _buffer;
+    Microsoft::Console::Types::TabStops _tabStops;
     Microsoft::Console::Types::Viewport _mutableViewport;
     SHORT _scrollbackLines;
 
@@ -181,6 +190,8 @@ private:
     int _VisibleStartIndex() const noexcept;
 
     Microsoft::Console::Types::Viewport _GetMutableViewport() const noexcept;
+
+    short _GetForwardTabColumn(const short column) const noexcept;
     Microsoft::Console::Types::Viewport _GetVisibleViewport() const noexcept;
 
     void _InitializeColorTable();
@@ -192,6 +203,7 @@ private:
 #pragma region TextSelection
     // These methods are defined in TerminalSelection.cpp
     std::vector<SMALL_RECT> _GetSelectionRects() const;
+    std::vector<SMALL_RECT> _GetSelectionRects(const Microsoft::Console::Types::Viewport& clip) const;
     const SHORT _ExpandWideGlyphSelectionLeft(const SHORT xPos, const SHORT yPos) const noexcept;
     const SHORT _ExpandWideGlyphSelectionRight(const SHORT xPos, const SHORT yPos) const noexcept;
 #pragma endregion
@@ -137,6 +137,76 @@ bool Terminal::EraseCharacters(const unsigned int numChars)
     return true;
 }
 
+// Method Description:
+// - Sets a tab stop in the cursor's column.
+// Return Value:
+// - true
+bool Terminal::HorizontalTabSet()
+{
+    const auto column = _buffer->GetCursor().GetPosition().X;
+    _tabStops.Set(gsl::narrow<size_t>(column));
+    return true;
+}
+
+// Method Description:
+// - Moves the cursor forward to the next tab stop, numTabs times. The cursor
+//   stops in the last column if it runs out of tab stops.
+// Arguments:
+// - numTabs: the number of tabs to perform
+// Return Value:
+// - true
+bool Terminal::ForwardTab(const SHORT numTabs)
+{
+    auto& cursor = _buffer->GetCursor();
+    auto position = cursor.GetPosition();
+    for (SHORT i = 0; i < numTabs; ++i)
+    {
+        position.X = _GetForwardTabColumn(position.X);
+    }
+    cursor.SetPosition(position);
+    return true;
+}
+
+// Method Description:
+// - Moves the cursor back to the previous tab stop, numTabs times. The cursor
+//   stops in the first column if it runs out of tab stops.
+// Arguments:
+// - numTabs: the number of tabs to perform
+// Return Value:
+// - true
+bool Terminal::BackwardsTab(const SHORT numTabs)
+{
+    auto& cursor = _buffer->GetCursor();
+    auto position = cursor.GetPosition();
+    for (SHORT i = 0; i < numTabs && position.X > 0; ++i)
+    {
+        const auto previousStop = _tabStops.Previous(gsl::narrow_cast<size_t>(position.X));
+        position.X = gsl::narrow_cast<short>(previousStop.value_or(0));
+    }
+    cursor.SetPosition(position);
+    return true;
+}
+
+// Method Description:
+// - Clears the tab stop in the cursor's column, or all of the tab stops.
+// Arguments:
+// - clearAll: if true, clears every tab stop
+// Return Value:
+// - true
+bool Terminal::TabClear(const bool clearAll)
+{
+    if (clearAll)
+    {
+        _tabStops.ClearAll();
+    }
+    else
+    {
+        const auto column = _buffer->GetCursor().GetPosition().X;
+        _tabStops.Clear(gsl::narrow<size_t>(column));
+    }
+    return true;
+}
+
 bool Terminal::SetWindowTitle(std::wstring_view title)
 {
     _title = title;
@@ -52,6 +52,40 @@ bool TerminalDispatch::EraseCharacters(const unsigned int uiNumChars)
     return _terminalApi.EraseCharacters(uiNumChars);
 }
 
+bool TerminalDispatch::HorizontalTabSet()
+{
+    return _terminalApi.HorizontalTabSet();
+}
+
+bool TerminalDispatch::ForwardTab(const SHORT sNumTabs)
+{
+    return _terminalApi.ForwardTab(sNumTabs);
+}
+
+bool TerminalDispatch::BackwardsTab(const SHORT sNumTabs)
+{
+    return _terminalApi.BackwardsTab(sNumTabs);
+}
+
+// Method Description:
+// - Clears either the tab stop in the cursor's column or all of them.
+// Arguments:
+// - sClearType - one of DispatchTypes::TabClearType
+// Return Value:
+// True if handled successfully. False otherwise.
+bool TerminalDispatch::TabClear(const SHORT sClearType)
+{
+    switch (sClearType)
+    {
+    case DispatchTypes::TabClearType::ClearCurrentColumn:
+        return _terminalApi.TabClear(false);
+    case DispatchTypes::TabClearType::ClearAllColumns:
+        return _terminalApi.TabClear(true);
+    default:
+        return false;
+    }
+}
+
 bool TerminalDispatch::SetWindowTitle(std::wstring_view title)
 {
     return _terminalApi.SetWindowTitle(title);
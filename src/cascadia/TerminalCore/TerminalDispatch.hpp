@@ -22,6 +22,11 @@ public:
     bool CursorForward(const unsigned int uiDistance) override;
 
     bool EraseCharacters(const unsigned int uiNumChars) override;
+
+    bool HorizontalTabSet() override; // HTS
+    bool ForwardTab(const SHORT sNumTabs) override; // CHT
+    bool BackwardsTab(const SHORT sNumTabs) override; // CBT
+    bool TabClear(const SHORT sClearType) override; // TBC
     bool SetWindowTitle(std::wstring_view title) override;
 
     bool SetColorTableEntry(const size_t tableIndex, const DWORD dwColor) override;
@@ -5,12 +5,26 @@
 #include "Terminal.hpp"
 
 using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Console::Types;
 
 // Method Description:
-// - Helper to determine the selected region of the buffer. Used for rendering.
+// - Helper to determine the selected region of the buffer.
 // Return Value:
 // - A vector of rectangles representing the regions to select, line by line. They are absolute coordinates relative to the buffer origin.
 std::vector<SMALL_RECT> Terminal::_GetSelectionRects() const
+{
+    return _GetSelectionRects(_buffer->GetSize());
+}
+
+// Method Description:
+// - Helper to determine the selected region of the buffer, limited to the rows
+//   of the given area. Rows outside of it are never looked at, so the cost
+//   doesn't depend on how far the selection extends into the scrollback.
+// Arguments:
+// - clip: the area of the buffer to return rows for. Only its rows are used.
+// Return Value:
+// - A vector of rectangles representing the regions to select, line by line. They are absolute coordinates relative to the buffer origin.
+std::vector<SMALL_RECT> Terminal::_GetSelectionRects(const Viewport& clip) const
 {
     std::vector<SMALL_RECT> selectionArea;
 
@@ -40,8 +54,15 @@ std::vector<SMALL_RECT> Terminal::_GetSelectionRects() const
                                   selectionAnchorWithOffset :
                                   endSelectionPositionWithOffset;
 
-    selectionArea.reserve(lowerCoord.Y - higherCoord.Y + 1);
-    for (auto row = higherCoord.Y; row <= lowerCoord.Y; row++)
+    const auto firstRow = std::max(higherCoord.Y, clip.Top());
+    const auto lastRow = std::min(lowerCoord.Y, clip.BottomInclusive());
+    if (firstRow > lastRow)
+    {
+        return selectionArea;
+    }
+
+    selectionArea.reserve(lastRow - firstRow + 1);
+    for (auto row = firstRow; row <= lastRow; row++)
     {
         SMALL_RECT selectionRow;
 
@@ -161,6 +182,29 @@ void Terminal::SetEndSelectionPosition(const COORD position)
     _endSelectionPosition_YOffset = gsl::narrow<SHORT>(_ViewStartIndex());
 }
 
+// Method Description:
+// - Select the word at a position, for a double click. Words are found with
+//   the same delimiter table that conhost uses. A delimiter is selected on its own.
+// Arguments:
+// - position: the (x,y) coordinate on the visible viewport
+void Terminal::DoubleClickSelection(const COORD position)
+{
+    SetSelectionAnchor(position);
+
+    // the row of the buffer that was clicked, the same way _GetSelectionRects() finds it
+    SHORT row;
+    THROW_IF_FAILED(ShortAdd(_selectionAnchor.Y, _selectionAnchor_YOffset, &row));
+    const auto text = _buffer->GetRowByOffset(row).GetCharRow().GetColumnText();
+    const auto column = gsl::narrow<size_t>(std::clamp(position.X, static_cast<SHORT>(0), _buffer->GetSize().RightInclusive()));
+
+    if (!_wordDelimiters.IsDelimiter(text.at(column)))
+    {
+        const auto word = _wordDelimiters.FindWord(text, column);
+        _selectionAnchor.X = gsl::narrow<SHORT>(word.first);
+        _endSelectionPosition.X = gsl::narrow<SHORT>(word.second - 1);
+    }
+}
+
 // Method Description:
 // - enable/disable box selection (ALT + selection)
 // Arguments:
@@ -192,20 +236,7 @@ void Terminal::ClearSelection() noexcept
 // - wstring text from buffer. If extended to multiple lines, each line is separated by \r\n
 const std::wstring Terminal::RetrieveSelectedTextFromBuffer(bool trimTrailingWhitespace) const
 {
-    std::function<COLORREF(TextAttribute&)> GetForegroundColor = std::bind(&Terminal::GetForegroundColor, this, std::placeholders::_1);
-    std::function<COLORREF(TextAttribute&)> GetBackgroundColor = std::bind(&Terminal::GetBackgroundColor, this, std::placeholders::_1);
-
-    auto data = _buffer->GetTextForClipboard(!_boxSelection,
-                                             trimTrailingWhitespace,
-                                             _GetSelectionRects(),
-                                             GetForegroundColor,
-                                             GetBackgroundColor);
-
-    std::wstring result;
-    for (const auto& text : data.text)
-    {
-        result += text;
-    }
-
-    return result;
+    return _buffer->GetPlainText(!_boxSelection,
+                                 trimTrailingWhitespace,
+                                 _GetSelectionRects());
 }
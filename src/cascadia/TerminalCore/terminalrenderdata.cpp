@@ -105,16 +105,27 @@ const bool Terminal::IsGridLineDrawingAllowed() noexcept
     return true;
 }
 
+// Method Description:
+// - Gets the rows of the selection that are in the visible viewport. They're
+//   built fresh on every call, but only for the visible rows, so the cost is
+//   bounded by the viewport height. Nothing is cached here: the render thread
+//   calls this under a shared lock and the UI thread calls it with no lock.
+// Return Value:
+// - One Viewport per visible selected row, in buffer coordinates.
 std::vector<Microsoft::Console::Types::Viewport> Terminal::GetSelectionRects() noexcept
 {
-    std::vector<Viewport> result;
-
-    for (const auto& lineRect : _GetSelectionRects())
+    try
     {
-        result.emplace_back(Viewport::FromInclusive(lineRect));
+        std::vector<Viewport> result;
+        for (const auto& lineRect : _GetSelectionRects(_GetVisibleViewport()))
+        {
+            result.emplace_back(Viewport::FromInclusive(lineRect));
+        }
+        return result;
     }
+    CATCH_LOG();
 
-    return result;
+    return {};
 }
 
 const std::wstring Terminal::GetConsoleTitle() const noexcept
@@ -179,6 +179,69 @@ namespace TerminalCoreUnitTests
             }
         }
 
+        TEST_METHOD(SelectionClippedToViewport)
+        {
+            Terminal term;
+            DummyRenderTarget emptyRT;
+            term.Create({ 100, 20 }, 100, emptyRT);
+
+            // Select from (5,5) down to (15,50), well past the bottom of the viewport
+            term.SetSelectionAnchor({ 5, 5 });
+            term.SetEndSelectionPosition({ 15, 50 });
+
+            // Only the rows the renderer can see come back
+            auto selectionRects = term.GetSelectionRects();
+            VERIFY_ARE_EQUAL(selectionRects.size(), static_cast<size_t>(15));
+
+            auto viewport = term.GetViewport();
+            SHORT rightBoundary = viewport.RightInclusive();
+            VERIFY_ARE_EQUAL(viewport.ConvertToOrigin(selectionRects.front()).ToInclusive(), SMALL_RECT({ 5, 5, rightBoundary, 5 }));
+            VERIFY_ARE_EQUAL(viewport.ConvertToOrigin(selectionRects.back()).ToInclusive(), SMALL_RECT({ 0, 19, rightBoundary, 19 }));
+
+            // Asking again without changing anything gives the same rows
+            VERIFY_ARE_EQUAL(selectionRects.size(), term.GetSelectionRects().size());
+
+            // Moving the end up into the viewport is picked up
+            term.SetEndSelectionPosition({ 15, 10 });
+            selectionRects = term.GetSelectionRects();
+            VERIFY_ARE_EQUAL(selectionRects.size(), static_cast<size_t>(6));
+            VERIFY_ARE_EQUAL(viewport.ConvertToOrigin(selectionRects.back()).ToInclusive(), SMALL_RECT({ 0, 10, 15, 10 }));
+
+            // The copied text still covers every selected row, not just the visible ones
+            term.SetEndSelectionPosition({ 15, 50 });
+            const auto text = term.RetrieveSelectedTextFromBuffer(true);
+            VERIFY_ARE_EQUAL(static_cast<size_t>(46), gsl::narrow<size_t>(std::count(text.begin(), text.end(), L'\n')) + 1);
+        }
+
+        TEST_METHOD(DoubleClickSelectsWord)
+        {
+            Terminal term;
+            DummyRenderTarget emptyRT;
+            term.Create({ 100, 100 }, 0, emptyRT);
+
+            term.SetCursorPosition(0, 10);
+            term.Write(L"hello world");
+
+            // Simulate double click at (x,y) = (8,10), inside "world"
+            term.DoubleClickSelection({ 8, 10 });
+
+            auto selectionRects = term.GetSelectionRects();
+            VERIFY_ARE_EQUAL(selectionRects.size(), static_cast<size_t>(1));
+
+            auto selection = term.GetViewport().ConvertToOrigin(selectionRects.at(0)).ToInclusive();
+            VERIFY_ARE_EQUAL(selection, SMALL_RECT({ 6, 10, 10, 10 }));
+
+            // Simulate double click at (x,y) = (5,10), on the space between the words.
+            // A delimiter is selected on its own.
+            term.DoubleClickSelection({ 5, 10 });
+
+            selectionRects = term.GetSelectionRects();
+            VERIFY_ARE_EQUAL(selectionRects.size(), static_cast<size_t>(1));
+
+            selection = term.GetViewport().ConvertToOrigin(selectionRects.at(0)).ToInclusive();
+            VERIFY_ARE_EQUAL(selection, SMALL_RECT({ 5, 10, 5, 10 }));
+        }
+
         TEST_METHOD(SelectWideGlyph_Trailing)
         {
             Terminal term;
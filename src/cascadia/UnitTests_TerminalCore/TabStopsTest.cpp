@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <WexTestClass.h>
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../renderer/inc/DummyRenderTarget.hpp"
+#include "consoletaeftemplates.hpp"
+
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Console::Render;
+
+namespace TerminalCoreUnitTests
+{
+    class TabStopsTest
+    {
+        TEST_CLASS(TabStopsTest);
+
+        TEST_METHOD(TabMovesToDefaultStops)
+        {
+            Terminal term;
+            DummyRenderTarget emptyRT;
+            term.Create({ 40, 10 }, 0, emptyRT);
+
+            term.Write(L"a\tb");
+            VERIFY_ARE_EQUAL((COORD{ 9, 0 }), term.GetCursorPosition());
+
+            term.Write(L"\t\t");
+            VERIFY_ARE_EQUAL((COORD{ 24, 0 }), term.GetCursorPosition());
+
+            // Past the last stop, a tab goes to the last column and stays there.
+            term.Write(L"\t\t\t");
+            VERIFY_ARE_EQUAL((COORD{ 39, 0 }), term.GetCursorPosition());
+        }
+
+        TEST_METHOD(SetAndClearStops)
+        {
+            Terminal term;
+            DummyRenderTarget emptyRT;
+            term.Create({ 40, 10 }, 0, emptyRT);
+
+            Log::Comment(L"Clear all stops (TBC 3), then set one in column 5 (HTS).");
+            term.Write(L"\x1b[3g\x1b[1;6H\x1bH\r");
+
+            term.Write(L"\t");
+            VERIFY_ARE_EQUAL((COORD{ 5, 0 }), term.GetCursorPosition());
+            term.Write(L"\t");
+            VERIFY_ARE_EQUAL((COORD{ 39, 0 }), term.GetCursorPosition());
+
+            Log::Comment(L"Tab backwards (CBT) to the stop, then clear it (TBC 0).");
+            term.Write(L"\x1b[Z");
+            VERIFY_ARE_EQUAL((COORD{ 5, 0 }), term.GetCursorPosition());
+            term.Write(L"\x1b[0g\x1b[Z");
+            VERIFY_ARE_EQUAL((COORD{ 0, 0 }), term.GetCursorPosition());
+
+            Log::Comment(L"Forward tab (CHT) with no stops left goes to the end of the row.");
+            term.Write(L"\x1b[2I");
+            VERIFY_ARE_EQUAL((COORD{ 39, 0 }), term.GetCursorPosition());
+        }
+
+        TEST_METHOD(ResizeAddsStopsToNewColumns)
+        {
+            Terminal term;
+            DummyRenderTarget emptyRT;
+            term.Create({ 20, 10 }, 0, emptyRT);
+
+            // Clear the stop in column 8, then make the terminal wider.
+            term.Write(L"\x1b[1;9H\x1b[0g\r");
+            VERIFY_SUCCEEDED(term.UserResize({ 40, 10 }));
+
+            term.Write(L"\t");
+            VERIFY_ARE_EQUAL((COORD{ 16, 0 }), term.GetCursorPosition());
+            term.Write(L"\t\t");
+            VERIFY_ARE_EQUAL((COORD{ 32, 0 }), term.GetCursorPosition());
+        }
+    };
+}
@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+/*++
+Module Name:
+- SettingsHash.h
+
+Abstract:
+- The hash of the settings file that's saved next to it. Once the settings
+  were checked against our schema (or written by us), the hash of that file
+  is saved, so that starting up with the same file doesn't have to serialize
+  the settings again to find out that they're current.
+- This is a content check, not a security boundary: FNV-1a is used because
+  it's cheap and stable from one build to the next.
+--*/
+
+#pragma once
+
+namespace Microsoft::Terminal::SettingsHash
+{
+    // Method Description:
+    // - Computes the 64-bit FNV-1a hash of the contents of a settings file.
+    // Arguments:
+    // - content: the contents of the file, exactly as they're stored on disk
+    // Return Value:
+    // - the hash of content
+    constexpr uint64_t HashContent(const std::string_view content) noexcept
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (const auto ch : content)
+        {
+            hash ^= static_cast<uint8_t>(ch);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+}
@@ -24,33 +24,158 @@
 
 using Microsoft::Console::Interactivity::ServiceLocator;
 
-struct case_insensitive_hash
+namespace
 {
-    std::size_t operator()(const std::wstring& key) const
+    // Hashes strings the way case_insensitive_equality compares them, without
+    // making a lowercased copy first.
+    struct case_insensitive_hash
     {
-        std::wstring lower(key);
-        std::transform(lower.begin(), lower.end(), lower.begin(), ::towlower);
-        std::hash<std::wstring> hash;
-        return hash(lower);
+        std::size_t operator()(const std::wstring_view key) const noexcept
+        {
+            // FNV-1a over the lowercased characters.
+            unsigned long long hash = 14695981039346656037ull;
+            for (const auto ch : key)
+            {
+                hash ^= ::towlower(ch);
+                hash *= 1099511628211ull;
+            }
+            return static_cast<std::size_t>(hash);
+        }
+    };
+
+    struct case_insensitive_equality
+    {
+        bool operator()(const std::wstring_view lhs, const std::wstring_view rhs) const noexcept
+        {
+            return lhs.size() == rhs.size() &&
+                   std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), [](const wchar_t a, const wchar_t b) {
+                       return ::towlower(a) == ::towlower(b);
+                   });
+        }
+    };
+
+    // An alias target, compiled ahead of time into the pieces it expands to,
+    // so that matching an alias doesn't have to look for macros in it again.
+    class AliasExpansion
+    {
+    public:
+        AliasExpansion(const std::wstring_view target);
+
+        void Expand(const std::wstring_view command, std::wstring& expanded) const;
+        size_t LineCount() const noexcept;
+
+    private:
+        struct Piece
+        {
+            enum class Kind
+            {
+                Text, // characters [offset, offset + length) of _text
+                Argument, // the argument numbered offset ($1-$9)
+                AllArguments, // everything after the alias ($*)
+                NewLine // a CRLF ($T, and the end of the target)
+            };
+
+            Kind kind;
+            size_t offset;
+            size_t length;
+        };
+
+        void _AppendText(const std::wstring_view text);
+
+        std::wstring _text;
+        std::vector<Piece> _pieces;
+        size_t _lineCount;
+    };
+
+    // One alias. The map of aliases is keyed by a view of source.
+    struct AliasEntry
+    {
+        AliasEntry(const std::wstring_view source, const std::wstring_view target) :
+            source{ source },
+            target{ target },
+            expansion{ target }
+        {
+        }
+
+        const std::wstring source;
+        std::wstring target;
+        AliasExpansion expansion;
+    };
+
+    using AliasMap = std::unordered_map<std::wstring_view,
+                                        std::unique_ptr<AliasEntry>,
+                                        case_insensitive_hash,
+                                        case_insensitive_equality>;
+
+    // The aliases of one exe. The map of exes is keyed by a view of exeName.
+    struct ExeAliases
+    {
+        ExeAliases(const std::wstring_view exeName) :
+            exeName{ exeName },
+            aliases{}
+        {
+        }
+
+        const std::wstring exeName;
+        AliasMap aliases;
+    };
+
+    // Keys are views into the entries they map to, which are heap allocated so
+    // that the views stay put. This lets every lookup take a wstring_view.
+    std::unordered_map<std::wstring_view,
+                       std::unique_ptr<ExeAliases>,
+                       case_insensitive_hash,
+                       case_insensitive_equality>
+        g_aliasData;
+
+    // Routine Description:
+    // - Finds the aliases defined for an exe, without creating an entry for it.
+    ExeAliases* FindExe(const std::wstring_view exeName)
+    {
+        const auto exeIter = g_aliasData.find(exeName);
+        return exeIter == g_aliasData.end() ? nullptr : exeIter->second.get();
     }
-};
 
-struct case_insensitive_equality
-{
-    bool operator()(const std::wstring& lhs, const std::wstring& rhs) const
+    // Routine Description:
+    // - Finds an alias, without creating entries for it or its exe.
+    const AliasEntry* FindAlias(const std::wstring_view exeName, const std::wstring_view source)
     {
-        return 0 == _wcsicmp(lhs.data(), rhs.data());
+        const auto exe = FindExe(exeName);
+        if (exe == nullptr)
+        {
+            return nullptr;
+        }
+
+        const auto aliasIter = exe->aliases.find(source);
+        return aliasIter == exe->aliases.end() ? nullptr : aliasIter->second.get();
     }
-};
 
-std::unordered_map<std::wstring,
-                   std::unordered_map<std::wstring,
-                                      std::wstring,
-                                      case_insensitive_hash,
-                                      case_insensitive_equality>,
-                   case_insensitive_hash,
-                   case_insensitive_equality>
-    g_aliasData;
+    // Routine Description:
+    // - Defines or redefines an alias, creating the entry for its exe as necessary.
+    void SetAlias(const std::wstring_view exeName, const std::wstring_view source, const std::wstring_view target)
+    {
+        auto exe = FindExe(exeName);
+        if (exe == nullptr)
+        {
+            auto newExe = std::make_unique<ExeAliases>(exeName);
+            exe = newExe.get();
+            g_aliasData.emplace(exe->exeName, std::move(newExe));
+        }
+
+        const auto aliasIter = exe->aliases.find(source);
+        if (aliasIter != exe->aliases.end())
+        {
+            aliasIter->second->target = target;
+            aliasIter->second->expansion = AliasExpansion{ target };
+        }
+        else
+        {
+            auto entry = std::make_unique<AliasEntry>(source, target);
+            const std::wstring_view key{ entry->source };
+            exe->aliases.emplace(key, std::move(entry));
+        }
+    }
+}
 
 // Routine Description:
 // - Adds a command line alias to the global set.
@@ -108,16 +233,15 @@ std::unordered_map<std::wstring,
         if (targetString.size() == 0)
         {
             // Only try to dig in and erase if the exeName exists.
-            auto exeData = g_aliasData.find(exeNameString);
-            if (exeData != g_aliasData.end())
+            const auto exe = FindExe(exeNameString);
+            if (exe != nullptr)
             {
-                g_aliasData[exeNameString].erase(sourceString);
+                exe->aliases.erase(sourceString);
             }
         }
         else
         {
-            // Map will auto-create each level as necessary
-            g_aliasData[exeNameString][sourceString] = targetString;
+            SetAlias(exeNameString, sourceString, targetString);
         }
     }
     CATCH_RETURN();
@@ -152,17 +276,10 @@ std::unordered_map<std::wstring,
         target.value().at(0) = UNICODE_NULL;
     }
 
-    std::wstring exeNameString(exeName);
-    std::wstring sourceString(source);
-
     // For compatibility, return ERROR_GEN_FAILURE for any result where the alias can't be found.
-    // We use .find for the iterators then dereference to search without creating entries.
-    const auto exeIter = g_aliasData.find(exeNameString);
-    RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), exeIter == g_aliasData.end());
-    const auto exeData = exeIter->second;
-    const auto sourceIter = exeData.find(sourceString);
-    RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), sourceIter == exeData.end());
-    const auto targetString = sourceIter->second;
+    const auto alias = FindAlias(exeName, source);
+    RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), alias == nullptr);
+    const auto& targetString = alias->target;
     RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_GEN_FAILURE), targetString.size() == 0);
 
     // TargetLength is a byte count, convert to characters.
@@ -318,8 +435,6 @@ static std::wstring aliasesSeparator(L"=");
 
     try
     {
-        const std::wstring exeNameString(exeName);
-
         size_t cchNeeded = 0;
 
         // Each of the aliases will be made up of the source, a separator, the target, then a null character.
@@ -333,21 +448,20 @@ static std::wstring aliasesSeparator(L"=");
         }
 
         // Find without creating.
-        auto exeIter = g_aliasData.find(exeNameString);
-        if (exeIter != g_aliasData.end())
+        const auto exe = FindExe(exeName);
+        if (exe != nullptr)
         {
-            auto list = exeIter->second;
-            for (auto& pair : list)
+            for (const auto& pair : exe->aliases)
             {
                 // Alias stores lengths in bytes.
                 size_t cchSource = pair.first.size();
-                size_t cchTarget = pair.second.size();
+                size_t cchTarget = pair.second->target.size();
 
                 // If we're counting how much multibyte space will be needed, trial convert the source and target strings before we add.
                 if (!countInUnicode)
                 {
                     cchSource = GetALengthFromW(codepage, pair.first);
-                    cchTarget = GetALengthFromW(codepage, pair.second);
+                    cchTarget = GetALengthFromW(codepage, pair.second->target);
                 }
 
                 // Accumulate all sizes to the final string count.
@@ -421,10 +535,10 @@ static std::wstring aliasesSeparator(L"=");
 void Alias::s_ClearCmdExeAliases()
 {
     // find without creating.
-    auto exeIter = g_aliasData.find(L"cmd.exe");
-    if (exeIter != g_aliasData.end())
+    const auto exe = FindExe(L"cmd.exe");
+    if (exe != nullptr)
     {
-        exeIter->second.clear();
+        exe->aliases.clear();
     }
 }
 
@@ -454,8 +568,6 @@ void Alias::s_ClearCmdExeAliases()
         aliasBuffer.value().at(0) = UNICODE_NULL;
     }
 
-    std::wstring exeNameString(exeName);
-
     LPWSTR AliasesBufferPtrW = aliasBuffer.has_value() ? aliasBuffer.value().data() : nullptr;
     size_t cchTotalLength = 0; // accumulate the characters we need/have copied as we walk the list
 
@@ -464,15 +576,16 @@ void Alias::s_ClearCmdExeAliases()
     size_t const cchNull = 1;
 
     // Find without creating.
-    auto exeIter = g_aliasData.find(exeNameString);
-    if (exeIter != g_aliasData.end())
+    const auto exe = FindExe(exeName);
+    if (exe != nullptr)
     {
-        auto list = exeIter->second;
-        for (auto& pair : list)
+        for (const auto& pair : exe->aliases)
         {
+            const auto& target = pair.second->target;
+
             // Alias stores lengths in bytes.
             size_t const cchSource = pair.first.size();
-            size_t const cchTarget = pair.second.size();
+            size_t const cchTarget = target.size();
 
             // Add up how many characters we will need for the full alias data.
             size_t cchNeeded = 0;
@@ -502,7 +615,7 @@ void Alias::s_ClearCmdExeAliases()
                 RETURN_IF_FAILED(SizeTSub(cchAliasBufferRemaining, aliasesSeparator.size(), &cchAliasBufferRemaining));
                 AliasesBufferPtrW += aliasesSeparator.size();
 
-                RETURN_IF_FAILED(StringCchCopyNW(AliasesBufferPtrW, cchAliasBufferRemaining, pair.second.data(), cchTarget));
+                RETURN_IF_FAILED(StringCchCopyNW(AliasesBufferPtrW, cchAliasBufferRemaining, target.data(), cchTarget));
                 RETURN_IF_FAILED(SizeTSub(cchAliasBufferRemaining, cchTarget, &cchAliasBufferRemaining));
                 AliasesBufferPtrW += cchTarget;
 
@@ -821,314 +934,187 @@ void Alias::s_ClearCmdExeAliases()
 }
 
 // Routine Description:
-// - Trims leading spaces off of a string
+// - Compiles an alias target into the text and substitutions it expands to.
+//   $1-$9 and $* take arguments from the command, $L, $G and $B become <, > and |,
+//   $T separates commands, and any other $ sequence is kept as written.
 // Arguments:
-// - str - String to trim
-void Alias::s_TrimLeadingSpaces(std::wstring& str)
+// - target - The target text of the alias, possibly containing $ macros.
+AliasExpansion::AliasExpansion(const std::wstring_view target) :
+    _text{},
+    _pieces{},
+    _lineCount{ 0 }
 {
-    // Erase from the beginning of the string up until the first
-    // character found that is not a space.
-    str.erase(str.begin(),
-              std::find_if(str.begin(), str.end(), [](wchar_t ch) { return !std::iswspace(ch); }));
-}
+    _text.reserve(target.size());
 
-// Routine Description:
-// - Trims trailing \r\n off of a string
-// Arguments:
-// - str - String to trim
-void Alias::s_TrimTrailingCrLf(std::wstring& str)
-{
-    const auto trailingCrLfPos = str.find_last_of(UNICODE_CARRIAGERETURN);
-    if (std::wstring::npos != trailingCrLfPos)
+    for (size_t i = 0; i < target.size(); ++i)
     {
-        str.erase(trailingCrLfPos);
-    }
-}
-
-// Routine Description:
-// - Tokenizes a string into a collection using space as a separator
-// Arguments:
-// - str - String to tokenize
-// Return Value:
-// - Collection of tokenized strings
-std::deque<std::wstring> Alias::s_Tokenize(const std::wstring& str)
-{
-    std::deque<std::wstring> result;
-
-    size_t prevIndex = 0;
-    auto spaceIndex = str.find(L' ');
-    while (std::wstring::npos != spaceIndex)
-    {
-        const auto length = spaceIndex - prevIndex;
-
-        result.emplace_back(str.substr(prevIndex, length));
-
-        spaceIndex++;
-        prevIndex = spaceIndex;
-
-        spaceIndex = str.find(L' ', spaceIndex);
-    }
-
-    // Place the final one into the set.
-    result.emplace_back(str.substr(prevIndex));
-
-    return result;
-}
-
-// Routine Description:
-// - Gets just the arguments portion of the command string
-//   Specifically, all text after the first space character.
-// Arguments:
-// - str - String to split into just args
-// Return Value:
-// - Only the arguments part of the string or empty if there are no arguments.
-std::wstring Alias::s_GetArgString(const std::wstring& str)
-{
-    std::wstring result;
-    auto firstSpace = str.find_first_of(L' ');
-    if (std::wstring::npos != firstSpace)
-    {
-        firstSpace++;
-        if (firstSpace < str.size())
+        const auto ch = target[i];
+        if (L'$' != ch || i + 1 >= target.size())
         {
-            result = str.substr(firstSpace);
+            // Plain text, or a $ with nothing after it.
+            _AppendText({ &target[i], 1 });
+            continue;
         }
-    }
-
-    return result;
-}
 
-// Routine Description:
-// - Checks the given character to see if it is a numbered arg replacement macro
-//   and replaces it with the counted argument if there is a match
-// Arguments:
-// - ch - Character to test as a macro
-// - appendToStr - Append the macro result here if it matched
-// - tokens - Tokens of the original command string. 0 is alias. 1-N are arguments.
-// Return Value:
-// - True if we found the macro and appended to the string.
-// - False if the given character doesn't match this macro.
-bool Alias::s_TryReplaceNumberedArgMacro(const wchar_t ch,
-                                         std::wstring& appendToStr,
-                                         const std::deque<std::wstring>& tokens)
-{
-    if (ch >= L'1' && ch <= L'9')
-    {
-        // Numerical macros substitute that numbered argument
-        const size_t index = ch - L'0';
-
-        if (index < tokens.size() && index > 0)
+        // Read ahead by one character, and consume it.
+        const auto chNext = target[++i];
+        if (chNext >= L'1' && chNext <= L'9')
         {
-            appendToStr.append(tokens[index]);
+            _pieces.push_back({ Piece::Kind::Argument, gsl::narrow_cast<size_t>(chNext - L'0'), 0 });
+        }
+        else if (L'*' == chNext)
+        {
+            _pieces.push_back({ Piece::Kind::AllArguments, 0, 0 });
+        }
+        else if (L'L' == towupper(chNext))
+        {
+            _AppendText(L"<");
+        }
+        else if (L'G' == towupper(chNext))
+        {
+            _AppendText(L">");
+        }
+        else if (L'B' == towupper(chNext))
+        {
+            _AppendText(L"|");
+        }
+        else if (L'T' == towupper(chNext))
+        {
+            _pieces.push_back({ Piece::Kind::NewLine, 0, 0 });
+            _lineCount++;
+        }
+        else
+        {
+            // If nothing matches, just keep these two characters.
+            _AppendText({ &target[i - 1], 2 });
         }
-
-        return true;
-    }
-
-    return false;
-}
-
-// Routine Description:
-// - Checks the given character to see if it is a wildcard arg replacement macro
-//   and replaces it with the entire argument string if there is a match
-// Arguments:
-// - ch - Character to test as a macro
-// - appendToStr - Append the macro result here if it matched
-// - fullArgString - All of the arguments as one big string.
-// Return Value:
-// - True if we found the macro and appended to the string.
-// - False if the given character doesn't match this macro.
-bool Alias::s_TryReplaceWildcardArgMacro(const wchar_t ch,
-                                         std::wstring& appendToStr,
-                                         const std::wstring fullArgString)
-{
-    if (L'*' == ch)
-    {
-        // Wildcard substitutes all arguments
-        appendToStr.append(fullArgString);
-        return true;
-    }
-
-    return false;
-}
-
-// Routine Description:
-// - Checks the given character to see if it is an input redirection macro
-//   and replaces it with the < redirector if there is a match
-// Arguments:
-// - ch - Character to test as a macro
-// - appendToStr - Append the macro result here if it matched
-// Return Value:
-// - True if we found the macro and appended to the string.
-// - False if the given character doesn't match this macro.
-bool Alias::s_TryReplaceInputRedirMacro(const wchar_t ch,
-                                        std::wstring& appendToStr)
-{
-    if (L'L' == towupper(ch))
-    {
-        // L (either case) replaces with input redirector <
-        appendToStr.push_back(L'<');
-        return true;
-    }
-    return false;
-}
-
-// Routine Description:
-// - Checks the given character to see if it is an output redirection macro
-//   and replaces it with the > redirector if there is a match
-// Arguments:
-// - ch - Character to test as a macro
-// - appendToStr - Append the macro result here if it matched
-// Return Value:
-// - True if we found the macro and appended to the string.
-// - False if the given character doesn't match this macro.
-bool Alias::s_TryReplaceOutputRedirMacro(const wchar_t ch,
-                                         std::wstring& appendToStr)
-{
-    if (L'G' == towupper(ch))
-    {
-        // G (either case) replaces with output redirector >
-        appendToStr.push_back(L'>');
-        return true;
     }
-    return false;
-}
 
-// Routine Description:
-// - Checks the given character to see if it is a pipe redirection macro
-//   and replaces it with the | redirector if there is a match
-// Arguments:
-// - ch - Character to test as a macro
-// - appendToStr - Append the macro result here if it matched
-// Return Value:
-// - True if we found the macro and appended to the string.
-// - False if the given character doesn't match this macro.
-bool Alias::s_TryReplacePipeRedirMacro(const wchar_t ch,
-                                       std::wstring& appendToStr)
-{
-    if (L'B' == towupper(ch))
-    {
-        // B (either case) replaces with pipe operator |
-        appendToStr.push_back(L'|');
-        return true;
-    }
-    return false;
+    // We always terminate with a CRLF to symbolize end of command.
+    _pieces.push_back({ Piece::Kind::NewLine, 0, 0 });
+    _lineCount++;
 }
 
 // Routine Description:
-// - Checks the given character to see if it is a next command macro
-//   and replaces it with CRLF if there is a match
-// Arguments:
-// - ch - Character to test as a macro
-// - appendToStr - Append the macro result here if it matched
-// - lineCount - Updates the rolling count of lines if we add a CRLF.
-// Return Value:
-// - True if we found the macro and appended to the string.
-// - False if the given character doesn't match this macro.
-bool Alias::s_TryReplaceNextCommandMacro(const wchar_t ch,
-                                         std::wstring& appendToStr,
-                                         size_t& lineCount)
+// - Adds literal text to the expansion, extending the previous piece if it
+//   was also text.
+void AliasExpansion::_AppendText(const std::wstring_view text)
 {
-    if (L'T' == towupper(ch))
+    if (_pieces.empty() || _pieces.back().kind != Piece::Kind::Text)
     {
-        // T (either case) inserts a CRLF to chain commands
-        s_AppendCrLf(appendToStr, lineCount);
-        return true;
+        _pieces.push_back({ Piece::Kind::Text, _text.size(), 0 });
     }
-    return false;
+    _text.append(text);
+    _pieces.back().length += text.size();
 }
 
 // Routine Description:
-// - Appends the system line feed (CRLF) to the given string
-// Arguments:
-// - appendToStr - Append the system line feed here
-// - lineCount - Updates the rolling count of lines if we add a CRLF.
-void Alias::s_AppendCrLf(std::wstring& appendToStr,
-                         size_t& lineCount)
+// - Gets the number of commands the expansion produces (CRLFs in it).
+size_t AliasExpansion::LineCount() const noexcept
 {
-    appendToStr.push_back(L'\r');
-    appendToStr.push_back(L'\n');
-    lineCount++;
+    return _lineCount;
 }
 
 // Routine Description:
-// - Searches through the given string for macros and replaces them
-//   with the matching action
+// - Expands the alias for the given command line.
 // Arguments:
-// - str - On input, the string to search. On output, the string is replaced.
-// - tokens - The tokenized command line input. 0 is the alias, 1-N are arguments.
-// - fullArgString - Shorthand to 1-N argument string in case of wildcard match.
-// Return Value:
-// - The number of commands in the final string (line feeds, CRLFs)
-size_t Alias::s_ReplaceMacros(std::wstring& str,
-                              const std::deque<std::wstring>& tokens,
-                              const std::wstring& fullArgString)
+// - command - The trimmed command line. Its first space-separated token is
+//   the alias itself, the rest are the arguments.
+// - expanded - The expansion is appended here.
+void AliasExpansion::Expand(const std::wstring_view command, std::wstring& expanded) const
 {
-    size_t lineCount = 0;
-    std::wstring finalText;
+    // Everything after the first space, for $*.
+    const auto firstSpace = command.find(L' ');
+    const auto allArguments = firstSpace == std::wstring_view::npos ? std::wstring_view{} : command.substr(firstSpace + 1);
 
-    // The target text may contain substitution macros indicated by $.
-    // Walk through and substitute them as appropriate.
-    for (auto ch = str.cbegin(); ch < str.cend(); ch++)
+    for (const auto& piece : _pieces)
     {
-        if (L'$' == *ch)
+        switch (piece.kind)
         {
-            // Attempt to read ahead by one character.
-            const auto chNext = ch + 1;
-
-            if (chNext < str.cend())
+        case Piece::Kind::Text:
+            expanded.append(_text, piece.offset, piece.length);
+            break;
+        case Piece::Kind::Argument:
+        {
+            // Walk to the numbered token. Arguments are separated by single spaces.
+            auto remaining = command;
+            auto found = true;
+            for (size_t n = 0; n < piece.offset; ++n)
             {
-                auto isProcessed = s_TryReplaceNumberedArgMacro(*chNext, finalText, tokens);
-                if (!isProcessed)
-                {
-                    isProcessed = s_TryReplaceWildcardArgMacro(*chNext, finalText, fullArgString);
-                }
-                if (!isProcessed)
-                {
-                    isProcessed = s_TryReplaceInputRedirMacro(*chNext, finalText);
-                }
-                if (!isProcessed)
-                {
-                    isProcessed = s_TryReplaceOutputRedirMacro(*chNext, finalText);
-                }
-                if (!isProcessed)
-                {
-                    isProcessed = s_TryReplacePipeRedirMacro(*chNext, finalText);
-                }
-                if (!isProcessed)
+                const auto space = remaining.find(L' ');
+                if (space == std::wstring_view::npos)
                 {
-                    isProcessed = s_TryReplaceNextCommandMacro(*chNext, finalText, lineCount);
+                    found = false;
+                    break;
                 }
-                if (!isProcessed)
-                {
-                    // If nothing matches, just push these two characters in.
-                    finalText.push_back(*ch);
-                    finalText.push_back(*chNext);
-                }
-
-                // Since we read ahead and used that character,
-                // advance the iterator one extra to compensate.
-                ch++;
+                remaining.remove_prefix(space + 1);
             }
-            else
+
+            if (found)
             {
-                // If no read-ahead, just push this character and be done.
-                finalText.push_back(*ch);
+                expanded.append(remaining.substr(0, remaining.find(L' ')));
             }
+            break;
         }
-        else
-        {
-            // If it didn't match the macro specifier $, push the character.
-            finalText.push_back(*ch);
+        case Piece::Kind::AllArguments:
+            expanded.append(allArguments);
+            break;
+        case Piece::Kind::NewLine:
+            expanded.push_back(L'\r');
+            expanded.push_back(L'\n');
+            break;
         }
     }
+}
 
-    // We always terminate with a CRLF to symbolize end of command.
-    s_AppendCrLf(finalText, lineCount);
+namespace
+{
+    // Routine Description:
+    // - Takes the source text and searches it for an alias belonging to exe name's list,
+    //   without copying the source text, the aliases or the alias target.
+    // Arguments:
+    // - sourceText - The string to search for an alias
+    // - exeName - The name of the EXE that has aliases associated
+    // - expanded - If an alias matched, its expansion is appended here.
+    // - lineCount - If an alias matched, the number of lines in the expansion.
+    // Return Value:
+    // - True if we found a matching alias and expanded it.
+    bool ExpandAlias(std::wstring_view sourceText,
+                     const std::wstring_view exeName,
+                     std::wstring& expanded,
+                     size_t& lineCount)
+    {
+        // Check if we have an EXE in the list that matches the request first.
+        const auto exe = FindExe(exeName);
+        if (exe == nullptr || exe->aliases.empty())
+        {
+            return false;
+        }
+
+        // Trim trailing \r\n off of the source text if it has one.
+        const auto trailingCrLfPos = sourceText.find_last_of(UNICODE_CARRIAGERETURN);
+        if (std::wstring_view::npos != trailingCrLfPos)
+        {
+            sourceText = sourceText.substr(0, trailingCrLfPos);
+        }
 
-    // Give back the final text and count.
-    str.swap(finalText);
-    return lineCount;
+        // Trim leading spaces off of the source text if it has any.
+        const auto firstNonSpace = std::find_if(sourceText.cbegin(), sourceText.cend(), [](wchar_t ch) { return !std::iswspace(ch); });
+        sourceText.remove_prefix(firstNonSpace - sourceText.cbegin());
+
+        // The alias is the first space-separated token.
+        const auto alias = sourceText.substr(0, sourceText.find(L' '));
+        const auto aliasIter = exe->aliases.find(alias);
+        if (aliasIter == exe->aliases.end() || aliasIter->second->target.empty())
+        {
+            return false;
+        }
+
+        const auto& expansion = aliasIter->second->expansion;
+        expansion.Expand(sourceText, expanded);
+        lineCount = expansion.LineCount();
+        return true;
+    }
 }
 
 // Routine Description:
@@ -1145,61 +1131,9 @@ std::wstring Alias::s_MatchAndCopyAlias(const std::wstring& sourceText,
                                         const std::wstring& exeName,
                                         size_t& lineCount)
 {
-    // Copy source text into a local for manipulation.
-    std::wstring sourceCopy(sourceText);
-
-    // Trim trailing \r\n off of sourceCopy if it has one.
-    s_TrimTrailingCrLf(sourceCopy);
-
-    // Trim leading spaces off of sourceCopy if it has any.
-    s_TrimLeadingSpaces(sourceCopy);
-
-    // Check if we have an EXE in the list that matches the request first.
-    auto exeIter = g_aliasData.find(exeName);
-    if (exeIter == g_aliasData.end())
-    {
-        // We found no data for this exe. Give back an empty string.
-        return std::wstring();
-    }
-
-    auto exeList = exeIter->second;
-    if (exeList.size() == 0)
-    {
-        // If there's no match, give back an empty string.
-        return std::wstring();
-    }
-
-    // Tokenize the text by spaces
-    const auto tokens = s_Tokenize(sourceCopy);
-
-    // If there are no tokens, return an empty string
-    if (tokens.size() == 0)
-    {
-        return std::wstring();
-    }
-
-    // Find alias. If there isn't one, return an empty string
-    const auto alias = tokens.front();
-    const auto aliasIter = exeList.find(alias);
-    if (aliasIter == exeList.end())
-    {
-        // We found no alias pair with this name. Give back an empty string.
-        return std::wstring();
-    }
-
-    const auto target = aliasIter->second;
-    if (target.size() == 0)
-    {
-        return std::wstring();
-    }
-
-    // Get the string of all parameters as a shorthand for $* later.
-    const auto allParams = s_GetArgString(sourceCopy);
-
-    // The final text will be the target but with macros replaced.
-    std::wstring finalText(target);
-    lineCount = s_ReplaceMacros(finalText, tokens, allParams);
-
+    // If there's no match, this gives back an empty string.
+    std::wstring finalText;
+    ExpandAlias(sourceText, exeName, finalText, lineCount);
     return finalText;
 }
 
@@ -1216,6 +1150,9 @@ std::wstring Alias::s_MatchAndCopyAlias(const std::wstring& sourceText,
 // - LineCount - aliases can contain multiple commands.  $T is the command separator
 // Return Value:
 // - None. It will just maintain the source as the target if we can't match an alias.
+// Note:
+// - pwchSource and pwchTarget may be the same buffer, so the expansion is built
+//   in a separate string first.
 void Alias::s_MatchAndCopyAliasLegacy(_In_reads_bytes_(cbSource) PWCHAR pwchSource,
                                       _In_ size_t cbSource,
                                       _Out_writes_bytes_(cbTargetWritten) PWCHAR pwchTarget,
@@ -1226,13 +1163,13 @@ void Alias::s_MatchAndCopyAliasLegacy(_In_reads_bytes_(cbSource) PWCHAR pwchSour
 {
     try
     {
-        std::wstring sourceText(pwchSource, cbSource / sizeof(WCHAR));
-        size_t lineCount = lines;
+        std::wstring targetText;
 
-        const auto targetText = s_MatchAndCopyAlias(sourceText, exeName, lineCount);
+        const std::wstring_view sourceText{ pwchSource, cbSource / sizeof(WCHAR) };
+        size_t lineCount = lines;
 
         // Only return data if the reply was non-empty (we had a match).
-        if (!targetText.empty())
+        if (ExpandAlias(sourceText, exeName, targetText, lineCount) && !targetText.empty())
         {
             const auto cchTargetSize = cbTargetSize / sizeof(wchar_t);
 
@@ -1261,7 +1198,7 @@ void Alias::s_TestAddAlias(std::wstring& exe,
                            std::wstring& alias,
                            std::wstring& target)
 {
-    g_aliasData[exe][alias] = target;
+    SetAlias(exe, alias, target);
 }
 
 void Alias::s_TestClearAliases()
@@ -93,14 +93,9 @@ bool IsValidStringBuffer(_In_ bool Unicode, _In_reads_bytes_(Size) PVOID Buffer,
 // - Detects Word delimiters
 bool IsWordDelim(const wchar_t wch)
 {
-    // the space character is always a word delimiter. Do not add it to the WordDelimiters global because
-    // that contains the user configurable word delimiters only.
-    if (wch == UNICODE_SPACE)
-    {
-        return true;
-    }
-    const auto& delimiters = ServiceLocator::LocateGlobals().WordDelimiters;
-    return std::find(delimiters.begin(), delimiters.end(), wch) != delimiters.end();
+    // the space character is always a word delimiter. The WordDelimiters table
+    // knows that, so it's a single lookup either way.
+    return ServiceLocator::LocateGlobals().WordDelimiters.IsDelimiter(wch);
 }
 
 bool IsWordDelim(const std::wstring_view charData)
@@ -1063,12 +1058,6 @@ COORD CommandLine::DeleteFromRightOfCursor(COOKED_READ_DATA& cookedReadData) noe
 
     if (!cookedReadData.AtEol())
     {
-        // Delete commandline.
-        // clang-format off
-#pragma prefast(suppress: __WARNING_BUFFER_OVERFLOW, "Not sure why prefast is getting confused here")
-        // clang-format on
-        DeleteCommandLine(cookedReadData, false);
-
         // Delete char.
         cookedReadData.BytesRead() -= sizeof(WCHAR);
         memmove(cookedReadData.BufferCurrentPtr(),
@@ -1080,18 +1069,13 @@ COORD CommandLine::DeleteFromRightOfCursor(COOKED_READ_DATA& cookedReadData) noe
             *buf = (WCHAR)' ';
         }
 
-        // Write commandline.
+        // Write the part of the commandline that moved.
         if (cookedReadData.IsEchoInput())
         {
-            FAIL_FAST_IF_NTSTATUS_FAILED(WriteCharsLegacy(cookedReadData.ScreenInfo(),
-                                                          cookedReadData.BufferStartPtr(),
-                                                          cookedReadData.BufferStartPtr(),
-                                                          cookedReadData.BufferStartPtr(),
-                                                          &cookedReadData.BytesRead(),
-                                                          &cookedReadData.VisibleCharCount(),
-                                                          cookedReadData.OriginalCursorPosition().X,
-                                                          WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_ECHO,
-                                                          nullptr));
+            FAIL_FAST_IF_NTSTATUS_FAILED(cookedReadData.RedrawLineFrom(cookedReadData.InsertionPoint(),
+                                                                       cursorPosition,
+                                                                       WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_ECHO,
+                                                                       nullptr));
         }
 
         // restore cursor position
@@ -441,6 +441,22 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
     return _WriteConsoleInputWImplHelper(*pInputBuffer, events, eventsWritten, append);
 }
 
+// Routine Description:
+// - Writes text to the end of the input buffer, as if it was typed (private call)
+// Arguments:
+// - pInputBuffer - the input buffer to write to
+// - text - the text to write
+// - charsWritten - on output, the number of characters written
+// Return Value:
+// - HRESULT indicating success or failure
+[[nodiscard]] HRESULT DoSrvPrivateWriteConsoleInputString(_Inout_ InputBuffer* const pInputBuffer,
+                                                          const std::wstring_view text,
+                                                          _Out_ size_t& charsWritten) noexcept
+{
+    charsWritten = pInputBuffer->WriteString(text);
+    return S_OK;
+}
+
 // Routine Description:
 // - Writes events to the input buffer, translating from codepage to unicode first
 // Arguments:
@@ -841,41 +857,31 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
         // We will start reading the buffer at the point of the top left corner (origin) of the (potentially adjusted) request
         const auto sourcePoint = clippedRequestRectangle.Origin();
 
-        // Get an iterator to the beginning of the return buffer
-        // We might have to seek this forward or skip around if we clipped the request.
-        auto targetIter = targetBuffer.begin();
-        COORD targetPos = { 0 };
-        const auto targetLimit = Viewport::FromDimensions(targetPoint, clippedRequestRectangle.Dimensions());
-
-        // Get an iterator to the beginning of the request inside the screen buffer
-        // This should walk exactly along every cell of the clipped request.
-        auto sourceIter = storageBuffer.GetCellDataAt(sourcePoint, clippedRequestRectangle);
-
-        // Walk through every cell of the target, advancing the buffer.
-        // Validate that we always still have a valid iterator to the backing store,
-        // that we always are writing inside the user's buffer (before the end)
-        // and we're always targeting the user's buffer inside its original bounds.
-        while (sourceIter && targetIter < targetBuffer.end())
-        {
-            // If the point we're trying to write is inside the limited buffer write zone...
-            if (targetLimit.IsInBounds(targetPos))
-            {
-                // Copy the data into position...
-                *targetIter = gci.AsCharInfo(*sourceIter);
-                // ... and advance the read iterator.
-                sourceIter++;
-            }
+        // Copy the clipped request out of the backing buffer one row at a time, straight into
+        // the matching part of each line of the user's buffer. Cells we clipped are left untouched.
+        const auto& textBuffer = storageBuffer.GetTextBuffer();
+        const std::function<WORD(const TextAttribute&)> generateLegacyAttributes = [&gci](const TextAttribute& attr) {
+            return gci.GenerateLegacyAttributes(attr);
+        };
 
-            // Always advance the write iterator, we might have skipped it due to clipping.
-            targetIter++;
+        const auto width = clippedRequestRectangle.Width();
+        const auto height = clippedRequestRectangle.Height();
+        for (SHORT row = 0; width > 0 && row < height; row++)
+        {
+            // We find the offset into the user's buffer by the dimensions of the original request rectangle.
+            ptrdiff_t targetOffset = 0;
+            RETURN_IF_FAILED(PtrdiffTMult(targetPoint.Y + row, targetSize.X, &targetOffset));
+            RETURN_IF_FAILED(PtrdiffTAdd(targetOffset, targetPoint.X, &targetOffset));
 
-            // Increment the target
-            targetPos.X++;
-            if (targetPos.X >= targetSize.X)
+            // The user's buffer is allowed to be smaller than the request. Stop where it ends.
+            if (targetOffset >= targetBuffer.size())
             {
-                targetPos.X = 0;
-                targetPos.Y++;
+                break;
             }
+            const auto count = std::min<ptrdiff_t>(width, targetBuffer.size() - targetOffset);
+
+            const auto& sourceRow = textBuffer.GetRowByOffset(sourcePoint.Y + row);
+            sourceRow.ReadCharInfos(sourcePoint.X, targetBuffer.subspan(targetOffset, count), generateLegacyAttributes);
         }
 
         // Reply with the region we read out of the backing buffer (potentially clipped)
@@ -1022,12 +1028,8 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
             // Now we make a subspan starting from that offset for as much of the original request as would fit
             const auto subspan = buffer.subspan(totalOffset, writeRectangle.Width());
 
-            // Convert to a CHAR_INFO view to fit into the iterator
-            const auto charInfos = std::basic_string_view<CHAR_INFO>(subspan.data(), subspan.size());
-
-            // Make the iterator and write to the target position.
-            OutputCellIterator it(charInfos);
-            storageBuffer.Write(it, target);
+            // Write the cells straight into the rows at the target position.
+            storageBuffer.GetTextBuffer().WriteCharInfos(subspan, target);
         }
 
         // Since we've managed to write part of the request, return the clamped part that we actually used.
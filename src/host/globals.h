@@ -29,6 +29,8 @@ Revision History:
 
 #include "..\server\DeviceComm.h"
 
+#include "..\types\inc\DelimiterClassTable.hpp"
+
 #include <TraceLoggingProvider.h>
 #include <winmeta.h>
 TRACELOGGING_DECLARE_PROVIDER(g_hConhostV2EventTraceProvider);
@@ -59,7 +61,8 @@ public:
     wil::unique_event_nothrow hConsoleInputInitEvent;
     DWORD dwInputThreadId;
 
-    std::vector<wchar_t> WordDelimiters;
+    // The user configurable word delimiters, plus the space.
+    Microsoft::Console::Types::DelimiterClassTable WordDelimiters;
 
     Microsoft::Console::Render::IRenderer* pRender;
 
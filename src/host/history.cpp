@@ -31,16 +31,27 @@ using Microsoft::Console::Interactivity::ServiceLocator;
 // If CommandHistory::s_Allocate and friends stop shuffling elements
 // for maintaining LRU, then this datatype can be changed.
 std::list<CommandHistory> CommandHistory::s_historyLists;
+unsigned long long CommandHistory::s_lruClock = 0;
+
+// These hold iterators into s_historyLists, which stay valid while elements
+// are spliced around it.
+std::unordered_map<HANDLE, CommandHistory::HistoryIterator> CommandHistory::s_byProcessHandle;
+std::unordered_multimap<std::wstring, CommandHistory::HistoryIterator> CommandHistory::s_byAppName;
+
+static std::wstring FoldCase(const std::wstring_view text)
+{
+    std::wstring folded(text);
+    std::transform(folded.begin(), folded.end(), folded.begin(), ::towlower);
+    return folded;
+}
 
 CommandHistory* CommandHistory::s_Find(const HANDLE processHandle)
 {
-    for (auto& historyList : s_historyLists)
+    const auto found = s_byProcessHandle.find(processHandle);
+    if (found != s_byProcessHandle.end())
     {
-        if (historyList._processHandle == processHandle)
-        {
-            FAIL_FAST_IF(WI_IsFlagClear(historyList.Flags, CLE_ALLOCATED));
-            return &historyList;
-        }
+        FAIL_FAST_IF(WI_IsFlagClear(found->second->Flags, CLE_ALLOCATED));
+        return &*found->second;
     }
 
     return nullptr;
@@ -57,6 +68,7 @@ void CommandHistory::s_Free(const HANDLE processHandle)
     {
         WI_ClearFlag(History->Flags, CLE_ALLOCATED);
         History->_processHandle = nullptr;
+        s_byProcessHandle.erase(processHandle);
     }
 }
 
@@ -77,6 +89,30 @@ static bool CaseInsensitiveEquality(wchar_t a, wchar_t b)
     return ::towlower(a) == ::towlower(b);
 }
 
+// Routine Description:
+// - Compares two strings the same way CaseInsensitiveEquality matches them.
+// Return Value:
+// - Less than, equal to or greater than zero as a sorts before, the same as or after b.
+static int CaseInsensitiveCompare(const std::wstring_view a, const std::wstring_view b) noexcept
+{
+    const size_t length = std::min(a.size(), b.size());
+    for (size_t i = 0; i < length; i++)
+    {
+        const wint_t lowerA = ::towlower(a[i]);
+        const wint_t lowerB = ::towlower(b[i]);
+        if (lowerA != lowerB)
+        {
+            return lowerA < lowerB ? -1 : 1;
+        }
+    }
+
+    if (a.size() == b.size())
+    {
+        return 0;
+    }
+    return a.size() < b.size() ? -1 : 1;
+}
+
 bool CommandHistory::IsAppNameMatch(const std::wstring_view other) const
 {
     return std::equal(_appName.cbegin(), _appName.cend(), other.cbegin(), other.cend(), CaseInsensitiveEquality);
@@ -124,6 +160,7 @@ void CommandHistory::_Reset()
             // find free record.  if all records are used, free the lru one.
             if ((SHORT)_commands.size() == _maxCommands)
             {
+                _IndexErase(0);
                 _commands.erase(_commands.cbegin());
                 // move LastDisplayed back one in order to stay synced with the
                 // command it referred to before erasing the lru one
@@ -139,6 +176,7 @@ void CommandHistory::_Reset()
             {
                 _commands.emplace_back(newCommand);
             }
+            _IndexInsert(gsl::narrow<SHORT>(_commands.size() - 1));
 
             if (LastDisplayed == -1 ||
                 _commands.at(LastDisplayed).size() != newCommand.size() ||
@@ -249,6 +287,7 @@ std::wstring_view CommandHistory::GetLastCommand() const
 void CommandHistory::Empty()
 {
     _commands.clear();
+    _index.clear();
     LastDisplayed = -1;
     Flags = CLE_RESET;
 }
@@ -290,6 +329,7 @@ void CommandHistory::Realloc(const size_t commands)
     {
         _commands.emplace_back(oldCommands[i]);
     }
+    _IndexRebuild();
 
     WI_SetFlag(Flags, CLE_RESET);
     LastDisplayed = gsl::narrow<SHORT>(_commands.size()) - 1;
@@ -298,31 +338,69 @@ void CommandHistory::Realloc(const size_t commands)
 
 void CommandHistory::s_ReallocExeToFront(const std::wstring_view appName, const size_t commands)
 {
-    for (auto it = s_historyLists.begin(); it != s_historyLists.end(); it++)
+    const auto found = s_FindMostRecentByExe(appName, true);
+    if (found.has_value())
     {
-        if (WI_IsFlagSet(it->Flags, CLE_ALLOCATED) && it->IsAppNameMatch(appName))
-        {
-            CommandHistory backup = *it;
-            backup.Realloc(commands);
+        found.value()->Realloc(commands);
+        s_MoveToFront(found.value());
+    }
+}
 
-            s_historyLists.erase(it);
-            s_historyLists.push_front(backup);
+CommandHistory* CommandHistory::s_FindByExe(const std::wstring_view appName)
+{
+    const auto found = s_FindMostRecentByExe(appName, true);
+    return found.has_value() ? &*found.value() : nullptr;
+}
 
-            return;
+// Routine Description:
+// - Finds the history for the given app name that was most recently moved to
+//   the front of the list, which is the one a walk of the list would find first.
+// Arguments:
+// - appName - the app name to look for. Compared case insensitively.
+// - allocated - whether to look for a history that is in use, or one that is free.
+// Return Value:
+// - The history, if there is one.
+std::optional<CommandHistory::HistoryIterator> CommandHistory::s_FindMostRecentByExe(const std::wstring_view appName,
+                                                                                     const bool allocated)
+{
+    std::optional<HistoryIterator> best;
+    const auto range = s_byAppName.equal_range(FoldCase(appName));
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        const auto history = it->second;
+        if (WI_IsFlagSet(history->Flags, CLE_ALLOCATED) == allocated &&
+            (!best.has_value() || history->_lruStamp > best.value()->_lruStamp))
+        {
+            best = history;
         }
     }
+    return best;
 }
 
-CommandHistory* CommandHistory::s_FindByExe(const std::wstring_view appName)
+// Routine Description:
+// - Moves a history to the front of the list, marking it most recently used.
+void CommandHistory::s_MoveToFront(const HistoryIterator it)
 {
-    for (auto& historyList : s_historyLists)
+    s_historyLists.splice(s_historyLists.begin(), s_historyLists, it);
+    it->_lruStamp = ++s_lruClock;
+}
+
+// Routine Description:
+// - Changes the app name of a history, keeping the lookup by name in step.
+void CommandHistory::s_SetAppName(const HistoryIterator it, const std::wstring_view appName)
+{
+    const auto range = s_byAppName.equal_range(FoldCase(it->_appName));
+    for (auto entry = range.first; entry != range.second; ++entry)
     {
-        if (WI_IsFlagSet(historyList.Flags, CLE_ALLOCATED) && historyList.IsAppNameMatch(appName))
+        if (entry->second == it)
         {
-            return &historyList;
+            s_byAppName.erase(entry);
+            break;
         }
     }
-    return nullptr;
+
+    it->_appName = appName;
+    s_byAppName.emplace(FoldCase(appName), it);
 }
 
 size_t CommandHistory::s_CountOfHistories()
@@ -341,23 +419,9 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     // Reuse a history buffer.  The buffer must be !CLE_ALLOCATED.
     // If possible, the buffer should have the same app name.
-    std::optional<CommandHistory> BestCandidate;
-    bool SameApp = false;
-
-    for (auto it = s_historyLists.cbegin(); it != s_historyLists.cend(); it++)
-    {
-        if (WI_IsFlagClear(it->Flags, CLE_ALLOCATED))
-        {
-            // use LRU history buffer with same app name
-            if (it->IsAppNameMatch(appName))
-            {
-                BestCandidate = *it;
-                SameApp = true;
-                s_historyLists.erase(it);
-                break;
-            }
-        }
-    }
+    // use LRU history buffer with same app name
+    std::optional<HistoryIterator> BestCandidate = s_FindMostRecentByExe(appName, false);
+    const bool SameApp = BestCandidate.has_value();
 
     // if there isn't a free buffer for the app name and the maximum number of
     // command history buffers hasn't been allocated, allocate a new one.
@@ -365,22 +429,26 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
     {
         CommandHistory History;
 
-        History._appName = appName;
         History.Flags = CLE_ALLOCATED;
         History.LastDisplayed = -1;
         History._maxCommands = gsl::narrow<SHORT>(gci.GetHistoryBufferSize());
         History._processHandle = processHandle;
-        return &s_historyLists.emplace_front(History);
+        s_historyLists.emplace_front(History);
+
+        const auto it = s_historyLists.begin();
+        it->_lruStamp = ++s_lruClock;
+        s_SetAppName(it, appName);
+        s_byProcessHandle[processHandle] = it;
+        return &*it;
     }
     else if (!BestCandidate.has_value() && s_historyLists.size() > 0)
     {
         // If we have no candidate already and we need one, take the LRU (which is the back/last one) which isn't allocated.
-        for (auto it = s_historyLists.crbegin(); it != s_historyLists.crend(); it++)
+        for (auto it = s_historyLists.rbegin(); it != s_historyLists.rend(); it++)
         {
             if (WI_IsFlagClear(it->Flags, CLE_ALLOCATED))
             {
-                BestCandidate = *it;
-                s_historyLists.erase(std::next(it).base()); // trickery to turn reverse iterator into forward iterator for erase.
+                BestCandidate = std::next(it).base(); // trickery to turn reverse iterator into forward iterator.
                 break;
             }
         }
@@ -389,17 +457,21 @@ CommandHistory* CommandHistory::s_Allocate(const std::wstring_view appName, cons
     // If the app name doesn't match, copy in the new app name and free the old commands.
     if (BestCandidate.has_value())
     {
+        const auto it = BestCandidate.value();
         if (!SameApp)
         {
-            BestCandidate->_commands.clear();
-            BestCandidate->LastDisplayed = -1;
-            BestCandidate->_appName = appName;
+            it->_commands.clear();
+            it->_index.clear();
+            it->LastDisplayed = -1;
+            s_SetAppName(it, appName);
         }
 
-        BestCandidate->_processHandle = processHandle;
-        WI_SetFlag(BestCandidate->Flags, CLE_ALLOCATED);
+        it->_processHandle = processHandle;
+        WI_SetFlag(it->Flags, CLE_ALLOCATED);
+        s_byProcessHandle[processHandle] = it;
 
-        return &s_historyLists.emplace_front(BestCandidate.value());
+        s_MoveToFront(it);
+        return &*it;
     }
 
     return nullptr;
@@ -471,6 +543,7 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
     try
     {
         const auto str = _commands.at(iDel);
+        _IndexErase(iDel);
 
         if (iDel < iLast)
         {
@@ -527,34 +600,121 @@ std::wstring CommandHistory::Remove(const SHORT iDel)
         return true;
     }
 
-    try
+    const SHORT count = gsl::narrow<SHORT>(_commands.size());
+    if (indexFound < 0 || indexFound >= count)
     {
-        for (size_t i = 0; i < _commands.size(); i++)
+        return false;
+    }
+
+    // Every command that starts with givenCommand is in one run of the index.
+    // Of those, pick the first one a walk backwards from indexFound would meet.
+    const auto first = std::lower_bound(_index.cbegin(), _index.cend(), givenCommand, [&](const SHORT index, const std::wstring_view value) {
+        return CaseInsensitiveCompare(_commands[index], value) < 0;
+    });
+    const auto last = std::upper_bound(first, _index.cend(), givenCommand, [&](const std::wstring_view value, const SHORT index) {
+        const std::wstring_view command{ _commands[index] };
+        return CaseInsensitiveCompare(value, command.substr(0, value.size())) < 0;
+    });
+
+    const bool exactMatch = WI_IsFlagSet(options, MatchOptions::ExactMatch);
+    SHORT bestDistance = count;
+    for (auto it = first; it != last; ++it)
+    {
+        if (exactMatch && _commands[*it].size() != givenCommand.size())
         {
-            const auto& storedCommand = _commands.at(indexFound);
-            if ((WI_IsFlagClear(options, MatchOptions::ExactMatch) && (givenCommand.size() <= storedCommand.size())) || (givenCommand.size() == storedCommand.size()))
-            {
-                if (std::equal(storedCommand.begin(),
-                               storedCommand.begin() + givenCommand.size(),
-                               givenCommand.begin(),
-                               givenCommand.end(),
-                               CaseInsensitiveEquality))
-                {
-                    return true;
-                }
-            }
+            continue;
+        }
 
-            _Prev(indexFound);
+        const SHORT distance = gsl::narrow_cast<SHORT>((indexFound - *it + count) % count);
+        if (distance < bestDistance)
+        {
+            bestDistance = distance;
         }
     }
-    CATCH_LOG();
 
-    return false;
+    if (bestDistance == count)
+    {
+        return false;
+    }
+
+    indexFound = gsl::narrow_cast<SHORT>((indexFound - bestDistance + count) % count);
+    return true;
+}
+
+// Routine Description:
+// - Orders two positions of _commands for the index: by command, case
+//   insensitively, and then by position.
+int CommandHistory::_IndexCompare(const SHORT a, const SHORT b) const noexcept
+{
+    const int result = CaseInsensitiveCompare(_commands[a], _commands[b]);
+    if (result != 0)
+    {
+        return result;
+    }
+    return a - b;
+}
+
+// Routine Description:
+// - Finds where the given position of _commands is, or belongs, in the index.
+std::vector<SHORT>::iterator CommandHistory::_IndexFind(const SHORT index)
+{
+    return std::lower_bound(_index.begin(), _index.end(), index, [&](const SHORT a, const SHORT b) {
+        return _IndexCompare(a, b) < 0;
+    });
+}
+
+// Routine Description:
+// - Adds a position of _commands to the index. The command must already be in place.
+void CommandHistory::_IndexInsert(const SHORT index)
+{
+    _index.insert(_IndexFind(index), index);
+}
+
+// Routine Description:
+// - Takes a position of _commands out of the index, leaving the others as they are.
+void CommandHistory::_IndexRemove(const SHORT index)
+{
+    const auto it = _IndexFind(index);
+    if (it != _index.end() && *it == index)
+    {
+        _index.erase(it);
+    }
+}
+
+// Routine Description:
+// - Takes a position out of the index ahead of the command being erased from
+//   _commands, and moves the positions after it down by one to match.
+void CommandHistory::_IndexErase(const SHORT index)
+{
+    _IndexRemove(index);
+    for (auto& position : _index)
+    {
+        if (position > index)
+        {
+            --position;
+        }
+    }
+}
+
+// Routine Description:
+// - Builds the index from scratch.
+void CommandHistory::_IndexRebuild()
+{
+    _index.clear();
+    for (SHORT i = 0; i < gsl::narrow<SHORT>(_commands.size()); i++)
+    {
+        _index.push_back(i);
+    }
+    std::sort(_index.begin(), _index.end(), [&](const SHORT a, const SHORT b) {
+        return _IndexCompare(a, b) < 0;
+    });
 }
 
 #ifdef UNIT_TESTING
 void CommandHistory::s_ClearHistoryListStorage()
 {
+    s_byProcessHandle.clear();
+    s_byAppName.clear();
     s_historyLists.clear();
 }
 #endif
@@ -566,7 +726,11 @@ void CommandHistory::s_ClearHistoryListStorage()
 // - indexB - index of one history item to swap
 void CommandHistory::Swap(const short indexA, const short indexB)
 {
+    _IndexRemove(indexA);
+    _IndexRemove(indexB);
     std::swap(_commands.at(indexA), _commands.at(indexB));
+    _IndexInsert(indexA);
+    _IndexInsert(indexB);
 }
 
 // Routine Description:
@@ -8,6 +8,10 @@ Module Name:
 Abstract:
 - Encapsulates the cmdline functions and structures specifically related to
         command history functionality.
+- Each history keeps its commands sorted case insensitively in a side index,
+        so that searching for a prefix (F8) doesn't have to walk every command.
+        Histories are looked up by process handle and by exe name through hash
+        tables rather than by walking the list of histories.
 --*/
 
 #pragma once
@@ -75,6 +79,19 @@ public:
 private:
     void _Reset();
 
+    int _IndexCompare(const SHORT a, const SHORT b) const noexcept;
+    std::vector<SHORT>::iterator _IndexFind(const SHORT index);
+    void _IndexInsert(const SHORT index);
+    void _IndexRemove(const SHORT index);
+    void _IndexErase(const SHORT index);
+    void _IndexRebuild();
+
+    using HistoryIterator = std::list<CommandHistory>::iterator;
+
+    static void s_MoveToFront(const HistoryIterator it);
+    static void s_SetAppName(const HistoryIterator it, const std::wstring_view appName);
+    static std::optional<HistoryIterator> s_FindMostRecentByExe(const std::wstring_view appName, const bool allocated);
+
     // _Next and _Prev go to the next and prev command
     // _Inc  and _Dec go to the next and prev slots
     // Don't get the two confused - it matters when the cmd history is not full!
@@ -86,10 +103,21 @@ private:
     std::vector<std::wstring> _commands;
     SHORT _maxCommands;
 
+    // The positions of _commands, ordered case insensitively by the command
+    // and then by position. Kept in step with every change to _commands.
+    std::vector<SHORT> _index;
+
     std::wstring _appName;
     HANDLE _processHandle;
 
+    // Larger is more recently moved to the front of s_historyLists.
+    unsigned long long _lruStamp;
+
     static std::list<CommandHistory> s_historyLists;
+    static unsigned long long s_lruClock;
+    static std::unordered_map<HANDLE, HistoryIterator> s_byProcessHandle;
+    // Keyed by the lowercased app name.
+    static std::unordered_multimap<std::wstring, HistoryIterator> s_byAppName;
 
 public:
     DWORD Flags;
@@ -5,6 +5,7 @@
 #include "inputBuffer.hpp"
 #include "dbcs.h"
 #include "stream.h"
+#include "../types/inc/convert.hpp"
 #include "../types/inc/GlyphWidth.hpp"
 
 #include <functional>
@@ -25,6 +26,7 @@ using Microsoft::Console::VirtualTerminal::TerminalInput;
 InputBuffer::InputBuffer() :
     InputMode{ INPUT_BUFFER_DEFAULT_INPUT_MODE },
     WaitQueue{},
+    _textRunRecords{ 0 },
     _termInput(std::bind(&InputBuffer::_HandleTerminalInputCallback, this, std::placeholders::_1))
 {
     // The _termInput's constructor takes a reference to this object's _HandleTerminalInputCallback.
@@ -150,7 +152,8 @@ void InputBuffer::ReinitializeInputBuffer()
 {
     ServiceLocator::LocateGlobals().hInputEvent.ResetEvent();
     InputMode = INPUT_BUFFER_DEFAULT_INPUT_MODE;
-    _storage.clear();
+    _storage.Clear();
+    _ClearTextRuns();
 }
 
 // Routine Description:
@@ -183,9 +186,11 @@ void InputBuffer::TerminateRead(_In_ WaitTerminationReason Flag)
 // - The number of events currently in the input buffer.
 // Note:
 // - The console lock must be held when calling this routine.
+// - Text written with WriteString counts as the key events that typing it
+// would produce, which is what ReadConsoleInput will return for it.
 size_t InputBuffer::GetNumberOfReadyEvents() const noexcept
 {
-    return _storage.size();
+    return _storage.Size() - _textRuns.size() + _textRunRecords;
 }
 
 // Routine Description:
@@ -198,7 +203,8 @@ size_t InputBuffer::GetNumberOfReadyEvents() const noexcept
 // - The console lock must be held when calling this routine.
 void InputBuffer::Flush()
 {
-    _storage.clear();
+    _storage.Clear();
+    _ClearTextRuns();
     ServiceLocator::LocateGlobals().hInputEvent.ResetEvent();
 }
 
@@ -212,39 +218,39 @@ void InputBuffer::Flush()
 // - The console lock must be held when calling this routine.
 void InputBuffer::FlushAllButKeys()
 {
-    auto newEnd = std::remove_if(_storage.begin(), _storage.end(), [](const std::unique_ptr<IInputEvent>& event) {
-        return event->EventType() != InputEventType::KeyEvent;
+    _storage.RemoveIf([](const INPUT_RECORD& record) {
+        return record.EventType != KEY_EVENT && record.EventType != _TextRunEventType;
     });
-    _storage.erase(newEnd, _storage.end());
 }
 
 // Routine Description:
-// - This routine reads from the input buffer.
-// - It can convert returned data to through the currently set Input CP, it can optionally return a wait condition
-//   if there isn't enough data in the buffer, and it can be set to not remove records as it reads them out.
+// - This routine reads from the input buffer into a caller supplied array.
+// - It can optionally return a wait condition if there isn't any data in the
+//   buffer, and it can be set to not remove records as it reads them out.
 // Note:
 // - The console lock must be held when calling this routine.
 // Arguments:
-// - OutEvents - deque to store the read events
-// - AmountToRead - the amount of events to try to read
-// - Peek - If true, copy events to pInputRecord but don't remove them from the input buffer.
+// - outRecords - where to store the read events. Its size is the amount of events to try to read.
+// - eventsRead - on exit, the number of events stored in outRecords
+// - Peek - If true, copy events to outRecords but don't remove them from the input buffer.
 // - WaitForData - if true, wait until an event is input (if there aren't enough to fill client buffer). if false, return immediately
 // - Unicode - true if the data in key events should be treated as unicode. false if they should be converted by the current input CP.
-// - Stream - true if read should unpack KeyEvents that have a >1 repeat count. AmountToRead must be 1 if Stream is true.
+// - Stream - true if read should unpack KeyEvents that have a >1 repeat count. outRecords must hold 1 event if Stream is true.
 // Return Value:
 // - STATUS_SUCCESS if records were read into the client buffer and everything is OK.
 // - CONSOLE_STATUS_WAIT if there weren't enough records to satisfy the request (and waits are allowed)
 // - otherwise a suitable memory/math/string error in NTSTATUS form.
-[[nodiscard]] NTSTATUS InputBuffer::Read(_Out_ std::deque<std::unique_ptr<IInputEvent>>& OutEvents,
-                                         const size_t AmountToRead,
+[[nodiscard]] NTSTATUS InputBuffer::Read(gsl::span<INPUT_RECORD> outRecords,
+                                         _Out_ size_t& eventsRead,
                                          const bool Peek,
                                          const bool WaitForData,
                                          const bool Unicode,
                                          const bool Stream)
 {
+    eventsRead = 0;
     try
     {
-        if (_storage.empty())
+        if (_storage.Empty())
         {
             if (!WaitForData)
             {
@@ -253,25 +259,14 @@ void InputBuffer::FlushAllButKeys()
             return CONSOLE_STATUS_WAIT;
         }
 
-        // read from buffer
-        std::deque<std::unique_ptr<IInputEvent>> events;
-        size_t eventsRead;
         bool resetWaitEvent;
-        _ReadBuffer(events,
-                    AmountToRead,
+        _ReadBuffer(outRecords,
                     eventsRead,
                     Peek,
                     resetWaitEvent,
                     Unicode,
                     Stream);
 
-        // copy events to outEvents
-        while (!events.empty())
-        {
-            OutEvents.push_back(std::move(events.front()));
-            events.pop_front();
-        }
-
         if (resetWaitEvent)
         {
             ServiceLocator::LocateGlobals().hInputEvent.ResetEvent();
@@ -284,6 +279,65 @@ void InputBuffer::FlushAllButKeys()
     }
 }
 
+// Routine Description:
+// - This routine reads from the input buffer.
+// - It can convert returned data to through the currently set Input CP, it can optionally return a wait condition
+//   if there isn't enough data in the buffer, and it can be set to not remove records as it reads them out.
+// Note:
+// - The console lock must be held when calling this routine.
+// - This is a compatibility wrapper around the INPUT_RECORD version of Read.
+// Arguments:
+// - OutEvents - deque to store the read events
+// - AmountToRead - the amount of events to try to read
+// - Peek - If true, copy events to pInputRecord but don't remove them from the input buffer.
+// - WaitForData - if true, wait until an event is input (if there aren't enough to fill client buffer). if false, return immediately
+// - Unicode - true if the data in key events should be treated as unicode. false if they should be converted by the current input CP.
+// - Stream - true if read should unpack KeyEvents that have a >1 repeat count. AmountToRead must be 1 if Stream is true.
+// Return Value:
+// - STATUS_SUCCESS if records were read into the client buffer and everything is OK.
+// - CONSOLE_STATUS_WAIT if there weren't enough records to satisfy the request (and waits are allowed)
+// - otherwise a suitable memory/math/string error in NTSTATUS form.
+[[nodiscard]] NTSTATUS InputBuffer::Read(_Out_ std::deque<std::unique_ptr<IInputEvent>>& OutEvents,
+                                         const size_t AmountToRead,
+                                         const bool Peek,
+                                         const bool WaitForData,
+                                         const bool Unicode,
+                                         const bool Stream)
+{
+    try
+    {
+        if (_storage.Empty())
+        {
+            if (!WaitForData)
+            {
+                return STATUS_SUCCESS;
+            }
+            return CONSOLE_STATUS_WAIT;
+        }
+
+        // Don't size the scratch space after a (possibly huge) client request
+        // when there's less than that to read.
+        std::vector<INPUT_RECORD> records(std::min(AmountToRead, GetNumberOfReadyEvents()));
+        size_t eventsRead;
+        const NTSTATUS Status = Read(records,
+                                     eventsRead,
+                                     Peek,
+                                     WaitForData,
+                                     Unicode,
+                                     Stream);
+
+        for (size_t i = 0; i < eventsRead; ++i)
+        {
+            OutEvents.push_back(IInputEvent::Create(records[i]));
+        }
+        return Status;
+    }
+    catch (...)
+    {
+        return NTSTATUS_FROM_HRESULT(wil::ResultFromCaughtException());
+    }
+}
+
 // Routine Description:
 // - This routine reads a single event from the input buffer.
 // - It can convert returned data to through the currently set Input CP, it can optionally return a wait condition
@@ -309,16 +363,17 @@ void InputBuffer::FlushAllButKeys()
     NTSTATUS Status;
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> outEvents;
-        Status = Read(outEvents,
-                      1,
+        INPUT_RECORD record;
+        size_t eventsRead;
+        Status = Read({ &record, 1 },
+                      eventsRead,
                       Peek,
                       WaitForData,
                       Unicode,
                       Stream);
-        if (!outEvents.empty())
+        if (eventsRead != 0)
         {
-            outEvent.swap(outEvents.front());
+            outEvent = IInputEvent::Create(record);
         }
     }
     catch (...)
@@ -332,122 +387,107 @@ void InputBuffer::FlushAllButKeys()
 // Routine Description:
 // - This routine reads from a buffer. It does the buffer manipulation.
 // Arguments:
-// - outEvents - where read events are placed
-// - readCount - amount of events to read
+// - outRecords - where read events are placed. Its size is the amount of events to read.
 // - eventsRead - where to store number of events read
 // - peek - if true , don't remove data from buffer, just copy it.
 // - resetWaitEvent - on exit, true if buffer became empty.
 // - unicode - true if read should be done in unicode mode
-// - streamRead - true if read should unpack KeyEvents that have a >1 repeat count. readCount must be 1 if streamRead is true.
+// - streamRead - true if read should unpack KeyEvents that have a >1 repeat count. outRecords must hold 1 event if streamRead is true.
 // Return Value:
 // - <none>
 // Note:
 // - The console lock must be held when calling this routine.
-void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& outEvents,
-                              const size_t readCount,
+void InputBuffer::_ReadBuffer(gsl::span<INPUT_RECORD> outRecords,
                               _Out_ size_t& eventsRead,
                               const bool peek,
                               _Out_ bool& resetWaitEvent,
                               const bool unicode,
                               const bool streamRead)
 {
+    const size_t readCount = gsl::narrow<size_t>(outRecords.size());
+
     // when stream reading, the previous behavior was to only allow reading of a single
     // event at a time.
     FAIL_FAST_IF(streamRead && readCount != 1);
 
     resetWaitEvent = false;
+    eventsRead = 0;
 
-    std::deque<std::unique_ptr<IInputEvent>> readEvents;
     // we need another var to keep track of how many we've read
     // because dbcs records count for two when we aren't doing a
     // unicode read but the eventsRead count should return the number
     // of events actually put into outRecords.
     size_t virtualReadCount = 0;
+    // the number of records at the front of storage that were read in full.
+    size_t consumed = 0;
 
-    while (!_storage.empty() && virtualReadCount < readCount)
+    while (consumed < _storage.Size() && virtualReadCount < readCount)
     {
-        bool performNormalRead = true;
-        // for stream reads we need to split any key events that have been coalesced
-        if (streamRead)
+        INPUT_RECORD& stored = _storage[consumed];
+        if (stored.EventType == _TextRunEventType && !streamRead)
         {
-            if (_storage.front()->EventType() == InputEventType::KeyEvent)
-            {
-                KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.front().get());
-                if (pKeyEvent->GetRepeatCount() > 1)
-                {
-                    // split the key event
-                    std::unique_ptr<KeyEvent> streamKeyEvent = std::make_unique<KeyEvent>(*pKeyEvent);
-                    streamKeyEvent->SetRepeatCount(1);
-                    readEvents.push_back(std::move(streamKeyEvent));
-                    pKeyEvent->SetRepeatCount(pKeyEvent->GetRepeatCount() - 1);
-                    performNormalRead = false;
-                }
-            }
+            // turn as much of the text into key events as this read needs,
+            // then carry on reading those.
+            _ExpandTextRun(consumed, readCount - virtualReadCount);
+            continue;
         }
 
-        if (performNormalRead)
-        {
-            readEvents.push_back(std::move(_storage.front()));
-            _storage.pop_front();
-        }
+        INPUT_RECORD& out = outRecords[eventsRead];
+        ++eventsRead;
 
-        ++virtualReadCount;
-        if (!unicode)
+        if (stored.EventType == _TextRunEventType)
         {
-            if (readEvents.back()->EventType() == InputEventType::KeyEvent)
+            // a stream reader only acts on the key down that carries each
+            // character, so that is all it gets.
+            TextRun& run = _textRuns.front();
+            const wchar_t wch = run.text[run.offset];
+            out = CharToKeyDownEvent(wch).ToInputRecord();
+            if (!peek)
             {
-                const KeyEvent* const pKeyEvent = static_cast<const KeyEvent* const>(readEvents.back().get());
-                if (IsGlyphFullWidth(pKeyEvent->GetCharData()))
+                ++run.offset;
+                _textRunRecords -= CharToKeyEventCount(wch, run.codepage);
+                if (run.offset == run.text.size())
                 {
-                    ++virtualReadCount;
+                    _textRuns.pop_front();
+                    ++consumed;
                 }
             }
         }
-    }
-
-    // the amount of events that were actually read
-    eventsRead = readEvents.size();
-
-    // copy the events back if we were supposed to peek
-    if (peek)
-    {
-        if (streamRead)
+        // for stream reads we need to split any key events that have been coalesced.
+        // a peek leaves the stored event as it was.
+        else if (streamRead &&
+                 stored.EventType == KEY_EVENT &&
+                 stored.Event.KeyEvent.wRepeatCount > 1)
         {
-            // we need to check and see if the event was split from a coalesced key event
-            // or if it was unrelated to the current front event in storage
-            if (!readEvents.empty() &&
-                !_storage.empty() &&
-                readEvents.back()->EventType() == InputEventType::KeyEvent &&
-                _storage.front()->EventType() == InputEventType::KeyEvent &&
-                _CanCoalesce(static_cast<const KeyEvent&>(*readEvents.back()),
-                             static_cast<const KeyEvent&>(*_storage.front())))
+            out = stored;
+            out.Event.KeyEvent.wRepeatCount = 1;
+            if (!peek)
             {
-                KeyEvent& keyEvent = static_cast<KeyEvent&>(*_storage.front());
-                keyEvent.SetRepeatCount(keyEvent.GetRepeatCount() + 1);
-            }
-            else
-            {
-                _storage.push_front(IInputEvent::Create(readEvents.back()->ToInputRecord()));
+                stored.Event.KeyEvent.wRepeatCount--;
             }
         }
         else
         {
-            for (auto it = readEvents.crbegin(); it != readEvents.crend(); ++it)
-            {
-                _storage.push_front(IInputEvent::Create((*it)->ToInputRecord()));
-            }
+            out = stored;
+            ++consumed;
+        }
+
+        ++virtualReadCount;
+        if (!unicode &&
+            out.EventType == KEY_EVENT &&
+            IsGlyphFullWidth(out.Event.KeyEvent.uChar.UnicodeChar))
+        {
+            ++virtualReadCount;
         }
     }
 
-    // move events read to proper deque
-    while (!readEvents.empty())
+    if (!peek)
     {
-        outEvents.push_back(std::move(readEvents.front()));
-        readEvents.pop_front();
+        _storage.PopFront(consumed);
     }
 
     // signal if we emptied the buffer
-    if (_storage.empty())
+    if (_storage.Empty())
     {
         resetWaitEvent = true;
     }
@@ -456,18 +496,18 @@ void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& ou
 // Routine Description:
 // -  Writes events to the beginning of the input buffer.
 // Arguments:
-// - inEvents - events to write to buffer.
-// - eventsWritten - The number of events written to the buffer on exit.
+// - inRecords - events to write to buffer.
 // Return Value:
-// S_OK if successful.
+// - The number of events written to the buffer.
 // Note:
 // - The console lock must be held when calling this routine.
-size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+size_t InputBuffer::Prepend(gsl::span<const INPUT_RECORD> inRecords)
 {
     try
     {
-        _HandleConsoleSuspensionEvents(inEvents);
-        if (inEvents.empty())
+        std::vector<INPUT_RECORD> filteredRecords;
+        inRecords = _HandleConsoleSuspensionEvents(inRecords, filteredRecords);
+        if (inRecords.empty())
         {
             return STATUS_SUCCESS;
         }
@@ -476,23 +516,23 @@ size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& in
         // this way to handle any coalescing that might occur.
 
         // get all of the existing records, "emptying" the buffer
-        std::deque<std::unique_ptr<IInputEvent>> existingStorage;
-        existingStorage.swap(_storage);
+        InputEventQueue existingStorage;
+        existingStorage.Swap(_storage);
 
         // We will need this variable to pass to _WriteBuffer so it can attempt to determine wait status.
-        // However, because we swapped the storage out from under it with an empty deque, it will always
-        // return true after the first one (as it is filling the newly emptied backing deque.)
+        // However, because we swapped the storage out from under it with an empty queue, it will always
+        // return true after the first one (as it is filling the newly emptied backing queue.)
         // Then after the second one, because we've inserted some input, it will always say false.
         bool unusedWaitStatus = false;
 
         // write the prepend records
         size_t prependEventsWritten;
-        _WriteBuffer(inEvents, prependEventsWritten, unusedWaitStatus);
+        _WriteBuffer(inRecords, prependEventsWritten, unusedWaitStatus);
         FAIL_FAST_IF(!(unusedWaitStatus));
 
         // write all previously existing records
         size_t existingEventsWritten;
-        _WriteBuffer(existingStorage, existingEventsWritten, unusedWaitStatus);
+        _WriteBuffer(existingStorage.Linearize(), existingEventsWritten, unusedWaitStatus);
         FAIL_FAST_IF(!(!unusedWaitStatus));
 
         // We need to set the wait event if there were 0 events in the
@@ -502,7 +542,7 @@ size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& in
         // and instead need to set the event if the original backing
         // buffer (the one we swapped out at the top) was empty
         // when this whole thing started.
-        if (existingStorage.empty())
+        if (existingStorage.Empty())
         {
             ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
         }
@@ -517,6 +557,71 @@ size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& in
     }
 }
 
+// Routine Description:
+// -  Writes events to the beginning of the input buffer.
+// Arguments:
+// - inEvents - events to write to buffer. Empty on exit.
+// Return Value:
+// - The number of events written to the buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+// - This is a compatibility wrapper around the INPUT_RECORD version of Prepend.
+size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+{
+    try
+    {
+        const auto inRecords = IInputEvent::ToInputRecords(inEvents);
+        inEvents.clear();
+        return Prepend(inRecords);
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
+    }
+}
+
+// Routine Description:
+// - Writes events to the input buffer. Wakes up any readers that are
+// waiting for additional input events.
+// Arguments:
+// - inRecords - input events to store in the buffer.
+// Return Value:
+// - The number of events that were written to input buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+size_t InputBuffer::Write(gsl::span<const INPUT_RECORD> inRecords)
+{
+    try
+    {
+        std::vector<INPUT_RECORD> filteredRecords;
+        inRecords = _HandleConsoleSuspensionEvents(inRecords, filteredRecords);
+        if (inRecords.empty())
+        {
+            return 0;
+        }
+
+        // Write to buffer.
+        size_t EventsWritten;
+        bool SetWaitEvent;
+        _WriteBuffer(inRecords, EventsWritten, SetWaitEvent);
+
+        if (SetWaitEvent)
+        {
+            ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
+        }
+
+        // Alert any writers waiting for space.
+        WakeUpReadersWaitingForData();
+        return EventsWritten;
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
+    }
+}
+
 // Routine Description:
 // - Writes event to the input buffer. Wakes up any readers that are
 // waiting for additional input events.
@@ -532,9 +637,9 @@ size_t InputBuffer::Write(_Inout_ std::unique_ptr<IInputEvent> inEvent)
 {
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> inEvents;
-        inEvents.push_back(std::move(inEvent));
-        return Write(inEvents);
+        const INPUT_RECORD record = inEvent->ToInputRecord();
+        inEvent.reset();
+        return Write({ &record, 1 });
     }
     catch (...)
     {
@@ -547,34 +652,89 @@ size_t InputBuffer::Write(_Inout_ std::unique_ptr<IInputEvent> inEvent)
 // - Writes events to the input buffer. Wakes up any readers that are
 // waiting for additional input events.
 // Arguments:
-// - inEvents - input events to store in the buffer.
+// - inEvents - input events to store in the buffer. Empty on exit.
 // Return Value:
 // - The number of events that were written to input buffer.
 // Note:
 // - The console lock must be held when calling this routine.
+// - This is a compatibility wrapper around the INPUT_RECORD version of Write.
 size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
 {
     try
     {
-        _HandleConsoleSuspensionEvents(inEvents);
-        if (inEvents.empty())
+        const auto inRecords = IInputEvent::ToInputRecords(inEvents);
+        inEvents.clear();
+        return Write(inRecords);
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
+    }
+}
+
+// Routine Description:
+// - Writes text to the input buffer, as if it was typed. Wakes up any
+// readers that are waiting for additional input events.
+// - The text is stored as is. It's only turned into key events if it's read
+// with ReadConsoleInput, and then only as much of it as is read. Stream
+// readers get one key down per character.
+// - In VT input mode, the text is written as key events right away, so that
+// the VT input module translates them.
+// Arguments:
+// - text - the text to store in the buffer.
+// Return Value:
+// - The number of characters that were written to input buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+size_t InputBuffer::WriteString(const std::wstring_view text)
+{
+    try
+    {
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        std::wstring_view remaining = text;
+        if (!remaining.empty() && WI_IsFlagSet(gci.Flags, CONSOLE_SUSPENDED))
+        {
+            // Like any other keypress, the first character resumes the
+            // console, and is swallowed doing so.
+            UnblockWriteConsole(CONSOLE_OUTPUT_SUSPENDED);
+            remaining.remove_prefix(1);
+        }
+        if (remaining.empty())
         {
             return 0;
         }
 
-        // Write to buffer.
-        size_t EventsWritten;
-        bool SetWaitEvent;
-        _WriteBuffer(inEvents, EventsWritten, SetWaitEvent);
+        const bool initiallyEmptyQueue = _storage.Empty();
+        if (IsInVirtualTerminalInputMode())
+        {
+            // The VT input module translates each key as it's written, so in
+            // VT input mode the text has to be written as keys.
+            std::vector<INPUT_RECORD> keyEvents;
+            for (const auto wch : remaining)
+            {
+                for (const auto& keyEvent : CharToKeyEvents(wch, gci.OutputCP))
+                {
+                    keyEvents.push_back(keyEvent->ToInputRecord());
+                }
+            }
+            size_t eventsWritten;
+            bool setWaitEvent;
+            _WriteBuffer(keyEvents, eventsWritten, setWaitEvent);
+        }
+        else
+        {
+            _AppendTextRun(remaining, gci.OutputCP);
+        }
 
-        if (SetWaitEvent)
+        if (initiallyEmptyQueue && !_storage.Empty())
         {
             ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
         }
 
-        // Alert any writers waiting for space.
         WakeUpReadersWaitingForData();
-        return EventsWritten;
+        return text.size();
     }
     catch (...)
     {
@@ -595,145 +755,214 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
 // Note:
 // - The console lock must be held when calling this routine.
 // - will throw on failure
-void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
+void InputBuffer::_WriteBuffer(gsl::span<const INPUT_RECORD> inRecords,
                                _Out_ size_t& eventsWritten,
                                _Out_ bool& setWaitEvent)
 {
     eventsWritten = 0;
     setWaitEvent = false;
-    const bool initiallyEmptyQueue = _storage.empty();
-    const size_t initialInEventsSize = inEvents.size();
+    const bool initiallyEmptyQueue = _storage.Empty();
+    const size_t initialInEventsSize = gsl::narrow<size_t>(inRecords.size());
     const bool vtInputMode = IsInVirtualTerminalInputMode();
 
-    while (!inEvents.empty())
+    // Outside of VT mode, a batch is never coalesced (see below), so it can
+    // be stored in one go.
+    if (!vtInputMode && initialInEventsSize != 1)
+    {
+        _storage.PushBack(inRecords);
+        eventsWritten = initialInEventsSize;
+    }
+    else
     {
-        // Pop the next event.
-        // If we're in vt mode, try and handle it with the vt input module.
-        // If it was handled, do nothing else for it.
-        // If there was one event passed in, try coalescing it with the previous event currently in the buffer.
-        // If it's not coalesced, append it to the buffer.
-        std::unique_ptr<IInputEvent> inEvent = std::move(inEvents.front());
-        inEvents.pop_front();
-        if (vtInputMode)
+        for (const INPUT_RECORD& inRecord : inRecords)
         {
-            const bool handled = _termInput.HandleKey(inEvent.get());
-            if (handled)
+            // If we're in vt mode, try and handle it with the vt input module.
+            // If it was handled, do nothing else for it.
+            // If there was one event passed in, try coalescing it with the previous event currently in the buffer.
+            // If it's not coalesced, append it to the buffer.
+            if (vtInputMode && inRecord.EventType == KEY_EVENT)
             {
-                eventsWritten++;
-                continue;
+                // A key down can stand for several presses of a held key. The
+                // vt input module only translates one press at a time, so
+                // it's told about each of them.
+                KeyEvent keyEvent{ inRecord.Event.KeyEvent };
+                const WORD repeatCount = std::max<WORD>(keyEvent.GetRepeatCount(), 1);
+                keyEvent.SetRepeatCount(1);
+                const bool handled = _termInput.HandleKey(&keyEvent);
+                for (WORD i = 1; handled && i < repeatCount && keyEvent.IsKeyDown(); ++i)
+                {
+                    _termInput.HandleKey(&keyEvent);
+                }
+                if (handled)
+                {
+                    eventsWritten++;
+                    continue;
+                }
             }
-        }
 
-        // we only check for possible coalescing when storing one
-        // record at a time because this is the original behavior of
-        // the input buffer. Changing this behavior may break stuff
-        // that was depending on it.
-        if (initialInEventsSize == 1 && !_storage.empty())
-        {
-            // coalescing requires a deque of events, so push it back onto the front.
-            inEvents.push_front(std::move(inEvent));
-
-            bool coalesced = false;
-            // this looks kinda weird but we don't want to coalesce a
-            // mouse event and then try to coalesce a key event right after.
-            //
-            // we also pass the whole deque to the coalescing methods
-            // even though they only want one event because it should
-            // be their responsibility to maintain the correct state
-            // of the deque if they process any records in it.
-            if (_CoalesceMouseMovedEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            else if (_CoalesceRepeatedKeyPressEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            if (coalesced)
+            // we only check for possible coalescing when storing one
+            // record at a time because this is the original behavior of
+            // the input buffer. Changing this behavior may break stuff
+            // that was depending on it.
+            if (initialInEventsSize == 1 && !_storage.Empty())
             {
-                eventsWritten = 1;
-                return;
-            }
-            else
-            {
-                // We didn't coalesce the event. pull it from the queue again,
-                //  to keep the state consistent with the start of this block.
-                inEvent = std::move(inEvents.front());
-                inEvents.pop_front();
+                // this looks kinda weird but we don't want to coalesce a
+                // mouse event and then try to coalesce a key event right after.
+                if (_CoalesceMouseMovedEvents(inRecord) ||
+                    _CoalesceRepeatedKeyPressEvents(inRecord))
+                {
+                    eventsWritten = 1;
+                    return;
+                }
             }
+            // At this point, the event was neither coalesced, nor processed by VT.
+            _storage.PushBack(inRecord);
+            ++eventsWritten;
         }
-        // At this point, the event was neither coalesced, nor processed by VT.
-        _storage.push_back(std::move(inEvent));
-        ++eventsWritten;
     }
-    if (initiallyEmptyQueue && !_storage.empty())
+    if (initiallyEmptyQueue && !_storage.Empty())
     {
         setWaitEvent = true;
     }
 }
 
 // Routine Description:
-// - Checks if the last saved event and the first event of inRecords are
-// both MOUSE_MOVED events. If they are, the last saved event is
-// updated with the new mouse position and the first event of inRecords is
-// dropped.
+// - Appends text to the end of the buffer. If the buffer already ends in
+// text written with the same codepage, it is extended rather than starting
+// a new run.
+// Arguments:
+// - text - the text to append
+// - codepage - the codepage to type the text in when it's read as key events
+// Note:
+// - The console lock must be held when calling this routine.
+// - will throw on failure
+void InputBuffer::_AppendTextRun(const std::wstring_view text, const UINT codepage)
+{
+    size_t records = 0;
+    for (const auto wch : text)
+    {
+        records += CharToKeyEventCount(wch, codepage);
+    }
+
+    if (!_storage.Empty() &&
+        _storage.Back().EventType == _TextRunEventType &&
+        _textRuns.back().codepage == codepage)
+    {
+        _textRuns.back().text.append(text);
+    }
+    else
+    {
+        _textRuns.push_back({ std::wstring{ text }, 0, codepage });
+        auto removeRun = wil::scope_exit([&]() noexcept { _textRuns.pop_back(); });
+
+        INPUT_RECORD record{ 0 };
+        record.EventType = _TextRunEventType;
+        _storage.PushBack(record);
+        removeRun.release();
+    }
+    _textRunRecords += records;
+}
+
+// Routine Description:
+// - Turns the start of the text run at index into the key events that
+// typing it would produce, and puts them in its place.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - index - the position of the text run in _storage. It has to be the first
+// run in the buffer.
+// - eventCount - how many key events are wanted. Whole characters are
+// converted until there are at least this many, or the run is used up.
+// Note:
+// - The console lock must be held when calling this routine.
+// - will throw on failure
+void InputBuffer::_ExpandTextRun(const size_t index, const size_t eventCount)
+{
+    TextRun& run = _textRuns.front();
+
+    std::vector<INPUT_RECORD> records;
+    size_t offset = run.offset;
+    while (records.size() < eventCount && offset < run.text.size())
+    {
+        for (const auto& keyEvent : CharToKeyEvents(run.text[offset], run.codepage))
+        {
+            records.push_back(keyEvent->ToInputRecord());
+        }
+        ++offset;
+    }
+    const size_t expandedRecords = records.size();
+
+    const bool usedUp = offset == run.text.size();
+    if (!usedUp)
+    {
+        // what's left of the text stays behind the new events.
+        records.push_back(_storage[index]);
+    }
+    _storage.Replace(index, records);
+
+    _textRunRecords -= expandedRecords;
+    run.offset = offset;
+    if (usedUp)
+    {
+        _textRuns.pop_front();
+    }
+}
+
+// Routine Description:
+// - Drops all text written with WriteString. Only to be used when _storage is
+// emptied as well.
+void InputBuffer::_ClearTextRuns() noexcept
+{
+    _textRuns.clear();
+    _textRunRecords = 0;
+}
+
+// Routine Description:
+// - Checks if the last saved event and inRecord are both MOUSE_MOVED
+// events. If they are, the last saved event is updated with the new
+// mouse position and inRecord is dropped.
+// Arguments:
+// - inRecord - The incoming record to process.
 // Return Value:
 // true if events were coalesced, false if they were not.
 // Note:
-// - The size of inRecords must be 1.
 // - Coalescing here means updating a record that already exists in
 // the buffer with updated values from an incoming event, instead of
 // storing the incoming event (which would make the original one
 // redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+bool InputBuffer::_CoalesceMouseMovedEvents(const INPUT_RECORD& inRecord) noexcept
 {
-    FAIL_FAST_IF(!(inEvents.size() == 1));
-    FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::MouseEvent &&
-        pLastStoredEvent->EventType() == InputEventType::MouseEvent)
+    FAIL_FAST_IF(_storage.Empty());
+    INPUT_RECORD& lastStored = _storage.Back();
+    if (inRecord.EventType == MOUSE_EVENT &&
+        lastStored.EventType == MOUSE_EVENT &&
+        inRecord.Event.MouseEvent.dwEventFlags == MOUSE_MOVED &&
+        lastStored.Event.MouseEvent.dwEventFlags == MOUSE_MOVED)
     {
-        const MouseEvent* const pInMouseEvent = static_cast<const MouseEvent* const>(pFirstInEvent);
-        const MouseEvent* const pLastMouseEvent = static_cast<const MouseEvent* const>(pLastStoredEvent);
-
-        if (pInMouseEvent->IsMouseMoveEvent() &&
-            pLastMouseEvent->IsMouseMoveEvent())
-        {
-            // update mouse moved position
-            MouseEvent* const pMouseEvent = static_cast<MouseEvent* const>(_storage.back().release());
-            pMouseEvent->SetPosition(pInMouseEvent->GetPosition());
-            std::unique_ptr<IInputEvent> tempPtr(pMouseEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
-            return true;
-        }
+        // update mouse moved position
+        lastStored.Event.MouseEvent.dwMousePosition = inRecord.Event.MouseEvent.dwMousePosition;
+        return true;
     }
     return false;
 }
 
 // Routine Description:
-// - checks two KeyEvents to see if they're similiar enough to be coalesced
+// - checks two key events to see if they're similiar enough to be coalesced
 // Arguments:
-// - a - the first KeyEvent
-// - b - the other KeyEvent
+// - a - the first key event
+// - b - the other key event
 // Return Value:
 // - true if the events could be coalesced, false otherwise
-bool InputBuffer::_CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexcept
+bool InputBuffer::_CanCoalesce(const KEY_EVENT_RECORD& a, const KEY_EVENT_RECORD& b) const noexcept
 {
-    if (WI_IsFlagSet(a.GetActiveModifierKeys(), NLS_IME_CONVERSION) &&
-        a.GetCharData() == b.GetCharData() &&
-        a.GetActiveModifierKeys() == b.GetActiveModifierKeys())
+    if (WI_IsFlagSet(a.dwControlKeyState, NLS_IME_CONVERSION) &&
+        a.uChar.UnicodeChar == b.uChar.UnicodeChar &&
+        a.dwControlKeyState == b.dwControlKeyState)
     {
         return true;
     }
     // other key events check
-    else if (a.GetVirtualScanCode() == b.GetVirtualScanCode() &&
-             a.GetCharData() == b.GetCharData() &&
-             a.GetActiveModifierKeys() == b.GetActiveModifierKeys())
+    else if (a.wVirtualScanCode == b.wVirtualScanCode &&
+             a.uChar.UnicodeChar == b.uChar.UnicodeChar &&
+             a.dwControlKeyState == b.dwControlKeyState)
     {
         return true;
     }
@@ -741,44 +970,35 @@ bool InputBuffer::_CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexc
 }
 
 // Routine Description::
-// - If the last input event saved and the first input event in inRecords
-// are both a keypress down event for the same key, update the repeat
-// count of the saved event and drop the first from inRecords.
+// - If the last input event saved and inRecord are both a keypress down
+// event for the same key, update the repeat count of the saved event
+// and drop inRecord.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - inRecord - The incoming record to process.
 // Return Value:
 // true if events were coalesced, false if they were not.
 // Note:
-// - The size of inRecords must be 1.
 // - Coalescing here means updating a record that already exists in
 // the buffer with updated values from an incoming event, instead of
 // storing the incoming event (which would make the original one
 // redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
-{
-    FAIL_FAST_IF(!(inEvents.size() == 1));
-    FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::KeyEvent &&
-        pLastStoredEvent->EventType() == InputEventType::KeyEvent)
-    {
-        const KeyEvent* const pInKeyEvent = static_cast<const KeyEvent* const>(pFirstInEvent);
-        const KeyEvent* const pLastKeyEvent = static_cast<const KeyEvent* const>(pLastStoredEvent);
-
-        if (pInKeyEvent->IsKeyDown() &&
-            pLastKeyEvent->IsKeyDown() &&
-            !IsGlyphFullWidth(pInKeyEvent->GetCharData()) &&
-            _CanCoalesce(*pInKeyEvent, *pLastKeyEvent))
+bool InputBuffer::_CoalesceRepeatedKeyPressEvents(const INPUT_RECORD& inRecord) noexcept
+{
+    FAIL_FAST_IF(_storage.Empty());
+    INPUT_RECORD& lastStored = _storage.Back();
+    if (inRecord.EventType == KEY_EVENT &&
+        lastStored.EventType == KEY_EVENT)
+    {
+        const KEY_EVENT_RECORD& inKeyEvent = inRecord.Event.KeyEvent;
+        KEY_EVENT_RECORD& lastKeyEvent = lastStored.Event.KeyEvent;
+
+        if (inKeyEvent.bKeyDown &&
+            lastKeyEvent.bKeyDown &&
+            !IsGlyphFullWidth(inKeyEvent.uChar.UnicodeChar) &&
+            _CanCoalesce(inKeyEvent, lastKeyEvent))
         {
             // increment repeat count
-            KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.back().release());
-            WORD repeatCount = pKeyEvent->GetRepeatCount() + pInKeyEvent->GetRepeatCount();
-            pKeyEvent->SetRepeatCount(repeatCount);
-            std::unique_ptr<IInputEvent> tempPtr(pKeyEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
+            lastKeyEvent.wRepeatCount += inKeyEvent.wRepeatCount;
             return true;
         }
     }
@@ -788,42 +1008,57 @@ bool InputBuffer::_CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique
 // Routine Description:
 // - Handles records that suspend/resume the console.
 // Arguments:
-// - records - records to check for pause/unpause events
+// - inRecords - records to check for pause/unpause events
+// - filteredRecords - scratch storage. Only used if a record has to be dropped.
 // Return Value:
-// - None
+// - The records that remain once the pause/unpause events are removed. Either
+// inRecords itself or a view of filteredRecords.
 // Note:
 // - The console lock must be held when calling this routine.
 // - will throw exception on error
-void InputBuffer::_HandleConsoleSuspensionEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+gsl::span<const INPUT_RECORD> InputBuffer::_HandleConsoleSuspensionEvents(gsl::span<const INPUT_RECORD> inRecords,
+                                                                          _Inout_ std::vector<INPUT_RECORD>& filteredRecords)
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
 
-    std::deque<std::unique_ptr<IInputEvent>> outEvents;
-    while (!inEvents.empty())
+    // Most writes contain no suspension events at all, so nothing is
+    // copied until the first record that has to be dropped shows up.
+    bool filtering = false;
+    for (const INPUT_RECORD& record : inRecords)
     {
-        std::unique_ptr<IInputEvent> currEvent = std::move(inEvents.front());
-        inEvents.pop_front();
-        if (currEvent->EventType() == InputEventType::KeyEvent)
+        bool drop = false;
+        if (record.EventType == KEY_EVENT && record.Event.KeyEvent.bKeyDown)
         {
-            const KeyEvent* const pKeyEvent = static_cast<const KeyEvent* const>(currEvent.get());
-            if (pKeyEvent->IsKeyDown())
+            if (WI_IsFlagSet(gci.Flags, CONSOLE_SUSPENDED) &&
+                !IsSystemKey(record.Event.KeyEvent.wVirtualKeyCode))
             {
-                if (WI_IsFlagSet(gci.Flags, CONSOLE_SUSPENDED) &&
-                    !IsSystemKey(pKeyEvent->GetVirtualKeyCode()))
-                {
-                    UnblockWriteConsole(CONSOLE_OUTPUT_SUSPENDED);
-                    continue;
-                }
-                else if (WI_IsFlagSet(InputMode, ENABLE_LINE_INPUT) && pKeyEvent->IsPauseKey())
-                {
-                    WI_SetFlag(gci.Flags, CONSOLE_SUSPENDED);
-                    continue;
-                }
+                UnblockWriteConsole(CONSOLE_OUTPUT_SUSPENDED);
+                drop = true;
+            }
+            else if (WI_IsFlagSet(InputMode, ENABLE_LINE_INPUT) &&
+                     record.Event.KeyEvent.wVirtualKeyCode == VK_PAUSE)
+            {
+                WI_SetFlag(gci.Flags, CONSOLE_SUSPENDED);
+                drop = true;
             }
         }
-        outEvents.push_back(std::move(currEvent));
+
+        if (drop && !filtering)
+        {
+            filteredRecords.assign(inRecords.data(), &record);
+            filtering = true;
+        }
+        else if (!drop && filtering)
+        {
+            filteredRecords.push_back(record);
+        }
+    }
+
+    if (filtering)
+    {
+        return filteredRecords;
     }
-    inEvents.swap(outEvents);
+    return inRecords;
 }
 
 // Routine Description:
@@ -850,12 +1085,11 @@ void InputBuffer::_HandleTerminalInputCallback(std::deque<std::unique_ptr<IInput
     try
     {
         // add all input events to the storage queue
-        while (!inEvents.empty())
+        for (const auto& inEvent : inEvents)
         {
-            std::unique_ptr<IInputEvent> inEvent = std::move(inEvents.front());
-            inEvents.pop_front();
-            _storage.push_back(std::move(inEvent));
+            _storage.PushBack(inEvent->ToInputRecord());
         }
+        inEvents.clear();
     }
     catch (...)
     {
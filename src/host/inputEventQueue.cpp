@@ -0,0 +1,238 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "inputEventQueue.hpp"
+
+InputEventQueue::InputEventQueue() noexcept :
+    _buffer{},
+    _head{ 0 },
+    _size{ 0 }
+{
+}
+
+// Routine Description:
+// - Returns the number of events in the queue.
+size_t InputEventQueue::Size() const noexcept
+{
+    return _size;
+}
+
+// Routine Description:
+// - Returns true if there are no events in the queue.
+bool InputEventQueue::Empty() const noexcept
+{
+    return _size == 0;
+}
+
+// Routine Description:
+// - Returns how many events the queue can hold before it has to grow.
+size_t InputEventQueue::Capacity() const noexcept
+{
+    return _buffer.size();
+}
+
+// Routine Description:
+// - Gets the event at the given position, counting from the front.
+// Arguments:
+// - index - the position of the event. Must be less than Size().
+INPUT_RECORD& InputEventQueue::operator[](const size_t index) noexcept
+{
+    return _buffer[(_head + index) & (_buffer.size() - 1)];
+}
+
+const INPUT_RECORD& InputEventQueue::operator[](const size_t index) const noexcept
+{
+    return _buffer[(_head + index) & (_buffer.size() - 1)];
+}
+
+// Routine Description:
+// - Gets the oldest event. The queue must not be empty.
+INPUT_RECORD& InputEventQueue::Front() noexcept
+{
+    return (*this)[0];
+}
+
+// Routine Description:
+// - Gets the newest event. The queue must not be empty.
+INPUT_RECORD& InputEventQueue::Back() noexcept
+{
+    return (*this)[_size - 1];
+}
+
+// Routine Description:
+// - Appends an event to the queue.
+// Arguments:
+// - record - the event to append
+// Note:
+// - will throw if the queue needed to grow and couldn't
+void InputEventQueue::PushBack(const INPUT_RECORD& record)
+{
+    PushBack({ &record, 1 });
+}
+
+// Routine Description:
+// - Appends events to the queue, in order.
+// Arguments:
+// - records - the events to append
+// Note:
+// - will throw if the queue needed to grow and couldn't
+void InputEventQueue::PushBack(gsl::span<const INPUT_RECORD> records)
+{
+    const size_t count = gsl::narrow<size_t>(records.size());
+    if (count == 0)
+    {
+        return;
+    }
+
+    size_t newSize;
+    THROW_IF_FAILED(SizeTAdd(_size, count, &newSize));
+    _Reserve(newSize);
+
+    // The free space may wrap around the end of the ring,
+    // so the copy happens in up to two pieces.
+    const size_t tail = (_head + _size) & (_buffer.size() - 1);
+    const size_t firstPart = std::min(count, _buffer.size() - tail);
+    std::copy_n(records.data(), firstPart, _buffer.begin() + tail);
+    std::copy_n(records.data() + firstPart, count - firstPart, _buffer.begin());
+
+    _size = newSize;
+}
+
+// Routine Description:
+// - Removes events from the front of the queue.
+// Arguments:
+// - count - the number of events to remove. Must not be more than Size().
+void InputEventQueue::PopFront(const size_t count) noexcept
+{
+    FAIL_FAST_IF(count > _size);
+    if (count == 0)
+    {
+        return;
+    }
+
+    _head = (_head + count) & (_buffer.size() - 1);
+    _size -= count;
+    if (_size == 0)
+    {
+        _head = 0;
+        _ReleaseIfDrained();
+    }
+}
+
+// Routine Description:
+// - Replaces one event with any number of events, in place. Room is made by
+//   moving the events in front of it, on the assumption that index is close
+//   to the front of the queue.
+// Arguments:
+// - index - the position of the event to replace. Must be less than Size().
+// - records - the events to put in its place. May be empty.
+// Note:
+// - will throw if the queue needed to grow and couldn't
+void InputEventQueue::Replace(const size_t index, gsl::span<const INPUT_RECORD> records)
+{
+    FAIL_FAST_IF(index >= _size);
+    const size_t count = gsl::narrow<size_t>(records.size());
+
+    if (count == 0)
+    {
+        for (size_t i = index; i > 0; --i)
+        {
+            (*this)[i] = (*this)[i - 1];
+        }
+        PopFront(1);
+        return;
+    }
+
+    const size_t extra = count - 1;
+    size_t newSize;
+    THROW_IF_FAILED(SizeTAdd(_size, extra, &newSize));
+    _Reserve(newSize);
+
+    // Grow the queue at the front, and slide the events
+    // that were in front of index down into the new space.
+    _head = (_head - extra) & (_buffer.size() - 1);
+    _size = newSize;
+    for (size_t i = 0; i < index; ++i)
+    {
+        (*this)[i] = (*this)[i + extra];
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        (*this)[index + i] = records.data()[i];
+    }
+}
+
+// Routine Description:
+// - Removes all events from the queue.
+void InputEventQueue::Clear() noexcept
+{
+    _head = 0;
+    _size = 0;
+    _ReleaseIfDrained();
+}
+
+// Routine Description:
+// - Exchanges the contents of two queues without copying any events.
+void InputEventQueue::Swap(InputEventQueue& other) noexcept
+{
+    _buffer.swap(other._buffer);
+    std::swap(_head, other._head);
+    std::swap(_size, other._size);
+}
+
+// Routine Description:
+// - Rearranges the ring (if necessary) so that the events are contiguous,
+//   oldest first, and returns them.
+// Return Value:
+// - A view of every event in the queue. It is invalidated by any call that
+//   modifies the queue.
+gsl::span<const INPUT_RECORD> InputEventQueue::Linearize() noexcept
+{
+    if (_head + _size > _buffer.size())
+    {
+        std::rotate(_buffer.begin(), _buffer.begin() + _head, _buffer.end());
+        _head = 0;
+    }
+    return { _buffer.data() + _head, gsl::narrow_cast<ptrdiff_t>(_size) };
+}
+
+// Routine Description:
+// - Grows the ring to a power of two that can hold at least minCapacity
+//   events. The events are moved to the start of the new ring.
+// Arguments:
+// - minCapacity - the number of events the ring needs to hold.
+// Note:
+// - will throw on allocation failure
+void InputEventQueue::_Reserve(const size_t minCapacity)
+{
+    if (minCapacity <= _buffer.size())
+    {
+        return;
+    }
+
+    size_t newCapacity = std::max(InitialCapacity, _buffer.size());
+    while (newCapacity < minCapacity)
+    {
+        THROW_IF_FAILED(SizeTMult(newCapacity, 2, &newCapacity));
+    }
+
+    std::vector<INPUT_RECORD> newBuffer(newCapacity);
+    const auto events = Linearize();
+    std::copy(events.begin(), events.end(), newBuffer.begin());
+
+    _buffer.swap(newBuffer);
+    _head = 0;
+}
+
+// Routine Description:
+// - Frees the ring if the queue is empty and the ring has grown past
+//   RetainedCapacity. It will be allocated again by the next push.
+void InputEventQueue::_ReleaseIfDrained() noexcept
+{
+    if (_size == 0 && _buffer.size() > RetainedCapacity)
+    {
+        std::vector<INPUT_RECORD>{}.swap(_buffer);
+        _head = 0;
+    }
+}
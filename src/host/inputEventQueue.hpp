@@ -0,0 +1,77 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- inputEventQueue.hpp
+
+Abstract:
+- FIFO storage for the input buffer's events.
+- Events are kept by value as INPUT_RECORDs in a ring over a single
+  allocation, so queueing an event never allocates unless the ring is full.
+  A full ring doubles in size. A ring that has grown large is released again
+  once it drains, so that a big paste doesn't pin its memory for the lifetime
+  of the console.
+--*/
+
+#pragma once
+
+class InputEventQueue final
+{
+public:
+    InputEventQueue() noexcept;
+
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+    size_t Capacity() const noexcept;
+
+    INPUT_RECORD& operator[](const size_t index) noexcept;
+    const INPUT_RECORD& operator[](const size_t index) const noexcept;
+    INPUT_RECORD& Front() noexcept;
+    INPUT_RECORD& Back() noexcept;
+
+    void PushBack(const INPUT_RECORD& record);
+    void PushBack(gsl::span<const INPUT_RECORD> records);
+    void PopFront(const size_t count) noexcept;
+    void Replace(const size_t index, gsl::span<const INPUT_RECORD> records);
+    void Clear() noexcept;
+    void Swap(InputEventQueue& other) noexcept;
+
+    gsl::span<const INPUT_RECORD> Linearize() noexcept;
+
+    // Routine Description:
+    // - Removes every event that matches the predicate, keeping the order
+    //   of the rest.
+    // Arguments:
+    // - pred - called with each INPUT_RECORD. Returns true to remove it.
+    template<typename Pred>
+    void RemoveIf(Pred pred) noexcept
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < _size; ++i)
+        {
+            const INPUT_RECORD& record = (*this)[i];
+            if (!pred(record))
+            {
+                (*this)[kept++] = record;
+            }
+        }
+        _size = kept;
+        _ReleaseIfDrained();
+    }
+
+    // The ring starts out (and is reset to) this many events.
+    static constexpr size_t InitialCapacity = 64;
+
+    // A drained ring bigger than this is freed rather than kept around.
+    static constexpr size_t RetainedCapacity = 4096;
+
+private:
+    void _Reserve(const size_t minCapacity);
+    void _ReleaseIfDrained() noexcept;
+
+    // Always empty or a power of two in size, so that indices wrap with a mask.
+    std::vector<INPUT_RECORD> _buffer;
+    size_t _head;
+    size_t _size;
+};
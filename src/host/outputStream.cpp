@@ -292,6 +292,22 @@ BOOL ConhostInternalGetSet::PrivateWriteConsoleInputW(_Inout_ std::deque<std::un
                                                     true)); // append
 }
 
+// Routine Description:
+// - Writes text to the end of the input buffer, as if it was typed. Unlike
+//   PrivateWriteConsoleInputW, the text isn't converted to key events up front.
+// Arguments:
+// - text - the text to write
+// - charsWritten - on output, the number of characters written
+// Return Value:
+// - TRUE if successful (see DoSrvPrivateWriteConsoleInputString). FALSE otherwise.
+BOOL ConhostInternalGetSet::PrivateWriteConsoleInputString(const std::wstring_view text,
+                                                           _Out_ size_t& charsWritten)
+{
+    return SUCCEEDED(DoSrvPrivateWriteConsoleInputString(_io.GetActiveInputBuffer(),
+                                                         text,
+                                                         charsWritten));
+}
+
 // Routine Description:
 // - Connects the ScrollConsoleScreenBuffer API call directly into our Driver Message servicing call inside Conhost.exe
 // Arguments:
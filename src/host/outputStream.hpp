@@ -91,6 +91,8 @@ public:
 
     BOOL PrivateWriteConsoleInputW(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& events,
                                    _Out_ size_t& eventsWritten) override;
+    BOOL PrivateWriteConsoleInputString(const std::wstring_view text,
+                                        _Out_ size_t& charsWritten) override;
 
     BOOL ScrollConsoleScreenBufferW(const SMALL_RECT* pScrollRectangle,
                                     _In_opt_ const SMALL_RECT* pClipRectangle,
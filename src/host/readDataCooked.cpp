@@ -577,6 +577,7 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
     else
     {
         bool CallWrite = true;
+        bool fReplacedInPlace = false;
         const SHORT sScreenBufferSizeX = _screenInfo.GetBufferSize().Width();
 
         // processing in the middle of the line is more complex:
@@ -676,6 +677,14 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
                     }
                 }
 
+                if (!_insertMode)
+                {
+                    // Overtyping a plain narrow character with another one
+                    // doesn't move anything else on the line.
+                    fReplacedInPlace = !IS_CONTROL_CHAR(*_bufPtr) && !IsGlyphFullWidth(*_bufPtr) &&
+                                       !IS_CONTROL_CHAR(wch) && !IsGlyphFullWidth(wch);
+                }
+
                 if (_insertMode)
                 {
                     memmove(_bufPtr + 1,
@@ -701,35 +710,44 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
 
         if (_echoInput && CallWrite)
         {
-            COORD CursorPosition;
+            // The cursor is sitting on the first character that changed: the
+            // one that was just stored, or the one that backspace stopped on.
+            const COORD ChangedPosition = _screenInfo.GetTextBuffer().GetCursor().GetPosition();
 
             // save cursor position
-            CursorPosition = _screenInfo.GetTextBuffer().GetCursor().GetPosition();
+            COORD CursorPosition = ChangedPosition;
             CursorPosition.X = (SHORT)(CursorPosition.X + NumSpaces);
 
-            // clear the current command line from the screen
-            // clang-format off
-#pragma prefast(suppress: __WARNING_BUFFER_OVERFLOW, "Not sure why prefast doesn't like this call.")
-            // clang-format on
-            DeleteCommandLine(*this, FALSE);
-
-            // write the new command line to the screen
-            NumToWrite = _bytesRead;
-
             DWORD dwFlags = WC_DESTRUCTIVE_BACKSPACE | WC_ECHO;
             if (wch == UNICODE_CARRIAGERETURN)
             {
+                // the carriage return was appended at the end, so the whole line is written out again
                 dwFlags |= WC_KEEP_CURSOR_VISIBLE;
+                status = RedrawLineFrom(0, _originalCursorPosition, dwFlags, &ScrollY);
+            }
+            else
+            {
+                // everything before the edit is still on the screen as it was
+                const bool erasedChar = wch == UNICODE_BACKSPACE && _processedInput;
+                const size_t ChangedIndex = erasedChar ? _currentPosition : _currentPosition - 1;
+                if (fReplacedInPlace)
+                {
+                    NumToWrite = sizeof(WCHAR);
+                    status = WriteCharsLegacy(_screenInfo,
+                                              _backupLimit,
+                                              _backupLimit + ChangedIndex,
+                                              _backupLimit + ChangedIndex,
+                                              &NumToWrite,
+                                              nullptr,
+                                              _originalCursorPosition.X,
+                                              dwFlags,
+                                              &ScrollY);
+                }
+                else
+                {
+                    status = RedrawLineFrom(ChangedIndex, ChangedPosition, dwFlags, &ScrollY);
+                }
             }
-            status = WriteCharsLegacy(_screenInfo,
-                                      _backupLimit,
-                                      _backupLimit,
-                                      _backupLimit,
-                                      &NumToWrite,
-                                      &_visibleCharCount,
-                                      _originalCursorPosition.X,
-                                      dwFlags,
-                                      &ScrollY);
             if (!NT_SUCCESS(status))
             {
                 RIPMSG1(RIP_WARNING, "WriteCharsLegacy failed 0x%x", status);
@@ -815,6 +833,91 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
     return false;
 }
 
+// Routine Description:
+// - Redraws the edit line from the given character to its end. The cells
+//   before that character are left alone, so an edit in the middle of a long
+//   line only costs as much as the part of the line that moved.
+// - If the line has scrolled off the top of the buffer, or the given position
+//   doesn't fit the line as it was last drawn, the whole line is redrawn.
+// - Leaves the cursor at the end of the line. The caller is expected to put
+//   it back where it belongs.
+// Arguments:
+// - index - the first character that changed
+// - position - the screen position of that character
+// - dwFlags - the WC_* flags to write the characters with
+// - psScrollY - if given, gets the number of rows the buffer scrolled by
+// Return Value:
+// - The status of writing the characters out.
+[[nodiscard]] NTSTATUS COOKED_READ_DATA::RedrawLineFrom(const size_t index,
+                                                        const COORD position,
+                                                        const DWORD dwFlags,
+                                                        _Inout_opt_ PSHORT const psScrollY) noexcept
+{
+    const SHORT sScreenBufferSizeX = _screenInfo.GetBufferSize().Width();
+    const ptrdiff_t cellsBefore = (position.Y - _originalCursorPosition.Y) * sScreenBufferSizeX +
+                                  (position.X - _originalCursorPosition.X);
+
+    size_t NumToWrite;
+    size_t NumSpaces = 0;
+    NTSTATUS status;
+    if (_originalCursorPosition.Y < 0 ||
+        cellsBefore < 0 ||
+        gsl::narrow_cast<size_t>(cellsBefore) > _visibleCharCount ||
+        index * sizeof(wchar_t) > _bytesRead)
+    {
+        DeleteCommandLine(*this, false);
+
+        NumToWrite = _bytesRead;
+        status = WriteCharsLegacy(_screenInfo,
+                                  _backupLimit,
+                                  _backupLimit,
+                                  _backupLimit,
+                                  &NumToWrite,
+                                  &NumSpaces,
+                                  _originalCursorPosition.X,
+                                  dwFlags,
+                                  psScrollY);
+    }
+    else
+    {
+        // Blank out the old tail first, in case the line got shorter. One
+        // more cell is cleared for the same reason DeleteCommandLine does.
+        size_t CharsToWrite = _visibleCharCount - cellsBefore;
+        if (!CheckBisectStringW(_backupLimit,
+                                _visibleCharCount,
+                                sScreenBufferSizeX - _originalCursorPosition.X))
+        {
+            CharsToWrite++;
+        }
+
+        try
+        {
+            _screenInfo.Write(OutputCellIterator(UNICODE_SPACE, CharsToWrite), position);
+        }
+        CATCH_LOG();
+
+        LOG_IF_FAILED(_screenInfo.SetCursorPosition(position, true));
+
+        NumToWrite = _bytesRead - index * sizeof(wchar_t);
+        status = WriteCharsLegacy(_screenInfo,
+                                  _backupLimit,
+                                  _backupLimit + index,
+                                  _backupLimit + index,
+                                  &NumToWrite,
+                                  &NumSpaces,
+                                  _originalCursorPosition.X,
+                                  dwFlags,
+                                  psScrollY);
+        NumSpaces += cellsBefore;
+    }
+
+    if (NT_SUCCESS(status))
+    {
+        _visibleCharCount = NumSpaces;
+    }
+    return status;
+}
+
 // Routine Description:
 // - Writes string to current position in prompt line. can overwrite text to the right of the cursor.
 // Arguments:
@@ -103,6 +103,10 @@ public:
     void SetReportedByteCount(const size_t count) noexcept;
 
     void Erase() noexcept;
+    [[nodiscard]] NTSTATUS RedrawLineFrom(const size_t index,
+                                          const COORD position,
+                                          const DWORD dwFlags,
+                                          _Inout_opt_ PSHORT const psScrollY) noexcept;
     size_t SavePromptToUserBuffer(const size_t cch);
     void SavePendingInput(const size_t cch, const bool multiline);
 
@@ -75,8 +75,7 @@ void Registry::GetEditKeys(_In_opt_ HKEY hConsoleKey) const
     // The space character is always considered a word delimiter, no matter the scenario.
     //
     // Read word delimiters from registry
-    auto& delimiters = ServiceLocator::LocateGlobals().WordDelimiters;
-    delimiters.clear();
+    std::wstring delimiters;
     Status = RegistrySerialization::s_QueryValue(hConsoleKey,
                                                  CONSOLE_REGISTRY_WORD_DELIM,
                                                  sizeof(dwValue),
@@ -111,9 +110,10 @@ void Registry::GetEditKeys(_In_opt_ HKEY hConsoleKey) const
         else
         {
             // the key isn't a REG_DWORD or a REG_SZ, fall back to our default word delimiters
-            delimiters = { '\\', '+', '!', ':', '=', '/', '.', '<', '>', ';', '|', '&' };
+            delimiters = L"\\+!:=/.<>;|&";
         }
     }
+    ServiceLocator::LocateGlobals().WordDelimiters = Microsoft::Console::Types::DelimiterClassTable{ delimiters };
     // --- END LOAD BEARING CODE ---
 
     if (hCurrentUserKey)
@@ -228,6 +228,7 @@ bool RenderData::IsCursorDoubleWidth() const noexcept
 // Method Description:
 // - Retrieves one rectangle per line describing the area of the viewport
 //   that should be highlighted in some way to represent a user-interactive selection
+// - Selected rows outside of the viewport are left out.
 // Return Value:
 // - Vector of Viewports describing the area selected
 std::vector<Viewport> RenderData::GetSelectionRects() noexcept
@@ -236,7 +237,7 @@ std::vector<Viewport> RenderData::GetSelectionRects() noexcept
 
     try
     {
-        for (const auto& select : Selection::Instance().GetSelectionRects())
+        for (const auto& select : Selection::Instance().GetSelectionRects(GetViewport()))
         {
             result.emplace_back(Viewport::FromInclusive(select));
         }
@@ -52,6 +52,7 @@ SCREEN_INFORMATION::SCREEN_INFORMATION(
     _viewport(Viewport::Empty()),
     _psiAlternateBuffer{ nullptr },
     _psiMainBuffer{ nullptr },
+    _psiRetiredAltBuffer{ nullptr },
     _rcAltSavedClientNew{ 0 },
     _rcAltSavedClientOld{ 0 },
     _fAltWindowChanged{ false },
@@ -221,6 +222,35 @@ void SCREEN_INFORMATION::s_InsertScreenBuffer(_In_ SCREEN_INFORMATION* const pSc
 // Note:
 // - The console lock must be held when calling this routine.
 void SCREEN_INFORMATION::s_RemoveScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo)
+{
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    s_UnlinkScreenBuffer(pScreenInfo);
+
+    if (pScreenInfo == gci.pCurrentScreenBuffer &&
+        gci.ScreenBuffers != gci.pCurrentScreenBuffer)
+    {
+        if (gci.ScreenBuffers != nullptr)
+        {
+            SetActiveScreenBuffer(*gci.ScreenBuffers);
+        }
+        else
+        {
+            gci.pCurrentScreenBuffer = nullptr;
+        }
+    }
+
+    delete pScreenInfo;
+}
+
+// Routine Description:
+// - This routine takes the screen buffer pointer out of the console's list of
+//   screen buffers, without deleting it or changing the active buffer.
+// Arguments:
+// - ScreenInfo - Pointer to screen information structure. Must be in the list.
+// Return Value:
+// Note:
+// - The console lock must be held when calling this routine.
+void SCREEN_INFORMATION::s_UnlinkScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo)
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     if (pScreenInfo == gci.ScreenBuffers)
@@ -246,20 +276,7 @@ void SCREEN_INFORMATION::s_RemoveScreenBuffer(_In_ SCREEN_INFORMATION* const pSc
         Prev->Next = Cur->Next;
     }
 
-    if (pScreenInfo == gci.pCurrentScreenBuffer &&
-        gci.ScreenBuffers != gci.pCurrentScreenBuffer)
-    {
-        if (gci.ScreenBuffers != nullptr)
-        {
-            SetActiveScreenBuffer(*gci.ScreenBuffers);
-        }
-        else
-        {
-            gci.pCurrentScreenBuffer = nullptr;
-        }
-    }
-
-    delete pScreenInfo;
+    pScreenInfo->Next = nullptr;
 }
 
 #pragma endregion
@@ -301,6 +318,10 @@ void SCREEN_INFORMATION::_FreeOutputStateMachine()
             s_RemoveScreenBuffer(_psiAlternateBuffer);
         }
 
+        // The retired alt isn't in the buffer list, so it only needs deleting.
+        delete _psiRetiredAltBuffer;
+        _psiRetiredAltBuffer = nullptr;
+
         _stateMachine.reset();
     }
 }
@@ -2035,6 +2056,57 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
     return Status;
 }
 
+// Routine Description:
+// - Returns an alternate buffer that has already been used to the state
+//     _CreateAltBuffer would have created it in, without reallocating its rows.
+//     The alt must already have the size of this buffer's viewport.
+// Parameters:
+// - siAlt - the alternate buffer to reset. May be this buffer.
+// Return value:
+// - <none>
+void SCREEN_INFORMATION::_RecycleAltBuffer(SCREEN_INFORMATION& siAlt)
+{
+    // Take everything we need from ourselves first, since we may be the alt.
+    const auto attributes = GetAttributes();
+    const auto popupAttributes = *GetPopupAttributes();
+    const auto font = GetCurrentFont();
+    const auto& myCursor = GetTextBuffer().GetCursor();
+    const auto cursorSize = myCursor.GetSize();
+    const auto cursorColor = myCursor.GetColor();
+    const auto cursorType = myCursor.GetType();
+
+    const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    siAlt.OutputMode = ENABLE_PROCESSED_OUTPUT | ENABLE_WRAP_AT_EOL_OUTPUT;
+    if (gci.GetVirtTermLevel() != 0)
+    {
+        siAlt.OutputMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+    }
+    siAlt.WriteConsoleDbcsLeadByte[0] = 0;
+    siAlt.WriteConsoleDbcsLeadByte[1] = 0;
+    siAlt.FillOutDbcsLeadChar = 0;
+    siAlt._PopupAttributes = popupAttributes;
+    siAlt._currentFont = font;
+    siAlt._desiredFont = FontInfoDesired{ font };
+    siAlt._scrollMargins = Viewport::FromCoord({ 0 });
+    siAlt._viewport = Viewport::FromDimensions({ 0, 0 }, siAlt.GetBufferSize().Dimensions());
+    siAlt.UpdateBottom();
+
+    // Clear the rows where they are rather than building new ones.
+    auto& textBuffer = siAlt.GetTextBuffer();
+    textBuffer.SetCurrentAttributes(attributes);
+    textBuffer.Reset();
+
+    auto& cursor = textBuffer.GetCursor();
+    cursor.SetPosition({ 0, 0 });
+    cursor.SetIsVisible(true);
+    cursor.SetIsOn(true);
+    cursor.SetBlinkingAllowed(true);
+    cursor.SetIsDouble(false);
+    cursor.SetStyle(cursorSize, cursorColor, cursorType);
+
+    siAlt.SetDefaultVtTabStops();
+}
+
 // Routine Description:
 // - Creates an "alternate" screen buffer for this buffer. In virtual terminals, there exists both a "main"
 //     screen buffer and an alternate. ASBSET creates a new alternate, and switches to it. If there is an already
@@ -2054,19 +2126,50 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
         siMain._fAltWindowChanged = false;
     }
 
+    // Prefer the alt we're already in, then the one we left last time. Either
+    // can be reset in place if it's still the size a new alt would be.
+    // Otherwise it's discarded below, once its replacement exists. The retired
+    // alt isn't on the buffer list, and only goes back on it if it's reused.
+    SCREEN_INFORMATION* psiOldAltBuffer = siMain._psiAlternateBuffer;
+    const bool oldAltIsRetired = psiOldAltBuffer == nullptr && siMain._psiRetiredAltBuffer != nullptr;
+    if (oldAltIsRetired)
+    {
+        psiOldAltBuffer = siMain._psiRetiredAltBuffer;
+    }
+
     SCREEN_INFORMATION* psiNewAltBuffer;
-    NTSTATUS Status = _CreateAltBuffer(&psiNewAltBuffer);
+    NTSTATUS Status = STATUS_SUCCESS;
+    if (psiOldAltBuffer != nullptr &&
+        psiOldAltBuffer->GetBufferSize().Dimensions() == _viewport.Dimensions())
+    {
+        if (oldAltIsRetired)
+        {
+            siMain._psiRetiredAltBuffer = nullptr;
+            s_InsertScreenBuffer(psiOldAltBuffer);
+        }
+        _RecycleAltBuffer(*psiOldAltBuffer);
+        psiNewAltBuffer = psiOldAltBuffer;
+        psiOldAltBuffer = nullptr;
+    }
+    else
+    {
+        Status = _CreateAltBuffer(&psiNewAltBuffer);
+    }
+
     if (NT_SUCCESS(Status))
     {
         // if this is already an alternate buffer, we want to make the new
         // buffer the alt on our main buffer, not on ourself, because there
         // can only ever be one main and one alternate.
-        SCREEN_INFORMATION* const psiOldAltBuffer = siMain._psiAlternateBuffer;
-
         psiNewAltBuffer->_psiMainBuffer = &siMain;
         siMain._psiAlternateBuffer = psiNewAltBuffer;
 
-        if (psiOldAltBuffer != nullptr)
+        if (psiOldAltBuffer != nullptr && oldAltIsRetired)
+        {
+            siMain._psiRetiredAltBuffer = nullptr;
+            delete psiOldAltBuffer;
+        }
+        else if (psiOldAltBuffer != nullptr)
         {
             s_RemoveScreenBuffer(psiOldAltBuffer); // this will also delete the old alt buffer
         }
@@ -2107,10 +2210,14 @@ void SCREEN_INFORMATION::UseMainScreenBuffer()
         // send a _coordScreenBufferSizeChangeEvent for the new Sb viewport
         ScreenBufferSizeChange(psiMain->GetBufferSize().Dimensions());
 
+        // Keep the alt around instead of deleting it, so that the next ASBSET
+        // (apps like vim and less send one every time they start) doesn't have
+        // to allocate a whole screen of rows again.
         SCREEN_INFORMATION* psiAlt = psiMain->_psiAlternateBuffer;
         psiMain->_psiAlternateBuffer = nullptr;
-        s_RemoveScreenBuffer(psiAlt); // this will also delete the alt buffer
-        // deleting the alt buffer will give the GetSet back to its main
+        s_UnlinkScreenBuffer(psiAlt);
+        delete psiMain->_psiRetiredAltBuffer;
+        psiMain->_psiRetiredAltBuffer = psiAlt;
 
         // Tell the VT MouseInput handler that we're in the main buffer now
         gci.terminalMouseInput.UseMainScreenBuffer();
@@ -2151,33 +2258,32 @@ bool SCREEN_INFORMATION::_IsInPtyMode() const
 // Note: may throw exception on allocation error
 void SCREEN_INFORMATION::AddTabStop(const SHORT sColumn)
 {
-    if (std::find(_tabStops.begin(), _tabStops.end(), sColumn) == _tabStops.end())
-    {
-        _tabStops.push_back(sColumn);
-        _tabStops.sort();
-    }
+    _tabStops.Set(gsl::narrow<size_t>(sColumn));
 }
 
 // Routine Description:
-// - Clears all of the VT tabs that have been set. This also deletes them.
+// - Clears all of the VT tabs that have been set.
 // Parameters:
 // <none>
 // Return value:
 // <none>
 void SCREEN_INFORMATION::ClearTabStops() noexcept
 {
-    _tabStops.clear();
+    _tabStops.ClearAll();
 }
 
 // Routine Description:
-// - Clears the VT tab in the column sColumn (if one has been set). Also deletes it from the heap.
+// - Clears the VT tab in the column sColumn (if one has been set).
 // Parameters:
 // - sColumn - The column to clear the tab stop for.
 // Return value:
 // <none>
 void SCREEN_INFORMATION::ClearTabStop(const SHORT sColumn) noexcept
 {
-    _tabStops.remove(sColumn);
+    if (sColumn >= 0)
+    {
+        _tabStops.Clear(gsl::narrow_cast<size_t>(sColumn));
+    }
 }
 
 // Routine Description:
@@ -2195,20 +2301,17 @@ COORD SCREEN_INFORMATION::GetForwardTab(const COORD cCurrCursorPos) const noexce
         cNewCursorPos.X = 0;
         cNewCursorPos.Y += 1;
     }
-    else if (_tabStops.empty() || cCurrCursorPos.X >= _tabStops.back())
-    {
-        cNewCursorPos.X = sWidth;
-    }
     else
     {
-        // search for next tab stop
-        for (auto it = _tabStops.cbegin(); it != _tabStops.cend(); ++it)
+        // If there's no stop left in this row, go to the end of it.
+        const auto nextStop = _tabStops.Next(gsl::narrow_cast<size_t>(std::max<SHORT>(cCurrCursorPos.X, 0)));
+        if (nextStop.has_value() && nextStop.value() < gsl::narrow_cast<size_t>(sWidth))
         {
-            if (*it > cCurrCursorPos.X)
-            {
-                cNewCursorPos.X = *it;
-                break;
-            }
+            cNewCursorPos.X = gsl::narrow_cast<SHORT>(nextStop.value());
+        }
+        else
+        {
+            cNewCursorPos.X = sWidth;
         }
     }
     return cNewCursorPos;
@@ -2223,22 +2326,9 @@ COORD SCREEN_INFORMATION::GetForwardTab(const COORD cCurrCursorPos) const noexce
 COORD SCREEN_INFORMATION::GetReverseTab(const COORD cCurrCursorPos) const noexcept
 {
     COORD cNewCursorPos = cCurrCursorPos;
-    // if we're at 0, or there are NO tabs, or the first tab is farther right than where we are
-    if (cCurrCursorPos.X == 0 || _tabStops.empty() || _tabStops.front() >= cCurrCursorPos.X)
-    {
-        cNewCursorPos.X = 0;
-    }
-    else
-    {
-        for (auto it = _tabStops.crbegin(); it != _tabStops.crend(); ++it)
-        {
-            if (*it < cCurrCursorPos.X)
-            {
-                cNewCursorPos.X = *it;
-                break;
-            }
-        }
-    }
+    // if we're at 0, or there are no tabs before where we are
+    const auto previousStop = cCurrCursorPos.X > 0 ? _tabStops.Previous(gsl::narrow_cast<size_t>(cCurrCursorPos.X)) : std::nullopt;
+    cNewCursorPos.X = gsl::narrow_cast<SHORT>(previousStop.value_or(0));
     return cNewCursorPos;
 }
 
@@ -2250,24 +2340,19 @@ COORD SCREEN_INFORMATION::GetReverseTab(const COORD cCurrCursorPos) const noexce
 // - true if any VT-style tab stops have been set
 bool SCREEN_INFORMATION::AreTabsSet() const noexcept
 {
-    return !_tabStops.empty();
+    return _tabStops.Any();
 }
 
 // Routine Description:
 // - adds default tab stops for vt mode
 void SCREEN_INFORMATION::SetDefaultVtTabStops()
 {
-    _tabStops.clear();
     const int width = GetBufferSize().RightInclusive();
     FAIL_FAST_IF(width < 0);
-    for (int pos = 0; pos <= width; pos += TAB_SIZE)
-    {
-        _tabStops.push_back(gsl::narrow<short>(pos));
-    }
-    if (_tabStops.back() != width)
-    {
-        _tabStops.push_back(gsl::narrow<short>(width));
-    }
+
+    _tabStops.ClearAll();
+    _tabStops.SetEvery(TAB_SIZE, 0, gsl::narrow_cast<size_t>(width) + 1);
+    _tabStops.Set(gsl::narrow_cast<size_t>(width));
 }
 
 // Routine Description:
@@ -2648,32 +2733,12 @@ std::pair<COORD, COORD> SCREEN_INFORMATION::GetWordBoundary(const COORD position
     COORD clampedPosition = position;
     GetBufferSize().Clamp(clampedPosition);
 
-    COORD start{ clampedPosition };
-    COORD end{ clampedPosition };
+    // find the start and end of the word in one pass over the row's text
+    const auto text = _textBuffer->GetRowByOffset(clampedPosition.Y).GetCharRow().GetColumnText();
+    const auto word = ServiceLocator::LocateGlobals().WordDelimiters.FindWord(text, clampedPosition.X);
 
-    // find the start of the word
-    auto startIt = GetTextLineDataAt(clampedPosition);
-    while (startIt)
-    {
-        --startIt;
-        if (!startIt || IsWordDelim(*startIt))
-        {
-            break;
-        }
-        --start.X;
-    }
-
-    // find the end of the word
-    auto endIt = GetTextLineDataAt(clampedPosition);
-    while (endIt)
-    {
-        if (IsWordDelim(*endIt))
-        {
-            break;
-        }
-        ++endIt;
-        ++end.X;
-    }
+    COORD start{ gsl::narrow<SHORT>(word.first), clampedPosition.Y };
+    COORD end{ gsl::narrow<SHORT>(word.second), clampedPosition.Y };
 
     // trim leading zeros if we need to
     const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
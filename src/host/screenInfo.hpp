@@ -48,6 +48,7 @@ Revision History:
 #include "../renderer/inc/FontInfoDesired.hpp"
 
 #include "../types/inc/Viewport.hpp"
+#include "../types/inc/TabStops.hpp"
 class ConversionAreaInfo; // forward decl window. circular reference
 
 class SCREEN_INFORMATION : public ConsoleObjectHeader, public Microsoft::Console::IIoProvider
@@ -275,6 +276,9 @@ private:
     void _FreeOutputStateMachine();
 
     [[nodiscard]] NTSTATUS _CreateAltBuffer(_Out_ SCREEN_INFORMATION** const ppsiNewScreenBuffer);
+    void _RecycleAltBuffer(SCREEN_INFORMATION& siAlt);
+
+    static void s_UnlinkScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo);
 
     bool _IsAltBuffer() const;
     bool _IsInPtyMode() const;
@@ -289,12 +293,13 @@ private:
 
     SCREEN_INFORMATION* _psiAlternateBuffer; // The VT "Alternate" screen buffer.
     SCREEN_INFORMATION* _psiMainBuffer; // A pointer to the main buffer, if this is the alternate buffer.
+    SCREEN_INFORMATION* _psiRetiredAltBuffer; // The last alternate buffer, kept off the buffer list so the next ASBSET can reuse it.
 
     RECT _rcAltSavedClientNew;
     RECT _rcAltSavedClientOld;
     bool _fAltWindowChanged;
 
-    std::list<short> _tabStops;
+    Microsoft::Console::Types::TabStops _tabStops;
 
     TextAttribute _PopupAttributes;
 
@@ -10,6 +10,7 @@
 #include "../interactivity/inc/ServiceLocator.hpp"
 
 using namespace Microsoft::Console::Interactivity;
+using namespace Microsoft::Console::Types;
 
 std::unique_ptr<Selection> Selection::_instance;
 
@@ -44,13 +45,15 @@ Selection& Selection::Instance()
 // - selectionRect - The selection rectangle outlining the region to be selected
 // - selectionAnchor - The corner of the selection rectangle that selection started from
 // - lineSelection - True to process in line mode. False to process in block mode.
+// - clip - Only rows inside this area are returned. The rest are never computed.
 // Return Value:
 // - Returns a vector where each SMALL_RECT is one Row worth of the area to be selected.
 // - Returns empty vector if no rows are selected.
 // - Throws exceptions for out of memory issues
 std::vector<SMALL_RECT> Selection::s_GetSelectionRects(const SMALL_RECT& selectionRect,
                                                        const COORD selectionAnchor,
-                                                       const bool lineSelection)
+                                                       const bool lineSelection,
+                                                       const Viewport& clip)
 {
     std::vector<SMALL_RECT> selectionAreas;
 
@@ -91,8 +94,16 @@ std::vector<SMALL_RECT> Selection::s_GetSelectionRects(const SMALL_RECT& selecti
         }
     }
 
-    // for each row within the selection rectangle
-    for (short i = selectionRect.Top; i <= selectionRect.Bottom; i++)
+    // for each row within the selection rectangle that's also inside the clip
+    const short firstRow = std::max(selectionRect.Top, clip.Top());
+    const short lastRow = std::min(selectionRect.Bottom, clip.BottomInclusive());
+    if (firstRow > lastRow)
+    {
+        return selectionAreas;
+    }
+
+    selectionAreas.reserve(lastRow - firstRow + 1);
+    for (short i = firstRow; i <= lastRow; i++)
     {
         // create a rectangle representing the highlight on one row
         SMALL_RECT highlightRow;
@@ -152,13 +163,29 @@ std::vector<SMALL_RECT> Selection::s_GetSelectionRects(const SMALL_RECT& selecti
 // - Returns empty vector if no rows are selected.
 // - Throws exceptions for out of memory issues
 std::vector<SMALL_RECT> Selection::GetSelectionRects() const
+{
+    const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    return GetSelectionRects(gci.GetActiveOutputBuffer().GetBufferSize());
+}
+
+// Routine Description:
+// - Detemines the line-by-line selection rectangles based on global selection
+//   state, for only the rows inside the given area. The renderer uses this to
+//   get just the rows in the viewport, however many rows are selected.
+// Arguments:
+// - clip - The area of the buffer to get rows for. Only its rows are used.
+// Return Value:
+// - Returns a vector where each SMALL_RECT is one Row worth of the area to be selected.
+// - Returns empty vector if no rows are selected.
+// - Throws exceptions for out of memory issues
+std::vector<SMALL_RECT> Selection::GetSelectionRects(const Viewport& clip) const
 {
     if (!_fSelectionVisible)
     {
         return std::vector<SMALL_RECT>();
     }
 
-    return s_GetSelectionRects(_srSelectionRect, _coordSelectionAnchor, IsLineSelection());
+    return s_GetSelectionRects(_srSelectionRect, _coordSelectionAnchor, IsLineSelection(), clip);
 }
 
 // Routine Description:
@@ -579,7 +606,11 @@ void Selection::ColorSelection(const COORD coordSelectionStart, const COORD coor
     // Extract row-by-row selection rectangles for the selection area.
     try
     {
-        const auto rectangles = s_GetSelectionRects(srSelection, coordSelectionStart, true);
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto rectangles = s_GetSelectionRects(srSelection,
+                                                    coordSelectionStart,
+                                                    true,
+                                                    gci.GetActiveOutputBuffer().GetBufferSize());
         for (const auto& rect : rectangles)
         {
             ColorSelection(rect, attr);
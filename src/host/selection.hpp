@@ -29,6 +29,7 @@ public:
     ~Selection() = default;
 
     std::vector<SMALL_RECT> GetSelectionRects() const;
+    std::vector<SMALL_RECT> GetSelectionRects(const Microsoft::Console::Types::Viewport& clip) const;
 
     void ShowSelection();
     void HideSelection();
@@ -79,7 +80,8 @@ private:
 
     static std::vector<SMALL_RECT> s_GetSelectionRects(const SMALL_RECT& selectionRect,
                                                        const COORD selectionAnchor,
-                                                       const bool lineSelection);
+                                                       const bool lineSelection,
+                                                       const Microsoft::Console::Types::Viewport& clip);
 
     void _CancelMarkSelection();
     void _CancelMouseSelection();
@@ -371,280 +371,173 @@ class AliasTests
         VERIFY_ARE_EQUAL(dwLinesExpected, dwLines, L"Line count be updated to 1.");
     }
 
-    TEST_METHOD(TrimTrailing)
+    TEST_METHOD(TestMatchAndCopyMixedCase)
     {
-        BEGIN_TEST_METHOD_PROPERTIES()
-            TEST_METHOD_PROPERTY(L"Data:targetExpectedPair",
-                                 L"{"
-                                 L"bar%=bar," // The character % will be turned into an \r\n
-                                 L"bar=bar"
-                                 L"}")
-        END_TEST_METHOD_PROPERTIES()
-
-        std::wstring target;
-        std::wstring expected;
-        _RetrieveTargetExpectedPair(target, expected);
+        // Aliases are stored lowercase by AddConsoleAlias, but matched regardless of case.
+        std::wstring exe(L"test.exe");
+        std::wstring source(L"foo");
+        std::wstring target(L"bar $2 $1$t$*");
+        Alias::s_TestAddAlias(exe, source, target);
 
-        // Substitute %s from metadata into \r\n (since metadata can't hold \r\n)
-        _ReplacePercentWithCRLF(target);
-        _ReplacePercentWithCRLF(expected);
+        // Redefining an alias has to replace its compiled expansion too.
+        target = L"baz $2 $1$t$*";
+        Alias::s_TestAddAlias(exe, source, target);
 
-        Alias::s_TrimTrailingCrLf(target);
+        std::wstring sourceText(L"  fOO one two\r\n");
+        size_t lines = 0;
+        const auto actual = Alias::s_MatchAndCopyAlias(sourceText, L"TEST.Exe", lines);
 
-        VERIFY_ARE_EQUAL(String(expected.data()), String(target.data()));
+        VERIFY_ARE_EQUAL(String(L"baz two one\r\none two\r\n"), String(actual.c_str()));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(2), lines);
     }
 
-    TEST_METHOD(Tokenize)
+    TEST_METHOD(AliasLookupBenchmark)
     {
-        std::wstring tokenStr(L"one two three");
-        std::deque<std::wstring> tokensExpected;
-        tokensExpected.emplace_back(L"one");
-        tokensExpected.emplace_back(L"two");
-        tokensExpected.emplace_back(L"three");
-
-        auto tokensActual = Alias::s_Tokenize(tokenStr);
-
-        VERIFY_ARE_EQUAL(tokensExpected.size(), tokensActual.size());
-
-        for (size_t i = 0; i < tokensExpected.size(); i++)
+        std::wstring exe(L"cmd.exe");
+        for (int i = 0; i < 1000; ++i)
         {
-            VERIFY_ARE_EQUAL(String(tokensExpected[i].data()), String(tokensActual[i].data()));
+            std::wstring source = L"alias" + std::to_wstring(i);
+            std::wstring target = L"target" + std::to_wstring(i) + L" $1 $*";
+            Alias::s_TestAddAlias(exe, source, target);
         }
-    }
-
-    TEST_METHOD(TokenizeNothing)
-    {
-        std::wstring tokenStr(L"alias");
-        std::deque<std::wstring> tokensExpected;
-        tokensExpected.emplace_back(tokenStr);
-
-        auto tokensActual = Alias::s_Tokenize(tokenStr);
 
-        VERIFY_ARE_EQUAL(tokensExpected.size(), tokensActual.size());
+        const std::wstring lookupExe(L"CMD.EXE");
+        const size_t iterations = 1000000;
+        wchar_t buffer[256];
+        size_t matched = 0;
 
-        for (size_t i = 0; i < tokensExpected.size(); i++)
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
         {
-            VERIFY_ARE_EQUAL(String(tokensExpected[i].data()), String(tokensActual[i].data()));
+            const auto length = swprintf_s(buffer, L"AliAs%zu first second\r\n", i % 1000);
+            size_t written = 0;
+            DWORD lines = 0;
+            Alias::s_MatchAndCopyAliasLegacy(buffer,
+                                             gsl::narrow_cast<size_t>(length) * sizeof(wchar_t),
+                                             buffer,
+                                             sizeof(buffer),
+                                             written,
+                                             lookupExe,
+                                             lines);
+            if (written != 0)
+            {
+                ++matched;
+            }
         }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        VERIFY_ARE_EQUAL(iterations, matched);
+        Log::Comment(NoThrowString().Format(L"%zu alias lookups took %lld us",
+                                            iterations,
+                                            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
     }
 
-    TEST_METHOD(GetArgString)
+    TEST_METHOD(MatchTrimsTrailingCrLf)
     {
         BEGIN_TEST_METHOD_PROPERTIES()
             TEST_METHOD_PROPERTY(L"Data:targetExpectedPair",
                                  L"{"
-                                 L"alias arg1 arg2 arg3=arg1 arg2 arg3,"
-                                 L"aliasOnly="
+                                 L"foo bar%=[bar]%," // The character % will be turned into an \r\n
+                                 L"foo bar=[bar]%"
                                  L"}")
         END_TEST_METHOD_PROPERTIES()
 
-        std::wstring target;
+        std::wstring source;
         std::wstring expected;
-        _RetrieveTargetExpectedPair(target, expected);
-
-        std::wstring actual = Alias::s_GetArgString(target);
+        _RetrieveTargetExpectedPair(source, expected);
 
-        VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data()));
-    }
+        // Substitute %s from metadata into \r\n (since metadata can't hold \r\n)
+        _ReplacePercentWithCRLF(source);
+        _ReplacePercentWithCRLF(expected);
 
-    TEST_METHOD(NumberedArgMacro)
-    {
-        BEGIN_TEST_METHOD_PROPERTIES()
-            TEST_METHOD_PROPERTY(L"Data:targetExpectedPair",
-                                 L"{"
-                                 L"1=one,"
-                                 L"2=two,"
-                                 L"3=three,"
-                                 L"4=four,"
-                                 L"5=five,"
-                                 L"6=six,"
-                                 L"7=seven,"
-                                 L"8=eight,"
-                                 L"9=nine,"
-                                 L"A=,"
-                                 L"0=,"
-                                 L"}")
-        END_TEST_METHOD_PROPERTIES()
+        std::wstring exe(L"test.exe");
+        std::wstring alias(L"foo");
+        std::wstring target(L"[$*]");
+        Alias::s_TestAddAlias(exe, alias, target);
 
-        std::wstring target;
-        std::wstring expected;
-        _RetrieveTargetExpectedPair(target, expected);
+        // The \r\n ending the line must not be taken as part of the arguments.
+        size_t lines = 0;
+        const auto actual = Alias::s_MatchAndCopyAlias(source, exe, lines);
 
-        std::deque<std::wstring> tokens;
-        tokens.emplace_back(L"alias");
-        tokens.emplace_back(L"one");
-        tokens.emplace_back(L"two");
-        tokens.emplace_back(L"three");
-        tokens.emplace_back(L"four");
-        tokens.emplace_back(L"five");
-        tokens.emplace_back(L"six");
-        tokens.emplace_back(L"seven");
-        tokens.emplace_back(L"eight");
-        tokens.emplace_back(L"nine");
-        tokens.emplace_back(L"ten");
-
-        // if we expect non-empty results, then we should get a bool back saying it was processed
-        const bool returnExpected = !expected.empty();
-
-        std::wstring actual;
-        const bool returnActual = Alias::s_TryReplaceNumberedArgMacro(target[0], actual, tokens);
-
-        VERIFY_ARE_EQUAL(returnExpected, returnActual);
         VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data()));
     }
 
-    TEST_METHOD(WildcardArgMacro)
+    TEST_METHOD(ExpandArguments)
     {
         BEGIN_TEST_METHOD_PROPERTIES()
             TEST_METHOD_PROPERTY(L"Data:targetExpectedPair",
                                  L"{"
-                                 L"*=one two three,"
-                                 L"A=,"
-                                 L"0=,"
+                                 L"alias one two three=one-two-three-one two three%," // The character % will be turned into an \r\n
+                                 L"alias one=one---one%,"
+                                 L"alias=---%"
                                  L"}")
         END_TEST_METHOD_PROPERTIES()
 
-        std::wstring target;
+        std::wstring source;
         std::wstring expected;
-        _RetrieveTargetExpectedPair(target, expected);
+        _RetrieveTargetExpectedPair(source, expected);
 
-        std::wstring fullArgString(L"one two three");
+        _ReplacePercentWithCRLF(expected);
 
-        // if we expect non-empty results, then we should get a bool back saying it was processed
-        const bool returnExpected = !expected.empty();
+        std::wstring exe(L"test.exe");
+        std::wstring alias(L"alias");
+        std::wstring target(L"$1-$2-$3-$*");
+        Alias::s_TestAddAlias(exe, alias, target);
 
-        std::wstring actual;
-        const bool returnActual = Alias::s_TryReplaceWildcardArgMacro(target[0], actual, fullArgString);
+        size_t lines = 0;
+        const auto actual = Alias::s_MatchAndCopyAlias(source, exe, lines);
 
-        VERIFY_ARE_EQUAL(returnExpected, returnActual);
         VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data()));
+        VERIFY_ARE_EQUAL(static_cast<size_t>(1), lines);
     }
 
-    TEST_METHOD(InputRedirMacro)
+    TEST_METHOD(ExpandMacro)
     {
         BEGIN_TEST_METHOD_PROPERTIES()
             TEST_METHOD_PROPERTY(L"Data:targetExpectedPair",
-                                 L"{"
+                                 L"{" // Each of these is a macro character and what $ followed by it expands to.
+                                 L"1=one,"
+                                 L"2=two,"
+                                 L"3=three,"
+                                 L"4=four,"
+                                 L"5=five,"
+                                 L"6=six,"
+                                 L"7=seven,"
+                                 L"8=eight,"
+                                 L"9=nine,"
+                                 L"*=one two three four five six seven eight nine ten,"
                                  L"L=<,"
                                  L"l=<,"
-                                 L"A=,"
-                                 L"a=,"
-                                 L"0=,"
-                                 L"}")
-        END_TEST_METHOD_PROPERTIES()
-
-        std::wstring target;
-        std::wstring expected;
-        _RetrieveTargetExpectedPair(target, expected);
-
-        // if we expect non-empty results, then we should get a bool back saying it was processed
-        const bool returnExpected = !expected.empty();
-
-        std::wstring actual;
-        const bool returnActual = Alias::s_TryReplaceInputRedirMacro(target[0], actual);
-
-        VERIFY_ARE_EQUAL(returnExpected, returnActual);
-        VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data()));
-    }
-
-    TEST_METHOD(OutputRedirMacro)
-    {
-        BEGIN_TEST_METHOD_PROPERTIES()
-            TEST_METHOD_PROPERTY(L"Data:targetExpectedPair",
-                                 L"{"
                                  L"G=>,"
                                  L"g=>,"
-                                 L"A=,"
-                                 L"a=,"
-                                 L"0=,"
-                                 L"}")
-        END_TEST_METHOD_PROPERTIES()
-
-        std::wstring target;
-        std::wstring expected;
-        _RetrieveTargetExpectedPair(target, expected);
-
-        // if we expect non-empty results, then we should get a bool back saying it was processed
-        const bool returnExpected = !expected.empty();
-
-        std::wstring actual;
-        const bool returnActual = Alias::s_TryReplaceOutputRedirMacro(target[0], actual);
-
-        VERIFY_ARE_EQUAL(returnExpected, returnActual);
-        VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data()));
-    }
-
-    TEST_METHOD(PipeRedirMacro)
-    {
-        BEGIN_TEST_METHOD_PROPERTIES()
-            TEST_METHOD_PROPERTY(L"Data:targetExpectedPair",
-                                 L"{"
                                  L"B=|,"
                                  L"b=|,"
-                                 L"A=,"
-                                 L"a=,"
-                                 L"0=,"
-                                 L"}")
-        END_TEST_METHOD_PROPERTIES()
-
-        std::wstring target;
-        std::wstring expected;
-        _RetrieveTargetExpectedPair(target, expected);
-
-        // if we expect non-empty results, then we should get a bool back saying it was processed
-        const bool returnExpected = !expected.empty();
-
-        std::wstring actual;
-        const bool returnActual = Alias::s_TryReplacePipeRedirMacro(target[0], actual);
-
-        VERIFY_ARE_EQUAL(returnExpected, returnActual);
-        VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data()));
-    }
-
-    TEST_METHOD(NextCommandMacro)
-    {
-        BEGIN_TEST_METHOD_PROPERTIES()
-            TEST_METHOD_PROPERTY(L"Data:targetExpectedPair",
-                                 L"{"
-                                 L"T=%,"
+                                 L"T=%," // The character % will be turned into an \r\n
                                  L"t=%,"
-                                 L"A=,"
-                                 L"a=,"
-                                 L"0=,"
+                                 L"A=$A," // Anything else is copied through.
+                                 L"a=$a,"
+                                 L"0=$0"
                                  L"}")
         END_TEST_METHOD_PROPERTIES()
 
-        std::wstring target;
+        std::wstring macro;
         std::wstring expected;
-        _RetrieveTargetExpectedPair(target, expected);
-
-        _ReplacePercentWithCRLF(expected);
-
-        // if we expect non-empty results, then we should get a bool back saying it was processed
-        const bool returnExpected = !expected.empty();
+        _RetrieveTargetExpectedPair(macro, expected);
 
-        std::wstring actual;
-        size_t lineCountActual = 0;
+        // Every expansion ends with an \r\n.
+        expected.push_back(L'%');
+        const auto linesExpected = _ReplacePercentWithCRLF(expected);
 
-        const auto lineCountExpected = lineCountActual + (returnExpected ? 1 : 0);
-
-        const bool returnActual = Alias::s_TryReplaceNextCommandMacro(target[0], actual, lineCountActual);
-
-        VERIFY_ARE_EQUAL(returnExpected, returnActual);
-        VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data()));
-        VERIFY_ARE_EQUAL(lineCountExpected, lineCountActual);
-    }
-
-    TEST_METHOD(AppendCrLf)
-    {
-        std::wstring actual;
-        size_t lineCountActual = 0;
+        std::wstring exe(L"test.exe");
+        std::wstring alias(L"alias");
+        std::wstring target = L"$" + macro;
+        Alias::s_TestAddAlias(exe, alias, target);
 
-        const std::wstring expected(L"\r\n");
-        const auto lineCountExpected = lineCountActual + 1;
+        const std::wstring source(L"alias one two three four five six seven eight nine ten");
+        size_t lines = 0;
+        const auto actual = Alias::s_MatchAndCopyAlias(source, exe, lines);
 
-        Alias::s_AppendCrLf(actual, lineCountActual);
         VERIFY_ARE_EQUAL(String(expected.data()), String(actual.data()));
-        VERIFY_ARE_EQUAL(lineCountExpected, lineCountActual);
+        VERIFY_ARE_EQUAL(static_cast<size_t>(linesExpected), lines);
     }
 };
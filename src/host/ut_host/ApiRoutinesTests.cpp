@@ -855,4 +855,47 @@ class ApiRoutinesTests
 
         ValidateComplexScreen(si, background, fill, scrollRect, Viewport::FromInclusive(scroll), destination, clipViewport);
     }
+
+    TEST_METHOD(ConsoleOutputRectBenchmark)
+    {
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
+
+        const SHORT width = 200;
+        const SHORT height = 60;
+        VERIFY_SUCCEEDED(_pApiRoutines->SetConsoleScreenBufferSizeImpl(si, { width, 300 }));
+
+        // Change colors every few cells so the attribute runs have to be split and merged.
+        std::vector<CHAR_INFO> source(width * height);
+        for (size_t i = 0; i < source.size(); ++i)
+        {
+            source.at(i).Char.UnicodeChar = static_cast<wchar_t>(L'!' + (i % 90));
+            source.at(i).Attributes = static_cast<WORD>((i / 8) % 0x100);
+        }
+        std::vector<CHAR_INFO> target(source.size());
+
+        const auto rect = Viewport::FromDimensions({ 0, 0 }, { width, height });
+        const size_t iterations = 200;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            Viewport written;
+            VERIFY_SUCCEEDED(_pApiRoutines->WriteConsoleOutputWImpl(si, { source.data(), gsl::narrow<ptrdiff_t>(source.size()) }, rect, written));
+
+            Viewport read;
+            VERIFY_SUCCEEDED(_pApiRoutines->ReadConsoleOutputWImpl(si, { target.data(), gsl::narrow<ptrdiff_t>(target.size()) }, rect, read));
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        VERIFY_IS_TRUE(std::equal(source.cbegin(), source.cend(), target.cbegin(), [](const CHAR_INFO& a, const CHAR_INFO& b) {
+            return a.Char.UnicodeChar == b.Char.UnicodeChar && a.Attributes == b.Attributes;
+        }));
+
+        Log::Comment(NoThrowString().Format(L"%zu writes and reads of %dx%d cells took %lld us",
+                                            iterations,
+                                            width,
+                                            height,
+                                            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    }
 };
@@ -63,6 +63,7 @@ namespace WEX
 
 class AttrRowTests
 {
+    TextAttributeTable _table;
     ATTR_ROW* pSingle;
     ATTR_ROW* pChain;
 
@@ -82,7 +83,7 @@ class AttrRowTests
 
     TEST_METHOD_SETUP(MethodSetup)
     {
-        pSingle = new ATTR_ROW(_sDefaultLength, _DefaultAttr);
+        pSingle = new ATTR_ROW(_sDefaultLength, _DefaultAttr, _table);
 
         // Segment length is the expected length divided by the row length
         // E.g. row of 80, 4 segments, 20 segment length each
@@ -102,31 +103,47 @@ class AttrRowTests
         }
 
         // Create the chain
-        pChain = new ATTR_ROW(_sDefaultLength, _DefaultAttr);
+        pChain = new ATTR_ROW(_sDefaultLength, _DefaultAttr, _table);
         pChain->_list.resize(sChainSegmentsNeeded);
 
         // Attach all chain segments that are even multiples of the row length
         for (short iChain = 0; iChain < _sDefaultChainLength; iChain++)
         {
-            TextAttributeRun* pRun = &pChain->_list[iChain];
-
-            pRun->SetAttributesFromLegacy(iChain); // Just use the chain position as the value
-            pRun->SetLength(sChainSegLength);
+            // Just use the chain position as the value
+            pChain->_list[iChain] = TextAttributeIdRun(sChainSegLength, _table.Intern(_LegacyAttr(iChain)));
         }
 
         if (sChainLeftover > 0)
         {
             // If we had a leftover, then this chain is one longer than we expected (the default length)
             // So use it as the index (because indicies start at 0)
-            TextAttributeRun* pRun = &pChain->_list[_sDefaultChainLength];
-
-            pRun->SetAttributes(_DefaultChainAttr);
-            pRun->SetLength(sChainLeftover);
+            pChain->_list[_sDefaultChainLength] = TextAttributeIdRun(sChainLeftover, _table.Intern(_DefaultChainAttr));
         }
 
         return true;
     }
 
+    // Routine Description:
+    // - Builds an attribute the same way TextAttributeRun::SetAttributesFromLegacy would.
+    static TextAttribute _LegacyAttr(const WORD wLegacy)
+    {
+        TextAttribute attr;
+        attr.SetFromLegacy(wLegacy);
+        return attr;
+    }
+
+    // Routine Description:
+    // - Resolves every run stored in the row against its attribute table.
+    static std::vector<TextAttributeRun> _ExpandRuns(const ATTR_ROW& row)
+    {
+        std::vector<TextAttributeRun> runs;
+        for (size_t i = 0; i < row.GetNumberOfRuns(); i++)
+        {
+            runs.push_back(row.GetRunAt(i));
+        }
+        return runs;
+    }
+
     TEST_METHOD_CLEANUP(MethodCleanup)
     {
         delete pSingle;
@@ -152,7 +169,7 @@ class AttrRowTests
             pUnderTest->Reset(attr);
 
             VERIFY_ARE_EQUAL(pUnderTest->_list.size(), 1u);
-            VERIFY_ARE_EQUAL(pUnderTest->_list[0].GetAttributes(), attr);
+            VERIFY_ARE_EQUAL(pUnderTest->GetRunAt(0).GetAttributes(), attr);
             VERIFY_ARE_EQUAL(pUnderTest->_list[0].GetLength(), (unsigned int)_sDefaultLength);
         }
     }
@@ -266,16 +283,14 @@ class AttrRowTests
 
         // Set up our "original row" that we are going to try to insert into.
         // This will represent a 10 column run of R3->B5->G2 that we will use for all tests.
-        ATTR_ROW originalRow{ static_cast<UINT>(_sDefaultLength), _DefaultAttr };
+        ATTR_ROW originalRow{ static_cast<UINT>(_sDefaultLength), _DefaultAttr, _table };
         originalRow._list.resize(3);
         originalRow._cchRowWidth = 10;
-        originalRow._list[0].SetAttributesFromLegacy('R');
-        originalRow._list[0].SetLength(3);
-        originalRow._list[1].SetAttributesFromLegacy('B');
-        originalRow._list[1].SetLength(5);
-        originalRow._list[2].SetAttributesFromLegacy('G');
-        originalRow._list[2].SetLength(2);
-        LogChain(L"Original: ", originalRow._list);
+        originalRow._list[0] = TextAttributeIdRun(3, _table.Intern(_LegacyAttr('R')));
+        originalRow._list[1] = TextAttributeIdRun(5, _table.Intern(_LegacyAttr('B')));
+        originalRow._list[2] = TextAttributeIdRun(2, _table.Intern(_LegacyAttr('G')));
+        auto originalRuns = _ExpandRuns(originalRow);
+        LogChain(L"Original: ", originalRuns);
 
         // Set up our "insertion run"
         size_t cInsertRow = 1;
@@ -352,12 +367,13 @@ class AttrRowTests
         std::vector<TextAttributeRun> packedRunExpected;
         std::copy_n(packedRun.get(), cPackedRun, std::back_inserter(packedRunExpected));
 
+        auto actualRuns = _ExpandRuns(originalRow);
         LogChain(L"Expected: ", packedRunExpected);
-        LogChain(L"Actual: ", originalRow._list);
+        LogChain(L"Actual: ", actualRuns);
 
         for (size_t testIndex = 0; testIndex < cPackedRun; testIndex++)
         {
-            VERIFY_ARE_EQUAL(packedRun[testIndex], originalRow._list[testIndex]);
+            VERIFY_ARE_EQUAL(packedRun[testIndex], actualRuns[testIndex]);
         }
     }
 
@@ -513,10 +529,10 @@ class AttrRowTests
         // Was 1 (single), should now have 2 segments
         VERIFY_ARE_EQUAL(pSingle->_list.size(), 2u);
 
-        VERIFY_ARE_EQUAL(pSingle->_list[0].GetAttributes(), _DefaultAttr);
+        VERIFY_ARE_EQUAL(pSingle->GetRunAt(0).GetAttributes(), _DefaultAttr);
         VERIFY_ARE_EQUAL(pSingle->_list[0].GetLength(), (unsigned int)(_sDefaultLength - (_sDefaultLength - iTestIndex)));
 
-        VERIFY_ARE_EQUAL(pSingle->_list[1].GetAttributes(), TestAttr);
+        VERIFY_ARE_EQUAL(pSingle->GetRunAt(1).GetAttributes(), TestAttr);
         VERIFY_ARE_EQUAL(pSingle->_list[1].GetLength(), (unsigned int)(_sDefaultLength - iTestIndex));
 
         Log::Comment(L"SetAttrToEnd for existing chain of multiple colors.");
@@ -526,19 +542,19 @@ class AttrRowTests
         VERIFY_ARE_EQUAL(pChain->_list.size(), 5u);
 
         // Verify chain colors and lengths
-        VERIFY_ARE_EQUAL(TextAttribute(0), pChain->_list[0].GetAttributes());
+        VERIFY_ARE_EQUAL(TextAttribute(0), pChain->GetRunAt(0).GetAttributes());
         VERIFY_ARE_EQUAL(pChain->_list[0].GetLength(), (unsigned int)13);
 
-        VERIFY_ARE_EQUAL(TextAttribute(1), pChain->_list[1].GetAttributes());
+        VERIFY_ARE_EQUAL(TextAttribute(1), pChain->GetRunAt(1).GetAttributes());
         VERIFY_ARE_EQUAL(pChain->_list[1].GetLength(), (unsigned int)13);
 
-        VERIFY_ARE_EQUAL(TextAttribute(2), pChain->_list[2].GetAttributes());
+        VERIFY_ARE_EQUAL(TextAttribute(2), pChain->GetRunAt(2).GetAttributes());
         VERIFY_ARE_EQUAL(pChain->_list[2].GetLength(), (unsigned int)13);
 
-        VERIFY_ARE_EQUAL(TextAttribute(3), pChain->_list[3].GetAttributes());
+        VERIFY_ARE_EQUAL(TextAttribute(3), pChain->GetRunAt(3).GetAttributes());
         VERIFY_ARE_EQUAL(pChain->_list[3].GetLength(), (unsigned int)11);
 
-        VERIFY_ARE_EQUAL(TestAttr, pChain->_list[4].GetAttributes());
+        VERIFY_ARE_EQUAL(TestAttr, pChain->GetRunAt(4).GetAttributes());
         VERIFY_ARE_EQUAL(pChain->_list[4].GetLength(), (unsigned int)30);
 
         Log::Comment(L"SECOND: Set index to 0 to test replacing anything with a single");
@@ -555,7 +571,7 @@ class AttrRowTests
             VERIFY_ARE_EQUAL(pUnderTest->_list.size(), 1u);
 
             // singular pair should contain the color
-            VERIFY_ARE_EQUAL(pUnderTest->_list[0].GetAttributes(), TestAttr);
+            VERIFY_ARE_EQUAL(pUnderTest->GetRunAt(0).GetAttributes(), TestAttr);
 
             // and its length should be the length of the whole string
             VERIFY_ARE_EQUAL(pUnderTest->_list[0].GetLength(), (unsigned int)_sDefaultLength);
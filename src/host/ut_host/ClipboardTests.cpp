@@ -70,7 +70,7 @@ class ClipboardTests
 
     const UINT cRectsSelected = 4;
 
-    std::vector<std::wstring> SetupRetrieveFromBuffers(bool fLineSelection, std::vector<SMALL_RECT>& selection)
+    std::wstring SetupRetrieveFromBuffers(bool fLineSelection, std::vector<SMALL_RECT>& selection)
     {
         const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         // NOTE: This test requires innate knowledge of how the common buffer text is emitted in order to test all cases
@@ -87,12 +87,9 @@ class ClipboardTests
 
         return Clipboard::Instance().RetrieveTextFromBuffer(screenInfo,
                                                             fLineSelection,
-                                                            selection)
-            .text;
+                                                            selection);
     }
 
-#pragma prefast(push)
-#pragma prefast(disable : 26006, "Specifically trying to check unterminated strings in this test.")
     TEST_METHOD(TestRetrieveFromBuffer)
     {
         // NOTE: This test requires innate knowledge of how the common buffer text is emitted in order to test all cases
@@ -101,30 +98,15 @@ class ClipboardTests
         std::vector<SMALL_RECT> selection;
         const auto text = SetupRetrieveFromBuffers(false, selection);
 
-        // verify trailing bytes were trimmed
-        // there are 2 double-byte characters in our sample string (see CommonState.hpp for sample)
-        // the width is right - left
-        VERIFY_ARE_EQUAL((short)wcslen(text[0].data()), selection[0].Right - selection[0].Left + 1);
-
-        // since we're not in line selection, the line should be \r\n terminated
-        PCWCHAR tempPtr = text[0].data();
-        tempPtr += text[0].size();
-        tempPtr -= 2;
-        VERIFY_ARE_EQUAL(String(tempPtr), String(L"\r\n"));
-
-        // since we're not in line selection, spaces should be trimmed from the end
-        tempPtr = text[0].data();
-        tempPtr += selection[0].Right - selection[0].Left - 2;
-        tempPtr++;
-        VERIFY_IS_NULL(wcsrchr(tempPtr, L' '));
-
-        // final line of selection should not contain CR/LF
-        tempPtr = text[3].data();
-        tempPtr += text[3].size();
-        tempPtr -= 2;
-        VERIFY_ARE_NOT_EQUAL(String(tempPtr), String(L"\r\n"));
+        // - trailing bytes of the 2 double-byte characters per row are dropped
+        // - since we're not in line selection, every line but the last is \r\n terminated
+        // - since we're not in line selection, spaces are trimmed from the end of each row
+        const std::wstring row = L"AB\x304b"
+                                 L"C\x304d"
+                                 L"DE";
+        const std::wstring expected = row + L"\r\n" + row + L"\r\n" + row + L"\r\n" + row;
+        VERIFY_ARE_EQUAL(String(expected.c_str()), String(text.c_str()));
     }
-#pragma prefast(pop)
 
     TEST_METHOD(TestRetrieveLineSelectionFromBuffer)
     {
@@ -134,28 +116,93 @@ class ClipboardTests
         std::vector<SMALL_RECT> selection;
         const auto text = SetupRetrieveFromBuffers(true, selection);
 
-        // row 2, no wrap
-        // no wrap row before the end should have CR/LF
-        PCWCHAR tempPtr = text[2].data();
-        tempPtr += text[2].size();
-        tempPtr -= 2;
-        VERIFY_ARE_EQUAL(String(tempPtr), String(L"\r\n"));
-
-        // no wrap row should trim spaces at the end
-        tempPtr = text[2].data();
-        VERIFY_IS_NULL(wcsrchr(tempPtr, L' '));
-
-        // row 1, wrap
-        // wrap row before the end should *not* have CR/LF
-        tempPtr = text[1].data();
-        tempPtr += text[1].size();
-        tempPtr -= 2;
-        VERIFY_ARE_NOT_EQUAL(String(tempPtr), String(L"\r\n"));
-
-        // wrap row should have spaces at the end
-        tempPtr = text[1].data();
-        const wchar_t* ptr = wcsrchr(tempPtr, L' ');
-        VERIFY_IS_NOT_NULL(ptr);
+        // - rows 0 and 2 didn't wrap: spaces are trimmed and they end with CR/LF
+        // - row 1 wrapped: it keeps its trailing spaces and has no CR/LF
+        // - row 3 is the final line of the selection and never has a CR/LF
+        const std::wstring row = L"AB\x304b"
+                                 L"C\x304d"
+                                 L"DE";
+        const std::wstring expected = row + L"\r\n" + row + L"      " + row + L"\r\n" + row;
+        VERIFY_ARE_EQUAL(String(expected.c_str()), String(text.c_str()));
+    }
+
+    TEST_METHOD(TestGenerateFormattedTextFromBuffer)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& buffer = gci.GetActiveOutputBuffer().GetTextBuffer();
+
+        std::function<COLORREF(TextAttribute&)> GetForegroundColor = std::bind(&CONSOLE_INFORMATION::LookupForegroundColor, &gci, std::placeholders::_1);
+        std::function<COLORREF(TextAttribute&)> GetBackgroundColor = std::bind(&CONSOLE_INFORMATION::LookupBackgroundColor, &gci, std::placeholders::_1);
+
+        // one row: A / B+か+C / き / DE are four differently colored runs.
+        const std::vector<SMALL_RECT> selection{ SMALL_RECT{ 0, 0, 8, 0 } };
+
+        const auto html = buffer.GenHTML(false, true, selection, 12, L"Consolas", GetForegroundColor, GetBackgroundColor);
+        VERIFY_IS_FALSE(html.empty());
+        VERIFY_ARE_EQUAL('\0', html.back());
+        VERIFY_ARE_EQUAL(0u, html.find("Version:0.9\r\n"));
+        VERIFY_ARE_NOT_EQUAL(std::string::npos, html.find("font-family: 'Consolas', monospace"));
+        VERIFY_ARE_NOT_EQUAL(std::string::npos, html.find("font-size: 12pt"));
+
+        size_t spans = 0;
+        for (auto pos = html.find("<SPAN STYLE=\"color:"); pos != std::string::npos; pos = html.find("<SPAN STYLE=\"color:", pos + 1))
+        {
+            ++spans;
+        }
+        VERIFY_ARE_EQUAL(4u, spans);
+
+        const auto rtf = buffer.GenRTF(false, true, selection, 12, L"Consolas", GetForegroundColor, GetBackgroundColor);
+        VERIFY_ARE_EQUAL(0u, rtf.find("{\\rtf1"));
+        VERIFY_ARE_EQUAL('}', rtf.back());
+        VERIFY_ARE_NOT_EQUAL(std::string::npos, rtf.find("\\fs24 "));
+        // か and き are written as \u escapes rather than raw bytes
+        VERIFY_ARE_NOT_EQUAL(std::string::npos, rtf.find("\\u12363?"));
+        VERIFY_ARE_NOT_EQUAL(std::string::npos, rtf.find("\\u12365?"));
+    }
+
+    TEST_METHOD(TestGenerateRtfWithManyColors)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& buffer = gci.GetActiveOutputBuffer().GetTextBuffer();
+
+        // Every lookup returns a new color, so each run adds two entries to the color table.
+        BYTE nextRed = 0;
+        std::function<COLORREF(TextAttribute&)> GetNewColor = [&](TextAttribute&) { return RGB(nextRed++, 0, 0); };
+
+        std::vector<SMALL_RECT> selection;
+        SetupRetrieveFromBuffers(false, selection);
+
+        const auto rtf = buffer.GenRTF(false, true, selection, 12, L"Consolas", GetNewColor, GetNewColor);
+        VERIFY_ARE_EQUAL(0u, rtf.find("{\\rtf1"));
+        VERIFY_ARE_EQUAL('}', rtf.back());
+        VERIFY_ARE_NOT_EQUAL(std::string::npos, rtf.find("\\red20\\green0\\blue0;"));
+
+        Log::Comment(L"The body follows the header directly.");
+        VERIFY_ARE_NOT_EQUAL(std::string::npos, rtf.find("\\fs24 \\cf1"));
+    }
+
+    TEST_METHOD(TestGenerateClipboardDataMatchesEachFormat)
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto& buffer = gci.GetActiveOutputBuffer().GetTextBuffer();
+
+        std::function<COLORREF(TextAttribute&)> GetForegroundColor = std::bind(&CONSOLE_INFORMATION::LookupForegroundColor, &gci, std::placeholders::_1);
+        std::function<COLORREF(TextAttribute&)> GetBackgroundColor = std::bind(&CONSOLE_INFORMATION::LookupBackgroundColor, &gci, std::placeholders::_1);
+
+        std::vector<SMALL_RECT> selection;
+        const auto text = SetupRetrieveFromBuffers(false, selection);
+
+        Log::Comment(L"One pass over the selection produces what each format produces on its own.");
+        const auto data = buffer.GenClipboardData(false, true, selection, true, 12, L"Consolas", GetForegroundColor, GetBackgroundColor);
+        VERIFY_ARE_EQUAL(String(text.c_str()), String(data.text.c_str()));
+        VERIFY_IS_TRUE(buffer.GenHTML(false, true, selection, 12, L"Consolas", GetForegroundColor, GetBackgroundColor) == data.html);
+        VERIFY_IS_TRUE(buffer.GenRTF(false, true, selection, 12, L"Consolas", GetForegroundColor, GetBackgroundColor) == data.rtf);
+
+        Log::Comment(L"Without formatting, only the text is generated.");
+        const auto plain = buffer.GenClipboardData(false, true, selection, false, 12, L"Consolas", GetForegroundColor, GetBackgroundColor);
+        VERIFY_ARE_EQUAL(String(text.c_str()), String(plain.text.c_str()));
+        VERIFY_IS_TRUE(plain.html.empty());
+        VERIFY_IS_TRUE(plain.rtf.empty());
     }
 
     TEST_METHOD(CanConvertTextToInputEvents)
@@ -103,6 +103,33 @@ class CommandLineTests
         cookedReadData._bufPtr = cookedReadData._backupLimit + column;
     }
 
+    // Puts both the edit point and the screen cursor on the given character
+    // of a line that starts at the top left of the buffer and has no wide
+    // characters in it.
+    void MoveEditCursor(COOKED_READ_DATA& cookedReadData, const size_t column)
+    {
+        MoveCursor(cookedReadData, column);
+
+        auto& screenInfo = cookedReadData.ScreenInfo();
+        const size_t width = screenInfo.GetBufferSize().Width();
+        const COORD position{ gsl::narrow<SHORT>(column % width), gsl::narrow<SHORT>(column / width) };
+        VERIFY_SUCCEEDED(screenInfo.SetCursorPosition(position, true));
+    }
+
+    // Reads the given number of cells from the top left of the buffer.
+    std::wstring ReadEditLineFromScreen(const size_t cells)
+    {
+        auto& screenInfo = ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer();
+        std::wstring text;
+        auto cellIterator = screenInfo.GetCellDataAt({ 0, 0 });
+        for (size_t i = 0; i < cells; ++i)
+        {
+            text.append(cellIterator->Chars());
+            cellIterator++;
+        }
+        return text;
+    }
+
     TEST_METHOD(CanCycleCommandHistory)
     {
         auto buffer = std::make_unique<wchar_t[]>(PROMPT_SIZE);
@@ -468,6 +495,95 @@ class CommandLineTests
         VerifyPromptText(cookedReadData, L"inflammable");
     }
 
+    TEST_METHOD(MidLineEditsKeepScreenInSync)
+    {
+        auto buffer = std::make_unique<wchar_t[]>(PROMPT_SIZE);
+        VERIFY_IS_NOT_NULL(buffer.get());
+
+        auto& cookedReadData = ServiceLocator::LocateGlobals().getConsoleInformation().CookedReadData();
+        InitCookedReadData(cookedReadData, nullptr, buffer.get(), PROMPT_SIZE);
+        cookedReadData.SetInsertMode(true);
+        const auto& cursor = cookedReadData.ScreenInfo().GetTextBuffer().GetCursor();
+
+        VERIFY_ARE_EQUAL(11u, cookedReadData.Write(L"hello world"));
+        NTSTATUS status = STATUS_SUCCESS;
+
+        Log::Comment(L"Insert a character in the middle of the line.");
+        MoveEditCursor(cookedReadData, 5);
+        VERIFY_IS_FALSE(cookedReadData.ProcessInput(L'X', 0, status));
+        VERIFY_IS_TRUE(NT_SUCCESS(status));
+        VerifyPromptText(cookedReadData, L"helloX world");
+        VERIFY_ARE_EQUAL(String(L"helloX world  "), String(ReadEditLineFromScreen(14).c_str()));
+        VERIFY_ARE_EQUAL(COORD({ 6, 0 }), cursor.GetPosition());
+
+        Log::Comment(L"Backspace over it. The end of the line has to be cleared.");
+        VERIFY_IS_FALSE(cookedReadData.ProcessInput(UNICODE_BACKSPACE, 0, status));
+        VERIFY_IS_TRUE(NT_SUCCESS(status));
+        VerifyPromptText(cookedReadData, L"hello world");
+        VERIFY_ARE_EQUAL(String(L"hello world   "), String(ReadEditLineFromScreen(14).c_str()));
+        VERIFY_ARE_EQUAL(COORD({ 5, 0 }), cursor.GetPosition());
+
+        Log::Comment(L"Delete the character after the cursor.");
+        CommandLine::Instance().DeleteFromRightOfCursor(cookedReadData);
+        VerifyPromptText(cookedReadData, L"helloworld");
+        VERIFY_ARE_EQUAL(String(L"helloworld    "), String(ReadEditLineFromScreen(14).c_str()));
+
+        Log::Comment(L"Overtype a character.");
+        MoveEditCursor(cookedReadData, 5);
+        cookedReadData.SetInsertMode(false);
+        VERIFY_IS_FALSE(cookedReadData.ProcessInput(L'_', 0, status));
+        VERIFY_IS_TRUE(NT_SUCCESS(status));
+        VerifyPromptText(cookedReadData, L"hello_orld");
+        VERIFY_ARE_EQUAL(String(L"hello_orld    "), String(ReadEditLineFromScreen(14).c_str()));
+        VERIFY_ARE_EQUAL(COORD({ 6, 0 }), cursor.GetPosition());
+    }
+
+    TEST_METHOD(LongLineEditBenchmark)
+    {
+        Log::Comment(L"Types and backspaces in the middle of a long edit line. "
+                     L"Each keystroke only redraws the part of the line after the cursor.");
+
+        // as long as comfortably fits on the test screen buffer
+        const size_t lineLength = 16 * 1024;
+        const size_t keystrokes = 500;
+        const size_t bufferSize = lineLength + keystrokes + 2;
+        auto buffer = std::make_unique<wchar_t[]>(bufferSize);
+        VERIFY_IS_NOT_NULL(buffer.get());
+
+        auto& cookedReadData = ServiceLocator::LocateGlobals().getConsoleInformation().CookedReadData();
+        InitCookedReadData(cookedReadData, nullptr, buffer.get(), bufferSize);
+        cookedReadData.SetInsertMode(true);
+
+        const std::wstring line(lineLength, L'a');
+        VERIFY_ARE_EQUAL(lineLength, cookedReadData.Write(line));
+        MoveEditCursor(cookedReadData, lineLength / 2);
+
+        NTSTATUS status = STATUS_SUCCESS;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < keystrokes; ++i)
+        {
+            cookedReadData.ProcessInput(L'b', 0, status);
+        }
+        const auto typed = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < keystrokes; ++i)
+        {
+            cookedReadData.ProcessInput(UNICODE_BACKSPACE, 0, status);
+        }
+        const auto erased = std::chrono::steady_clock::now();
+        VERIFY_IS_TRUE(NT_SUCCESS(status));
+
+        VerifyPromptText(cookedReadData, line);
+        VERIFY_ARE_EQUAL(String(line.c_str()), String(ReadEditLineFromScreen(lineLength).c_str()));
+
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        Log::Comment(NoThrowString().Format(L"%zu keystrokes in the middle of a %zu character line: typed in %lldus, erased in %lldus",
+                                            keystrokes,
+                                            lineLength,
+                                            duration_cast<microseconds>(typed - start).count(),
+                                            duration_cast<microseconds>(erased - typed).count()));
+    }
+
     TEST_METHOD(CmdlineCtrlHomeFullwidthChars)
     {
         Log::Comment(L"Set up buffers, create cooked read data, get screen information.");
@@ -242,6 +242,172 @@ class HistoryTests
         VERIFY_ARE_EQUAL(2ul, history->GetNumberOfCommands());
     }
 
+    TEST_METHOD(FindMatchingCommandAgreesWithLinearScan)
+    {
+        auto history = CommandHistory::s_Allocate(_manyApps[0], _MakeHandle(0));
+        VERIFY_IS_NOT_NULL(history);
+        history->Realloc(20);
+
+        Log::Comment(L"Fill the history past capacity, so the oldest commands get evicted, then shuffle it.");
+        for (size_t i = 0; i < 3; i++)
+        {
+            for (const auto& item : _manyHistoryItems)
+            {
+                std::wstring command{ item };
+                if (i == 1)
+                {
+                    std::transform(command.begin(), command.end(), command.begin(), ::towupper);
+                }
+                VERIFY_SUCCEEDED(history->Add(command, false));
+            }
+        }
+        history->Remove(3);
+        history->Remove(0);
+        history->Swap(2, 9);
+
+        const std::array<std::wstring, 9> prefixes = {
+            L"d",
+            L"DIR",
+            L"dir /",
+            L"dir /w",
+            L"ipconfig",
+            L"IPCONFIG /ALL",
+            L"n",
+            L"z",
+            L"git push --force"
+        };
+        const auto count = gsl::narrow<SHORT>(history->GetNumberOfCommands());
+        for (const auto& prefix : prefixes)
+        {
+            for (const auto options : { CommandHistory::MatchOptions::JustLooking,
+                                        CommandHistory::MatchOptions::JustLooking | CommandHistory::MatchOptions::ExactMatch })
+            {
+                for (SHORT start = 0; start < count; start++)
+                {
+                    // Walk backwards from the command before start, like F8 does.
+                    std::optional<SHORT> expected;
+                    for (SHORT i = 1; i <= count && !expected.has_value(); i++)
+                    {
+                        const SHORT candidate = (start - i + count) % count;
+                        const auto command = history->GetNth(candidate);
+                        const bool sizeMatches = WI_IsFlagSet(options, CommandHistory::MatchOptions::ExactMatch) ?
+                                                     command.size() == prefix.size() :
+                                                     command.size() >= prefix.size();
+                        if (sizeMatches && std::equal(prefix.cbegin(), prefix.cend(), command.cbegin(), [](wchar_t a, wchar_t b) {
+                                return ::towlower(a) == ::towlower(b);
+                            }))
+                        {
+                            expected = candidate;
+                        }
+                    }
+
+                    SHORT found = -1;
+                    const bool matched = history->FindMatchingCommand(prefix, start, found, options);
+                    VERIFY_ARE_EQUAL(expected.has_value(), matched, NoThrowString().Format(L"'%s' from %d", prefix.c_str(), start));
+                    if (matched)
+                    {
+                        VERIFY_ARE_EQUAL(expected.value(), found, NoThrowString().Format(L"'%s' from %d", prefix.c_str(), start));
+                    }
+                }
+            }
+        }
+    }
+
+    TEST_METHOD(FindHistoriesByHandleAndExe)
+    {
+        const auto first = CommandHistory::s_Allocate(L"Foo.exe", _MakeHandle(0));
+        const auto second = CommandHistory::s_Allocate(L"foo.EXE", _MakeHandle(1));
+        const auto other = CommandHistory::s_Allocate(_manyApps[1], _MakeHandle(2));
+        VERIFY_IS_NOT_NULL(first);
+        VERIFY_IS_NOT_NULL(second);
+        VERIFY_IS_NOT_NULL(other);
+
+        VERIFY_ARE_EQUAL(first, CommandHistory::s_Find(_MakeHandle(0)));
+        VERIFY_ARE_EQUAL(second, CommandHistory::s_Find(_MakeHandle(1)));
+        VERIFY_ARE_EQUAL(other, CommandHistory::s_Find(_MakeHandle(2)));
+        VERIFY_IS_NULL(CommandHistory::s_Find(_MakeHandle(3)));
+
+        Log::Comment(L"The most recently allocated history for an exe is the one found.");
+        VERIFY_ARE_EQUAL(second, CommandHistory::s_FindByExe(L"FOO.exe"));
+
+        Log::Comment(L"A freed history can't be found, by handle or by exe.");
+        VERIFY_SUCCEEDED(second->Add(L"dir", false));
+        CommandHistory::s_Free(_MakeHandle(1));
+        VERIFY_IS_NULL(CommandHistory::s_Find(_MakeHandle(1)));
+        VERIFY_ARE_EQUAL(first, CommandHistory::s_FindByExe(L"foo.exe"));
+
+        Log::Comment(L"Reallocating the same exe takes the freed history back.");
+        const auto again = CommandHistory::s_Allocate(L"FOO.EXE", _MakeHandle(4));
+        VERIFY_ARE_EQUAL(second, again);
+        VERIFY_ARE_EQUAL(1ul, again->GetNumberOfCommands());
+        VERIFY_ARE_EQUAL(again, CommandHistory::s_Find(_MakeHandle(4)));
+        VERIFY_ARE_EQUAL(again, CommandHistory::s_FindByExe(L"foo.exe"));
+    }
+
+    TEST_METHOD(PrefixSearchBenchmark)
+    {
+        Log::Comment(L"Searches a 10k command history by prefix, and looks histories up among many attached processes.");
+
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const UINT historyCount = 500;
+        const SHORT commandCount = 10000;
+        gci.SetNumberOfHistoryBuffers(historyCount);
+        auto restoreBuffers = wil::scope_exit([&] { gci.SetNumberOfHistoryBuffers(s_NumberOfBuffers); });
+
+        std::vector<std::wstring> appNames;
+        for (size_t i = 0; i < historyCount; i++)
+        {
+            appNames.emplace_back(L"app" + std::to_wstring(i) + L".exe");
+            VERIFY_IS_NOT_NULL(CommandHistory::s_Allocate(appNames.back(), _MakeHandle(i)));
+        }
+
+        auto history = CommandHistory::s_FindByExe(appNames[0]);
+        VERIFY_IS_NOT_NULL(history);
+        history->Realloc(commandCount);
+
+        const auto startFill = std::chrono::steady_clock::now();
+        for (SHORT i = 0; i < commandCount; i++)
+        {
+            VERIFY_SUCCEEDED(history->Add(_manyHistoryItems[i % _manyHistoryItems.size()] + L" " + std::to_wstring(i), false));
+        }
+        const auto filled = std::chrono::steady_clock::now();
+        VERIFY_ARE_EQUAL(static_cast<size_t>(commandCount), history->GetNumberOfCommands());
+
+        const size_t searches = 10000;
+        size_t matches = 0;
+        for (size_t i = 0; i < searches; i++)
+        {
+            SHORT found;
+            const auto& prefix = _manyHistoryItems[i % _manyHistoryItems.size()];
+            if (history->FindMatchingCommand(prefix + L" 1", gsl::narrow<SHORT>(i % commandCount), found, CommandHistory::MatchOptions::JustLooking))
+            {
+                matches++;
+            }
+        }
+        const auto searched = std::chrono::steady_clock::now();
+        VERIFY_ARE_EQUAL(searches, matches);
+
+        size_t found = 0;
+        for (size_t i = 0; i < searches; i++)
+        {
+            found += CommandHistory::s_Find(_MakeHandle(i % historyCount)) != nullptr;
+            found += CommandHistory::s_FindByExe(appNames[(i * 7) % historyCount]) != nullptr;
+        }
+        const auto lookedUp = std::chrono::steady_clock::now();
+        VERIFY_ARE_EQUAL(2 * searches, found);
+
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        Log::Comment(NoThrowString().Format(L"added %d commands in %lldus, %zu prefix searches in %lldus, %zu lookups among %u histories in %lldus",
+                                            commandCount,
+                                            duration_cast<microseconds>(filled - startFill).count(),
+                                            searches,
+                                            duration_cast<microseconds>(searched - filled).count(),
+                                            2 * searches,
+                                            historyCount,
+                                            duration_cast<microseconds>(lookedUp - searched).count()));
+    }
+
 private:
     const std::array<std::wstring, 5> _manyApps = {
         L"foo.exe",
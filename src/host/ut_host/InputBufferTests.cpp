@@ -8,6 +8,9 @@
 
 #include "..\interactivity\inc\ServiceLocator.hpp"
 #include "..\types\inc\IInputEvent.hpp"
+#include "..\types\inc\convert.hpp"
+
+#include <chrono>
 
 using namespace WEX::Logging;
 using Microsoft::Console::Interactivity::ServiceLocator;
@@ -78,7 +81,7 @@ class InputBufferTests
             INPUT_RECORD record;
             record.EventType = MENU_EVENT;
             VERIFY_IS_GREATER_THAN(inputBuffer.Write(IInputEvent::Create(record)), 0u);
-            VERIFY_ARE_EQUAL(record, inputBuffer._storage.back()->ToInputRecord());
+            VERIFY_ARE_EQUAL(record, inputBuffer._storage.Back());
         }
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT);
     }
@@ -98,7 +101,7 @@ class InputBufferTests
         // verify that the events are the same in storage
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i]->ToInputRecord(), record);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i], record);
         }
     }
 
@@ -121,10 +124,9 @@ class InputBufferTests
         // check that they coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 1u);
         // check that the mouse position is being updated correctly
-        const IInputEvent* const pOutEvent = inputBuffer._storage.front().get();
-        const MouseEvent* const pMouseEvent = static_cast<const MouseEvent* const>(pOutEvent);
-        VERIFY_ARE_EQUAL(pMouseEvent->GetPosition().X, static_cast<SHORT>(RECORD_INSERT_COUNT));
-        VERIFY_ARE_EQUAL(pMouseEvent->GetPosition().Y, static_cast<SHORT>(RECORD_INSERT_COUNT * 2));
+        const MOUSE_EVENT_RECORD& outMouseEvent = inputBuffer._storage.Front().Event.MouseEvent;
+        VERIFY_ARE_EQUAL(outMouseEvent.dwMousePosition.X, static_cast<SHORT>(RECORD_INSERT_COUNT));
+        VERIFY_ARE_EQUAL(outMouseEvent.dwMousePosition.Y, static_cast<SHORT>(RECORD_INSERT_COUNT * 2));
 
         // add a key event and another mouse event to make sure that
         // an event between two mouse events stopped the coalescing.
@@ -162,10 +164,10 @@ class InputBufferTests
         // no events should have been coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT + 1);
         // check that the events stored match those inserted
-        VERIFY_ARE_EQUAL(inputBuffer._storage.front()->ToInputRecord(), mouseRecords[0]);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.Front(), mouseRecords[0]);
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1]->ToInputRecord(), mouseRecords[i]);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1], mouseRecords[i]);
         }
     }
 
@@ -221,10 +223,10 @@ class InputBufferTests
         // no events should have been coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT + 1);
         // check that the events stored match those inserted
-        VERIFY_ARE_EQUAL(inputBuffer._storage.front()->ToInputRecord(), keyRecords[0]);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.Front(), keyRecords[0]);
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1]->ToInputRecord(), keyRecords[i]);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1], keyRecords[i]);
         }
     }
 
@@ -239,7 +241,7 @@ class InputBufferTests
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
             VERIFY_IS_GREATER_THAN(inputBuffer.Write(IInputEvent::Create(record)), 0u);
-            VERIFY_ARE_EQUAL(inputBuffer._storage.back()->ToInputRecord(), record);
+            VERIFY_ARE_EQUAL(inputBuffer._storage.Back(), record);
         }
 
         // The events shouldn't be coalesced
@@ -382,11 +384,10 @@ class InputBufferTests
         VERIFY_IS_GREATER_THAN(inputBuffer.Write(inEvents), 0u);
 
         // read one record, make sure ResetWaitEvent isn't set
-        std::deque<std::unique_ptr<IInputEvent>> outEvents;
+        INPUT_RECORD outRecords[RECORD_INSERT_COUNT];
         size_t eventsRead = 0;
         bool resetWaitEvent = false;
-        inputBuffer._ReadBuffer(outEvents,
-                                1,
+        inputBuffer._ReadBuffer({ outRecords, 1 },
                                 eventsRead,
                                 false,
                                 resetWaitEvent,
@@ -396,9 +397,7 @@ class InputBufferTests
         VERIFY_IS_FALSE(!!resetWaitEvent);
 
         // read the rest, resetWaitEvent should be set to true
-        outEvents.clear();
-        inputBuffer._ReadBuffer(outEvents,
-                                RECORD_INSERT_COUNT - 1,
+        inputBuffer._ReadBuffer({ outRecords, RECORD_INSERT_COUNT - 1 },
                                 eventsRead,
                                 false,
                                 resetWaitEvent,
@@ -431,11 +430,10 @@ class InputBufferTests
         VERIFY_IS_GREATER_THAN(inputBuffer.Write(inEvents), 0u);
 
         // read them out non-unicode style and compare
-        std::deque<std::unique_ptr<IInputEvent>> outEvents;
+        INPUT_RECORD outRecords[recordInsertCount];
         size_t eventsRead = 0;
         bool resetWaitEvent = false;
-        inputBuffer._ReadBuffer(outEvents,
-                                recordInsertCount,
+        inputBuffer._ReadBuffer(outRecords,
                                 eventsRead,
                                 false,
                                 resetWaitEvent,
@@ -444,10 +442,9 @@ class InputBufferTests
         // the dbcs record should have counted for two elements in
         // the array, making it so that we get less events read
         VERIFY_ARE_EQUAL(eventsRead, recordInsertCount - 1);
-        VERIFY_ARE_EQUAL(eventsRead, outEvents.size());
         for (size_t i = 0; i < eventsRead; ++i)
         {
-            VERIFY_ARE_EQUAL(outEvents[i]->ToInputRecord(), inRecords[i]);
+            VERIFY_ARE_EQUAL(outRecords[i], inRecords[i]);
         }
     }
 
@@ -589,22 +586,17 @@ class InputBufferTests
     {
         InputBuffer inputBuffer;
         INPUT_RECORD record = MakeKeyEvent(true, 1, L'a', 0, L'a', 0);
-        std::unique_ptr<IInputEvent> inputEvent = IInputEvent::Create(record);
         size_t eventsWritten;
         bool waitEvent = false;
         inputBuffer.Flush();
         // write one event to an empty buffer
-        std::deque<std::unique_ptr<IInputEvent>> storage;
-        storage.push_back(std::move(inputEvent));
-        inputBuffer._WriteBuffer(storage, eventsWritten, waitEvent);
+        inputBuffer._WriteBuffer({ &record, 1 }, eventsWritten, waitEvent);
         VERIFY_IS_TRUE(waitEvent);
         // write another, it shouldn't signal this time
         INPUT_RECORD record2 = MakeKeyEvent(true, 1, L'b', 0, L'b', 0);
-        std::unique_ptr<IInputEvent> inputEvent2 = IInputEvent::Create(record2);
         // write another event to a non-empty buffer
         waitEvent = false;
-        storage.push_back(std::move(inputEvent2));
-        inputBuffer._WriteBuffer(storage, eventsWritten, waitEvent);
+        inputBuffer._WriteBuffer({ &record2, 1 }, eventsWritten, waitEvent);
 
         VERIFY_IS_FALSE(waitEvent);
     }
@@ -624,8 +616,8 @@ class InputBufferTests
                                                  true,
                                                  true));
         VERIFY_ARE_EQUAL(outEvents.size(), 1u);
-        VERIFY_ARE_EQUAL(inputBuffer._storage.size(), 1u);
-        VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*inputBuffer._storage.front()).GetRepeatCount(), repeatCount - 1);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.Size(), 1u);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.Front().Event.KeyEvent.wRepeatCount, repeatCount - 1);
         VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*outEvents.front()).GetRepeatCount(), 1u);
     }
 
@@ -644,8 +636,305 @@ class InputBufferTests
                                                  true,
                                                  true));
         VERIFY_ARE_EQUAL(outEvents.size(), 1u);
-        VERIFY_ARE_EQUAL(inputBuffer._storage.size(), 1u);
-        VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*inputBuffer._storage.front()).GetRepeatCount(), repeatCount);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.Size(), 1u);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.Front().Event.KeyEvent.wRepeatCount, repeatCount);
         VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*outEvents.front()).GetRepeatCount(), 1u);
     }
+
+    TEST_METHOD(VtInputTranslatesEachRepeat)
+    {
+        Log::Comment(L"A key down with a repeat count should be translated once per repeat in VT input mode");
+
+        InputBuffer inputBuffer;
+        WI_SetFlag(inputBuffer.InputMode, ENABLE_VIRTUAL_TERMINAL_INPUT);
+
+        INPUT_RECORD record = MakeKeyEvent(TRUE, 1, VK_UP, 0, 0, 0);
+        VERIFY_ARE_EQUAL(inputBuffer.Write({ &record, 1 }), 1u);
+        const size_t sequenceLength = inputBuffer._storage.Size();
+        VERIFY_IS_GREATER_THAN(sequenceLength, 0u);
+        inputBuffer.Flush();
+
+        const WORD repeatCount = 3;
+        record.Event.KeyEvent.wRepeatCount = repeatCount;
+        VERIFY_ARE_EQUAL(inputBuffer.Write({ &record, 1 }), 1u);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.Size(), sequenceLength * repeatCount);
+    }
+
+    TEST_METHOD(EventQueueWrapsAndGrowsInOrder)
+    {
+        Log::Comment(L"The event ring should keep FIFO order across wrapping around and growing");
+
+        InputEventQueue queue;
+        std::vector<INPUT_RECORD> records;
+        for (size_t i = 0; i < InputEventQueue::InitialCapacity * 3; ++i)
+        {
+            records.push_back(MakeKeyEvent(TRUE, 1, static_cast<WORD>(i), 0, static_cast<WCHAR>(i), 0));
+        }
+
+        // move the head to the middle of the ring, then fill it so that it wraps.
+        const size_t half = InputEventQueue::InitialCapacity / 2;
+        queue.PushBack({ records.data(), gsl::narrow<ptrdiff_t>(half) });
+        queue.PopFront(half);
+        queue.PushBack({ records.data(), gsl::narrow<ptrdiff_t>(InputEventQueue::InitialCapacity) });
+        VERIFY_ARE_EQUAL(queue.Capacity(), InputEventQueue::InitialCapacity);
+
+        // growing has to unwrap the events into the new ring.
+        queue.PushBack(records.back());
+        VERIFY_ARE_EQUAL(queue.Capacity(), InputEventQueue::InitialCapacity * 2);
+        VERIFY_ARE_EQUAL(queue.Size(), InputEventQueue::InitialCapacity + 1);
+        for (size_t i = 0; i < InputEventQueue::InitialCapacity; ++i)
+        {
+            VERIFY_ARE_EQUAL(queue[i], records[i]);
+        }
+        VERIFY_ARE_EQUAL(queue.Back(), records.back());
+
+        // wrap the bigger ring and make sure linearizing keeps the order.
+        queue.PopFront(InputEventQueue::InitialCapacity);
+        queue.PushBack({ records.data(), gsl::narrow<ptrdiff_t>(InputEventQueue::InitialCapacity + 10) });
+        const auto linear = queue.Linearize();
+        VERIFY_ARE_EQUAL(linear.size(), gsl::narrow<ptrdiff_t>(InputEventQueue::InitialCapacity + 11));
+        VERIFY_ARE_EQUAL(linear[0], records.back());
+        for (size_t i = 0; i < InputEventQueue::InitialCapacity + 10; ++i)
+        {
+            VERIFY_ARE_EQUAL(linear[i + 1], records[i]);
+        }
+    }
+
+    TEST_METHOD(CanReadAndWriteRecordSpans)
+    {
+        InputBuffer inputBuffer;
+        INPUT_RECORD records[RECORD_INSERT_COUNT];
+        for (unsigned int i = 0; i < RECORD_INSERT_COUNT; ++i)
+        {
+            records[i] = MakeKeyEvent(TRUE, 1, static_cast<WCHAR>(L'A' + i), 0, static_cast<WCHAR>(L'A' + i), 0);
+        }
+        VERIFY_ARE_EQUAL(inputBuffer.Write(records), RECORD_INSERT_COUNT);
+
+        // peeking leaves everything in place
+        INPUT_RECORD outRecords[RECORD_INSERT_COUNT];
+        size_t eventsRead = 0;
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outRecords, eventsRead, true, false, true, false));
+        VERIFY_ARE_EQUAL(eventsRead, RECORD_INSERT_COUNT);
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT);
+
+        // reading removes them
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read({ outRecords, 5 }, eventsRead, false, false, true, false));
+        VERIFY_ARE_EQUAL(eventsRead, 5u);
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read({ outRecords + 5, RECORD_INSERT_COUNT - 5 }, eventsRead, false, false, true, false));
+        VERIFY_ARE_EQUAL(eventsRead, RECORD_INSERT_COUNT - 5);
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 0u);
+        for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
+        {
+            VERIFY_ARE_EQUAL(outRecords[i], records[i]);
+        }
+
+        // and an empty buffer asks the caller to wait
+        VERIFY_ARE_EQUAL(inputBuffer.Read(outRecords, eventsRead, false, true, true, false), CONSOLE_STATUS_WAIT);
+        VERIFY_ARE_EQUAL(eventsRead, 0u);
+    }
+
+    TEST_METHOD(PasteThroughput)
+    {
+        Log::Comment(L"Pastes 1MB of text worth of key events through the input buffer and reads it back "
+                     L"in ReadConsoleInput sized chunks. Logs the time taken as a benchmark.");
+
+        // 1MB of UTF-16 text, typed as a key down and key up per character.
+        const size_t charCount = 1024 * 1024 / sizeof(wchar_t);
+        std::vector<INPUT_RECORD> records;
+        records.reserve(charCount * 2);
+        for (size_t i = 0; i < charCount; ++i)
+        {
+            const WCHAR wch = static_cast<WCHAR>(L'a' + (i % 26));
+            records.push_back(MakeKeyEvent(TRUE, 1, wch, 0, wch, 0));
+            records.push_back(MakeKeyEvent(FALSE, 1, wch, 0, wch, 0));
+        }
+
+        std::vector<INPUT_RECORD> outRecords(4096);
+        for (const bool vtInput : { false, true })
+        {
+            InputBuffer inputBuffer;
+            WI_UpdateFlag(inputBuffer.InputMode, ENABLE_VIRTUAL_TERMINAL_INPUT, vtInput);
+
+            const auto start = std::chrono::steady_clock::now();
+            VERIFY_ARE_EQUAL(inputBuffer.Write(records), records.size());
+            const auto written = std::chrono::steady_clock::now();
+
+            size_t totalRead = 0;
+            size_t eventsRead = 0;
+            do
+            {
+                VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outRecords, eventsRead, false, false, true, false));
+                totalRead += eventsRead;
+            } while (eventsRead != 0);
+            const auto read = std::chrono::steady_clock::now();
+
+            if (!vtInput)
+            {
+                VERIFY_ARE_EQUAL(totalRead, records.size());
+            }
+            VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 0u);
+
+            using std::chrono::duration_cast;
+            using std::chrono::microseconds;
+            Log::Comment(NoThrowString().Format(L"%s: wrote %zu events in %lldus, read %zu events in %lldus",
+                                                vtInput ? L"VT input" : L"Console input",
+                                                records.size(),
+                                                duration_cast<microseconds>(written - start).count(),
+                                                totalRead,
+                                                duration_cast<microseconds>(read - written).count()));
+        }
+    }
+
+    std::vector<INPUT_RECORD> TextToRecords(const std::wstring_view text)
+    {
+        const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
+        std::vector<INPUT_RECORD> records;
+        for (const auto wch : text)
+        {
+            for (const auto& keyEvent : CharToKeyEvents(wch, codepage))
+            {
+                records.push_back(keyEvent->ToInputRecord());
+            }
+        }
+        return records;
+    }
+
+    TEST_METHOD(WrittenStringIsReadAsKeyEvents)
+    {
+        Log::Comment(L"ReadConsoleInput should see text as the key events that would type it");
+
+        InputBuffer inputBuffer;
+        const std::wstring_view text{ L"aB$\r" };
+        const auto expected = TextToRecords(text);
+
+        VERIFY_ARE_EQUAL(inputBuffer.WriteString(text), text.size());
+        VERIFY_ARE_EQUAL(inputBuffer._storage.Size(), 1u);
+
+        // the count is what ReadConsoleInput will return, not the number of characters.
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), expected.size());
+
+        // read a single event. only the first character should be converted.
+        INPUT_RECORD outRecord;
+        size_t eventsRead = 0;
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read({ &outRecord, 1 }, eventsRead, false, false, true, false));
+        VERIFY_ARE_EQUAL(eventsRead, 1u);
+        VERIFY_ARE_EQUAL(outRecord, expected[0]);
+        VERIFY_ARE_EQUAL(inputBuffer._textRuns.size(), 1u);
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), expected.size() - 1);
+
+        // then read the rest
+        std::vector<INPUT_RECORD> outRecords(expected.size());
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outRecords, eventsRead, false, false, true, false));
+        VERIFY_ARE_EQUAL(eventsRead, expected.size() - 1);
+        for (size_t i = 0; i < eventsRead; ++i)
+        {
+            VERIFY_ARE_EQUAL(outRecords[i], expected[i + 1]);
+        }
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 0u);
+        VERIFY_ARE_EQUAL(inputBuffer._textRuns.size(), 0u);
+    }
+
+    TEST_METHOD(WrittenStringIsStreamReadAsCharacters)
+    {
+        Log::Comment(L"Stream reads should get one key down per character of written text");
+
+        InputBuffer inputBuffer;
+        VERIFY_ARE_EQUAL(inputBuffer.WriteString(L"hel"), 3u);
+        VERIFY_ARE_EQUAL(inputBuffer.WriteString(L"lo"), 2u);
+        // the second write extends the first run
+        VERIFY_ARE_EQUAL(inputBuffer._storage.Size(), 1u);
+
+        INPUT_RECORD record;
+        size_t eventsRead = 0;
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read({ &record, 1 }, eventsRead, true, false, true, true));
+        VERIFY_ARE_EQUAL(eventsRead, 1u);
+        VERIFY_ARE_EQUAL(record.Event.KeyEvent.uChar.UnicodeChar, L'h');
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), TextToRecords(L"hello").size());
+
+        std::wstring read;
+        while (inputBuffer.GetNumberOfReadyEvents() != 0)
+        {
+            VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read({ &record, 1 }, eventsRead, false, false, true, true));
+            VERIFY_ARE_EQUAL(eventsRead, 1u);
+            VERIFY_ARE_EQUAL(record.EventType, KEY_EVENT);
+            VERIFY_IS_TRUE(!!record.Event.KeyEvent.bKeyDown);
+            read.push_back(record.Event.KeyEvent.uChar.UnicodeChar);
+        }
+        VERIFY_ARE_EQUAL(read, L"hello");
+        VERIFY_IS_TRUE(inputBuffer._storage.Empty());
+    }
+
+    TEST_METHOD(WrittenStringKeepsOrderWithOtherEvents)
+    {
+        InputBuffer inputBuffer;
+        INPUT_RECORD before = MakeKeyEvent(TRUE, 1, VK_LEFT, 0, 0, 0);
+        INPUT_RECORD after = MakeKeyEvent(TRUE, 1, VK_RIGHT, 0, 0, 0);
+        VERIFY_ARE_EQUAL(inputBuffer.Write({ &before, 1 }), 1u);
+        VERIFY_ARE_EQUAL(inputBuffer.WriteString(L"xy"), 2u);
+        VERIFY_ARE_EQUAL(inputBuffer.Write({ &after, 1 }), 1u);
+
+        auto expected = TextToRecords(L"xy");
+        expected.insert(expected.begin(), before);
+        expected.push_back(after);
+
+        std::vector<INPUT_RECORD> outRecords(expected.size() + 1);
+        size_t eventsRead = 0;
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outRecords, eventsRead, false, false, true, false));
+        VERIFY_ARE_EQUAL(eventsRead, expected.size());
+        for (size_t i = 0; i < eventsRead; ++i)
+        {
+            VERIFY_ARE_EQUAL(outRecords[i], expected[i]);
+        }
+    }
+
+    TEST_METHOD(WrittenStringInVtInputModeIsWrittenAsKeys)
+    {
+        Log::Comment(L"In VT input mode, text should go through the VT input module instead of being kept as a run");
+
+        InputBuffer inputBuffer;
+        WI_SetFlag(inputBuffer.InputMode, ENABLE_VIRTUAL_TERMINAL_INPUT);
+
+        VERIFY_ARE_EQUAL(inputBuffer.WriteString(L"a\x7f"), 2u);
+        VERIFY_ARE_EQUAL(inputBuffer._textRuns.size(), 0u);
+        VERIFY_IS_FALSE(inputBuffer._storage.Empty());
+        VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), inputBuffer._storage.Size());
+    }
+
+    TEST_METHOD(StringPasteThroughput)
+    {
+        Log::Comment(L"Writes 10MB of text to the input buffer and reads it back with stream reads. "
+                     L"Logs the time taken as a benchmark.");
+
+        const size_t charCount = 10 * 1024 * 1024 / sizeof(wchar_t);
+        std::wstring text;
+        text.reserve(charCount);
+        for (size_t i = 0; i < charCount; ++i)
+        {
+            text.push_back(static_cast<wchar_t>(L'a' + (i % 26)));
+        }
+
+        InputBuffer inputBuffer;
+        const auto start = std::chrono::steady_clock::now();
+        VERIFY_ARE_EQUAL(inputBuffer.WriteString(text), text.size());
+        const auto written = std::chrono::steady_clock::now();
+
+        INPUT_RECORD record;
+        size_t eventsRead = 0;
+        size_t totalRead = 0;
+        do
+        {
+            VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read({ &record, 1 }, eventsRead, false, false, true, true));
+            totalRead += eventsRead;
+        } while (eventsRead != 0);
+        const auto read = std::chrono::steady_clock::now();
+
+        VERIFY_ARE_EQUAL(totalRead, text.size());
+
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        Log::Comment(NoThrowString().Format(L"wrote %zu characters in %lldus, stream read them in %lldus",
+                                            text.size(),
+                                            duration_cast<microseconds>(written - start).count(),
+                                            duration_cast<microseconds>(read - written).count()));
+    }
 };
@@ -87,8 +87,13 @@ class ScreenBufferTests
 
     TEST_METHOD(MultipleAlternateBuffersFromMainCreationTest);
 
+    TEST_METHOD(AlternateBufferIsRecycled);
+
     TEST_METHOD(TestReverseLineFeed);
 
+    std::list<short> _GetTabStops(const SCREEN_INFORMATION& si) const;
+    void _SetTabStops(SCREEN_INFORMATION& si, const std::list<short>& stops) const;
+
     TEST_METHOD(TestAddTabStop);
 
     TEST_METHOD(TestClearTabStops);
@@ -225,7 +230,8 @@ void ScreenBufferTests::MultipleAlternateBufferCreationTest()
             Log::Comment(L"Second alternate buffer successfully created");
             SCREEN_INFORMATION* psiSecondAlternate = &gci.GetActiveOutputBuffer();
             VERIFY_ARE_NOT_EQUAL(psiOriginal, psiSecondAlternate);
-            VERIFY_ARE_NOT_EQUAL(psiSecondAlternate, psiFirstAlternate);
+            Log::Comment(L"The first alternate is the same size, so it's reset and reused.");
+            VERIFY_ARE_EQUAL(psiSecondAlternate, psiFirstAlternate);
             VERIFY_ARE_EQUAL(psiSecondAlternate, psiOriginal->_psiAlternateBuffer);
             VERIFY_ARE_EQUAL(psiOriginal, psiSecondAlternate->_psiMainBuffer);
             VERIFY_IS_NULL(psiOriginal->_psiMainBuffer);
@@ -270,7 +276,8 @@ void ScreenBufferTests::MultipleAlternateBuffersFromMainCreationTest()
             Log::Comment(L"Second alternate buffer successfully created");
             SCREEN_INFORMATION* const psiSecondAlternate = &gci.GetActiveOutputBuffer();
             VERIFY_ARE_NOT_EQUAL(psiOriginal, psiSecondAlternate);
-            VERIFY_ARE_NOT_EQUAL(psiSecondAlternate, psiFirstAlternate);
+            Log::Comment(L"The first alternate is the same size, so it's reset and reused.");
+            VERIFY_ARE_EQUAL(psiSecondAlternate, psiFirstAlternate);
             VERIFY_ARE_EQUAL(psiSecondAlternate, psiOriginal->_psiAlternateBuffer);
             VERIFY_ARE_EQUAL(psiOriginal, psiSecondAlternate->_psiMainBuffer);
             VERIFY_IS_NULL(psiOriginal->_psiMainBuffer);
@@ -288,6 +295,74 @@ void ScreenBufferTests::MultipleAlternateBuffersFromMainCreationTest()
     }
 }
 
+void ScreenBufferTests::AlternateBufferIsRecycled()
+{
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    StateMachine& stateMachine = si.GetStateMachine();
+
+    Log::Comment(L"Switch to the alt buffer and dirty it up.");
+    std::wstring seq = L"\x1b[?1049h";
+    stateMachine.ProcessString(&seq[0], seq.length());
+    SCREEN_INFORMATION* const psiFirstAlt = si._psiAlternateBuffer;
+    VERIFY_IS_NOT_NULL(psiFirstAlt);
+    VERIFY_IS_NULL(si._psiRetiredAltBuffer);
+
+    seq = L"\x1b[2;3r\x1b[4;5H\x1b[32mfoo\x1b[?25l";
+    stateMachine.ProcessString(&seq[0], seq.length());
+    VERIFY_ARE_EQUAL(L"f", psiFirstAlt->GetTextBuffer().GetCellDataAt({ 4, 3 })->Chars());
+    VERIFY_IS_FALSE(psiFirstAlt->GetTextBuffer().GetCursor().IsVisible());
+
+    Log::Comment(L"Leaving the alt buffer keeps it around, off the buffer list.");
+    seq = L"\x1b[?1049l";
+    stateMachine.ProcessString(&seq[0], seq.length());
+    VERIFY_IS_NULL(si._psiAlternateBuffer);
+    VERIFY_ARE_EQUAL(psiFirstAlt, si._psiRetiredAltBuffer);
+    for (auto* psi = gci.ScreenBuffers; psi != nullptr; psi = psi->Next)
+    {
+        VERIFY_ARE_NOT_EQUAL(psiFirstAlt, psi);
+    }
+
+    Log::Comment(L"Coming back reuses the same buffer, as good as new.");
+    seq = L"\x1b[?1049h";
+    stateMachine.ProcessString(&seq[0], seq.length());
+    VERIFY_ARE_EQUAL(psiFirstAlt, si._psiAlternateBuffer);
+    VERIFY_IS_NULL(si._psiRetiredAltBuffer);
+    VERIFY_ARE_EQUAL(psiFirstAlt, &gci.GetActiveOutputBuffer().GetActiveBuffer());
+
+    const auto& textBuffer = psiFirstAlt->GetTextBuffer();
+    VERIFY_ARE_EQUAL(L"\x20", textBuffer.GetCellDataAt({ 4, 3 })->Chars());
+    VERIFY_ARE_EQUAL(si.GetAttributes(), textBuffer.GetCellDataAt({ 4, 3 })->TextAttr());
+    VERIFY_ARE_EQUAL(si.GetAttributes(), psiFirstAlt->GetAttributes());
+    VERIFY_ARE_EQUAL(COORD({ 0, 0 }), textBuffer.GetCursor().GetPosition());
+    VERIFY_IS_TRUE(textBuffer.GetCursor().IsVisible());
+    VERIFY_IS_FALSE(psiFirstAlt->AreMarginsSet());
+    VERIFY_ARE_EQUAL(si.GetViewport().Dimensions(), psiFirstAlt->GetBufferSize().Dimensions());
+
+    seq = L"\x1b[?1049l";
+    stateMachine.ProcessString(&seq[0], seq.length());
+
+    Log::Comment(L"Once the main viewport changes size, the kept buffer doesn't fit and is replaced.");
+    const COORD originalSize = si.GetViewport().Dimensions();
+    COORD newSize = originalSize;
+    newSize.X -= 2;
+    newSize.Y -= 2;
+    si.SetViewportSize(&newSize);
+
+    seq = L"\x1b[?1049h";
+    stateMachine.ProcessString(&seq[0], seq.length());
+    VERIFY_IS_NOT_NULL(si._psiAlternateBuffer);
+    VERIFY_IS_NULL(si._psiRetiredAltBuffer);
+    VERIFY_ARE_EQUAL(newSize, si._psiAlternateBuffer->GetBufferSize().Dimensions());
+
+    seq = L"\x1b[?1049l";
+    stateMachine.ProcessString(&seq[0], seq.length());
+    si.SetViewportSize(&originalSize);
+}
+
 void ScreenBufferTests::TestReverseLineFeed()
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -368,6 +443,29 @@ void ScreenBufferTests::TestReverseLineFeed()
     VERIFY_ARE_EQUAL(c.Y, 6);
 }
 
+std::list<short> ScreenBufferTests::_GetTabStops(const SCREEN_INFORMATION& si) const
+{
+    std::list<short> stops;
+    if (si._tabStops.IsSet(0))
+    {
+        stops.push_back(0);
+    }
+    for (auto stop = si._tabStops.Next(0); stop.has_value(); stop = si._tabStops.Next(stop.value()))
+    {
+        stops.push_back(gsl::narrow<short>(stop.value()));
+    }
+    return stops;
+}
+
+void ScreenBufferTests::_SetTabStops(SCREEN_INFORMATION& si, const std::list<short>& stops) const
+{
+    si._tabStops.ClearAll();
+    for (const auto stop : stops)
+    {
+        si._tabStops.Set(gsl::narrow<size_t>(stop));
+    }
+}
+
 void ScreenBufferTests::TestAddTabStop()
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -378,27 +476,27 @@ void ScreenBufferTests::TestAddTabStop()
     std::list<short> expectedStops{ 12 };
     Log::Comment(L"Add tab to empty list.");
     screenInfo.AddTabStop(12);
-    VERIFY_ARE_EQUAL(expectedStops, screenInfo._tabStops);
+    VERIFY_ARE_EQUAL(expectedStops, _GetTabStops(screenInfo));
 
     Log::Comment(L"Add tab to head of existing list.");
     screenInfo.AddTabStop(4);
     expectedStops.push_front(4);
-    VERIFY_ARE_EQUAL(expectedStops, screenInfo._tabStops);
+    VERIFY_ARE_EQUAL(expectedStops, _GetTabStops(screenInfo));
 
     Log::Comment(L"Add tab to tail of existing list.");
     screenInfo.AddTabStop(30);
     expectedStops.push_back(30);
-    VERIFY_ARE_EQUAL(expectedStops, screenInfo._tabStops);
+    VERIFY_ARE_EQUAL(expectedStops, _GetTabStops(screenInfo));
 
     Log::Comment(L"Add tab to middle of existing list.");
     screenInfo.AddTabStop(24);
     expectedStops.push_back(24);
     expectedStops.sort();
-    VERIFY_ARE_EQUAL(expectedStops, screenInfo._tabStops);
+    VERIFY_ARE_EQUAL(expectedStops, _GetTabStops(screenInfo));
 
     Log::Comment(L"Add tab that duplicates an item in the existing list.");
     screenInfo.AddTabStop(24);
-    VERIFY_ARE_EQUAL(expectedStops, screenInfo._tabStops);
+    VERIFY_ARE_EQUAL(expectedStops, _GetTabStops(screenInfo));
 }
 
 void ScreenBufferTests::TestClearTabStops()
@@ -409,7 +507,7 @@ void ScreenBufferTests::TestClearTabStops()
     Log::Comment(L"Clear non-existant tab stops.");
     {
         screenInfo.ClearTabStops();
-        VERIFY_IS_TRUE(screenInfo._tabStops.empty());
+        VERIFY_IS_FALSE(screenInfo._tabStops.Any());
     }
 
     Log::Comment(L"Clear handful of tab stops.");
@@ -418,9 +516,9 @@ void ScreenBufferTests::TestClearTabStops()
         {
             screenInfo.AddTabStop(gsl::narrow<short>(x));
         }
-        VERIFY_IS_FALSE(screenInfo._tabStops.empty());
+        VERIFY_IS_TRUE(screenInfo._tabStops.Any());
         screenInfo.ClearTabStops();
-        VERIFY_IS_TRUE(screenInfo._tabStops.empty());
+        VERIFY_IS_FALSE(screenInfo._tabStops.Any());
     }
 }
 
@@ -433,82 +531,82 @@ void ScreenBufferTests::TestClearTabStop()
     {
         screenInfo.ClearTabStop(0);
 
-        VERIFY_IS_TRUE(screenInfo._tabStops.empty(), L"List should remain empty");
+        VERIFY_IS_FALSE(screenInfo._tabStops.Any(), L"List should remain empty");
     }
 
     Log::Comment(L"Allocate 1 list item and clear it.");
     {
-        screenInfo._tabStops.push_back(0);
+        screenInfo._tabStops.Set(0);
         screenInfo.ClearTabStop(0);
 
-        VERIFY_IS_TRUE(screenInfo._tabStops.empty());
+        VERIFY_IS_FALSE(screenInfo._tabStops.Any());
     }
 
     Log::Comment(L"Allocate 1 list item and clear non-existant.");
     {
-        screenInfo._tabStops.push_back(0);
+        screenInfo._tabStops.Set(0);
 
         Log::Comment(L"Free greater");
         screenInfo.ClearTabStop(1);
-        VERIFY_IS_FALSE(screenInfo._tabStops.empty());
+        VERIFY_IS_TRUE(screenInfo._tabStops.Any());
 
         Log::Comment(L"Free less than");
         screenInfo.ClearTabStop(-1);
-        VERIFY_IS_FALSE(screenInfo._tabStops.empty());
+        VERIFY_IS_TRUE(screenInfo._tabStops.Any());
 
         // clear all tab stops
-        screenInfo._tabStops.clear();
+        screenInfo._tabStops.ClearAll();
     }
 
     Log::Comment(L"Allocate many (5) list items and clear head.");
     {
         std::list<short> inputData = { 3, 5, 6, 10, 15, 17 };
-        screenInfo._tabStops = inputData;
+        _SetTabStops(screenInfo, inputData);
         screenInfo.ClearTabStop(inputData.front());
 
         inputData.pop_front();
-        VERIFY_ARE_EQUAL(inputData, screenInfo._tabStops);
+        VERIFY_ARE_EQUAL(inputData, _GetTabStops(screenInfo));
 
         // clear all tab stops
-        screenInfo._tabStops.clear();
+        screenInfo._tabStops.ClearAll();
     }
 
     Log::Comment(L"Allocate many (5) list items and clear middle.");
     {
         std::list<short> inputData = { 3, 5, 6, 10, 15, 17 };
-        screenInfo._tabStops = inputData;
+        _SetTabStops(screenInfo, inputData);
         screenInfo.ClearTabStop(*std::next(inputData.begin()));
 
         inputData.erase(std::next(inputData.begin()));
-        VERIFY_ARE_EQUAL(inputData, screenInfo._tabStops);
+        VERIFY_ARE_EQUAL(inputData, _GetTabStops(screenInfo));
 
         // clear all tab stops
-        screenInfo._tabStops.clear();
+        screenInfo._tabStops.ClearAll();
     }
 
     Log::Comment(L"Allocate many (5) list items and clear tail.");
     {
         std::list<short> inputData = { 3, 5, 6, 10, 15, 17 };
-        screenInfo._tabStops = inputData;
+        _SetTabStops(screenInfo, inputData);
         screenInfo.ClearTabStop(inputData.back());
 
         inputData.pop_back();
-        VERIFY_ARE_EQUAL(inputData, screenInfo._tabStops);
+        VERIFY_ARE_EQUAL(inputData, _GetTabStops(screenInfo));
 
         // clear all tab stops
-        screenInfo._tabStops.clear();
+        screenInfo._tabStops.ClearAll();
     }
 
     Log::Comment(L"Allocate many (5) list items and clear non-existant item.");
     {
         std::list<short> inputData = { 3, 5, 6, 10, 15, 17 };
-        screenInfo._tabStops = inputData;
+        _SetTabStops(screenInfo, inputData);
         screenInfo.ClearTabStop(9000);
 
-        VERIFY_ARE_EQUAL(inputData, screenInfo._tabStops);
+        VERIFY_ARE_EQUAL(inputData, _GetTabStops(screenInfo));
 
         // clear all tab stops
-        screenInfo._tabStops.clear();
+        screenInfo._tabStops.ClearAll();
     }
 }
 
@@ -518,7 +616,7 @@ void ScreenBufferTests::TestGetForwardTab()
     SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
 
     std::list<short> inputData = { 3, 5, 6, 10, 15, 17 };
-    si._tabStops = inputData;
+    _SetTabStops(si, inputData);
 
     const COORD coordScreenBufferSize = si.GetBufferSize().Dimensions();
     COORD coordCursor;
@@ -566,7 +664,7 @@ void ScreenBufferTests::TestGetForwardTab()
                          L"Cursor advanced to end of screen buffer.");
     }
 
-    si._tabStops.clear();
+    si._tabStops.ClearAll();
 }
 
 void ScreenBufferTests::TestGetReverseTab()
@@ -575,7 +673,7 @@ void ScreenBufferTests::TestGetReverseTab()
     SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
 
     std::list<short> inputData = { 3, 5, 6, 10, 15, 17 };
-    si._tabStops = inputData;
+    _SetTabStops(si, inputData);
 
     COORD coordCursor;
     // in the middle of the buffer, it doesn't make a difference.
@@ -623,7 +721,7 @@ void ScreenBufferTests::TestGetReverseTab()
                          L"Cursor adjusted to last item in the sample list from position beyond end.");
     }
 
-    si._tabStops.clear();
+    si._tabStops.ClearAll();
 }
 
 void ScreenBufferTests::TestAreTabsSet()
@@ -631,7 +729,7 @@ void ScreenBufferTests::TestAreTabsSet()
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
 
-    si._tabStops.clear();
+    si._tabStops.ClearAll();
     VERIFY_IS_FALSE(si.AreTabsSet());
 
     si.AddTabStop(1);
@@ -663,7 +761,7 @@ void ScreenBufferTests::TestAltBufferDefaultTabStops()
 
     VERIFY_IS_TRUE(WI_IsFlagSet(altBuffer.OutputMode, ENABLE_VIRTUAL_TERMINAL_PROCESSING));
     VERIFY_IS_TRUE(altBuffer.AreTabsSet());
-    VERIFY_IS_TRUE(altBuffer._tabStops.size() > 3);
+    VERIFY_IS_TRUE(_GetTabStops(altBuffer).size() > 3);
 
     const COORD origin{ 0, 0 };
     auto& cursor = altBuffer.GetTextBuffer().GetCursor();
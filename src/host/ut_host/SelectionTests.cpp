@@ -339,6 +339,40 @@ class SelectionTests
         VERIFY_ARE_EQUAL(srOriginal.Right + sDeltaRight, srSelection.Right);
     }
 
+    TEST_METHOD(TestGetSelectionRectsClipped)
+    {
+        const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        const auto bufferSize = gci.GetActiveOutputBuffer().GetBufferSize();
+
+        m_pSelection->_fSelectionVisible = true;
+        m_pSelection->_srSelectionRect.Top = 0;
+        m_pSelection->_srSelectionRect.Bottom = 10;
+        m_pSelection->_srSelectionRect.Left = 1;
+        m_pSelection->_srSelectionRect.Right = 10;
+        m_pSelection->_coordSelectionAnchor.X = m_pSelection->_srSelectionRect.Left;
+        m_pSelection->_coordSelectionAnchor.Y = m_pSelection->_srSelectionRect.Top;
+        m_pSelection->_fLineSelection = true;
+        m_pSelection->_fUseAlternateSelection = false;
+
+        Log::Comment(L"Only the rows inside the clip should come back, and they should match the unclipped ones.");
+        const auto allRects = m_pSelection->GetSelectionRects();
+        VERIFY_ARE_EQUAL(size_t{ 11 }, allRects.size());
+
+        const auto clip = Microsoft::Console::Types::Viewport::FromInclusive({ 0, 4, bufferSize.RightInclusive(), 7 });
+        const auto clippedRects = m_pSelection->GetSelectionRects(clip);
+        if (VERIFY_ARE_EQUAL(size_t{ 4 }, clippedRects.size()))
+        {
+            for (size_t i = 0; i < clippedRects.size(); i++)
+            {
+                VERIFY_ARE_EQUAL(allRects.at(i + 4), clippedRects.at(i));
+            }
+        }
+
+        Log::Comment(L"A clip that misses the selection entirely gives no rows.");
+        const auto below = Microsoft::Console::Types::Viewport::FromInclusive({ 0, 20, bufferSize.RightInclusive(), 30 });
+        VERIFY_ARE_EQUAL(size_t{ 0 }, m_pSelection->GetSelectionRects(below).size());
+    }
+
     TEST_METHOD(TestBisectSelection)
     {
         m_state->FillTextBufferBisect();
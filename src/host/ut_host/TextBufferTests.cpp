@@ -10,6 +10,7 @@
 #include "globals.h"
 #include "../buffer/out/textBuffer.hpp"
 #include "../buffer/out/CharRow.hpp"
+#include "../../types/inc/ConsoleMetrics.hpp"
 
 #include "input.h"
 #include "_stream.h"
@@ -143,6 +144,8 @@ class TextBufferTests
     TEST_METHOD(ResizeTraditionalHighUnicodeColumnRemoval);
 
     TEST_METHOD(TestBurrito);
+
+    TEST_METHOD(TestWriteCharInfosMatchesWrite);
 };
 
 void TextBufferTests::TestBufferCreate()
@@ -1940,3 +1943,90 @@ void TextBufferTests::TestBurrito()
     _buffer->IncrementCursor();
     VERIFY_IS_FALSE(afterBurritoIter);
 }
+
+void TextBufferTests::TestWriteCharInfosMatchesWrite()
+{
+    COORD bufferSize{ 10, 3 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x07 };
+    TextBuffer cellBuffer{ bufferSize, attr, cursorSize, _renderTarget };
+    TextBuffer charInfoBuffer{ bufferSize, attr, cursorSize, _renderTarget };
+
+    auto makeCharInfo = [](const wchar_t wch, const WORD attributes) {
+        CHAR_INFO ci;
+        ci.Char.UnicodeChar = wch;
+        ci.Attributes = attributes;
+        return ci;
+    };
+
+    // Several color runs, a double byte character in the middle of the row, and one that
+    // lands on the last column so it has to be padded and pushed onto the next row.
+    const std::vector<CHAR_INFO> source{
+        makeCharInfo(L'a', 0x07),
+        makeCharInfo(L'b', 0x07),
+        makeCharInfo(L'c', 0x1F),
+        makeCharInfo(L'\x3042', 0x1F | COMMON_LVB_LEADING_BYTE),
+        makeCharInfo(L'\x3042', 0x1F | COMMON_LVB_TRAILING_BYTE),
+        makeCharInfo(L'd', 0x2E),
+        makeCharInfo(L'e', 0x2E),
+        makeCharInfo(L'f', 0x2E),
+        makeCharInfo(L'\x3044', 0x4C | COMMON_LVB_LEADING_BYTE),
+        makeCharInfo(L'\x3044', 0x4C | COMMON_LVB_TRAILING_BYTE),
+        makeCharInfo(L'g', 0x07),
+        makeCharInfo(L'h', 0x07),
+    };
+
+    using Microsoft::Console::Metrics::Counter;
+    using Microsoft::Console::Metrics::TakeSnapshot;
+
+    const COORD target{ 1, 0 };
+    const auto beforeCells = TakeSnapshot().Get(Counter::BufferRowsWritten);
+    const auto finalIt = cellBuffer.Write(OutputCellIterator({ source.data(), source.size() }), target);
+    VERIFY_IS_FALSE(finalIt);
+    const auto rowsWrittenByCells = TakeSnapshot().Get(Counter::BufferRowsWritten) - beforeCells;
+
+    const auto beforeCharInfos = TakeSnapshot().Get(Counter::BufferRowsWritten);
+    const auto written = charInfoBuffer.WriteCharInfos({ source.data(), gsl::narrow<ptrdiff_t>(source.size()) }, target);
+    VERIFY_ARE_EQUAL(source.size(), written);
+    const auto rowsWrittenByCharInfos = TakeSnapshot().Get(Counter::BufferRowsWritten) - beforeCharInfos;
+
+    Log::Comment(L"Both paths count the rows they write.");
+    VERIFY_ARE_EQUAL(rowsWrittenByCells, rowsWrittenByCharInfos);
+    VERIFY_ARE_NOT_EQUAL(0ull, rowsWrittenByCharInfos);
+
+    const std::function<WORD(const TextAttribute&)> legacy = [](const TextAttribute& attr) {
+        return attr.GetLegacyAttributes();
+    };
+
+    for (size_t rowIndex = 0; rowIndex < 2; ++rowIndex)
+    {
+        const auto& expectedRow = cellBuffer.GetRowByOffset(rowIndex);
+        const auto& actualRow = charInfoBuffer.GetRowByOffset(rowIndex);
+
+        VERIFY_ARE_EQUAL(expectedRow.GetCharRow().WasWrapForced(), actualRow.GetCharRow().WasWrapForced());
+        VERIFY_ARE_EQUAL(expectedRow.GetCharRow().WasDoubleBytePadded(), actualRow.GetCharRow().WasDoubleBytePadded());
+
+        std::vector<CHAR_INFO> expected(bufferSize.X);
+        std::vector<CHAR_INFO> actual(bufferSize.X);
+        expectedRow.ReadCharInfos(0, { expected.data(), gsl::narrow<ptrdiff_t>(expected.size()) }, legacy);
+        actualRow.ReadCharInfos(0, { actual.data(), gsl::narrow<ptrdiff_t>(actual.size()) }, legacy);
+
+        for (size_t column = 0; column < expected.size(); ++column)
+        {
+            const auto& expectedCell = expected.at(column);
+            const auto& actualCell = actual.at(column);
+            VERIFY_ARE_EQUAL(expectedCell.Char.UnicodeChar, actualCell.Char.UnicodeChar, NoThrowString().Format(L"row %zu column %zu", rowIndex, column));
+            VERIFY_ARE_EQUAL(expectedCell.Attributes, actualCell.Attributes, NoThrowString().Format(L"row %zu column %zu", rowIndex, column));
+
+            // Reading the row in bulk has to agree with reading it a cell at a time.
+            const auto cell = *charInfoBuffer.GetCellDataAt({ gsl::narrow<SHORT>(column), gsl::narrow<SHORT>(rowIndex) });
+            VERIFY_ARE_EQUAL(cell.Chars(), std::wstring_view(&actualCell.Char.UnicodeChar, 1));
+            VERIFY_ARE_EQUAL(static_cast<WORD>(cell.TextAttr().GetLegacyAttributes() | cell.DbcsAttr().GeneratePublicApiAttributeFormat()), actualCell.Attributes);
+        }
+    }
+
+    // The second double byte character couldn't fit at the end of the first row.
+    VERIFY_IS_TRUE(charInfoBuffer.GetRowByOffset(0).GetCharRow().WasDoubleBytePadded());
+    const std::wstring_view pushedGlyph = charInfoBuffer.GetRowByOffset(1).GetCharRow().GlyphAt(0);
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"\x3044" }, pushedGlyph);
+}
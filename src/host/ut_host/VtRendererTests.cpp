@@ -98,8 +98,12 @@ class Microsoft::Console::Render::VtRendererTest
     TEST_METHOD(Xterm256TestColors);
     TEST_METHOD(Xterm256TestCursor);
 
+    TEST_METHOD(Xterm256TestSgrDelta);
+    TEST_METHOD(Xterm256TestColorizedOutputBytes);
+
     TEST_METHOD(XtermTestInvalidate);
     TEST_METHOD(XtermTestColors);
+    TEST_METHOD(XtermTestSgrDefaults);
     TEST_METHOD(XtermTestCursor);
 
     TEST_METHOD(WinTelnetTestInvalidate);
@@ -110,6 +114,11 @@ class Microsoft::Console::Render::VtRendererTest
 
     TEST_METHOD(TestResize);
 
+    TEST_METHOD(TestPipeWriterSlowConsumer);
+
+    TEST_METHOD(TestWriteTerminalUtf8);
+    TEST_METHOD(TestRepaintThroughput);
+
     void Test16Colors(VtEngine* engine);
 
     std::deque<std::string> qExpectedInput;
@@ -408,8 +417,7 @@ void VtRendererTest::Xterm256TestColors()
     Log::Comment(NoThrowString().Format(
         L"Begin by setting some test values - FG,BG = (1,2,3), (4,5,6) to start"
         L"These values were picked for ease of formatting raw COLORREF values."));
-    qExpectedInput.push_back("\x1b[38;2;1;2;3m");
-    qExpectedInput.push_back("\x1b[48;2;5;6;7m");
+    qExpectedInput.push_back("\x1b[38;2;1;2;3;48;2;5;6;7m");
     VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(0x00030201, 0x00070605, 0, false, false));
 
     TestPaint(*engine, [&]() {
@@ -590,6 +598,99 @@ void VtRendererTest::Xterm256TestCursor()
     });
 }
 
+void VtRendererTest::Xterm256TestSgrDelta()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    qExpectedInput.push_back("\x1b[m");
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[15], g_ColorTable[0], 0, false, false));
+
+    Log::Comment(L"Every attribute that changes goes into one sequence");
+    qExpectedInput.push_back("\x1b[1;4;91;44m");
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[12], g_ColorTable[1], COMMON_LVB_UNDERSCORE, true, false));
+
+    Log::Comment(L"Only the attributes that changed are sent");
+    qExpectedInput.push_back("\x1b[24;92m");
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[10], g_ColorTable[1], 0, true, false));
+
+    Log::Comment(L"Colors in the 256 color palette use the shorter palette form");
+    qExpectedInput.push_back("\x1b[38;5;196;48;5;244m");
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(RGB(255, 0, 0), RGB(128, 128, 128), 0, true, false));
+
+    Log::Comment(L"A reset is used when it's shorter than undoing each attribute");
+    qExpectedInput.push_back("\x1b[0;1m");
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[15], g_ColorTable[0], 0, true, false));
+
+    Log::Comment(L"Nothing is sent when nothing changed");
+    qExpectedInput.push_back(EMPTY_CALLBACK_SENTINEL);
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[15], g_ColorTable[0], 0, true, false));
+    WriteCallback(EMPTY_CALLBACK_SENTINEL, 1);
+}
+
+void VtRendererTest::Xterm256TestColorizedOutputBytes()
+{
+    // Paints a screenful of compiler-like output: file names, line numbers,
+    //      bold red errors, yellow warnings and plain message text, and
+    //      reports how many bytes each frame costs.
+    Viewport view = SetUpViewport();
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, view, g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+
+    size_t bytes = 0;
+    engine->SetTestCallback([&](const char* const /*pch*/, size_t const cch) {
+        bytes += cch;
+        return true;
+    });
+
+    struct Span
+    {
+        std::wstring_view text;
+        COLORREF foreground;
+        bool isBold;
+    };
+    const Span error[] = {
+        { L"src/host/screenInfo.cpp", g_ColorTable[15], true },
+        { L"(1234,17): ", g_ColorTable[8], false },
+        { L"error", g_ColorTable[12], true },
+        { L" C2065: 'coordCursor': undeclared identifier", g_ColorTable[15], false },
+    };
+    const Span warning[] = {
+        { L"src/host/getset.cpp", g_ColorTable[15], true },
+        { L"(98,5): ", g_ColorTable[8], false },
+        { L"warning", g_ColorTable[14], true },
+        { L" C4100: 'flags': unreferenced parameter", g_ColorTable[15], false },
+    };
+
+    const size_t frameCount = 20;
+    for (size_t frame = 0; frame < frameCount; frame++)
+    {
+        VERIFY_SUCCEEDED(engine->InvalidateAll());
+        VERIFY_SUCCEEDED(engine->StartPaint());
+        for (short y = 0; y < view.Height(); y++)
+        {
+            short x = 0;
+            for (const auto& span : (y % 3 == 0) ? warning : error)
+            {
+                std::vector<Cluster> clusters;
+                for (const auto& wch : span.text)
+                {
+                    clusters.emplace_back(std::wstring_view{ &wch, 1 }, static_cast<size_t>(1));
+                }
+                VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(span.foreground, g_ColorTable[0], 0, span.isBold, false));
+                VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, { x, y }, false));
+                x += gsl::narrow<short>(clusters.size());
+            }
+        }
+        VERIFY_SUCCEEDED(engine->EndPaint());
+    }
+
+    Log::Comment(NoThrowString().Format(L"%zu bytes per frame", bytes / frameCount));
+    VERIFY_IS_GREATER_THAN(bytes, size_t{ 0 });
+}
+
 void VtRendererTest::XtermTestInvalidate()
 {
     wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
@@ -767,7 +868,7 @@ void VtRendererTest::XtermTestColors()
 
         Log::Comment(NoThrowString().Format(
             L"----Change only the BG to the 'Default' background----"));
-        qExpectedInput.push_back("\x1b[40m"); // Background DARK_BLACK
+        qExpectedInput.push_back("\x1b[49m"); // Background default
         VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[7], g_ColorTable[0], 0, false, false));
 
         Log::Comment(NoThrowString().Format(
@@ -786,6 +887,35 @@ void VtRendererTest::XtermTestColors()
     });
 }
 
+void VtRendererTest::XtermTestSgrDefaults()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<XtermEngine> engine = std::make_unique<XtermEngine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE), false);
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    qExpectedInput.push_back("\x1b[m");
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[15], g_ColorTable[0], 0, false, false));
+
+    qExpectedInput.push_back("\x1b[91;44m");
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[12], g_ColorTable[1], 0, false, false));
+
+    Log::Comment(L"Changing to the default foreground selects the default, not the nearest table color");
+    qExpectedInput.push_back("\x1b[39m");
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[15], g_ColorTable[1], 0, false, false));
+
+    Log::Comment(L"When a reset is shorter, it leaves the default background as the default too");
+    qExpectedInput.push_back("\x1b[0;91m");
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[12], g_ColorTable[0], 0, false, false));
+
+    Log::Comment(L"Changing away from the defaults selects the table colors");
+    qExpectedInput.push_back("\x1b[0;44m");
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[15], g_ColorTable[1], 0, false, false));
+
+    qExpectedInput.push_back("\x1b[m");
+    VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(g_ColorTable[15], g_ColorTable[0], 0, false, false));
+}
+
 void VtRendererTest::XtermTestCursor()
 {
     wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
@@ -1191,3 +1321,134 @@ void VtRendererTest::TestResize()
         VERIFY_IS_FALSE(engine->_suppressResizeRepaint);
     });
 }
+
+void VtRendererTest::TestPipeWriterSlowConsumer()
+{
+    // A pipe with a tiny buffer and a reader that takes its time stands in for
+    //      a terminal that can't keep up with our output.
+    wil::unique_hfile hRead;
+    wil::unique_hfile hWrite;
+    VERIFY_WIN32_BOOL_SUCCEEDED(CreatePipe(&hRead, &hWrite, nullptr, 64));
+
+    std::string received;
+    std::thread reader([&]() {
+        char buffer[64];
+        DWORD dwRead = 0;
+        while (ReadFile(hRead.get(), buffer, ARRAYSIZE(buffer), &dwRead, nullptr) && dwRead > 0)
+        {
+            received.append(buffer, dwRead);
+            Sleep(5);
+        }
+    });
+
+    const size_t frameCount = 40;
+    std::string expected;
+    VtPipeWriter::Metrics metrics{};
+    {
+        VtPipeWriter writer{ hWrite.get(), 256 };
+
+        std::string frame;
+        for (size_t i = 0; i < frameCount; i++)
+        {
+            const auto text = std::string(99, static_cast<char>('A' + (i % 26))) + "\n";
+            frame.append(text);
+            expected.append(text);
+
+            // Submitting must not wait for the write to complete, only for the
+            //      pending data to fall under the limit.
+            VERIFY_SUCCEEDED(writer.Submit(frame));
+            VERIFY_IS_TRUE(frame.empty());
+        }
+
+        VERIFY_SUCCEEDED(writer.WaitForIdle());
+        metrics = writer.GetMetrics();
+    }
+    hWrite.reset();
+    reader.join();
+
+    // Every byte arrives, in order, even though frames were merged.
+    VERIFY_ARE_EQUAL(expected.size(), received.size());
+    VERIFY_IS_TRUE(expected == received);
+
+    Log::Comment(NoThrowString().Format(L"writes:%zu coalesced:%zu stalls:%zu peak:%zu",
+                                        metrics.pipeWrites,
+                                        metrics.framesCoalesced,
+                                        metrics.producerStalls,
+                                        metrics.peakPendingBytes));
+    VERIFY_ARE_EQUAL(frameCount, metrics.framesSubmitted);
+    VERIFY_ARE_EQUAL(expected.size(), metrics.bytesWritten);
+    VERIFY_IS_GREATER_THAN(metrics.framesCoalesced, size_t{ 0 });
+    VERIFY_IS_LESS_THAN(metrics.pipeWrites, frameCount);
+    VERIFY_IS_GREATER_THAN(metrics.producerStalls, size_t{ 0 });
+}
+
+void VtRendererTest::TestWriteTerminalUtf8()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, SetUpViewport(), g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    Log::Comment(L"One, two, three and four byte sequences");
+    qExpectedInput.push_back("a\xc3\xa9\xe3\x81\x8b\xf0\x9f\x98\x80");
+    VERIFY_SUCCEEDED(engine->_WriteTerminalUtf8(L"a\x00e9\x304b\xD83D\xDE00"));
+
+    Log::Comment(L"Unpaired surrogates become U+FFFD");
+    qExpectedInput.push_back("\xef\xbf\xbd" "b" "\xef\xbf\xbd");
+    VERIFY_SUCCEEDED(engine->_WriteTerminalUtf8(L"\xDE00" L"b" L"\xD83D"));
+
+    Log::Comment(L"Sequences with parameters are formatted in place");
+    qExpectedInput.push_back("\x1b[38;2;1;22;255m");
+    VERIFY_SUCCEEDED(engine->_SetGraphicsRenditionRGBColor(RGB(1, 22, 255), true));
+
+    qExpectedInput.push_back("\x1b]0;title\x7");
+    VERIFY_SUCCEEDED(engine->_ChangeTitle("title"));
+}
+
+void VtRendererTest::TestRepaintThroughput()
+{
+    // Repaints the whole viewport, with a color change every few cells, many
+    //      times over, and reports how fast the engine produces output.
+    Viewport view = SetUpViewport();
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), p, view, g_ColorTable, static_cast<WORD>(COLOR_TABLE_SIZE));
+
+    size_t bytes = 0;
+    engine->SetTestCallback([&](const char* const /*pch*/, size_t const cch) {
+        bytes += cch;
+        return true;
+    });
+
+    const std::wstring text = L"The quick brown fox jumps over the lazy dog. \x304b\x304d ";
+    std::vector<Cluster> clusters;
+    for (short x = 0; x < view.Width(); x++)
+    {
+        clusters.emplace_back(std::wstring_view{ &text[x % text.size()], 1 }, static_cast<size_t>(1));
+    }
+
+    const size_t frameCount = 200;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t frame = 0; frame < frameCount; frame++)
+    {
+        VERIFY_SUCCEEDED(engine->InvalidateAll());
+        VERIFY_SUCCEEDED(engine->StartPaint());
+        for (short y = 0; y < view.Height(); y++)
+        {
+            for (short x = 0; x < view.Width(); x += 8)
+            {
+                const auto color = g_ColorTable[(x / 8 + y + frame) % COLOR_TABLE_SIZE];
+                VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(color, g_ColorTable[0], 0, false, false));
+                VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data() + x, 8 }, { x, y }, false));
+            }
+        }
+        VERIFY_SUCCEEDED(engine->EndPaint());
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    VERIFY_IS_GREATER_THAN(bytes, size_t{ 0 });
+    Log::Comment(NoThrowString().Format(L"%zu frames, %zu bytes in %.3fs: %.0f bytes/s",
+                                        frameCount,
+                                        bytes,
+                                        elapsed.count(),
+                                        bytes / std::max(elapsed.count(), 1e-9)));
+}
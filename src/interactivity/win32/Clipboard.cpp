@@ -107,8 +107,7 @@ void Clipboard::StringPaste(_In_reads_(cchData) const wchar_t* const pData,
 
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> inEvents = TextToKeyEvents(pData, cchData);
-        gci.pInputBuffer->Write(inEvents);
+        gci.pInputBuffer->WriteString(FilterTextForPaste(pData, cchData));
     }
     catch (...)
     {
@@ -132,10 +131,39 @@ void Clipboard::StringPaste(_In_reads_(cchData) const wchar_t* const pData,
 // - will throw exception on error
 std::deque<std::unique_ptr<IInputEvent>> Clipboard::TextToKeyEvents(_In_reads_(cchData) const wchar_t* const pData,
                                                                     const size_t cchData)
+{
+    const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
+    std::deque<std::unique_ptr<IInputEvent>> keyEvents;
+
+    for (const wchar_t currentChar : FilterTextForPaste(pData, cchData))
+    {
+        std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(currentChar, codepage);
+        while (!convertedEvents.empty())
+        {
+            keyEvents.push_back(std::move(convertedEvents.front()));
+            convertedEvents.pop_front();
+        }
+    }
+    return keyEvents;
+}
+
+// Routine Description:
+// - Prepares clipboard text for writing to the input buffer: drops the
+// characters that shouldn't be pasted and normalizes line endings.
+// Arguments:
+// - pData - the text to filter
+// - cchData - the size of pData, in wchars
+// Return Value:
+// - the text to paste
+// Note:
+// - will throw exception on error
+std::wstring Clipboard::FilterTextForPaste(_In_reads_(cchData) const wchar_t* const pData,
+                                          const size_t cchData)
 {
     THROW_IF_NULL_ALLOC(pData);
 
-    std::deque<std::unique_ptr<IInputEvent>> keyEvents;
+    std::wstring text;
+    text.reserve(cchData);
 
     for (size_t i = 0; i < cchData; ++i)
     {
@@ -173,25 +201,19 @@ std::deque<std::unique_ptr<IInputEvent>> Clipboard::TextToKeyEvents(_In_reads_(c
             currentChar = UNICODE_CARRIAGERETURN;
         }
 
-        const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
-        std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(currentChar, codepage);
-        while (!convertedEvents.empty())
-        {
-            keyEvents.push_back(std::move(convertedEvents.front()));
-            convertedEvents.pop_front();
-        }
+        text.push_back(currentChar);
     }
-    return keyEvents;
+    return text;
 }
 
 // Routine Description:
 // - Copies the selected area onto the global system clipboard.
 // - NOTE: Throws on allocation and other clipboard failures.
 // Arguments:
-// - fAlsoCopyHtml - This will also place colored HTML text onto the clipboard as well as the usual plain text.
+// - fAlsoCopyFormatting - This will also place colored HTML and RTF text onto the clipboard as well as the usual plain text.
 // Return Value:
 //   <none>
-void Clipboard::StoreSelectionToClipboard(bool const fAlsoCopyHtml)
+void Clipboard::StoreSelectionToClipboard(bool const fAlsoCopyFormatting)
 {
     const auto& selection = Selection::Instance();
 
@@ -208,11 +230,26 @@ void Clipboard::StoreSelectionToClipboard(bool const fAlsoCopyHtml)
     const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     const auto& screenInfo = gci.GetActiveOutputBuffer();
 
-    const auto text = RetrieveTextFromBuffer(screenInfo,
-                                             lineSelection,
-                                             selectionRects);
+    const auto& buffer = screenInfo.GetTextBuffer();
+
+    std::function<COLORREF(TextAttribute&)> GetForegroundColor = std::bind(&CONSOLE_INFORMATION::LookupForegroundColor, &gci, std::placeholders::_1);
+    std::function<COLORREF(TextAttribute&)> GetBackgroundColor = std::bind(&CONSOLE_INFORMATION::LookupBackgroundColor, &gci, std::placeholders::_1);
 
-    CopyTextToSystemClipboard(text, fAlsoCopyHtml);
+    const auto& fontData = screenInfo.GetCurrentFont();
+    const int iFontHeightPoints = fontData.GetUnscaledSize().Y * 72 / ServiceLocator::LocateGlobals().dpi;
+    const std::wstring fontFaceName = fontData.GetFaceName();
+
+    // The plain text and both formatted copies come out of one pass over the selection.
+    const auto data = buffer.GenClipboardData(lineSelection,
+                                              _ShouldTrimTrailingWhitespace(),
+                                              selectionRects,
+                                              fAlsoCopyFormatting,
+                                              iFontHeightPoints,
+                                              fontFaceName,
+                                              GetForegroundColor,
+                                              GetBackgroundColor);
+
+    CopyTextToSystemClipboard(data.text, data.html, data.rtf);
 }
 
 // Routine Description:
@@ -221,334 +258,87 @@ void Clipboard::StoreSelectionToClipboard(bool const fAlsoCopyHtml)
 // - screenInfo - what is rendered on the screen
 // - lineSelection - true if entire line is being selected. False otherwise (box selection)
 // - selectionRects - the selection regions from which the data will be extracted from the buffer
-TextBuffer::TextAndColor Clipboard::RetrieveTextFromBuffer(const SCREEN_INFORMATION& screenInfo,
-                                                           const bool lineSelection,
-                                                           const std::vector<SMALL_RECT>& selectionRects)
+// Return Value:
+// - the selected text, rows separated by CR/LF
+std::wstring Clipboard::RetrieveTextFromBuffer(const SCREEN_INFORMATION& screenInfo,
+                                               const bool lineSelection,
+                                               const std::vector<SMALL_RECT>& selectionRects)
 {
-    const auto& buffer = screenInfo.GetTextBuffer();
-    const bool trimTrailingWhitespace = !WI_IsFlagSet(GetKeyState(VK_SHIFT), KEY_PRESSED);
-    const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
-
-    std::function<COLORREF(TextAttribute&)> GetForegroundColor = std::bind(&CONSOLE_INFORMATION::LookupForegroundColor, &gci, std::placeholders::_1);
-    std::function<COLORREF(TextAttribute&)> GetBackgroundColor = std::bind(&CONSOLE_INFORMATION::LookupBackgroundColor, &gci, std::placeholders::_1);
-
-    return buffer.GetTextForClipboard(lineSelection,
-                                      trimTrailingWhitespace,
-                                      selectionRects,
-                                      GetForegroundColor,
-                                      GetBackgroundColor);
+    return screenInfo.GetTextBuffer().GetPlainText(lineSelection,
+                                                   _ShouldTrimTrailingWhitespace(),
+                                                   selectionRects);
 }
 
 // Routine Description:
-// - Generates a CF_HTML compliant structure based on the passed in text and color data
-// Arguments:
-// - rows - the text and color data we will format & encapsulate
+// - Trailing whitespace is trimmed from copied rows unless the SHIFT key is held.
 // Return Value:
-// - string containing the generated HTML
-std::string Clipboard::GenHTML(const TextBuffer::TextAndColor& rows)
+// - true if trailing whitespace should be trimmed
+bool Clipboard::_ShouldTrimTrailingWhitespace()
 {
-    std::string szClipboard; // we will build the data going back in this string buffer
-
-    try
-    {
-        std::string const szHtmlClipFormat =
-            "Version:0.9\r\n"
-            "StartHTML:%010d\r\n"
-            "EndHTML:%010d\r\n"
-            "StartFragment:%010d\r\n"
-            "EndFragment:%010d\r\n"
-            "StartSelection:%010d\r\n"
-            "EndSelection:%010d\r\n";
-
-        // measure clip header
-        size_t const cbHeader = 157; // when formats are expanded, there will be 157 bytes in the header.
-
-        std::string const szHtmlHeader =
-            "<!DOCTYPE><HTML><HEAD><TITLE>Windows Console Host</TITLE></HEAD><BODY>";
-        size_t const cbHtmlHeader = szHtmlHeader.size();
-
-        std::string const szHtmlFragStart = "<!--StartFragment -->";
-        std::string const szHtmlFragEnd = "<!--EndFragment -->";
-        std::string const szHtmlFooter = "</BODY></HTML>";
-        size_t const cbHtmlFooter = szHtmlFooter.size();
-
-        std::string const szDivOuterBackgroundPattern = R"X(<DIV STYLE="background-color:#%02x%02x%02x;white-space:pre;">)X";
-
-        size_t const cbDivOuter = 55;
-        std::string szDivOuter;
-        szDivOuter.reserve(cbDivOuter);
-
-        std::string const szSpanFontSizePattern = R"X(<SPAN STYLE="font-size: %dpt">)X";
-
-        const auto& fontData = ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetCurrentFont();
-        int const iFontHeightPoints = fontData.GetUnscaledSize().Y * 72 / ServiceLocator::LocateGlobals().dpi;
-        size_t const cbSpanFontSize = 28 + (iFontHeightPoints / 10) + 1;
-
-        std::string szSpanFontSize;
-        szSpanFontSize.resize(cbSpanFontSize + 1); // reserve space for null after string for sprintf
-        sprintf_s(szSpanFontSize.data(), cbSpanFontSize + 1, szSpanFontSizePattern.data(), iFontHeightPoints);
-        szSpanFontSize.resize(cbSpanFontSize); //chop off null at end
-
-        std::string const szSpanStartPattern = R"X(<SPAN STYLE="color:#%02x%02x%02x;background-color:#%02x%02x%02x">)X";
-
-        size_t const cbSpanStart = 53; // when format is expanded, there will be 53 bytes per color pattern.
-        std::string szSpanStart;
-        szSpanStart.resize(cbSpanStart + 1); // +1 for null terminator
-
-        std::string const szSpanStartFontPattern = R"X(<SPAN STYLE="font-family: '%s', monospace">)X";
-        size_t const cbSpanStartFontPattern = 41;
-
-        std::string const szSpanStartFontConstant = R"X(<SPAN STYLE="font-family: monospace">)X";
-        size_t const cbSpanStartFontConstant = 37;
-
-        std::string szSpanStartFont;
-        size_t cbSpanStartFont;
-        bool fDeleteSpanStartFont = false;
-
-        std::wstring const wszFontFaceName = fontData.GetFaceName();
-        size_t const cchFontFaceName = wszFontFaceName.size();
-        if (cchFontFaceName > 0)
-        {
-            // measure and create buffer to convert face name to UTF8
-            int const cbNeeded = WideCharToMultiByte(CP_UTF8, 0, wszFontFaceName.data(), static_cast<int>(cchFontFaceName), nullptr, 0, nullptr, nullptr);
-            std::string szBuffer;
-            szBuffer.resize(cbNeeded);
-
-            // do conversion
-            WideCharToMultiByte(CP_UTF8, 0, wszFontFaceName.data(), static_cast<int>(cchFontFaceName), szBuffer.data(), cbNeeded, nullptr, nullptr);
-
-            // format converted font name into pattern
-            std::string const szFinalFontPattern = R"X(<SPAN STYLE="font-family: ')X" + szBuffer + R"X(', monospace\">)X";
-            size_t const cbBytesNeeded = szFinalFontPattern.length();
-
-            fDeleteSpanStartFont = true;
-            szSpanStartFont = szFinalFontPattern;
-            cbSpanStartFont = cbBytesNeeded;
-        }
-        else
-        {
-            szSpanStartFont = szSpanStartFontConstant;
-            cbSpanStartFont = cbSpanStartFontConstant;
-        }
-
-        std::string const szSpanEnd = "</SPAN>";
-        std::string const szDivEnd = "</DIV>";
-
-        // Start building the HTML formated string to return
-        // First we have to add the required header and then
-        // some standard HTML boiler plate required for CF_HTML
-        // as part of the HTML Clipboard format
-        szClipboard.append(cbHeader, 'H'); // reserve space for a header we fill in later
-        szClipboard.append(szHtmlHeader);
-        szClipboard.append(szHtmlFragStart);
-
-        COLORREF iBgColor = rows.BkAttr.at(0).at(0);
-
-        szDivOuter.resize(cbDivOuter + 1);
-        sprintf_s(szDivOuter.data(), cbDivOuter + 1, szDivOuterBackgroundPattern.data(), GetRValue(iBgColor), GetGValue(iBgColor), GetBValue(iBgColor));
-        szDivOuter.resize(cbDivOuter);
-        szClipboard.append(szDivOuter);
-
-        // copy font face start
-        szClipboard.append(szSpanStartFont);
-
-        // copy font size start
-        szClipboard.append(szSpanFontSize);
-
-        bool bColorFound = false;
-
-        // copy all text into the final clipboard data handle. There should be no nulls between rows of
-        // characters, but there should be a \0 at the end.
-        for (UINT iRow = 0; iRow < rows.text.size(); iRow++)
-        {
-            size_t cbStartOffset = 0;
-            size_t cchCharsToPrint = 0;
-
-            COLORREF const Blackness = RGB(0x00, 0x00, 0x00);
-            COLORREF fgColor = Blackness;
-            COLORREF bkColor = Blackness;
-
-            for (UINT iCol = 0; iCol < rows.text.at(iRow).length(); iCol++)
-            {
-                bool fColorDelta = false;
-
-                if (!bColorFound)
-                {
-                    fgColor = rows.FgAttr.at(iRow).at(iCol);
-                    bkColor = rows.BkAttr.at(iRow).at(iCol);
-                    bColorFound = true;
-                    fColorDelta = true;
-                }
-                else if ((rows.FgAttr.at(iRow).at(iCol) != fgColor) || (rows.BkAttr.at(iRow).at(iCol) != bkColor))
-                {
-                    fgColor = rows.FgAttr.at(iRow).at(iCol);
-                    bkColor = rows.BkAttr.at(iRow).at(iCol);
-                    fColorDelta = true;
-                }
-
-                if (fColorDelta)
-                {
-                    if (cchCharsToPrint > 0)
-                    {
-                        // write accumulated characters to stream ....
-                        std::string TempBuff;
-                        int const cbTempCharsNeeded = WideCharToMultiByte(CP_UTF8, 0, rows.text[iRow].data() + cbStartOffset, static_cast<int>(cchCharsToPrint), nullptr, 0, nullptr, nullptr);
-                        TempBuff.resize(cbTempCharsNeeded);
-                        WideCharToMultiByte(CP_UTF8, 0, rows.text[iRow].data() + cbStartOffset, static_cast<int>(cchCharsToPrint), TempBuff.data(), cbTempCharsNeeded, nullptr, nullptr);
-                        szClipboard.append(TempBuff);
-                        cbStartOffset += cchCharsToPrint;
-                        cchCharsToPrint = 0;
-
-                        // close previous span
-                        szClipboard += szSpanEnd;
-                    }
-
-                    // start new span
-
-                    // format with color then copy formatted string
-                    szSpanStart.resize(cbSpanStart + 1); // add room for null
-                    sprintf_s(szSpanStart.data(), cbSpanStart + 1, szSpanStartPattern.data(), GetRValue(fgColor), GetGValue(fgColor), GetBValue(fgColor), GetRValue(bkColor), GetGValue(bkColor), GetBValue(bkColor));
-                    szSpanStart.resize(cbSpanStart); // chop null from sprintf
-                    szClipboard.append(szSpanStart);
-                }
-
-                // accumulate 1 character
-                cchCharsToPrint++;
-            }
-
-            PCWCHAR pwchAccumulateStart = rows.text.at(iRow).data() + cbStartOffset;
-
-            // write accumulated characters to stream
-            std::string CharsConverted;
-            int cbCharsConverted = WideCharToMultiByte(CP_UTF8, 0, pwchAccumulateStart, static_cast<int>(cchCharsToPrint), nullptr, 0, nullptr, nullptr);
-            CharsConverted.resize(cbCharsConverted);
-            WideCharToMultiByte(CP_UTF8, 0, pwchAccumulateStart, static_cast<int>(cchCharsToPrint), CharsConverted.data(), cbCharsConverted, nullptr, nullptr);
-            szClipboard.append(CharsConverted);
-        }
-
-        if (bColorFound)
-        {
-            // copy end span
-            szClipboard.append(szSpanEnd);
-        }
-
-        // after we have copied all text we must wrap up
-        // with a standard set of HTML boilerplate required
-        // by CF_HTML
-
-        // copy end font size span
-        szClipboard.append(szSpanEnd);
-
-        // copy end font face span
-        szClipboard.append(szSpanEnd);
-
-        // copy end background color span
-        szClipboard.append(szDivEnd);
-
-        // copy HTML end fragment
-        szClipboard.append(szHtmlFragEnd);
-
-        // copy HTML footer
-        szClipboard.append(szHtmlFooter);
-
-        // null terminate the clipboard data
-        szClipboard += '\0';
-
-        // we are done generating formating & building HTML for the selection
-        // prepare the header text with the byte counts now that we know them
-        size_t const cbHtmlStart = cbHeader; // bytecount to start of HTML context
-        size_t const cbHtmlEnd = szClipboard.size() - 1; // don't count the null at the end
-        size_t const cbFragStart = cbHeader + cbHtmlHeader; // bytecount to start of selection fragment
-        size_t const cbFragEnd = cbHtmlEnd - cbHtmlFooter;
-
-        // push the values into the required HTML 0.9 header format
-        std::string szHtmlClipHeaderFinal;
-        szHtmlClipHeaderFinal.resize(cbHeader + 1); // add room for a null
-        sprintf_s(szHtmlClipHeaderFinal.data(), cbHeader + 1, szHtmlClipFormat.data(), cbHtmlStart, cbHtmlEnd, cbFragStart, cbFragEnd, cbFragStart, cbFragEnd);
-        szHtmlClipHeaderFinal.resize(cbHeader); // chop off the null
-
-        // overwrite the reserved space with the actual header & offsets we calculated
-        szClipboard.replace(0, cbHeader, szHtmlClipHeaderFinal.data());
-    }
-    catch (...)
-    {
-        LOG_HR(wil::ResultFromCaughtException());
-        szClipboard.clear(); // dont return a partial html fragment...
-    }
-
-    return szClipboard;
+    return !WI_IsFlagSet(GetKeyState(VK_SHIFT), KEY_PRESSED);
 }
 
 // Routine Description:
-// - Copies the text given onto the global system clipboard.
+// - Places a block of bytes onto the clipboard in the given format.
+// - NOTE: The clipboard must already be open. Throws on failure.
 // Arguments:
-// - rows - Rows of text data to copy
-void Clipboard::CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows, bool const fAlsoCopyHtml)
+// - format - the clipboard format to register the data under
+// - data - the bytes to place on the clipboard, including any terminating null
+void Clipboard::_SetClipboardData(const UINT format, const std::string_view data)
 {
-    std::wstring finalString;
-
-    // Concatenate strings into one giant string to put onto the clipboard.
-    for (const auto& str : rows.text)
-    {
-        finalString += str;
-    }
-
-    // allocate the final clipboard data
-    const size_t cchNeeded = finalString.size() + 1;
-    const size_t cbNeeded = sizeof(wchar_t) * cchNeeded;
-    wil::unique_hglobal globalHandle(GlobalAlloc(GMEM_MOVEABLE | GMEM_DDESHARE, cbNeeded));
+    wil::unique_hglobal globalHandle(GlobalAlloc(GMEM_MOVEABLE | GMEM_DDESHARE, data.size()));
     THROW_LAST_ERROR_IF_NULL(globalHandle.get());
 
-    PWSTR pwszClipboard = (PWSTR)GlobalLock(globalHandle.get());
-    THROW_LAST_ERROR_IF_NULL(pwszClipboard);
+    void* const pClipboard = GlobalLock(globalHandle.get());
+    THROW_LAST_ERROR_IF_NULL(pClipboard);
 
     // The pattern gets a bit strange here because there's no good wil built-in for global lock of this type.
-    // Try to copy then immediately unlock. Don't throw until after (so the hglobal won't be freed until we unlock).
-    const HRESULT hr = StringCchCopyW(pwszClipboard, cchNeeded, finalString.data());
+    // Copy then immediately unlock so the hglobal won't be freed until we unlock.
+    memcpy(pClipboard, data.data(), data.size());
     GlobalUnlock(globalHandle.get());
-    THROW_IF_FAILED(hr);
 
-    // Set global data to clipboard
-    THROW_LAST_ERROR_IF(!OpenClipboard(ServiceLocator::LocateConsoleWindow()->GetWindowHandle()));
-    THROW_LAST_ERROR_IF(!EmptyClipboard());
-    THROW_LAST_ERROR_IF_NULL(SetClipboardData(CF_UNICODETEXT, globalHandle.get()));
+    THROW_LAST_ERROR_IF_NULL(SetClipboardData(format, globalHandle.get()));
 
-    if (fAlsoCopyHtml)
-    {
-        std::string HTMLToPlaceOnClip = GenHTML(rows);
-        const size_t cbNeededHTML = HTMLToPlaceOnClip.size();
-        if (cbNeededHTML)
-        {
-            wil::unique_hglobal globalHandleHTML(GlobalAlloc(GMEM_MOVEABLE | GMEM_DDESHARE, cbNeededHTML));
-            THROW_LAST_ERROR_IF_NULL(globalHandleHTML.get());
+    // only free if we failed.
+    // the memory has to remain allocated if we successfully placed it on the clipboard.
+    // Releasing the smart pointer will leave it allocated as we exit scope.
+    globalHandle.release();
+}
 
-            PSTR pszClipboardHTML = (PSTR)GlobalLock(globalHandleHTML.get());
-            THROW_LAST_ERROR_IF_NULL(pszClipboardHTML);
+// Routine Description:
+// - Copies the text given onto the global system clipboard.
+// Arguments:
+// - text - the plain text to copy
+// - html - CF_HTML formatted text to copy alongside, if not empty
+// - rtf - RTF formatted text to copy alongside, if not empty
+void Clipboard::CopyTextToSystemClipboard(const std::wstring& text, const std::string& html, const std::string& rtf)
+{
+    // Set global data to clipboard
+    THROW_LAST_ERROR_IF(!OpenClipboard(ServiceLocator::LocateConsoleWindow()->GetWindowHandle()));
+    auto closeClipboard = wil::scope_exit([]() { LOG_LAST_ERROR_IF(!CloseClipboard()); });
 
-            // The pattern gets a bit strange here because there's no good wil built-in for global lock of this type.
-            // Try to copy then immediately unlock. Don't throw until after (so the hglobal won't be freed until we unlock).
-            const HRESULT hr2 = StringCchCopyA(pszClipboardHTML, cbNeededHTML, HTMLToPlaceOnClip.data());
-            GlobalUnlock(globalHandleHTML.get());
-            THROW_IF_FAILED(hr2);
+    THROW_LAST_ERROR_IF(!EmptyClipboard());
 
-            UINT const CF_HTML = RegisterClipboardFormatW(L"HTML Format");
-            THROW_LAST_ERROR_IF(0 == CF_HTML);
+    // include the null terminator
+    const std::string_view textBytes{ reinterpret_cast<const char*>(text.c_str()), (text.size() + 1) * sizeof(wchar_t) };
+    _SetClipboardData(CF_UNICODETEXT, textBytes);
 
-            THROW_LAST_ERROR_IF_NULL(SetClipboardData(CF_HTML, globalHandleHTML.get()));
+    if (!html.empty())
+    {
+        UINT const CF_HTML = RegisterClipboardFormatW(L"HTML Format");
+        THROW_LAST_ERROR_IF(0 == CF_HTML);
 
-            // only free if we failed.
-            // the memory has to remain allocated if we successfully placed it on the clipboard.
-            // Releasing the smart pointer will leave it allocated as we exit scope.
-            globalHandleHTML.release();
-        }
+        // the generated HTML already carries its own null terminator
+        _SetClipboardData(CF_HTML, html);
     }
 
-    THROW_LAST_ERROR_IF(!CloseClipboard());
+    if (!rtf.empty())
+    {
+        UINT const CF_RTF = RegisterClipboardFormatW(L"Rich Text Format");
+        THROW_LAST_ERROR_IF(0 == CF_RTF);
 
-    // only free if we failed.
-    // the memory has to remain allocated if we successfully placed it on the clipboard.
-    // Releasing the smart pointer will leave it allocated as we exit scope.
-    globalHandle.release();
+        _SetClipboardData(CF_RTF, { rtf.c_str(), rtf.size() + 1 });
+    }
 }
 
 // Returns true if the character should be emitted to the paste stream
@@ -542,6 +542,25 @@ IFACEMETHODIMP UiaTextRange::ExpandToEnclosingUnit(_In_ TextUnit unit)
         {
             _end = _start;
         }
+        else if (unit == TextUnit::TextUnit_Word)
+        {
+            // expand to the word under the start, found with one scan of its
+            // row. A delimiter is a word all by itself.
+            const COORD position = _endpointToCoord(_start);
+            const auto text = _getTextBuffer().GetRowByOffset(position.Y).GetCharRow().GetColumnText();
+            const auto& delimiters = ServiceLocator::LocateGlobals().WordDelimiters;
+            if (delimiters.IsDelimiter(text.at(position.X)))
+            {
+                _end = _start;
+            }
+            else
+            {
+                const Endpoint rowStart = _start - position.X;
+                const auto word = delimiters.FindWord(text, position.X);
+                _start = rowStart + gsl::narrow<Endpoint>(word.first);
+                _end = rowStart + gsl::narrow<Endpoint>(word.second) - 1;
+            }
+        }
         else if (unit <= TextUnit::TextUnit_Line)
         {
             // expand to line
@@ -709,14 +728,15 @@ IFACEMETHODIMP UiaTextRange::GetEnclosingElement(_Outptr_result_maybenull_ IRawE
 
 IFACEMETHODIMP UiaTextRange::GetText(_In_ int maxLength, _Out_ BSTR* pRetVal)
 {
+    RETURN_HR_IF(E_INVALIDARG, pRetVal == nullptr);
+    *pRetVal = nullptr;
+
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     gci.LockConsole();
     auto Unlock = wil::scope_exit([&] {
         gci.UnlockConsole();
     });
 
-    std::wstring wstr = L"";
-
     if (maxLength < -1)
     {
         return E_INVALIDARG;
@@ -726,83 +746,124 @@ IFACEMETHODIMP UiaTextRange::GetText(_In_ int maxLength, _Out_ BSTR* pRetVal)
     // truncated.
     const bool getPartialText = maxLength != -1;
 
-    if (!_degenerate)
+    BSTR text = nullptr;
+    try
     {
-        try
+        text = _exportText(getPartialText ? static_cast<size_t>(maxLength) : SIZE_MAX);
+    }
+    CATCH_RETURN();
+
+    // tracing
+    ApiMsgGetText apiMsg;
+    apiMsg.Text = text;
+    Tracing::s_TraceUia(this, ApiCall::GetText, &apiMsg);
+
+#if defined(_DEBUG) && defined(UIATEXTRANGE_DEBUG_MSGS)
+    std::wstringstream ss;
+    ss << L"--------Retrieved Text Max Length(" << maxLength << L") [" << _id << L"]: " << text << "\n";
+    OutputDebugString(ss.str().c_str());
+#endif
+
+    *pRetVal = text;
+    return S_OK;
+}
+
+// Routine Description:
+// - builds the text of the range straight into a BSTR. The range is walked
+//   once to measure it, so that the string is allocated only once and each
+//   row is copied into it without building any intermediate strings.
+// Arguments:
+// - maxLength - the most code units to return. The text is cut off there.
+// Return Value:
+// - the text of the range, rows separated by CRLF. The caller owns the string.
+// - Note: will throw exception if out of memory
+BSTR UiaTextRange::_exportText(const size_t maxLength) const
+{
+    const TextBuffer& textBuffer = _getTextBuffer();
+
+    // calls rowFunc with each row in the range, the span of columns
+    // that have text in that row, and whether a line break follows it.
+    // stops early if rowFunc returns false.
+    auto walkRows = [&](auto rowFunc) {
+        if (_degenerate)
         {
-            const ScreenInfoRow startScreenInfoRow = _endpointToScreenInfoRow(_start);
-            const Column startColumn = _endpointToColumn(_start);
-            const ScreenInfoRow endScreenInfoRow = _endpointToScreenInfoRow(_end);
-            const Column endColumn = _endpointToColumn(_end);
-            const unsigned int totalRowsInRange = _rowCountInRange();
-            const TextBuffer& textBuffer = _getTextBuffer();
+            return;
+        }
+
+        const ScreenInfoRow startScreenInfoRow = _endpointToScreenInfoRow(_start);
+        const Column startColumn = _endpointToColumn(_start);
+        const ScreenInfoRow endScreenInfoRow = _endpointToScreenInfoRow(_end);
+        const Column endColumn = _endpointToColumn(_end);
+        const unsigned int totalRowsInRange = _rowCountInRange();
 
 #if defined(_DEBUG) && defined(UIATEXTRANGE_DEBUG_MSGS)
-            std::wstringstream ss;
-            ss << L"---Initial span start=" << _start << L" and end=" << _end << L"\n";
-            ss << L"----Retrieving sr:" << startScreenInfoRow << L" sc:" << startColumn << L" er:" << endScreenInfoRow << L" ec:" << endColumn << L"\n";
-            OutputDebugString(ss.str().c_str());
+        std::wstringstream ss;
+        ss << L"---Initial span start=" << _start << L" and end=" << _end << L"\n";
+        ss << L"----Retrieving sr:" << startScreenInfoRow << L" sc:" << startColumn << L" er:" << endScreenInfoRow << L" ec:" << endColumn << L"\n";
+        OutputDebugString(ss.str().c_str());
 #endif
 
-            ScreenInfoRow currentScreenInfoRow;
-            for (unsigned int i = 0; i < totalRowsInRange; ++i)
+        for (unsigned int i = 0; i < totalRowsInRange; ++i)
+        {
+            const ScreenInfoRow currentScreenInfoRow = startScreenInfoRow + i;
+            const CharRow& charRow = textBuffer.GetRowByOffset(currentScreenInfoRow).GetCharRow();
+            size_t startIndex = 0;
+            size_t endIndex = 0;
+            if (charRow.ContainsText())
             {
-                currentScreenInfoRow = startScreenInfoRow + i;
-                const ROW& row = textBuffer.GetRowByOffset(currentScreenInfoRow);
-                if (row.GetCharRow().ContainsText())
-                {
-                    const size_t rowRight = row.GetCharRow().MeasureRight();
-                    size_t startIndex = 0;
-                    size_t endIndex = rowRight;
-                    if (currentScreenInfoRow == startScreenInfoRow)
-                    {
-                        startIndex = startColumn;
-                    }
-                    if (currentScreenInfoRow == endScreenInfoRow)
-                    {
-                        // prevent the end from going past the last non-whitespace char in the row
-                        endIndex = std::min(static_cast<size_t>(endColumn + 1), rowRight);
-                    }
-
-                    // if startIndex >= endIndex then _start is
-                    // further to the right than the last
-                    // non-whitespace char in the row so there
-                    // wouldn't be any text to grab.
-                    if (startIndex < endIndex)
-                    {
-                        wstr += row.GetText().substr(startIndex, endIndex - startIndex);
-                    }
-                }
-
-                if (currentScreenInfoRow != endScreenInfoRow)
-                {
-                    wstr += L"\r\n";
-                }
+                const size_t rowRight = charRow.MeasureRight();
+                startIndex = (currentScreenInfoRow == startScreenInfoRow) ? startColumn : 0;
+                // prevent the end from going past the last non-whitespace char in the row
+                endIndex = (currentScreenInfoRow == endScreenInfoRow) ? std::min(static_cast<size_t>(endColumn + 1), rowRight) : rowRight;
+
+                // if startIndex >= endIndex then _start is
+                // further to the right than the last
+                // non-whitespace char in the row so there
+                // wouldn't be any text to grab.
+                endIndex = std::max(startIndex, endIndex);
+            }
 
-                if (getPartialText && wstr.size() > static_cast<size_t>(maxLength))
-                {
-                    wstr.resize(maxLength);
-                    break;
-                }
+            if (!rowFunc(charRow, startIndex, endIndex, currentScreenInfoRow != endScreenInfoRow))
+            {
+                break;
             }
         }
-        CATCH_RETURN();
-    }
+    };
 
-    *pRetVal = SysAllocString(wstr.c_str());
+    static constexpr std::wstring_view lineBreak{ L"\r\n" };
 
-    // tracing
-    ApiMsgGetText apiMsg;
-    apiMsg.Text = wstr.c_str();
-    Tracing::s_TraceUia(this, ApiCall::GetText, &apiMsg);
+    size_t length = 0;
+    walkRows([&](const CharRow& charRow, const size_t startIndex, const size_t endIndex, const bool addLineBreak) {
+        length += charRow.MeasureText(startIndex, endIndex);
+        if (addLineBreak)
+        {
+            length += lineBreak.size();
+        }
+        return length < maxLength;
+    });
+    length = std::min(length, maxLength);
 
-#if defined(_DEBUG) && defined(UIATEXTRANGE_DEBUG_MSGS)
-    std::wstringstream ss;
-    ss << L"--------Retrieved Text Max Length(" << maxLength << L") [" << _id << L"]: " << wstr.c_str() << "\n";
-    OutputDebugString(ss.str().c_str());
-#endif
+    BSTR text = SysAllocStringLen(nullptr, gsl::narrow<UINT>(length));
+    THROW_IF_NULL_ALLOC(text);
+    auto freeText = wil::scope_exit([&] {
+        SysFreeString(text);
+    });
 
-    return S_OK;
+    const gsl::span<wchar_t> dest{ text, gsl::narrow<ptrdiff_t>(length) };
+    size_t written = 0;
+    walkRows([&](const CharRow& charRow, const size_t startIndex, const size_t endIndex, const bool addLineBreak) {
+        written += charRow.CopyText(startIndex, endIndex, dest.subspan(gsl::narrow_cast<ptrdiff_t>(written)));
+        if (addLineBreak)
+        {
+            const size_t count = std::min(lineBreak.size(), length - written);
+            std::copy_n(lineBreak.data(), count, dest.data() + written);
+            written += count;
+        }
+        return written < length;
+    });
+
+    freeText.release();
+    return text;
 }
 
 IFACEMETHODIMP UiaTextRange::Move(_In_ TextUnit unit,
@@ -842,6 +903,10 @@ IFACEMETHODIMP UiaTextRange::Move(_In_ TextUnit unit,
     {
         moveFunc = &_moveByCharacter;
     }
+    else if (unit == TextUnit::TextUnit_Word)
+    {
+        moveFunc = &_moveByWord;
+    }
     else if (unit <= TextUnit::TextUnit_Line)
     {
         moveFunc = &_moveByLine;
@@ -915,6 +980,10 @@ IFACEMETHODIMP UiaTextRange::MoveEndpointByUnit(_In_ TextPatternRangeEndpoint en
     {
         moveFunc = &_moveEndpointByUnitCharacter;
     }
+    else if (unit == TextUnit::TextUnit_Word)
+    {
+        moveFunc = &_moveEndpointByUnitWord;
+    }
     else if (unit <= TextUnit::TextUnit_Line)
     {
         moveFunc = &_moveEndpointByUnitLine;
@@ -1644,6 +1713,120 @@ const int UiaTextRange::_compareScreenCoords(const ScreenInfoRow rowA,
     return 0;
 }
 
+// Routine Description:
+// - moves a position forward moveCount characters, where a character is any
+//   cell up to the last non-whitespace cell of its row. Each row is crossed
+//   in one step rather than one character at a time.
+// Arguments:
+// - moveCount - the number of characters to move
+// - moveState - values indicating the state of the console for the
+// move operation
+// - currentScreenInfoRow - the row of the position. Updated with the new row.
+// - currentColumn - the column of the position. Updated with the new column.
+// Return Value:
+// - the number of characters actually moved
+int UiaTextRange::_advanceByCharacterForward(const int moveCount,
+                                             const MoveState& moveState,
+                                             ScreenInfoRow& currentScreenInfoRow,
+                                             Column& currentColumn)
+{
+    const int increment = static_cast<int>(moveState.Increment);
+    int amountMoved = 0;
+    int remaining = abs(moveCount);
+    while (remaining > 0)
+    {
+        // get the current row's right
+        const ROW& row = _getTextBuffer().GetRowByOffset(currentScreenInfoRow);
+        const size_t right = row.GetCharRow().MeasureRight();
+
+        if (currentColumn + 1 < right)
+        {
+            // moving somewhere away from the edges of a row, as far along it as we can
+            const int steps = std::min(remaining, gsl::narrow<int>(right - 1 - currentColumn));
+            currentColumn += steps * increment;
+            remaining -= steps;
+            amountMoved += steps * increment;
+        }
+        else if (currentScreenInfoRow == moveState.LimitingRow)
+        {
+            // we're at the edge of the screen info buffer
+            break;
+        }
+        else
+        {
+            // we're at the edge of a row and need to go to the next one
+            currentColumn = moveState.FirstColumnInRow;
+            currentScreenInfoRow += increment;
+            --remaining;
+            amountMoved += increment;
+        }
+    }
+
+    FAIL_FAST_IF(!(currentColumn >= _getFirstColumnIndex()));
+    FAIL_FAST_IF(!(currentColumn <= _getLastColumnIndex()));
+    FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
+    FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
+
+    return amountMoved;
+}
+
+// Routine Description:
+// - moves a position backward moveCount characters. Moving off the start of
+//   a row lands on the last non-whitespace cell of the row before it. Each
+//   row is crossed in one step rather than one character at a time.
+// Arguments:
+// - moveCount - the number of characters to move
+// - moveState - values indicating the state of the console for the
+// move operation
+// - currentScreenInfoRow - the row of the position. Updated with the new row.
+// - currentColumn - the column of the position. Updated with the new column.
+// Return Value:
+// - the number of characters actually moved
+int UiaTextRange::_advanceByCharacterBackward(const int moveCount,
+                                              const MoveState& moveState,
+                                              ScreenInfoRow& currentScreenInfoRow,
+                                              Column& currentColumn)
+{
+    const int increment = static_cast<int>(moveState.Increment);
+    int amountMoved = 0;
+    int remaining = abs(moveCount);
+    while (remaining > 0)
+    {
+        if (currentColumn != moveState.LastColumnInRow)
+        {
+            // moving somewhere away from the edges of a row, as far along it as we can
+            const int columnsLeft = abs(static_cast<int>(currentColumn) - static_cast<int>(moveState.LastColumnInRow));
+            const int steps = std::min(remaining, columnsLeft);
+            currentColumn += steps * increment;
+            remaining -= steps;
+            amountMoved += steps * increment;
+        }
+        else if (currentScreenInfoRow == moveState.LimitingRow)
+        {
+            // we're at the edge of the screen info buffer
+            break;
+        }
+        else
+        {
+            // we're at the edge of a row and need to go to the
+            // next one. move to the cell with the last non-whitespace charactor
+            currentScreenInfoRow += increment;
+            const ROW& row = _getTextBuffer().GetRowByOffset(currentScreenInfoRow);
+            const size_t right = row.GetCharRow().MeasureRight();
+            currentColumn = static_cast<Column>((right == 0) ? 0 : right - 1);
+            --remaining;
+            amountMoved += increment;
+        }
+    }
+
+    FAIL_FAST_IF(!(currentColumn >= _getFirstColumnIndex()));
+    FAIL_FAST_IF(!(currentColumn <= _getLastColumnIndex()));
+    FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
+    FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
+
+    return amountMoved;
+}
+
 // Routine Description:
 // - calculates new Endpoints if they were to be moved moveCount times
 // by character.
@@ -1672,41 +1855,10 @@ std::pair<Endpoint, Endpoint> UiaTextRange::_moveByCharacterForward(const int mo
                                                                     const MoveState moveState,
                                                                     _Out_ int* const pAmountMoved)
 {
-    *pAmountMoved = 0;
-    int count = moveCount;
     ScreenInfoRow currentScreenInfoRow = moveState.StartScreenInfoRow;
     Column currentColumn = moveState.StartColumn;
 
-    for (int i = 0; i < abs(count); ++i)
-    {
-        // get the current row's right
-        const ROW& row = _getTextBuffer().GetRowByOffset(currentScreenInfoRow);
-        const size_t right = row.GetCharRow().MeasureRight();
-
-        // check if we're at the edge of the screen info buffer
-        if (currentScreenInfoRow == moveState.LimitingRow &&
-            currentColumn + 1 >= right)
-        {
-            break;
-        }
-        else if (currentColumn + 1 >= right)
-        {
-            // we're at the edge of a row and need to go to the next one
-            currentColumn = moveState.FirstColumnInRow;
-            currentScreenInfoRow += static_cast<int>(moveState.Increment);
-        }
-        else
-        {
-            // moving somewhere away from the edges of a row
-            currentColumn += static_cast<int>(moveState.Increment);
-        }
-        *pAmountMoved += static_cast<int>(moveState.Increment);
-
-        FAIL_FAST_IF(!(currentColumn >= _getFirstColumnIndex()));
-        FAIL_FAST_IF(!(currentColumn <= _getLastColumnIndex()));
-        FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
-        FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
-    }
+    *pAmountMoved = _advanceByCharacterForward(moveCount, moveState, currentScreenInfoRow, currentColumn);
 
     Endpoint start = _screenInfoRowToEndpoint(currentScreenInfoRow) + currentColumn;
     Endpoint end = start;
@@ -1717,45 +1869,127 @@ std::pair<Endpoint, Endpoint> UiaTextRange::_moveByCharacterBackward(const int m
                                                                      const MoveState moveState,
                                                                      _Out_ int* const pAmountMoved)
 {
-    *pAmountMoved = 0;
-    int count = moveCount;
     ScreenInfoRow currentScreenInfoRow = moveState.StartScreenInfoRow;
     Column currentColumn = moveState.StartColumn;
 
-    for (int i = 0; i < abs(count); ++i)
-    {
-        // check if we're at the edge of the screen info buffer
-        if (currentScreenInfoRow == moveState.LimitingRow &&
-            currentColumn == moveState.LastColumnInRow)
+    *pAmountMoved = _advanceByCharacterBackward(moveCount, moveState, currentScreenInfoRow, currentColumn);
+
+    Endpoint start = _screenInfoRowToEndpoint(currentScreenInfoRow) + currentColumn;
+    Endpoint end = start;
+    return std::make_pair<Endpoint, Endpoint>(std::move(start), std::move(end));
+}
+
+// Routine Description:
+// - calculates the position that is moveCount word edges away from the
+// current one. A word starts at a character that isn't a delimiter at the
+// beginning of its row or right after a delimiter, and it ends the same way
+// looking the other way. Delimiters come from the global word delimiter table.
+// Arguments:
+// - moveCount - the number of word edges to move
+// - moveState - values indicating the state of the console for the
+// move operation
+// - edge - whether to stop at the starts or the ends of words
+// - currentScreenInfoRow - the screenInfoRow to move
+// - currentColumn - the column to move
+// Return Value:
+// - the number of words that were moved
+int UiaTextRange::_advanceByWord(const int moveCount,
+                                 const MoveState& moveState,
+                                 const WordEdge edge,
+                                 ScreenInfoRow& currentScreenInfoRow,
+                                 Column& currentColumn)
+{
+    const auto& delimiters = ServiceLocator::LocateGlobals().WordDelimiters;
+    const int increment = static_cast<int>(moveState.Increment);
+    // the neighbor that has to be a delimiter (or off the row) for a
+    // character to be on the edge of its word
+    const int outside = edge == WordEdge::Start ? -1 : 1;
+    const auto isEdge = [&](const std::wstring_view text, const int column) {
+        const int neighbor = column + outside;
+        return !delimiters.IsDelimiter(text.at(column)) &&
+               (neighbor < 0 || neighbor >= gsl::narrow<int>(text.size()) || delimiters.IsDelimiter(text.at(neighbor)));
+    };
+
+    // each row's text is fetched once, so that the scan is one pass over it
+    ScreenInfoRow screenInfoRow = currentScreenInfoRow;
+    std::wstring text = _getTextBuffer().GetRowByOffset(screenInfoRow).GetCharRow().GetColumnText();
+    int column = gsl::narrow<int>(currentColumn);
+    int amountMoved = 0;
+    while (amountMoved != moveCount)
+    {
+        column += increment;
+        if (column < 0 || column >= gsl::narrow<int>(text.size()))
         {
-            break;
+            if (screenInfoRow == moveState.LimitingRow)
+            {
+                // there are no more words in this direction
+                break;
+            }
+            screenInfoRow += increment;
+            text = _getTextBuffer().GetRowByOffset(screenInfoRow).GetCharRow().GetColumnText();
+            column = (increment > 0) ? 0 : gsl::narrow<int>(text.size()) - 1;
         }
-        else if (currentColumn == moveState.LastColumnInRow)
-        {
-            // we're at the edge of a row and need to go to the
-            // next one. move to the cell with the last non-whitespace charactor
 
-            currentScreenInfoRow += static_cast<int>(moveState.Increment);
-            // get the right cell for the next row
-            const ROW& row = _getTextBuffer().GetRowByOffset(currentScreenInfoRow);
-            const size_t right = row.GetCharRow().MeasureRight();
-            currentColumn = static_cast<Column>((right == 0) ? 0 : right - 1);
-        }
-        else
+        if (isEdge(text, column))
         {
-            // moving somewhere away from the edges of a row
-            currentColumn += static_cast<int>(moveState.Increment);
+            currentScreenInfoRow = screenInfoRow;
+            currentColumn = gsl::narrow<Column>(column);
+            amountMoved += increment;
         }
-        *pAmountMoved += static_cast<int>(moveState.Increment);
+    }
 
-        FAIL_FAST_IF(!(currentColumn >= _getFirstColumnIndex()));
-        FAIL_FAST_IF(!(currentColumn <= _getLastColumnIndex()));
-        FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
-        FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
+    FAIL_FAST_IF(!(currentColumn >= _getFirstColumnIndex()));
+    FAIL_FAST_IF(!(currentColumn <= _getLastColumnIndex()));
+    FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
+    FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
+
+    return amountMoved;
+}
+
+// Routine Description:
+// - counts the rows between a row and the limiting row of a move
+// Arguments:
+// - screenInfoRow - the row to count from
+// - moveState - values indicating the state of the console for the
+// move operation
+// Return Value:
+// - the number of rows that can be moved before reaching the limiting row
+int UiaTextRange::_rowsToLimit(const ScreenInfoRow screenInfoRow, const MoveState& moveState)
+{
+    const ScreenInfoRow limitingRow = moveState.LimitingRow;
+    return gsl::narrow<int>(std::max(screenInfoRow, limitingRow) - std::min(screenInfoRow, limitingRow));
+}
+
+// Routine Description:
+// - calculates new Endpoints if they were to be moved moveCount times
+// by word. The range becomes the word that its start moves to.
+// Arguments:
+// - moveCount - the number of times to move
+// - moveState - values indicating the state of the console for the
+// move operation
+// - pAmountMoved - the number of times that the return values are "moved"
+// Return Value:
+// - a pair of endpoints of the form <start, end>
+std::pair<Endpoint, Endpoint> UiaTextRange::_moveByWord(const int moveCount,
+                                                        const MoveState moveState,
+                                                        _Out_ int* const pAmountMoved)
+{
+    Endpoint start = _screenInfoRowToEndpoint(moveState.StartScreenInfoRow) + moveState.StartColumn;
+    Endpoint end = _screenInfoRowToEndpoint(moveState.EndScreenInfoRow) + moveState.EndColumn;
+
+    ScreenInfoRow currentScreenInfoRow = moveState.StartScreenInfoRow;
+    Column currentColumn = moveState.StartColumn;
+    *pAmountMoved = _advanceByWord(moveCount, moveState, WordEdge::Start, currentScreenInfoRow, currentColumn);
+
+    // we don't move the range if there was no word to move to
+    if (*pAmountMoved != 0)
+    {
+        const auto text = _getTextBuffer().GetRowByOffset(currentScreenInfoRow).GetCharRow().GetColumnText();
+        const auto word = ServiceLocator::LocateGlobals().WordDelimiters.FindWord(text, currentColumn);
+        start = _screenInfoRowToEndpoint(currentScreenInfoRow) + currentColumn;
+        end = start + gsl::narrow<Endpoint>(word.second - currentColumn) - 1;
     }
 
-    Endpoint start = _screenInfoRowToEndpoint(currentScreenInfoRow) + currentColumn;
-    Endpoint end = start;
     return std::make_pair<Endpoint, Endpoint>(std::move(start), std::move(end));
 }
 
@@ -1785,19 +2019,13 @@ std::pair<Endpoint, Endpoint> UiaTextRange::_moveByLine(const int moveCount,
 
     if (moveCount != 0 && !illegalMovement)
     {
-        // move the range
-        for (int i = 0; i < abs(moveCount); ++i)
-        {
-            if (currentScreenInfoRow == moveState.LimitingRow)
-            {
-                break;
-            }
-            currentScreenInfoRow += static_cast<int>(moveState.Increment);
-            *pAmountMoved += static_cast<int>(moveState.Increment);
+        // move the range, stopping at the limiting row
+        const int rowsMoved = std::min(abs(moveCount), _rowsToLimit(currentScreenInfoRow, moveState));
+        currentScreenInfoRow += rowsMoved * static_cast<int>(moveState.Increment);
+        *pAmountMoved = rowsMoved * static_cast<int>(moveState.Increment);
 
-            FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
-            FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
-        }
+        FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
+        FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
         start = _screenInfoRowToEndpoint(currentScreenInfoRow);
         end = start + _getLastColumnIndex();
     }
@@ -1862,8 +2090,6 @@ UiaTextRange::_moveEndpointByUnitCharacterForward(const int moveCount,
                                                   const MoveState moveState,
                                                   _Out_ int* const pAmountMoved)
 {
-    *pAmountMoved = 0;
-    int count = moveCount;
     ScreenInfoRow currentScreenInfoRow;
     Column currentColumn;
 
@@ -1879,36 +2105,7 @@ UiaTextRange::_moveEndpointByUnitCharacterForward(const int moveCount,
         currentColumn = moveState.EndColumn;
     }
 
-    for (int i = 0; i < abs(count); ++i)
-    {
-        // get the current row's right
-        const ROW& row = _getTextBuffer().GetRowByOffset(currentScreenInfoRow);
-        const size_t right = row.GetCharRow().MeasureRight();
-
-        // check if we're at the edge of the screen info buffer
-        if (currentScreenInfoRow == moveState.LimitingRow &&
-            currentColumn + 1 >= right)
-        {
-            break;
-        }
-        else if (currentColumn + 1 >= right)
-        {
-            // we're at the edge of a row and need to go to the next one
-            currentColumn = moveState.FirstColumnInRow;
-            currentScreenInfoRow += static_cast<int>(moveState.Increment);
-        }
-        else
-        {
-            // moving somewhere away from the edges of a row
-            currentColumn += static_cast<int>(moveState.Increment);
-        }
-        *pAmountMoved += static_cast<int>(moveState.Increment);
-
-        FAIL_FAST_IF(!(currentColumn >= _getFirstColumnIndex()));
-        FAIL_FAST_IF(!(currentColumn <= _getLastColumnIndex()));
-        FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
-        FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
-    }
+    *pAmountMoved = _advanceByCharacterForward(moveCount, moveState, currentScreenInfoRow, currentColumn);
 
     // translate the row back to an endpoint and handle any crossed endpoints
     Endpoint convertedEndpoint = _screenInfoRowToEndpoint(currentScreenInfoRow) + currentColumn;
@@ -1948,8 +2145,6 @@ UiaTextRange::_moveEndpointByUnitCharacterBackward(const int moveCount,
                                                    const MoveState moveState,
                                                    _Out_ int* const pAmountMoved)
 {
-    *pAmountMoved = 0;
-    int count = moveCount;
     ScreenInfoRow currentScreenInfoRow;
     Column currentColumn;
 
@@ -1965,37 +2160,76 @@ UiaTextRange::_moveEndpointByUnitCharacterBackward(const int moveCount,
         currentColumn = moveState.EndColumn;
     }
 
-    for (int i = 0; i < abs(count); ++i)
+    *pAmountMoved = _advanceByCharacterBackward(moveCount, moveState, currentScreenInfoRow, currentColumn);
+
+    // translate the row back to an endpoint and handle any crossed endpoints
+    Endpoint convertedEndpoint = _screenInfoRowToEndpoint(currentScreenInfoRow) + currentColumn;
+    Endpoint start = _screenInfoRowToEndpoint(moveState.StartScreenInfoRow) + moveState.StartColumn;
+    Endpoint end = _screenInfoRowToEndpoint(moveState.EndScreenInfoRow) + moveState.EndColumn;
+    bool degenerate = false;
+    if (endpoint == TextPatternRangeEndpoint::TextPatternRangeEndpoint_Start)
     {
-        // check if we're at the edge of the screen info buffer
-        if (currentScreenInfoRow == moveState.LimitingRow &&
-            currentColumn == moveState.LastColumnInRow)
-        {
-            break;
-        }
-        else if (currentColumn == moveState.LastColumnInRow)
+        start = convertedEndpoint;
+        if (_compareScreenCoords(currentScreenInfoRow,
+                                 currentColumn,
+                                 moveState.EndScreenInfoRow,
+                                 moveState.EndColumn) == 1)
         {
-            // we're at the edge of a row and need to go to the
-            // next one. move to the cell with the last non-whitespace charactor
-
-            currentScreenInfoRow += static_cast<int>(moveState.Increment);
-            // get the right cell for the next row
-            const ROW& row = _getTextBuffer().GetRowByOffset(currentScreenInfoRow);
-            const size_t right = row.GetCharRow().MeasureRight();
-            currentColumn = static_cast<Column>((right == 0) ? 0 : right - 1);
+            end = start;
+            degenerate = true;
         }
-        else
+    }
+    else
+    {
+        end = convertedEndpoint;
+        if (_compareScreenCoords(currentScreenInfoRow,
+                                 currentColumn,
+                                 moveState.StartScreenInfoRow,
+                                 moveState.StartColumn) == -1)
         {
-            // moving somewhere away from the edges of a row
-            currentColumn += static_cast<int>(moveState.Increment);
+            start = end;
+            degenerate = true;
         }
-        *pAmountMoved += static_cast<int>(moveState.Increment);
+    }
+    return std::make_tuple(start, end, degenerate);
+}
 
-        FAIL_FAST_IF(!(currentColumn >= _getFirstColumnIndex()));
-        FAIL_FAST_IF(!(currentColumn <= _getLastColumnIndex()));
-        FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
-        FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
+// Routine Description:
+// - calculates new Endpoints/degenerate state if the indicated
+// endpoint was moved moveCount times by word. The start of the range
+// moves between the starts of words, and the end between their ends.
+// Arguments:
+// - moveCount - the number of times to move
+// - endpoint - the endpoint to move
+// - moveState - values indicating the state of the console for the
+// move operation
+// - pAmountMoved - the number of times that the return values are "moved"
+// Return Value:
+// - A tuple of elements of the form <start, end, degenerate>
+std::tuple<Endpoint, Endpoint, bool> UiaTextRange::_moveEndpointByUnitWord(const int moveCount,
+                                                                           const TextPatternRangeEndpoint endpoint,
+                                                                           const MoveState moveState,
+                                                                           _Out_ int* const pAmountMoved)
+{
+    ScreenInfoRow currentScreenInfoRow;
+    Column currentColumn;
+    WordEdge edge;
+
+    // set current location vars
+    if (endpoint == TextPatternRangeEndpoint::TextPatternRangeEndpoint_Start)
+    {
+        currentScreenInfoRow = moveState.StartScreenInfoRow;
+        currentColumn = moveState.StartColumn;
+        edge = WordEdge::Start;
     }
+    else
+    {
+        currentScreenInfoRow = moveState.EndScreenInfoRow;
+        currentColumn = moveState.EndColumn;
+        edge = WordEdge::End;
+    }
+
+    *pAmountMoved = _advanceByWord(moveCount, moveState, edge, currentScreenInfoRow, currentColumn);
 
     // translate the row back to an endpoint and handle any crossed endpoints
     Endpoint convertedEndpoint = _screenInfoRowToEndpoint(currentScreenInfoRow) + currentColumn;
@@ -2152,16 +2386,13 @@ std::tuple<Endpoint, Endpoint, bool> UiaTextRange::_moveEndpointByUnitLine(const
     FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
     FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
 
-    // move the row that the endpoint corresponds to
-    while (count != 0 && currentScreenInfoRow != moveState.LimitingRow)
-    {
-        count -= static_cast<int>(moveState.Increment);
-        currentScreenInfoRow += static_cast<int>(moveState.Increment);
-        *pAmountMoved += static_cast<int>(moveState.Increment);
+    // move the row that the endpoint corresponds to, stopping at the limiting row
+    const int rowsMoved = std::min(abs(count), _rowsToLimit(currentScreenInfoRow, moveState));
+    currentScreenInfoRow += rowsMoved * static_cast<int>(moveState.Increment);
+    *pAmountMoved += rowsMoved * static_cast<int>(moveState.Increment);
 
-        FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
-        FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
-    }
+    FAIL_FAST_IF(!(currentScreenInfoRow >= _getFirstScreenInfoRowIndex()));
+    FAIL_FAST_IF(!(currentScreenInfoRow <= _getLastScreenInfoRowIndex()));
 
     // translate the row back to an endpoint and handle any crossed endpoints
     Endpoint convertedEndpoint = _screenInfoRowToEndpoint(currentScreenInfoRow) + currentColumn;
@@ -93,6 +93,13 @@ namespace Microsoft::Console::Interactivity::Win32
             Backward = -1
         };
 
+        // the edge of a word that moving by word stops at
+        enum class WordEdge
+        {
+            Start,
+            End
+        };
+
         // common information used by the variety of
         // movement operations
         struct MoveState
@@ -282,6 +289,8 @@ namespace Microsoft::Console::Interactivity::Win32
 
         const unsigned int _rowCountInRange() const;
 
+        BSTR _exportText(const size_t maxLength) const;
+
         static const TextBufferRow _endpointToTextBufferRow(const Endpoint endpoint);
         static const ScreenInfoRow _textBufferRowToScreenInfoRow(const TextBufferRow row);
 
@@ -317,6 +326,24 @@ namespace Microsoft::Console::Interactivity::Win32
                                               const ScreenInfoRow rowB,
                                               const Column colB);
 
+        static int _advanceByCharacterForward(const int moveCount,
+                                              const MoveState& moveState,
+                                              ScreenInfoRow& currentScreenInfoRow,
+                                              Column& currentColumn);
+
+        static int _advanceByCharacterBackward(const int moveCount,
+                                               const MoveState& moveState,
+                                               ScreenInfoRow& currentScreenInfoRow,
+                                               Column& currentColumn);
+
+        static int _advanceByWord(const int moveCount,
+                                  const MoveState& moveState,
+                                  const WordEdge edge,
+                                  ScreenInfoRow& currentScreenInfoRow,
+                                  Column& currentColumn);
+
+        static int _rowsToLimit(const ScreenInfoRow screenInfoRow, const MoveState& moveState);
+
         static std::pair<Endpoint, Endpoint> _moveByCharacter(const int moveCount,
                                                               const MoveState moveState,
                                                               _Out_ int* const pAmountMoved);
@@ -329,6 +356,10 @@ namespace Microsoft::Console::Interactivity::Win32
                                                                       const MoveState moveState,
                                                                       _Out_ int* const pAmountMoved);
 
+        static std::pair<Endpoint, Endpoint> _moveByWord(const int moveCount,
+                                                         const MoveState moveState,
+                                                         _Out_ int* const pAmountMoved);
+
         static std::pair<Endpoint, Endpoint> _moveByLine(const int moveCount,
                                                          const MoveState moveState,
                                                          _Out_ int* const pAmountMoved);
@@ -355,6 +386,12 @@ namespace Microsoft::Console::Interactivity::Win32
                                              const MoveState moveState,
                                              _Out_ int* const pAmountMoved);
 
+        static std::tuple<Endpoint, Endpoint, bool>
+        _moveEndpointByUnitWord(const int moveCount,
+                                const TextPatternRangeEndpoint endpoint,
+                                const MoveState moveState,
+                                _Out_ int* const pAmountMoved);
+
         static std::tuple<Endpoint, Endpoint, bool>
         _moveEndpointByUnitLine(const int moveCount,
                                 const TextPatternRangeEndpoint endpoint,
@@ -37,16 +37,19 @@ namespace Microsoft::Console::Interactivity::Win32
     private:
         std::deque<std::unique_ptr<IInputEvent>> TextToKeyEvents(_In_reads_(cchData) const wchar_t* const pData,
                                                                  const size_t cchData);
+        std::wstring FilterTextForPaste(_In_reads_(cchData) const wchar_t* const pData,
+                                        const size_t cchData);
 
-        void StoreSelectionToClipboard(_In_ bool const fAlsoCopyHtml);
+        void StoreSelectionToClipboard(_In_ bool const fAlsoCopyFormatting);
 
-        TextBuffer::TextAndColor RetrieveTextFromBuffer(const SCREEN_INFORMATION& screenInfo,
-                                                        const bool lineSelection,
-                                                        const std::vector<SMALL_RECT>& selectionRects);
+        std::wstring RetrieveTextFromBuffer(const SCREEN_INFORMATION& screenInfo,
+                                            const bool lineSelection,
+                                            const std::vector<SMALL_RECT>& selectionRects);
 
-        void CopyHTMLToClipboard(const TextBuffer::TextAndColor& rows);
-        std::string GenHTML(const TextBuffer::TextAndColor& rows);
-        void CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows, _In_ bool const fAlsoCopyHtml);
+        void CopyTextToSystemClipboard(const std::wstring& text, const std::string& html, const std::string& rtf);
+
+        static bool _ShouldTrimTrailingWhitespace();
+        static void _SetClipboardData(const UINT format, const std::string_view data);
 
         bool FilterCharacterOnPaste(_Inout_ WCHAR* const pwch);
 
@@ -154,6 +154,175 @@ class UiaTextRangeTests
         VERIFY_ARE_EQUAL(1u, notDegenerate1._rowCountInRange());
     }
 
+    TEST_METHOD(CanExpandToEnclosingWord)
+    {
+        // the first row reads "aaaaa aaaaa aaa..."
+        auto& charRow = _pTextBuffer->GetRowByOffset(0).GetCharRow();
+        charRow.GlyphAt(5) = L" ";
+        charRow.GlyphAt(11) = L" ";
+
+        UiaTextRange range{
+            &_dummyProvider,
+            8,
+            8,
+            false
+        };
+        VERIFY_SUCCEEDED(range.ExpandToEnclosingUnit(TextUnit::TextUnit_Word));
+        VERIFY_ARE_EQUAL(6u, range._start);
+        VERIFY_ARE_EQUAL(10u, range._end);
+
+        // a delimiter is a word of its own
+        UiaTextRange delimiter{
+            &_dummyProvider,
+            5,
+            5,
+            false
+        };
+        VERIFY_SUCCEEDED(delimiter.ExpandToEnclosingUnit(TextUnit::TextUnit_Word));
+        VERIFY_ARE_EQUAL(5u, delimiter._start);
+        VERIFY_ARE_EQUAL(5u, delimiter._end);
+
+        // the first word starts at the beginning of the row
+        UiaTextRange first{
+            &_dummyProvider,
+            2,
+            2,
+            false
+        };
+        VERIFY_SUCCEEDED(first.ExpandToEnclosingUnit(TextUnit::TextUnit_Word));
+        VERIFY_ARE_EQUAL(0u, first._start);
+        VERIFY_ARE_EQUAL(4u, first._end);
+    }
+
+    TEST_METHOD(CanMoveByWord)
+    {
+        // the first row reads "aaaaa aaaaa aaa...", every row after it is one word
+        auto& charRow = _pTextBuffer->GetRowByOffset(0).GetCharRow();
+        charRow.GlyphAt(5) = L" ";
+        charRow.GlyphAt(11) = L" ";
+        const Endpoint secondRow = UiaTextRange::_screenInfoRowToEndpoint(1);
+
+        UiaTextRange range{
+            &_dummyProvider,
+            2,
+            2,
+            false
+        };
+        int amountMoved = 0;
+
+        // the range becomes the word its start moves to
+        VERIFY_SUCCEEDED(range.Move(TextUnit::TextUnit_Word, 1, &amountMoved));
+        VERIFY_ARE_EQUAL(1, amountMoved);
+        VERIFY_ARE_EQUAL(6u, range._start);
+        VERIFY_ARE_EQUAL(10u, range._end);
+
+        // words carry on into the next row
+        VERIFY_SUCCEEDED(range.Move(TextUnit::TextUnit_Word, 2, &amountMoved));
+        VERIFY_ARE_EQUAL(2, amountMoved);
+        VERIFY_ARE_EQUAL(secondRow, range._start);
+        VERIFY_ARE_EQUAL(secondRow + UiaTextRange::_getLastColumnIndex(), range._end);
+
+        VERIFY_SUCCEEDED(range.Move(TextUnit::TextUnit_Word, -3, &amountMoved));
+        VERIFY_ARE_EQUAL(-3, amountMoved);
+        VERIFY_ARE_EQUAL(0u, range._start);
+        VERIFY_ARE_EQUAL(4u, range._end);
+
+        // there's no word before the first one
+        VERIFY_SUCCEEDED(range.Move(TextUnit::TextUnit_Word, -1, &amountMoved));
+        VERIFY_ARE_EQUAL(0, amountMoved);
+        VERIFY_ARE_EQUAL(0u, range._start);
+        VERIFY_ARE_EQUAL(4u, range._end);
+    }
+
+    TEST_METHOD(CanMoveEndpointByUnitWord)
+    {
+        // the first row reads "aaaaa aaaaa aaa..."
+        auto& charRow = _pTextBuffer->GetRowByOffset(0).GetCharRow();
+        charRow.GlyphAt(5) = L" ";
+        charRow.GlyphAt(11) = L" ";
+
+        UiaTextRange range{
+            &_dummyProvider,
+            0,
+            4,
+            false
+        };
+        int amountMoved = 0;
+
+        // the end moves between the ends of words
+        VERIFY_SUCCEEDED(range.MoveEndpointByUnit(TextPatternRangeEndpoint::TextPatternRangeEndpoint_End,
+                                                  TextUnit::TextUnit_Word,
+                                                  1,
+                                                  &amountMoved));
+        VERIFY_ARE_EQUAL(1, amountMoved);
+        VERIFY_ARE_EQUAL(0u, range._start);
+        VERIFY_ARE_EQUAL(10u, range._end);
+
+        // the start moves between the starts of words
+        VERIFY_SUCCEEDED(range.MoveEndpointByUnit(TextPatternRangeEndpoint::TextPatternRangeEndpoint_Start,
+                                                  TextUnit::TextUnit_Word,
+                                                  1,
+                                                  &amountMoved));
+        VERIFY_ARE_EQUAL(1, amountMoved);
+        VERIFY_ARE_EQUAL(6u, range._start);
+        VERIFY_ARE_EQUAL(10u, range._end);
+        VERIFY_IS_FALSE(range.IsDegenerate());
+
+        // moving the start past the end collapses the range
+        VERIFY_SUCCEEDED(range.MoveEndpointByUnit(TextPatternRangeEndpoint::TextPatternRangeEndpoint_Start,
+                                                  TextUnit::TextUnit_Word,
+                                                  1,
+                                                  &amountMoved));
+        VERIFY_ARE_EQUAL(1, amountMoved);
+        VERIFY_ARE_EQUAL(12u, range._start);
+        VERIFY_ARE_EQUAL(12u, range._end);
+        VERIFY_IS_TRUE(range.IsDegenerate());
+    }
+
+    TEST_METHOD(CanGetTextOfLargeRange)
+    {
+        const Column lastColumnIndex = _pScreenInfo->GetBufferSize().Width() - 1;
+        const ScreenInfoRow bottomRow = _pTextBuffer->TotalRowCount() - 1;
+
+        // the second row ends early, so it contributes less text
+        auto& charRow = _pTextBuffer->GetRowByOffset(1).GetCharRow();
+        for (size_t i = 10; i < charRow.size(); ++i)
+        {
+            charRow.GlyphAt(i) = L" ";
+        }
+
+        std::wstring expected;
+        for (ScreenInfoRow i = 0; i <= bottomRow; ++i)
+        {
+            expected += (i == 1) ? std::wstring(10, L'a') : std::wstring(lastColumnIndex + 1, L'a');
+            if (i != bottomRow)
+            {
+                expected += L"\r\n";
+            }
+        }
+
+        UiaTextRange range{
+            &_dummyProvider,
+            0,
+            UiaTextRange::_screenInfoRowToEndpoint(bottomRow) + lastColumnIndex,
+            false
+        };
+
+        BSTR text = nullptr;
+        VERIFY_SUCCEEDED(range.GetText(-1, &text));
+        VERIFY_ARE_EQUAL(expected.size(), static_cast<size_t>(SysStringLen(text)));
+        VERIFY_ARE_EQUAL(expected, std::wstring(text));
+        SysFreeString(text);
+
+        // truncating cuts the same text short, even in the middle of a line break
+        for (const size_t maxLength : { size_t{ 0 }, size_t{ 5 }, static_cast<size_t>(lastColumnIndex + 2), size_t{ 1000 } })
+        {
+            VERIFY_SUCCEEDED(range.GetText(static_cast<int>(maxLength), &text));
+            VERIFY_ARE_EQUAL(expected.substr(0, maxLength), std::wstring(text));
+            SysFreeString(text);
+        }
+    }
+
     TEST_METHOD(CanCheckIfScreenInfoRowIsInViewport)
     {
         // check a viewport that's one line tall
@@ -598,6 +767,73 @@ class UiaTextRangeTests
         }
     }
 
+    TEST_METHOD(CanMoveByLargeCounts)
+    {
+        const Column firstColumnIndex = 0;
+        const Column lastColumnIndex = _pScreenInfo->GetBufferSize().Width() - 1;
+        const ScreenInfoRow topRow = 0;
+        const ScreenInfoRow bottomRow = _pTextBuffer->TotalRowCount() - 1;
+        const int totalCells = static_cast<int>((bottomRow + 1) * (lastColumnIndex + 1));
+
+        const UiaTextRange::MoveState forward{
+            topRow, firstColumnIndex,
+            topRow, firstColumnIndex,
+            bottomRow,
+            firstColumnIndex,
+            lastColumnIndex,
+            UiaTextRange::MovementIncrement::Forward,
+            UiaTextRange::MovementDirection::Forward
+        };
+        const UiaTextRange::MoveState backward{
+            bottomRow, lastColumnIndex,
+            bottomRow, lastColumnIndex,
+            topRow,
+            lastColumnIndex,
+            firstColumnIndex,
+            UiaTextRange::MovementIncrement::Backward,
+            UiaTextRange::MovementDirection::Backward
+        };
+
+        int amountMoved;
+        Log::Comment(L"moving a row and a bit by character lands in the next row");
+        auto newEndpoints = UiaTextRange::_moveByCharacter(lastColumnIndex + 4, forward, &amountMoved);
+        VERIFY_ARE_EQUAL(static_cast<int>(lastColumnIndex + 4), amountMoved);
+        VERIFY_ARE_EQUAL(UiaTextRange::_screenInfoRowToEndpoint(topRow + 1) + 3, newEndpoints.first);
+
+        Log::Comment(L"moving past the end by character stops at the last cell");
+        newEndpoints = UiaTextRange::_moveByCharacter(INT_MAX, forward, &amountMoved);
+        VERIFY_ARE_EQUAL(totalCells - 1, amountMoved);
+        VERIFY_ARE_EQUAL(UiaTextRange::_screenInfoRowToEndpoint(bottomRow) + lastColumnIndex, newEndpoints.first);
+
+        Log::Comment(L"moving past the start by character stops at the first cell");
+        newEndpoints = UiaTextRange::_moveByCharacter(-INT_MAX, backward, &amountMoved);
+        VERIFY_ARE_EQUAL(-(totalCells - 1), amountMoved);
+        VERIFY_ARE_EQUAL(0u, newEndpoints.first);
+
+        Log::Comment(L"moving the end endpoint past the start makes the range degenerate");
+        const auto moved = UiaTextRange::_moveEndpointByUnitCharacter(-INT_MAX,
+                                                                      TextPatternRangeEndpoint::TextPatternRangeEndpoint_End,
+                                                                      backward,
+                                                                      &amountMoved);
+        VERIFY_ARE_EQUAL(-(totalCells - 1), amountMoved);
+        VERIFY_ARE_EQUAL(0u, std::get<0>(moved));
+        VERIFY_ARE_EQUAL(0u, std::get<1>(moved));
+        VERIFY_IS_TRUE(std::get<2>(moved));
+
+        Log::Comment(L"moving past the end by line stops at the last row");
+        newEndpoints = UiaTextRange::_moveByLine(INT_MAX, forward, &amountMoved);
+        VERIFY_ARE_EQUAL(static_cast<int>(bottomRow), amountMoved);
+        VERIFY_ARE_EQUAL(UiaTextRange::_screenInfoRowToEndpoint(bottomRow), newEndpoints.first);
+
+        Log::Comment(L"moving the start endpoint past the end by line stops at the last row");
+        const auto movedLine = UiaTextRange::_moveEndpointByUnitLine(INT_MAX,
+                                                                     TextPatternRangeEndpoint::TextPatternRangeEndpoint_Start,
+                                                                     forward,
+                                                                     &amountMoved);
+        VERIFY_ARE_EQUAL(static_cast<int>(bottomRow), amountMoved);
+        VERIFY_ARE_EQUAL(UiaTextRange::_screenInfoRowToEndpoint(bottomRow), std::get<0>(movedLine));
+    }
+
     TEST_METHOD(CanMoveEndpointByUnitCharacter)
     {
         const Column firstColumnIndex = 0;
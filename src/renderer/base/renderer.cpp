@@ -4,9 +4,11 @@
 #include "precomp.h"
 
 #include "renderer.hpp"
+#include "../../types/inc/ConsoleMetrics.hpp"
 
 #pragma hdrstop
 
+using namespace Microsoft::Console;
 using namespace Microsoft::Console::Render;
 using namespace Microsoft::Console::Types;
 
@@ -92,6 +94,15 @@ Renderer::~Renderer()
         return S_OK;
     }
 
+    // Declared before endPaint, so the time includes finishing the frame.
+    Metrics::ScopedTimer paintTimer{ Metrics::Histogram::RenderPaintMicroseconds };
+    Metrics::Add(Metrics::Counter::RenderFrames);
+    if constexpr (Metrics::Enabled)
+    {
+        const auto dirty = Viewport::FromInclusive(pEngine->GetDirtyRectInChars());
+        Metrics::Record(Metrics::Histogram::RenderDirtyCells, gsl::narrow_cast<uint64_t>(std::max<SHORT>(dirty.Width(), 0)) * std::max<SHORT>(dirty.Height(), 0));
+    }
+
     auto endPaint = wil::scope_exit([&]() {
         LOG_IF_FAILED(pEngine->EndPaint());
     });
@@ -590,7 +601,9 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
         size_t cols = 0;
 
         // Retrieve the first color.
+        // Runs are split by comparing interned attribute IDs rather than whole attributes.
         auto color = it->TextAttr();
+        auto colorId = it.GetAttributeId();
 
         // And hold the point where we should start drawing.
         auto screenPoint = target;
@@ -618,9 +631,10 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
             // When the color changes, it will save the new color off and break.
             do
             {
-                if (color != it->TextAttr())
+                if (colorId != it.GetAttributeId())
                 {
                     color = it->TextAttr();
+                    colorId = it.GetAttributeId();
                     break;
                 }
 
@@ -0,0 +1,208 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "VtPipeWriter.hpp"
+
+#pragma hdrstop
+
+using namespace Microsoft::Console::Render;
+
+// How long the destructor lets the writer drain before cancelling a write
+//      that the terminal isn't reading.
+static constexpr DWORD s_ShutdownTimeoutMs = 1000;
+
+// Routine Description:
+// - Creates the writer and starts its thread.
+// - NOTE: Will throw if the thread can't be created. Caller must catch.
+// Arguments:
+// - hPipe - the pipe to write frames to. Must outlive this object.
+// - pendingLimit - how many bytes may be waiting on the pipe before Submit blocks.
+VtPipeWriter::VtPipeWriter(const HANDLE hPipe, const size_t pendingLimit) :
+    _hPipe{ hPipe },
+    _pendingLimit{ pendingLimit },
+    _pending{},
+    _writing{},
+    _writerBusy{ false },
+    _shutdown{ false },
+    _result{ S_OK },
+    _metrics{},
+    _hThread{}
+{
+    _hThread.reset(CreateThread(nullptr,
+                                0,
+                                s_WriterThreadProc,
+                                this,
+                                0,
+                                nullptr));
+    THROW_LAST_ERROR_IF_NULL(_hThread.get());
+}
+
+// Routine Description:
+// - Writes out whatever is still pending, then stops the writer thread.
+// - If the terminal isn't reading and the pipe stays blocked, the outstanding
+//      write is cancelled so that we don't hang on teardown.
+VtPipeWriter::~VtPipeWriter()
+{
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _shutdown = true;
+    }
+    _frameReady.notify_all();
+
+    if (WaitForSingleObject(_hThread.get(), s_ShutdownTimeoutMs) != WAIT_OBJECT_0)
+    {
+        LOG_IF_WIN32_BOOL_FALSE(CancelSynchronousIo(_hThread.get()));
+        WaitForSingleObject(_hThread.get(), INFINITE);
+    }
+}
+
+// Routine Description:
+// - Hands a frame to the writer thread. The contents of frame are moved out,
+//      and frame is returned empty, but possibly with capacity left over from
+//      an earlier frame, so the caller can fill it again without reallocating.
+// - If the pipe is still busy with an earlier write, the frame is appended to
+//      whatever is already pending, and both are written together. If that
+//      makes the pending data exceed the limit, this blocks until the writer
+//      has taken it.
+// Arguments:
+// - frame - the VT sequences to write.
+// Return Value:
+// - S_OK, or the error that broke the pipe on an earlier write.
+[[nodiscard]] HRESULT VtPipeWriter::Submit(std::string& frame) noexcept
+{
+    try
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        RETURN_IF_FAILED(_result);
+
+        if (frame.empty())
+        {
+            return S_OK;
+        }
+
+        _metrics.framesSubmitted++;
+        if (_pending.empty())
+        {
+            _pending.swap(frame);
+        }
+        else
+        {
+            _pending.append(frame);
+            _metrics.framesCoalesced++;
+        }
+        frame.clear();
+        _metrics.peakPendingBytes = std::max(_metrics.peakPendingBytes, _pending.size());
+
+        _frameReady.notify_one();
+
+        if (_pending.size() > _pendingLimit)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            _writeCompleted.wait(lock, [&] { return _pending.size() <= _pendingLimit || FAILED(_result); });
+            _metrics.producerStalls++;
+            _metrics.producerStallTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        }
+
+        return _result;
+    }
+    CATCH_RETURN();
+}
+
+// Routine Description:
+// - Blocks until everything submitted so far has been written to the pipe.
+// Return Value:
+// - S_OK, or the error that broke the pipe.
+[[nodiscard]] HRESULT VtPipeWriter::WaitForIdle() noexcept
+{
+    try
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _writeCompleted.wait(lock, [&] { return (_pending.empty() && !_writerBusy) || FAILED(_result); });
+        return _result;
+    }
+    CATCH_RETURN();
+}
+
+// Routine Description:
+// - Gets the result of the writes so far. Once a write fails, the writer
+//      stops writing, and every later call returns that failure.
+[[nodiscard]] HRESULT VtPipeWriter::GetResult() const noexcept
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    return _result;
+}
+
+// Routine Description:
+// - Gets a snapshot of the backpressure counters. See Metrics.
+VtPipeWriter::Metrics VtPipeWriter::GetMetrics() const noexcept
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    return _metrics;
+}
+
+// Routine Description:
+// - Static function used for initializing an instance's ThreadProc.
+// Arguments:
+// - lpParameter - A pointer to the VtPipeWriter instance that should be called.
+// Return Value:
+// - The return value of the underlying instance's _WriterThread
+DWORD WINAPI VtPipeWriter::s_WriterThreadProc(_In_ LPVOID lpParameter)
+{
+    VtPipeWriter* const pInstance = reinterpret_cast<VtPipeWriter*>(lpParameter);
+    return pInstance->_WriterThread();
+}
+
+// Routine Description:
+// - The ThreadProc for the writer. Takes whatever is pending, writes it to the
+//      pipe outside of the lock, and repeats until shutdown.
+// Return Value:
+// - S_OK, or the error from the write that broke the pipe.
+DWORD VtPipeWriter::_WriterThread() noexcept
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    for (;;)
+    {
+        _frameReady.wait(lock, [&] { return !_pending.empty() || _shutdown; });
+        if (_pending.empty() || FAILED(_result))
+        {
+            break;
+        }
+
+        // Take the whole pending buffer and leave our old one (already
+        //      cleared, but with its capacity) in its place.
+        _writing.swap(_pending);
+        _writerBusy = true;
+        lock.unlock();
+
+        HRESULT hr = S_OK;
+        size_t written = 0;
+        while (written < _writing.size())
+        {
+            DWORD dwWritten = 0;
+            const auto cb = static_cast<DWORD>(std::min<size_t>(_writing.size() - written, MAXDWORD));
+            if (!WriteFile(_hPipe, _writing.data() + written, cb, &dwWritten, nullptr))
+            {
+                hr = HRESULT_FROM_WIN32(GetLastError());
+                break;
+            }
+            written += dwWritten;
+
+            std::unique_lock<std::mutex> metricsLock(_lock);
+            _metrics.pipeWrites++;
+            _metrics.bytesWritten += dwWritten;
+        }
+        _writing.clear();
+
+        lock.lock();
+        _writerBusy = false;
+        if (FAILED(hr))
+        {
+            _result = hr;
+            _pending.clear();
+        }
+        _writeCompleted.notify_all();
+    }
+
+    return _result;
+}
@@ -0,0 +1,86 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- VtPipeWriter.hpp
+
+Abstract:
+- Writes the output of the VT renderer to the terminal pipe on a dedicated
+  thread, so that a terminal that is slow to read doesn't block painting
+  (and with it the console lock).
+- Frames are handed over by swapping buffers. While the pipe is busy, newly
+  submitted frames are coalesced into a single pending buffer that is written
+  in one go once the pipe frees up. The pending buffer is bounded: once it
+  grows past the limit, submitting blocks until the writer catches up.
+--*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+
+namespace Microsoft::Console::Render
+{
+    class VtPipeWriter final
+    {
+    public:
+        struct Metrics
+        {
+            // Number of non-empty frames handed to Submit.
+            size_t framesSubmitted;
+            // Number of frames that were appended to an already pending frame
+            //      because the pipe was still busy with an earlier write.
+            size_t framesCoalesced;
+            // Number of WriteFile calls made, and the bytes they wrote.
+            size_t pipeWrites;
+            size_t bytesWritten;
+            // Largest the pending buffer has been, in bytes.
+            size_t peakPendingBytes;
+            // Number of times Submit had to wait for the writer because the
+            //      pending buffer was over the limit, and the total time spent waiting.
+            size_t producerStalls;
+            std::chrono::microseconds producerStallTime;
+        };
+
+        // Once this many bytes are waiting on the pipe, Submit blocks.
+        static constexpr size_t DefaultPendingLimit = 1024 * 1024;
+
+        VtPipeWriter(const HANDLE hPipe, const size_t pendingLimit = DefaultPendingLimit);
+        ~VtPipeWriter();
+
+        VtPipeWriter(const VtPipeWriter&) = delete;
+        VtPipeWriter& operator=(const VtPipeWriter&) = delete;
+
+        [[nodiscard]] HRESULT Submit(std::string& frame) noexcept;
+        [[nodiscard]] HRESULT WaitForIdle() noexcept;
+
+        [[nodiscard]] HRESULT GetResult() const noexcept;
+        Metrics GetMetrics() const noexcept;
+
+    private:
+        static DWORD WINAPI s_WriterThreadProc(_In_ LPVOID lpParameter);
+        DWORD _WriterThread() noexcept;
+
+        const HANDLE _hPipe; // non ownership handle
+        const size_t _pendingLimit;
+
+        mutable std::mutex _lock;
+        // Signaled when a frame is pending or we're shutting down.
+        std::condition_variable _frameReady;
+        // Signaled every time the writer finishes a write.
+        std::condition_variable _writeCompleted;
+
+        // Frames waiting to be written. Only touched under _lock.
+        std::string _pending;
+        // The frame currently being written. Only touched by the writer thread.
+        std::string _writing;
+        bool _writerBusy;
+        bool _shutdown;
+        HRESULT _result;
+
+        Metrics _metrics;
+
+        wil::unique_handle _hThread;
+    };
+}
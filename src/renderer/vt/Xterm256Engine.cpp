@@ -18,8 +18,9 @@ Xterm256Engine::Xterm256Engine(_In_ wil::unique_hfile hPipe,
 }
 
 // Routine Description:
-// - Write a VT sequence to change the current colors of text. Writes true RGB
-//      color sequences.
+// - Write a VT sequence to change the current colors of text. Each color is
+//      written as a 16 color, 256 color or true RGB color, whichever is
+//      shortest while still being exact.
 // Arguments:
 // - colorForeground: The RGB Color to use to paint the foreground text.
 // - colorBackground: The RGB Color to use to paint the background of the text.
@@ -35,17 +36,16 @@ Xterm256Engine::Xterm256Engine(_In_ wil::unique_hfile hPipe,
                                                            const bool isBold,
                                                            const bool /*isSettingDefaultBrushes*/) noexcept
 {
-    //When we update the brushes, check the wAttrs to see if the LVB_UNDERSCORE
-    //      flag is there. If the state of that flag is different then our
-    //      current state, change the underlining state.
-    // We have to do this here, instead of in PaintBufferGridLines, because
-    //      we'll have already painted the text by the time PaintBufferGridLines
-    //      is called.
-    RETURN_IF_FAILED(_UpdateUnderline(legacyColorAttribute));
+    // We check the wAttrs for the LVB_UNDERSCORE flag here, instead of in
+    //      PaintBufferGridLines, because we'll have already painted the text
+    //      by the time PaintBufferGridLines is called.
+    const bool isUnderlined = WI_IsFlagSet(legacyColorAttribute, COMMON_LVB_UNDERSCORE);
 
-    return VtEngine::_RgbUpdateDrawingBrushes(colorForeground,
+    return VtEngine::_UpdateGraphicsRendition(colorForeground,
                                               colorBackground,
                                               isBold,
+                                              isUnderlined,
+                                              true,
                                               _ColorTable,
                                               _cColorTable);
 }
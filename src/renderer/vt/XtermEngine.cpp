@@ -20,7 +20,6 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
     _cColorTable(cColorTable),
     _fUseAsciiOnly(fUseAsciiOnly),
     _previousLineWrapped(false),
-    _usingUnderLine(false),
     _needToDisableCursor(false)
 {
     // Set out initial cursor position to -1, -1. This will force our initial
@@ -122,31 +121,6 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
     return S_OK;
 }
 
-// Routine Description:
-// - Write a VT sequence to either start or stop underlining text.
-// Arguments:
-// - legacyColorAttribute: A console attributes bit field containing information
-//      about the underlining state of the text.
-// Return Value:
-// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
-[[nodiscard]] HRESULT XtermEngine::_UpdateUnderline(const WORD legacyColorAttribute) noexcept
-{
-    bool textUnderlined = WI_IsFlagSet(legacyColorAttribute, COMMON_LVB_UNDERSCORE);
-    if (textUnderlined != _usingUnderLine)
-    {
-        if (textUnderlined)
-        {
-            RETURN_IF_FAILED(_BeginUnderline());
-        }
-        else
-        {
-            RETURN_IF_FAILED(_EndUnderline());
-        }
-        _usingUnderLine = textUnderlined;
-    }
-    return S_OK;
-}
-
 // Routine Description:
 // - Write a VT sequence to change the current colors of text. Only writes
 //      16-color attributes.
@@ -165,16 +139,19 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
                                                         const bool isBold,
                                                         const bool /*isSettingDefaultBrushes*/) noexcept
 {
-    //When we update the brushes, check the wAttrs to see if the LVB_UNDERSCORE
-    //      flag is there. If the state of that flag is different then our
-    //      current state, change the underlining state.
-    // We have to do this here, instead of in PaintBufferGridLines, because
-    //      we'll have already painted the text by the time PaintBufferGridLines
-    //      is called.
-
-    RETURN_IF_FAILED(_UpdateUnderline(legacyColorAttribute));
+    // We check the wAttrs for the LVB_UNDERSCORE flag here, instead of in
+    //      PaintBufferGridLines, because we'll have already painted the text
+    //      by the time PaintBufferGridLines is called.
+    const bool isUnderlined = WI_IsFlagSet(legacyColorAttribute, COMMON_LVB_UNDERSCORE);
+
     // The base xterm mode only knows about 16 colors
-    return VtEngine::_16ColorUpdateDrawingBrushes(colorForeground, colorBackground, isBold, _ColorTable, _cColorTable);
+    return VtEngine::_UpdateGraphicsRendition(colorForeground,
+                                              colorBackground,
+                                              isBold,
+                                              isUnderlined,
+                                              false,
+                                              _ColorTable,
+                                              _cColorTable);
 }
 
 // Routine Description:
@@ -212,27 +189,23 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
             }
             else
             {
-                std::string seq = "\r\n";
-                hr = _Write(seq);
+                hr = _Write("\r\n");
             }
         }
         else if (coord.X == 0 && coord.Y == _lastText.Y)
         {
             // Start of this line
-            std::string seq = "\r";
-            hr = _Write(seq);
+            hr = _Write("\r");
         }
         else if (coord.X == _lastText.X && coord.Y == (_lastText.Y + 1))
         {
             // Down one line, same X position
-            std::string seq = "\n";
-            hr = _Write(seq);
+            hr = _Write("\n");
         }
         else if (coord.X == (_lastText.X - 1) && coord.Y == (_lastText.Y))
         {
             // Back one char, same Y position
-            std::string seq = "\b";
-            hr = _Write(seq);
+            hr = _Write("\b");
         }
         else if (coord.Y == _lastText.Y && coord.X > _lastText.X)
         {
@@ -58,13 +58,10 @@ namespace Microsoft::Console::Render
         const WORD _cColorTable;
         const bool _fUseAsciiOnly;
         bool _previousLineWrapped;
-        bool _usingUnderLine;
         bool _needToDisableCursor;
 
         [[nodiscard]] HRESULT _MoveCursor(const COORD coord) noexcept override;
 
-        [[nodiscard]] HRESULT _UpdateUnderline(const WORD wLegacyAttrs) noexcept;
-
         [[nodiscard]] HRESULT _DoUpdateTitle(const std::wstring& newTitle) noexcept override;
 
 #ifdef UNIT_TESTING
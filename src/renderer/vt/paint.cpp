@@ -7,6 +7,8 @@
 #include "../../inc/conattrs.hpp"
 #include "../../types/inc/convert.hpp"
 
+#include <array>
+
 #pragma hdrstop
 using namespace Microsoft::Console::Render;
 using namespace Microsoft::Console::Types;
@@ -170,85 +172,236 @@ using namespace Microsoft::Console::Types;
     return S_OK;
 }
 
+namespace
+{
+    // A list of SGR parameters, separated by semicolons, built on the stack.
+    // 64 chars is enough for every parameter we could want in one sequence:
+    //      0;1;4;38;2;255;255;255;48;2;255;255;255
+    class SgrParameters final
+    {
+    public:
+        void Add(const int value) noexcept
+        {
+            if (_length > 0)
+            {
+                _buffer[_length++] = ';';
+            }
+            const auto result = std::to_chars(_buffer.data() + _length, _buffer.data() + _buffer.size(), value);
+            _length = gsl::narrow_cast<size_t>(result.ptr - _buffer.data());
+        }
+
+        size_t Length() const noexcept
+        {
+            return _length;
+        }
+
+        std::string_view View() const noexcept
+        {
+            return { _buffer.data(), _length };
+        }
+
+    private:
+        std::array<char, 64> _buffer{};
+        size_t _length = 0;
+    };
+
+    // Routine Description:
+    // - Finds the given color in the standard xterm 256 color palette, beyond
+    //      the first 16 entries (which are the color table). That's the 6x6x6
+    //      color cube and the 24 step grayscale ramp.
+    // Arguments:
+    // - color: the color to look for
+    // Return Value:
+    // - The palette index, or nullopt if the color isn't exactly in the palette.
+    std::optional<int> FindXterm256Index(const COLORREF color) noexcept
+    {
+        // The cube levels are 0, 95, 135, 175, 215, 255.
+        const auto cubeLevel = [](const int channel) noexcept {
+            if (channel == 0)
+            {
+                return 0;
+            }
+            return (channel >= 95 && (channel - 95) % 40 == 0) ? (channel - 95) / 40 + 1 : -1;
+        };
+
+        const int r = GetRValue(color);
+        const int g = GetGValue(color);
+        const int b = GetBValue(color);
+
+        const int levelR = cubeLevel(r);
+        const int levelG = cubeLevel(g);
+        const int levelB = cubeLevel(b);
+        if (levelR >= 0 && levelG >= 0 && levelB >= 0)
+        {
+            return 16 + (36 * levelR) + (6 * levelG) + levelB;
+        }
+
+        // The grayscale ramp is 8, 18, ..., 238.
+        if (r == g && g == b && r >= 8 && r <= 238 && (r - 8) % 10 == 0)
+        {
+            return 232 + (r - 8) / 10;
+        }
+
+        return std::nullopt;
+    }
+
+    // Routine Description:
+    // - Adds the SGR parameters that select the given color, picking the
+    //      shortest form that represents it exactly: the default color, one of
+    //      the 16 table colors, a 256 color palette index, or full RGB.
+    // Arguments:
+    // - params: the list to add to
+    // - color: the color to select
+    // - isForeground: true for the foreground color, false for the background
+    // - isDefault: true if color is the default color for this layer
+    // - allowExtendedColors: if false, we can only use the 16 table colors, and
+    //      use whichever is nearest to color. The default color is still
+    //      selected as the default, so that it looks the same no matter which
+    //      form of the sequence ends up being written.
+    // - ColorTable/cColorTable: the 16 color table
+    void AddColorParameters(SgrParameters& params,
+                            const COLORREF color,
+                            const bool isForeground,
+                            const bool isDefault,
+                            const bool allowExtendedColors,
+                            _In_reads_(cColorTable) const COLORREF* const ColorTable,
+                            const WORD cColorTable) noexcept
+    {
+        const int base = isForeground ? 30 : 40;
+
+        if (isDefault)
+        {
+            params.Add(base + 9);
+            return;
+        }
+
+        WORD index = 0;
+        if (!allowExtendedColors)
+        {
+            index = ::FindNearestTableIndex(color, ColorTable, cColorTable);
+        }
+        else if (!::FindTableIndex(color, ColorTable, cColorTable, &index))
+        {
+            params.Add(base + 8);
+            if (const auto paletteIndex = FindXterm256Index(color))
+            {
+                params.Add(5);
+                params.Add(paletteIndex.value());
+            }
+            else
+            {
+                params.Add(2);
+                params.Add(GetRValue(color));
+                params.Add(GetGValue(color));
+                params.Add(GetBValue(color));
+            }
+            return;
+        }
+
+        // See _SetGraphicsRendition16Color for how table indices map to SGR values.
+        params.Add(base +
+                   (WI_IsFlagSet(index, FOREGROUND_INTENSITY) ? 60 : 0) +
+                   (WI_IsFlagSet(index, FOREGROUND_RED) ? 1 : 0) +
+                   (WI_IsFlagSet(index, FOREGROUND_GREEN) ? 2 : 0) +
+                   (WI_IsFlagSet(index, FOREGROUND_BLUE) ? 4 : 0));
+    }
+}
+
 // Routine Description:
-// - Write a VT sequence to change the current colors of text. Writes true RGB
-//      color sequences.
+// - Write a single VT sequence to change the current text attributes, from
+//      the ones we last sent to the terminal to the given ones.
+// - We build two candidate parameter lists: one with only the attributes that
+//      changed, and one that starts with an SGR reset and then sets every
+//      attribute that isn't the default. Whichever is shorter gets written.
 // Arguments:
 // - colorForeground: The RGB Color to use to paint the foreground text.
 // - colorBackground: The RGB Color to use to paint the background of the text.
+// - isBold: true if the text should be bold.
+// - isUnderlined: true if the text should be underlined.
+// - allowExtendedColors: true to allow 256 color and RGB sequences, false to
+//      only use the nearest of the 16 table colors.
+// - ColorTable/cColorTable: the 16 color table
 // Return Value:
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
-[[nodiscard]] HRESULT VtEngine::_RgbUpdateDrawingBrushes(const COLORREF colorForeground,
+[[nodiscard]] HRESULT VtEngine::_UpdateGraphicsRendition(const COLORREF colorForeground,
                                                          const COLORREF colorBackground,
                                                          const bool isBold,
+                                                         const bool isUnderlined,
+                                                         const bool allowExtendedColors,
                                                          _In_reads_(cColorTable) const COLORREF* const ColorTable,
                                                          const WORD cColorTable) noexcept
 {
     const bool fgChanged = colorForeground != _LastFG;
     const bool bgChanged = colorBackground != _LastBG;
+    const bool boldChanged = isBold != _lastWasBold;
+    const bool underlineChanged = isUnderlined != _lastWasUnderlined;
+    if (!fgChanged && !bgChanged && !boldChanged && !underlineChanged)
+    {
+        return S_OK;
+    }
+
     const bool fgIsDefault = colorForeground == _colorProvider.GetDefaultForeground();
     const bool bgIsDefault = colorBackground == _colorProvider.GetDefaultBackground();
 
-    // If both the FG and BG should be the defaults, emit a SGR reset.
-    if ((fgChanged || bgChanged) && fgIsDefault && bgIsDefault)
+    SgrParameters delta;
+    if (boldChanged)
     {
-        // SGR Reset will also clear out the boldness of the text.
-        RETURN_IF_FAILED(_SetGraphicsDefault());
-        _LastFG = colorForeground;
-        _LastBG = colorBackground;
-        _lastWasBold = false;
+        delta.Add(isBold ? 1 : 22);
+    }
+    if (underlineChanged)
+    {
+        delta.Add(isUnderlined ? 4 : 24);
+    }
+    if (fgChanged)
+    {
+        AddColorParameters(delta, colorForeground, true, fgIsDefault, allowExtendedColors, ColorTable, cColorTable);
+    }
+    if (bgChanged)
+    {
+        AddColorParameters(delta, colorBackground, false, bgIsDefault, allowExtendedColors, ColorTable, cColorTable);
+    }
 
-        // I'm not sure this is possible currently, but if the text is bold, but
-        //      default colors, make sure we bold it.
-        if (isBold)
-        {
-            RETURN_IF_FAILED(_SetGraphicsBoldness(isBold));
-            _lastWasBold = isBold;
-        }
+    // The parameters to follow an SGR reset. The reset itself is written as
+    //      "\x1b[m" on its own, or as a leading "0;" otherwise.
+    SgrParameters reset;
+    if (isBold)
+    {
+        reset.Add(1);
     }
-    else
+    if (isUnderlined)
     {
-        if (_lastWasBold != isBold)
-        {
-            RETURN_IF_FAILED(_SetGraphicsBoldness(isBold));
-            _lastWasBold = isBold;
-        }
+        reset.Add(4);
+    }
+    if (!fgIsDefault)
+    {
+        AddColorParameters(reset, colorForeground, true, fgIsDefault, allowExtendedColors, ColorTable, cColorTable);
+    }
+    if (!bgIsDefault)
+    {
+        AddColorParameters(reset, colorBackground, false, bgIsDefault, allowExtendedColors, ColorTable, cColorTable);
+    }
+    const size_t resetLength = reset.Length() == 0 ? 0 : reset.Length() + 2;
 
-        WORD wFoundColor = 0;
-        if (fgChanged)
+    if (resetLength < delta.Length())
+    {
+        if (reset.Length() == 0)
         {
-            if (fgIsDefault)
-            {
-                RETURN_IF_FAILED(_SetGraphicsRenditionDefaultColor(true));
-            }
-            else if (::FindTableIndex(colorForeground, ColorTable, cColorTable, &wFoundColor))
-            {
-                RETURN_IF_FAILED(_SetGraphicsRendition16Color(wFoundColor, true));
-            }
-            else
-            {
-                RETURN_IF_FAILED(_SetGraphicsRenditionRGBColor(colorForeground, true));
-            }
-            _LastFG = colorForeground;
+            RETURN_IF_FAILED(_SetGraphicsDefault());
         }
-
-        if (bgChanged)
+        else
         {
-            if (bgIsDefault)
-            {
-                RETURN_IF_FAILED(_SetGraphicsRenditionDefaultColor(false));
-            }
-            else if (::FindTableIndex(colorBackground, ColorTable, cColorTable, &wFoundColor))
-            {
-                RETURN_IF_FAILED(_SetGraphicsRendition16Color(wFoundColor, false));
-            }
-            else
-            {
-                RETURN_IF_FAILED(_SetGraphicsRenditionRGBColor(colorBackground, false));
-            }
-            _LastBG = colorBackground;
+            RETURN_IF_FAILED(_WriteSequence("\x1b[0;", reset.View(), "m"));
         }
     }
+    else
+    {
+        RETURN_IF_FAILED(_WriteSequence("\x1b[", delta.View(), "m"));
+    }
+
+    _LastFG = colorForeground;
+    _LastBG = colorBackground;
+    _lastWasBold = isBold;
+    _lastWasUnderlined = isUnderlined;
 
     return S_OK;
 }
@@ -446,8 +599,7 @@ using namespace Microsoft::Console::Types;
                                      totalWidth;
 
     // Write the actual text string
-    std::wstring wstr = std::wstring(unclusteredString.data(), cchActual);
-    RETURN_IF_FAILED(VtEngine::_WriteTerminalUtf8(wstr));
+    RETURN_IF_FAILED(VtEngine::_WriteTerminalUtf8({ unclusteredString.data(), cchActual }));
 
     // Update our internal tracker of the cursor's position.
     // See MSFT:20266233
@@ -5,10 +5,7 @@
 #include "vtrenderer.hpp"
 #include "../../inc/conattrs.hpp"
 #include "../../types/inc/convert.hpp"
-
-// For _vcprintf
-#include <conio.h>
-#include <stdarg.h>
+#include "../../types/inc/ConsoleMetrics.hpp"
 
 #pragma hdrstop
 
@@ -30,10 +27,12 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
                    const Viewport initialViewport) :
     RenderEngineBase(),
     _hFile(std::move(pipe)),
+    _pipeWriter{ nullptr },
     _colorProvider(colorProvider),
     _LastFG(INVALID_COLOR),
     _LastBG(INVALID_COLOR),
     _lastWasBold(false),
+    _lastWasUnderlined(false),
     _lastViewport(initialViewport),
     _invalidRect(Viewport::Empty()),
     _fInvalidRectUsed(false),
@@ -63,6 +62,11 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     // member is only defined when UNIT_TESTING is.
     _usingTestCallback = false;
 #endif
+
+    if (_hFile.get() != INVALID_HANDLE_VALUE)
+    {
+        _pipeWriter = std::make_unique<VtPipeWriter>(_hFile.get());
+    }
 }
 
 // Method Description:
@@ -75,24 +79,51 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
 // - S_OK or suitable HRESULT error from writing pipe.
 [[nodiscard]] HRESULT VtEngine::_Write(std::string_view const str) noexcept
 {
+    const size_t start = _buffer.size();
+    try
+    {
+        _buffer.append(str);
+    }
+    CATCH_RETURN();
+
+    return _CompleteWrite(start);
+}
+
+// Method Description:
+// - Finishes a write that was placed directly into our buffer. Everything in
+//      the buffer from start onwards is the newly written sequence. If we're
+//      building the unit tests, the sequence is handed to the test callback
+//      instead, and removed from the buffer again.
+// Arguments:
+// - start: the length of the buffer before the sequence was written.
+// Return Value:
+// - S_OK, or a failure from the test callback.
+[[nodiscard]] HRESULT VtEngine::_CompleteWrite(const size_t start) noexcept
+{
+    const std::string_view str{ _buffer.data() + start, _buffer.size() - start };
     _trace.TraceString(str);
+    Metrics::Add(Metrics::Counter::VtBytesEmitted, str.size());
 #ifdef UNIT_TESTING
     if (_usingTestCallback)
     {
-        RETURN_LAST_ERROR_IF(!_pfnTestCallback(str.data(), str.size()));
-        return S_OK;
+        const bool succeeded = _pfnTestCallback(str.data(), str.size());
+        _buffer.resize(start);
+        RETURN_LAST_ERROR_IF(!succeeded);
     }
 #endif
 
-    try
-    {
-        _buffer.append(str);
-
-        return S_OK;
-    }
-    CATCH_RETURN();
+    return S_OK;
 }
 
+// Method Description:
+// - Hands everything written this frame to the pipe writer. The writer puts
+//      it on the pipe on its own thread, so a terminal that is slow to read
+//      doesn't hold up painting. If an earlier write broke the pipe, we find
+//      out about it here.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
 [[nodiscard]] HRESULT VtEngine::_Flush() noexcept
 {
 #ifdef UNIT_TESTING
@@ -103,13 +134,20 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     }
 #endif
 
+    if (!_pipeWriter)
+    {
+        // There's no pipe to write to, so there's nobody to give this to.
+        _buffer.clear();
+        return S_OK;
+    }
+
     if (!_pipeBroken)
     {
-        bool fSuccess = !!WriteFile(_hFile.get(), _buffer.data(), static_cast<DWORD>(_buffer.size()), nullptr, nullptr);
+        const HRESULT hr = _pipeWriter->Submit(_buffer);
         _buffer.clear();
-        if (!fSuccess)
+        if (FAILED(hr))
         {
-            _exitResult = HRESULT_FROM_WIN32(GetLastError());
+            _exitResult = hr;
             _pipeBroken = true;
             if (_terminalOwner)
             {
@@ -129,21 +167,78 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     return _Write(str);
 }
 
+// Routine Description:
+// - Encodes UTF-16 text as UTF-8. Unpaired surrogates are encoded as U+FFFD,
+//      the same as WideCharToMultiByte does.
+// Arguments:
+// - wstr - the text to encode
+// - out - where to write the encoded text. Must have room for 3 bytes per
+//      UTF-16 code unit, which is the most any code unit can take.
+// Return Value:
+// - The number of bytes written to out.
+static size_t _EncodeUtf8(const std::wstring_view wstr, _Out_writes_(wstr.size() * 3) char* const out) noexcept
+{
+    char* dst = out;
+    for (size_t i = 0; i < wstr.size(); ++i)
+    {
+        unsigned int codepoint = wstr[i];
+        if (codepoint < 0x80)
+        {
+            *dst++ = static_cast<char>(codepoint);
+            continue;
+        }
+
+        if (codepoint < 0x800)
+        {
+            *dst++ = static_cast<char>(0xC0 | (codepoint >> 6));
+            *dst++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+            continue;
+        }
+
+        if (codepoint >= 0xD800 && codepoint <= 0xDFFF)
+        {
+            const bool isLeading = codepoint <= 0xDBFF;
+            if (isLeading && i + 1 < wstr.size() && wstr[i + 1] >= 0xDC00 && wstr[i + 1] <= 0xDFFF)
+            {
+                codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (wstr[i + 1] - 0xDC00);
+                ++i;
+                *dst++ = static_cast<char>(0xF0 | (codepoint >> 18));
+                *dst++ = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+                *dst++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                *dst++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+                continue;
+            }
+            codepoint = 0xFFFD;
+        }
+
+        *dst++ = static_cast<char>(0xE0 | (codepoint >> 12));
+        *dst++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        *dst++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+    return gsl::narrow_cast<size_t>(dst - out);
+}
+
 // Method Description:
 // - Writes a wstring to the tty, encoded as full utf-8. This is one
 //      implementation of the WriteTerminalW method.
+// - The text is encoded straight into our output buffer.
 // Arguments:
 // - wstr - wstring of text to be written
 // Return Value:
 // - S_OK or suitable HRESULT error from either conversion or writing pipe.
-[[nodiscard]] HRESULT VtEngine::_WriteTerminalUtf8(const std::wstring& wstr) noexcept
+[[nodiscard]] HRESULT VtEngine::_WriteTerminalUtf8(const std::wstring_view wstr) noexcept
 {
+    const size_t start = _buffer.size();
     try
     {
-        const auto converted = ConvertToA(CP_UTF8, wstr);
-        return _Write(converted);
+        _buffer.resize(start + wstr.size() * 3);
     }
     CATCH_RETURN();
+
+    const size_t cb = _EncodeUtf8(wstr, _buffer.data() + start);
+    _buffer.resize(start + cb);
+
+    return _CompleteWrite(start);
 }
 
 // Method Description:
@@ -155,55 +250,22 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
 // - wstr - wstring of text to be written
 // Return Value:
 // - S_OK or suitable HRESULT error from writing pipe.
-[[nodiscard]] HRESULT VtEngine::_WriteTerminalAscii(const std::wstring& wstr) noexcept
+[[nodiscard]] HRESULT VtEngine::_WriteTerminalAscii(const std::wstring_view wstr) noexcept
 {
-    const size_t cchActual = wstr.length();
-
-    std::string needed;
-    needed.reserve(wstr.size());
-
-    for (const auto& wch : wstr)
+    const size_t start = _buffer.size();
+    try
     {
-        // We're explicitly replacing characters outside ASCII with a ? because
-        //      that's what telnet wants.
-        needed.push_back((wch > L'\x7f') ? '?' : static_cast<char>(wch));
+        _buffer.resize(start + wstr.size());
     }
+    CATCH_RETURN();
 
-    return _Write(needed);
-}
-
-// Method Description:
-// - Helper for calling _Write with a string for formatting a sequence. Used
-//      extensively by VtSequences.cpp
-// Arguments:
-// - pFormat: the pointer to the string to write to the pipe.
-// - ...: a va_list of args to format the string with.
-// Return Value:
-// - S_OK, E_INVALIDARG for a invalid format string, or suitable HRESULT error
-//      from writing pipe.
-[[nodiscard]] HRESULT VtEngine::_WriteFormattedString(const std::string* const pFormat, ...) noexcept
-{
-    HRESULT hr = E_FAIL;
-    va_list argList;
-    va_start(argList, pFormat);
-
-    int cchNeeded = _scprintf(pFormat->c_str(), argList);
-    // -1 is the _scprintf error case https://msdn.microsoft.com/en-us/library/t32cf9tb.aspx
-    if (cchNeeded > -1)
-    {
-        wistd::unique_ptr<char[]> psz = wil::make_unique_nothrow<char[]>(cchNeeded + 1);
-        RETURN_IF_NULL_ALLOC(psz);
-
-        int cchWritten = _vsnprintf_s(psz.get(), cchNeeded + 1, cchNeeded, pFormat->c_str(), argList);
-        hr = _Write({ psz.get(), gsl::narrow<size_t>(cchWritten) });
-    }
-    else
-    {
-        hr = E_INVALIDARG;
-    }
+    // We're explicitly replacing characters outside ASCII with a ? because
+    //      that's what telnet wants.
+    std::transform(wstr.begin(), wstr.end(), _buffer.begin() + start, [](const wchar_t wch) {
+        return (wch > L'\x7f') ? '?' : static_cast<char>(wch);
+    });
 
-    va_end(argList);
-    return hr;
+    return _CompleteWrite(start);
 }
 
 // Method Description:
@@ -403,6 +465,22 @@ void VtEngine::SetTerminalOwner(Microsoft::Console::ITerminalOwner* const termin
     _terminalOwner = terminalOwner;
 }
 
+// Method Description:
+// - Gets the backpressure counters of the pipe writer, to see how far the
+//      terminal is lagging behind our output.
+// Arguments:
+// - <none>
+// Return Value:
+// - The counters, or nullopt if we're not writing to a pipe.
+std::optional<VtPipeWriter::Metrics> VtEngine::GetPipeWriterMetrics() const noexcept
+{
+    if (_pipeWriter)
+    {
+        return _pipeWriter->GetMetrics();
+    }
+    return std::nullopt;
+}
+
 // Method Description:
 // - sends a sequence to request the end terminal to tell us the
 //      cursor position. The terminal will reply back on the vt input handle.
@@ -21,8 +21,10 @@ Author(s):
 #include "../../inc/ITerminalOwner.hpp"
 #include "../../types/inc/Viewport.hpp"
 #include "tracing.hpp"
+#include "VtPipeWriter.hpp"
 #include <string>
 #include <functional>
+#include <charconv>
 
 namespace Microsoft::Console::Render
 {
@@ -95,15 +97,20 @@ namespace Microsoft::Console::Render
 
         void SetTerminalOwner(Microsoft::Console::ITerminalOwner* const terminalOwner);
 
+        std::optional<VtPipeWriter::Metrics> GetPipeWriterMetrics() const noexcept;
+
     protected:
         wil::unique_hfile _hFile;
         std::string _buffer;
+        // Declared after _hFile, so it finishes writing before the pipe is closed.
+        std::unique_ptr<VtPipeWriter> _pipeWriter;
 
         const Microsoft::Console::IDefaultColorProvider& _colorProvider;
 
         COLORREF _LastFG;
         COLORREF _LastBG;
         bool _lastWasBold;
+        bool _lastWasUnderlined;
 
         Microsoft::Console::Types::Viewport _lastViewport;
         Microsoft::Console::Types::Viewport _invalidRect;
@@ -134,9 +141,46 @@ namespace Microsoft::Console::Render
         Microsoft::Console::VirtualTerminal::RenderTracing _trace;
 
         [[nodiscard]] HRESULT _Write(std::string_view const str) noexcept;
-        [[nodiscard]] HRESULT _WriteFormattedString(const std::string* const pFormat, ...) noexcept;
+        [[nodiscard]] HRESULT _CompleteWrite(const size_t start) noexcept;
         [[nodiscard]] HRESULT _Flush() noexcept;
 
+        // Method Description:
+        // - Writes a sequence built from literal pieces and integer parameters
+        //      straight into our output buffer, without any intermediate
+        //      allocation. For example, _WriteSequence("\x1b[", y, ";", x, "H")
+        // Arguments:
+        // - parts: string literals or views, and ints to write in decimal.
+        // Return Value:
+        // - S_OK, or E_OUTOFMEMORY if the buffer couldn't grow.
+        template<typename... Args>
+        [[nodiscard]] HRESULT _WriteSequence(const Args&... parts) noexcept
+        {
+            const size_t start = _buffer.size();
+            try
+            {
+                (_AppendSequencePart(parts), ...);
+            }
+            catch (...)
+            {
+                _buffer.resize(start);
+                RETURN_CAUGHT_EXCEPTION();
+            }
+            return _CompleteWrite(start);
+        }
+
+        void _AppendSequencePart(const std::string_view str)
+        {
+            _buffer.append(str);
+        }
+
+        void _AppendSequencePart(const int value)
+        {
+            // Long enough for any int, including the sign.
+            char digits[11];
+            const auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+            _buffer.append(digits, result.ptr);
+        }
+
         void _OrRect(_Inout_ SMALL_RECT* const pRectExisting, const SMALL_RECT* const pRectToOr) const;
         [[nodiscard]] HRESULT _InvalidCombine(const Microsoft::Console::Types::Viewport invalid) noexcept;
         [[nodiscard]] HRESULT _InvalidOffset(const COORD* const ppt) noexcept;
@@ -161,7 +205,6 @@ namespace Microsoft::Console::Render
                                                            const bool fIsForeground) noexcept;
         [[nodiscard]] HRESULT _SetGraphicsRenditionRGBColor(const COLORREF color,
                                                             const bool fIsForeground) noexcept;
-        [[nodiscard]] HRESULT _SetGraphicsRenditionDefaultColor(const bool fIsForeground) noexcept;
 
         [[nodiscard]] HRESULT _SetGraphicsBoldness(const bool isBold) noexcept;
 
@@ -169,16 +212,14 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] HRESULT _ResizeWindow(const short sWidth, const short sHeight) noexcept;
 
-        [[nodiscard]] HRESULT _BeginUnderline() noexcept;
-
-        [[nodiscard]] HRESULT _EndUnderline() noexcept;
-
         [[nodiscard]] HRESULT _RequestCursor() noexcept;
 
         [[nodiscard]] virtual HRESULT _MoveCursor(const COORD coord) noexcept = 0;
-        [[nodiscard]] HRESULT _RgbUpdateDrawingBrushes(const COLORREF colorForeground,
+        [[nodiscard]] HRESULT _UpdateGraphicsRendition(const COLORREF colorForeground,
                                                        const COLORREF colorBackground,
                                                        const bool isBold,
+                                                       const bool isUnderlined,
+                                                       const bool allowExtendedColors,
                                                        _In_reads_(cColorTable) const COLORREF* const ColorTable,
                                                        const WORD cColorTable) noexcept;
         [[nodiscard]] HRESULT _16ColorUpdateDrawingBrushes(const COLORREF colorForeground,
@@ -195,8 +236,8 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _PaintAsciiBufferLine(std::basic_string_view<Cluster> const clusters,
                                                     const COORD coord) noexcept;
 
-        [[nodiscard]] HRESULT _WriteTerminalUtf8(const std::wstring& str) noexcept;
-        [[nodiscard]] HRESULT _WriteTerminalAscii(const std::wstring& str) noexcept;
+        [[nodiscard]] HRESULT _WriteTerminalUtf8(const std::wstring_view str) noexcept;
+        [[nodiscard]] HRESULT _WriteTerminalAscii(const std::wstring_view str) noexcept;
 
         [[nodiscard]] virtual HRESULT _DoUpdateTitle(const std::wstring& newTitle) noexcept override;
 
@@ -50,8 +50,9 @@ bool InteractDispatch::WriteCtrlC()
 }
 
 // Method Description:
-// - Writes a string of input to the host. The string is converted to keystrokes
-//      that will faithfully represent the input by CharToKeyEvents.
+// - Writes a string of input to the host. The host stores the string as text,
+//      and only converts it to keystrokes (the same ones CharToKeyEvents
+//      produces) for clients that read it as input records.
 // Arguments:
 // - pws: a string to write to the console.
 // - cch: the number of chars in pws.
@@ -65,24 +66,8 @@ bool InteractDispatch::WriteString(_In_reads_(cch) const wchar_t* const pws,
         return true;
     }
 
-    unsigned int codepage = 0;
-    bool fSuccess = !!_pConApi->GetConsoleOutputCP(&codepage);
-    if (fSuccess)
-    {
-        std::deque<std::unique_ptr<IInputEvent>> keyEvents;
-
-        for (size_t i = 0; i < cch; ++i)
-        {
-            std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(pws[i], codepage);
-
-            std::move(convertedEvents.begin(),
-                      convertedEvents.end(),
-                      std::back_inserter(keyEvents));
-        }
-
-        fSuccess = WriteInput(keyEvents);
-    }
-    return fSuccess;
+    size_t charsWritten = 0;
+    return !!_pConApi->PrivateWriteConsoleInputString({ pws, cch }, charsWritten);
 }
 
 //Method Description:
@@ -55,6 +55,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         virtual BOOL PrivateWriteConsoleInputW(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& events,
                                                _Out_ size_t& eventsWritten) = 0;
+        virtual BOOL PrivateWriteConsoleInputString(const std::wstring_view text,
+                                                    _Out_ size_t& charsWritten) = 0;
         virtual BOOL ScrollConsoleScreenBufferW(const SMALL_RECT* pScrollRectangle,
                                                 _In_opt_ const SMALL_RECT* pClipRectangle,
                                                 _In_ COORD dwDestinationOrigin,
@@ -363,6 +363,21 @@ public:
         return _fPrivateWriteConsoleInputWResult;
     }
 
+    BOOL PrivateWriteConsoleInputString(const std::wstring_view text,
+                                        _Out_ size_t& charsWritten) override
+    {
+        Log::Comment(L"PrivateWriteConsoleInputString MOCK called...");
+
+        charsWritten = 0;
+        if (_fPrivateWriteConsoleInputWResult)
+        {
+            _writtenString = text;
+            charsWritten = text.size();
+        }
+
+        return _fPrivateWriteConsoleInputWResult;
+    }
+
     BOOL PrivatePrependConsoleInput(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& events,
                                     _Out_ size_t& eventsWritten) override
     {
@@ -1310,6 +1325,7 @@ public:
 
     CHAR_INFO* _rgchars = nullptr;
     std::deque<std::unique_ptr<IInputEvent>> _events;
+    std::wstring _writtenString;
 
     COORD _coordBufferSize = { 0, 0 };
     SMALL_RECT _srViewport = { 0, 0, 0, 0 };
@@ -9,6 +9,8 @@
 
 #include "..\..\input\terminalInput.hpp"
 
+#include <chrono>
+
 #ifdef BUILD_ONECORE_INTERACTIVITY
 #include "..\..\..\interactivity\inc\VtApiRedirection.hpp"
 #endif
@@ -45,6 +47,7 @@ public:
     TEST_METHOD(TerminalInputModifierKeyTests);
     TEST_METHOD(TerminalInputNullKeyTests);
     TEST_METHOD(DifferentModifiersTest);
+    TEST_METHOD(KeystrokeBenchmark);
 
     wchar_t GetModifierChar(const bool fShift, const bool fAlt, const bool fCtrl)
     {
@@ -680,3 +683,64 @@ void InputTest::DifferentModifiersTest()
     uiKeystate = RIGHT_ALT_PRESSED;
     TestKey(pInput, uiKeystate, vkey, L'/');
 }
+
+void InputTest::KeystrokeBenchmark()
+{
+    Log::Comment(L"Translates a mix of plain, modified, cursor and function keys many times over. "
+                 L"Logs the time taken per keystroke as a benchmark.");
+
+    size_t eventsWritten = 0;
+    const TerminalInput input{ [&](std::deque<std::unique_ptr<IInputEvent>>& inEvents) {
+        eventsWritten += inEvents.size();
+    } };
+
+    struct Keystroke
+    {
+        WORD vkey;
+        wchar_t wch;
+        DWORD keystate;
+    };
+    const Keystroke keystrokes[] = {
+        { 'A', L'a', 0 },
+        { VK_UP, 0, 0 },
+        { VK_DOWN, 0, SHIFT_PRESSED },
+        { VK_RIGHT, 0, LEFT_CTRL_PRESSED },
+        { VK_F5, 0, 0 },
+        { VK_F12, 0, LEFT_ALT_PRESSED | SHIFT_PRESSED },
+        { VK_DELETE, 0, 0 },
+        { VK_BACK, L'\x8', LEFT_CTRL_PRESSED },
+        { VK_TAB, L'\t', SHIFT_PRESSED },
+    };
+
+    std::vector<std::unique_ptr<IInputEvent>> events;
+    for (const auto& keystroke : keystrokes)
+    {
+        INPUT_RECORD irTest = { 0 };
+        irTest.EventType = KEY_EVENT;
+        irTest.Event.KeyEvent.dwControlKeyState = keystroke.keystate;
+        irTest.Event.KeyEvent.wRepeatCount = 1;
+        irTest.Event.KeyEvent.wVirtualKeyCode = keystroke.vkey;
+        irTest.Event.KeyEvent.bKeyDown = TRUE;
+        irTest.Event.KeyEvent.uChar.UnicodeChar = keystroke.wch;
+        events.push_back(IInputEvent::Create(irTest));
+    }
+
+    const size_t iterations = 100000;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        for (const auto& event : events)
+        {
+            input.HandleKey(event.get());
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const size_t keystrokeCount = iterations * events.size();
+    VERIFY_IS_GREATER_THAN(eventsWritten, keystrokeCount);
+    Log::Comment(NoThrowString().Format(L"%zu keystrokes translated to %zu events in %lldus (%lldns per keystroke)",
+                                        keystrokeCount,
+                                        eventsWritten,
+                                        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+                                        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / static_cast<long long>(keystrokeCount)));
+}
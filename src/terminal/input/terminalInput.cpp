@@ -5,7 +5,7 @@
 #include <windows.h>
 #include "terminalInput.hpp"
 
-#include "strsafe.h"
+#include <array>
 
 #define WIL_SUPPORT_BITOPERATION_PASCAL_NAMES
 #include <wil\Common.h>
@@ -25,11 +25,33 @@ TerminalInput::TerminalInput(_In_ std::function<void(std::deque<std::unique_ptr<
     _pfnWriteEvents = pfn;
 }
 
+namespace
+{
+    // One entry in the key mapping tables below. These are only used to build
+    //      the lookup tables at compile time.
+    struct TermKeyMap
+    {
+        WORD const wVirtualKey;
+        DWORD const dwModifiers;
+        std::wstring_view const sequence;
+
+        constexpr TermKeyMap(const WORD wVirtualKey, const std::wstring_view sequence) :
+            wVirtualKey(wVirtualKey),
+            dwModifiers(0),
+            sequence(sequence){};
+
+        constexpr TermKeyMap(const WORD wVirtualKey, const DWORD dwModifiers, const std::wstring_view sequence) :
+            wVirtualKey(wVirtualKey),
+            dwModifiers(dwModifiers),
+            sequence(sequence){};
+    };
+}
+
 // See http://invisible-island.net/xterm/ctlseqs/ctlseqs.html#h2-PC-Style-Function-Keys
 //    For the source for these tables.
 // Also refer to the values in terminfo for kcub1, kcud1, kcuf1, kcuu1, kend, khome.
 //   the 'xterm' setting lists the application mode versions of these sequences.
-const TerminalInput::_TermKeyMap TerminalInput::s_rgCursorKeysNormalMapping[]{
+static constexpr TermKeyMap s_rgCursorKeysNormalMapping[]{
     { VK_UP, L"\x1b[A" },
     { VK_DOWN, L"\x1b[B" },
     { VK_RIGHT, L"\x1b[C" },
@@ -38,7 +60,7 @@ const TerminalInput::_TermKeyMap TerminalInput::s_rgCursorKeysNormalMapping[]{
     { VK_END, L"\x1b[F" },
 };
 
-const TerminalInput::_TermKeyMap TerminalInput::s_rgCursorKeysApplicationMapping[]{
+static constexpr TermKeyMap s_rgCursorKeysApplicationMapping[]{
     { VK_UP, L"\x1bOA" },
     { VK_DOWN, L"\x1bOB" },
     { VK_RIGHT, L"\x1bOC" },
@@ -47,7 +69,7 @@ const TerminalInput::_TermKeyMap TerminalInput::s_rgCursorKeysApplicationMapping
     { VK_END, L"\x1bOF" },
 };
 
-const TerminalInput::_TermKeyMap TerminalInput::s_rgKeypadNumericMapping[]{
+static constexpr TermKeyMap s_rgKeypadNumericMapping[]{
     // HEY YOU. UPDATE THE MAX LENGTH DEF WHEN YOU MAKE CHANGES HERE.
     { VK_TAB, L"\x09" },
     { VK_BACK, L"\x7f" },
@@ -80,7 +102,7 @@ const TerminalInput::_TermKeyMap TerminalInput::s_rgKeypadNumericMapping[]{
 //It seems to me as though this was used for early numpad implementations, where presently numlock would enable
 //  "numeric" mode, outputting the numbers on the keys, while "application" mode does things like pgup/down, arrow keys, etc.
 //These keys aren't translated at all in numeric mode, so I figured I'd leave them out of the numeric table.
-const TerminalInput::_TermKeyMap TerminalInput::s_rgKeypadApplicationMapping[]{
+static constexpr TermKeyMap s_rgKeypadApplicationMapping[]{
     // HEY YOU. UPDATE THE MAX LENGTH DEF WHEN YOU MAKE CHANGES HERE.
     { VK_TAB, L"\x09" },
     { VK_BACK, L"\x7f" },
@@ -134,7 +156,7 @@ const TerminalInput::_TermKeyMap TerminalInput::s_rgKeypadApplicationMapping[]{
 // Sequences to send when a modifier is pressed with any of these keys
 // Basically, the 'm' will be replaced with a character indicating which
 //      modifier keys are pressed.
-const TerminalInput::_TermKeyMap TerminalInput::s_rgModifierKeyMapping[]{
+static constexpr TermKeyMap s_rgModifierKeyMapping[]{
     // HEY YOU. UPDATE THE MAX LENGTH DEF WHEN YOU MAKE CHANGES HERE.
     { VK_UP, L"\x1b[1;mA" },
     { VK_DOWN, L"\x1b[1;mB" },
@@ -167,7 +189,7 @@ const TerminalInput::_TermKeyMap TerminalInput::s_rgModifierKeyMapping[]{
 // These sequences are not later updated to encode the modifier state in the
 //      sequence itself, they are just weird exceptional cases to the general
 //      rules above.
-const TerminalInput::_TermKeyMap TerminalInput::s_rgSimpleModifedKeyMapping[]{
+static constexpr TermKeyMap s_rgSimpleModifedKeyMapping[]{
     // HEY YOU. UPDATE THE MAX LENGTH DEF WHEN YOU MAKE CHANGES HERE.
     { VK_BACK, CTRL_PRESSED, L"\x8" },
     { VK_BACK, ALT_PRESSED, L"\x1b\x7f" },
@@ -180,185 +202,183 @@ const TerminalInput::_TermKeyMap TerminalInput::s_rgSimpleModifedKeyMapping[]{
     // { VK_ESCAPE, ALT_PRESSED, L""}, This is another Windows system shortcut for switching windows.
 };
 
-const wchar_t* const CTRL_SLASH_SEQUENCE = L"\x1f";
+static constexpr std::wstring_view CTRL_SLASH_SEQUENCE = L"\x1f";
 
 // Do NOT include the null terminator in the count.
-const size_t TerminalInput::_TermKeyMap::s_cchMaxSequenceLength = 7; // UPDATE THIS DEF WHEN THE LONGEST MAPPED STRING CHANGES
-
-const size_t TerminalInput::s_cCursorKeysNormalMapping = ARRAYSIZE(s_rgCursorKeysNormalMapping);
-const size_t TerminalInput::s_cCursorKeysApplicationMapping = ARRAYSIZE(s_rgCursorKeysApplicationMapping);
-const size_t TerminalInput::s_cKeypadNumericMapping = ARRAYSIZE(s_rgKeypadNumericMapping);
-const size_t TerminalInput::s_cKeypadApplicationMapping = ARRAYSIZE(s_rgKeypadApplicationMapping);
-const size_t TerminalInput::s_cModifierKeyMapping = ARRAYSIZE(s_rgModifierKeyMapping);
-const size_t TerminalInput::s_cSimpleModifedKeyMapping = ARRAYSIZE(s_rgSimpleModifedKeyMapping);
+static constexpr size_t s_cchMaxSequenceLength = 7; // UPDATE THIS DEF WHEN THE LONGEST MAPPED STRING CHANGES
 
-void TerminalInput::ChangeKeypadMode(const bool fApplicationMode)
+namespace
 {
-    _fKeypadApplicationMode = fApplicationMode;
-}
+    // The sequence for every virtual key in one of the tables above, or an
+    //      empty view for keys that aren't in it.
+    using KeyTable = std::array<std::wstring_view, 256>;
 
-void TerminalInput::ChangeCursorKeysMode(const bool fApplicationMode)
-{
-    _fCursorApplicationMode = fApplicationMode;
-}
-
-const size_t TerminalInput::GetKeyMappingLength(const KeyEvent& keyEvent) const
-{
-    if (keyEvent.IsCursorKey())
+    template<size_t N>
+    constexpr KeyTable MakeKeyTable(const TermKeyMap (&mappings)[N])
     {
-        return (_fCursorApplicationMode) ? s_cCursorKeysApplicationMapping : s_cCursorKeysNormalMapping;
+        KeyTable table{};
+        for (const auto& mapping : mappings)
+        {
+            table[mapping.wVirtualKey] = mapping.sequence;
+        }
+        return table;
     }
 
-    return (_fKeypadApplicationMode) ? s_cKeypadApplicationMapping : s_cKeypadNumericMapping;
-}
-
-const TerminalInput::_TermKeyMap* TerminalInput::GetKeyMapping(const KeyEvent& keyEvent) const
-{
-    if (keyEvent.IsCursorKey())
+    // Shift, alt and ctrl as an index from 0 to 7. Adding this to '1' gives
+    //      the VT encoding of the modifiers.
+    constexpr size_t ModifierIndex(const bool fShift, const bool fAlt, const bool fCtrl) noexcept
     {
-        return (_fCursorApplicationMode) ? s_rgCursorKeysApplicationMapping : s_rgCursorKeysNormalMapping;
+        return (fShift ? 1 : 0) + (fAlt ? 2 : 0) + (fCtrl ? 4 : 0);
     }
 
-    return (_fKeypadApplicationMode) ? s_rgKeypadApplicationMapping : s_rgKeypadNumericMapping;
-}
+    constexpr size_t ModifierIndex(const DWORD dwModifiers) noexcept
+    {
+        return ModifierIndex((dwModifiers & SHIFT_PRESSED) != 0,
+                             (dwModifiers & ALT_PRESSED) != 0,
+                             (dwModifiers & CTRL_PRESSED) != 0);
+    }
 
-// Routine Description:
-// - Searches the s_ModifierKeyMapping for a entry corresponding to this key event.
-//      Changes the second to last byte to correspond to the currently pressed modifier keys
-//      before sending to the input.
-// Arguments:
-// - keyEvent - Key event to translate
-// Return Value:
-// - True if there was a match to a key translation, and we successfully modified and sent it to the input
-bool TerminalInput::_SearchWithModifier(const KeyEvent& keyEvent) const
-{
-    const TerminalInput::_TermKeyMap* pMatchingMapping;
-    bool fSuccess = _SearchKeyMapping(keyEvent,
-                                      s_rgModifierKeyMapping,
-                                      s_cModifierKeyMapping,
-                                      &pMatchingMapping);
-    if (fSuccess)
+    // The sequences for the keys that are sent differently when a modifier is
+    //      pressed, prebuilt for every combination of modifiers.
+    template<size_t N>
+    struct ModifiedKeyTable
     {
-        size_t cch = 0;
-        if (SUCCEEDED(StringCchLengthW(pMatchingMapping->pwszSequence, _TermKeyMap::s_cchMaxSequenceLength + 1, &cch)) &&
-            cch > 0)
+        struct Sequences
         {
-            wchar_t* rwchModifiedSequence = new (std::nothrow) wchar_t[cch + 1];
-            if (rwchModifiedSequence != nullptr)
+            std::array<std::array<wchar_t, s_cchMaxSequenceLength>, 8> text;
+            std::array<size_t, 8> length;
+        };
+
+        // For every virtual key, 1 + the index of its sequences, or 0 if it has none.
+        std::array<BYTE, 256> index;
+        std::array<Sequences, N> keys;
+        size_t count;
+
+        // Adds the sequence for a key with the given modifiers. Any 'm' in it
+        //      is replaced with the VT encoding of those modifiers.
+        constexpr void Add(const WORD wVirtualKey, const size_t modifiers, const std::wstring_view sequence)
+        {
+            if (index[wVirtualKey] == 0)
             {
-                memcpy(rwchModifiedSequence, pMatchingMapping->pwszSequence, cch * sizeof(wchar_t));
-                const bool fShift = keyEvent.IsShiftPressed();
-                const bool fAlt = keyEvent.IsAltPressed();
-                const bool fCtrl = keyEvent.IsCtrlPressed();
-                rwchModifiedSequence[cch - 2] = L'1' + (fShift ? 1 : 0) + (fAlt ? 2 : 0) + (fCtrl ? 4 : 0);
-                rwchModifiedSequence[cch] = 0;
-                _SendInputSequence(rwchModifiedSequence);
-                fSuccess = true;
-                delete[] rwchModifiedSequence;
+                index[wVirtualKey] = static_cast<BYTE>(++count);
             }
+            Sequences& key = keys[index[wVirtualKey] - 1];
+            for (size_t i = 0; i < sequence.size(); i++)
+            {
+                key.text[modifiers][i] = sequence[i] == L'm' ? static_cast<wchar_t>(L'1' + modifiers) : sequence[i];
+            }
+            key.length[modifiers] = sequence.size();
         }
-    }
-    else
-    {
-        // We didn't find the key in the map of modified keys that need editing,
-        //      maybe it's in the other map of modified keys with sequences that
-        //      don't need editing before sending.
-        fSuccess = _SearchKeyMapping(keyEvent,
-                                     s_rgSimpleModifedKeyMapping,
-                                     s_cSimpleModifedKeyMapping,
-                                     &pMatchingMapping);
-        if (fSuccess)
+
+        constexpr std::wstring_view Lookup(const WORD wVirtualKey, const size_t modifiers) const noexcept
         {
-            // This mapping doesn't need to be changed at all.
-            _SendInputSequence(pMatchingMapping->pwszSequence);
-            fSuccess = true;
+            if (wVirtualKey >= index.size() || index[wVirtualKey] == 0)
+            {
+                return {};
+            }
+            const Sequences& key = keys[index[wVirtualKey] - 1];
+            return { key.text[modifiers].data(), key.length[modifiers] };
         }
-        else
+    };
+
+    // Builds the table for both kinds of modified keys: the ones with an 'm' to
+    //      fill in, which apply to every combination of modifiers, and the
+    //      exceptional ones, which only apply to exactly the modifiers given.
+    template<size_t M, size_t S>
+    constexpr ModifiedKeyTable<M + S> MakeModifiedKeyTable(const TermKeyMap (&modifierMappings)[M],
+                                                           const TermKeyMap (&simpleMappings)[S])
+    {
+        ModifiedKeyTable<M + S> table{};
+        for (const auto& mapping : modifierMappings)
         {
-            // One last check: C-/ is supposed to be C-_
-            // But '/' is not the same VKEY on all keyboards. So we have to
-            //      figure out the vkey at runtime.
-            const BYTE slashVkey = LOBYTE(VkKeyScan(L'/'));
-            if (keyEvent.GetVirtualKeyCode() == slashVkey && keyEvent.IsCtrlPressed())
+            for (size_t modifiers = 0; modifiers < 8; modifiers++)
             {
-                // This mapping doesn't need to be changed at all.
-                _SendInputSequence(CTRL_SLASH_SEQUENCE);
-                fSuccess = true;
+                table.Add(mapping.wVirtualKey, modifiers, mapping.sequence);
             }
         }
+        for (const auto& mapping : simpleMappings)
+        {
+            table.Add(mapping.wVirtualKey, ModifierIndex(mapping.dwModifiers), mapping.sequence);
+        }
+        return table;
     }
+}
+
+static constexpr KeyTable s_cursorKeysNormalTable = MakeKeyTable(s_rgCursorKeysNormalMapping);
+static constexpr KeyTable s_cursorKeysApplicationTable = MakeKeyTable(s_rgCursorKeysApplicationMapping);
+static constexpr KeyTable s_keypadNumericTable = MakeKeyTable(s_rgKeypadNumericMapping);
+static constexpr KeyTable s_keypadApplicationTable = MakeKeyTable(s_rgKeypadApplicationMapping);
+static constexpr auto s_modifiedKeyTable = MakeModifiedKeyTable(s_rgModifierKeyMapping, s_rgSimpleModifedKeyMapping);
+
+void TerminalInput::ChangeKeypadMode(const bool fApplicationMode)
+{
+    _fKeypadApplicationMode = fApplicationMode;
+}
 
-    return fSuccess;
+void TerminalInput::ChangeCursorKeysMode(const bool fApplicationMode)
+{
+    _fCursorApplicationMode = fApplicationMode;
 }
 
 // Routine Description:
-// - Searches the keyMapping for a entry corresponding to this key event, and returns it.
+// - Looks up the sequence for this key with the currently pressed modifier
+//      keys, and sends it to the input. Most of these have the modifiers
+//      encoded in them, the rest are exceptional cases for certain modifiers.
 // Arguments:
 // - keyEvent - Key event to translate
-// - keyMapping - Array of key mappings to search
-// - cKeyMapping - number of entries in keyMapping
-// - pMatchingMapping - Where to put the pointer to the found match
 // Return Value:
-// - True if there was a match to a key translation
-bool TerminalInput::_SearchKeyMapping(const KeyEvent& keyEvent,
-                                      _In_reads_(cKeyMapping) const TerminalInput::_TermKeyMap* keyMapping,
-                                      const size_t cKeyMapping,
-                                      _Out_ const TerminalInput::_TermKeyMap** pMatchingMapping) const
+// - True if there was a match to a key translation, and we successfully modified and sent it to the input
+bool TerminalInput::_SearchWithModifier(const KeyEvent& keyEvent) const
 {
-    bool fKeyTranslated = false;
-    for (size_t i = 0; i < cKeyMapping; i++)
+    const size_t modifiers = ModifierIndex(keyEvent.IsShiftPressed(), keyEvent.IsAltPressed(), keyEvent.IsCtrlPressed());
+    const std::wstring_view sequence = s_modifiedKeyTable.Lookup(keyEvent.GetVirtualKeyCode(), modifiers);
+    if (!sequence.empty())
     {
-        const _TermKeyMap* const pMap = &(keyMapping[i]);
-
-        if (pMap->wVirtualKey == keyEvent.GetVirtualKeyCode())
-        {
-            // If the mapping has no modifiers set, then it doesn't really care
-            //      what the modifiers are on the key. The caller will likely do
-            //      something with them.
-            // However, if there are modifiers set, then we only want to match
-            //      if the key's modifiers are the same as the modifiers in the
-            //      mapping.
-            bool modifiersMatch = WI_AreAllFlagsClear(pMap->dwModifiers, MOD_PRESSED);
-            if (!modifiersMatch)
-            {
-                // The modifier mapping expects certain modifier keys to be
-                //      pressed. Check those as well.
-                modifiersMatch =
-                    (WI_IsFlagSet(pMap->dwModifiers, SHIFT_PRESSED) == keyEvent.IsShiftPressed()) &&
-                    (WI_IsAnyFlagSet(pMap->dwModifiers, ALT_PRESSED) == keyEvent.IsAltPressed()) &&
-                    (WI_IsAnyFlagSet(pMap->dwModifiers, CTRL_PRESSED) == keyEvent.IsCtrlPressed());
-            }
+        _SendInputSequence(sequence);
+        return true;
+    }
 
-            if (modifiersMatch)
-            {
-                fKeyTranslated = true;
-                *pMatchingMapping = pMap;
-                break;
-            }
-        }
+    // One last check: C-/ is supposed to be C-_
+    // But '/' is not the same VKEY on all keyboards. So we have to
+    //      figure out the vkey at runtime.
+    const BYTE slashVkey = LOBYTE(VkKeyScan(L'/'));
+    if (keyEvent.GetVirtualKeyCode() == slashVkey && keyEvent.IsCtrlPressed())
+    {
+        // This mapping doesn't need to be changed at all.
+        _SendInputSequence(CTRL_SLASH_SEQUENCE);
+        return true;
     }
-    return fKeyTranslated;
+
+    return false;
 }
 
 // Routine Description:
-// - Searches the input array of mappings, and sends it to the input if a match was found.
+// - Looks up the sequence for this key in the table for the current cursor
+//      keys or keypad mode, and sends it to the input if there is one.
 // Arguments:
 // - keyEvent - Key event to translate
-// - keyMapping - Array of key mappings to search
-// - cKeyMapping - number of entries in keyMapping
 // Return Value:
 // - True if there was a match to a key translation, and we successfully sent it to the input
-bool TerminalInput::_TranslateDefaultMapping(const KeyEvent& keyEvent,
-                                             _In_reads_(cKeyMapping) const TerminalInput::_TermKeyMap* keyMapping,
-                                             const size_t cKeyMapping) const
+bool TerminalInput::_TranslateDefaultMapping(const KeyEvent& keyEvent) const
 {
-    const TerminalInput::_TermKeyMap* pMatchingMapping;
-    const bool fSuccess = _SearchKeyMapping(keyEvent, keyMapping, cKeyMapping, &pMatchingMapping);
-    if (fSuccess)
+    const KeyTable* table;
+    if (keyEvent.IsCursorKey())
+    {
+        table = _fCursorApplicationMode ? &s_cursorKeysApplicationTable : &s_cursorKeysNormalTable;
+    }
+    else
     {
-        _SendInputSequence(pMatchingMapping->pwszSequence);
+        table = _fKeypadApplicationMode ? &s_keypadApplicationTable : &s_keypadNumericTable;
     }
-    return fSuccess;
+
+    const WORD wVirtualKey = keyEvent.GetVirtualKeyCode();
+    if (wVirtualKey >= table->size() || (*table)[wVirtualKey].empty())
+    {
+        return false;
+    }
+
+    _SendInputSequence((*table)[wVirtualKey]);
+    return true;
 }
 
 bool TerminalInput::HandleKey(const IInputEvent* const pInEvent) const
@@ -449,14 +469,12 @@ bool TerminalInput::HandleKey(const IInputEvent* const pInEvent) const
                 if ((keyEvent.GetVirtualKeyCode() < '0' || keyEvent.GetVirtualKeyCode() > 'Z') &&
                     keyEvent.GetVirtualKeyCode() != VK_CANCEL)
                 {
-                    fKeyHandled = _TranslateDefaultMapping(keyEvent, GetKeyMapping(keyEvent), GetKeyMappingLength(keyEvent));
+                    fKeyHandled = _TranslateDefaultMapping(keyEvent);
                 }
                 else
                 {
-                    WCHAR rgwchSequence[2];
-                    rgwchSequence[0] = keyEvent.GetCharData();
-                    rgwchSequence[1] = UNICODE_NULL;
-                    _SendInputSequence(rgwchSequence);
+                    const wchar_t wch = keyEvent.GetCharData();
+                    _SendInputSequence({ &wch, 1 });
                     fKeyHandled = true;
                 }
             }
@@ -507,18 +525,18 @@ void TerminalInput::_SendNullInputSequence(const DWORD dwControlKeyState) const
     }
 }
 
-void TerminalInput::_SendInputSequence(_In_ PCWSTR const pwszSequence) const
+void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const
 {
-    size_t cch = 0;
-    // + 1 to max sequence length for null terminator count which is required by StringCchLengthW
-    if (SUCCEEDED(StringCchLengthW(pwszSequence, _TermKeyMap::s_cchMaxSequenceLength + 1, &cch)) && cch > 0)
+    // A NUL ends the sequence, just as it would have ended a C string.
+    const std::wstring_view text = sequence.substr(0, sequence.find(UNICODE_NULL));
+    if (!text.empty())
     {
         try
         {
             std::deque<std::unique_ptr<IInputEvent>> inputEvents;
-            for (size_t i = 0; i < cch; i++)
+            for (const auto wch : text)
             {
-                inputEvents.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, pwszSequence[i], 0));
+                inputEvents.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, wch, 0));
             }
             _pfnWriteEvents(inputEvents);
         }
@@ -50,6 +50,8 @@ namespace Microsoft::Console::VirtualTerminal
                                        _In_reads_(cParams) const unsigned short* const rgusParams,
                                        const unsigned short cParams) = 0;
 
+        virtual bool ActionEndOfString() = 0;
+
         virtual bool FlushAtEndOfString() const = 0;
         virtual bool DispatchControlCharsFromEscape() const = 0;
         virtual bool DispatchIntermediatesFromEscape() const = 0;
@@ -82,7 +82,10 @@ InputStateMachineEngine::InputStateMachineEngine(IInteractDispatch* const pDispa
 
 InputStateMachineEngine::InputStateMachineEngine(IInteractDispatch* const pDispatch, const bool lookingForDSR) :
     _pDispatch(THROW_IF_NULL_ALLOC(pDispatch)),
-    _lookingForDSR(lookingForDSR)
+    _lookingForDSR(lookingForDSR),
+    _pendingInput{},
+    _batchStart{},
+    _metrics{}
 {
 }
 
@@ -104,7 +107,8 @@ bool InputStateMachineEngine::_DoControlCharacter(const wchar_t wch, const bool
     if (wch == UNICODE_ETX && !writeAlt)
     {
         // This is Ctrl+C, which is handled specially by the host.
-        fSuccess = _pDispatch->WriteCtrlC();
+        fSuccess = _FlushPendingInput();
+        fSuccess = _pDispatch->WriteCtrlC() && fSuccess;
     }
     else if (wch >= '\x0' && wch < '\x20')
     {
@@ -224,7 +228,8 @@ bool InputStateMachineEngine::ActionPrintString(const wchar_t* const rgwch,
     {
         return true;
     }
-    return _pDispatch->WriteString(rgwch, cch);
+    const bool fFlushed = _FlushPendingInput();
+    return _pDispatch->WriteString(rgwch, cch) && fFlushed;
 }
 
 // Method Description:
@@ -363,7 +368,8 @@ bool InputStateMachineEngine::ActionCsiDispatch(const wchar_t wch,
             // Else, fall though to the _GetCursorKeysModifierState handler.
             if (_lookingForDSR)
             {
-                fSuccess = _pDispatch->MoveCursor(row, col);
+                fSuccess = _FlushPendingInput();
+                fSuccess = _pDispatch->MoveCursor(row, col) && fSuccess;
                 // Right now we're only looking for on initial cursor
                 //      position response. After that, only look for F3.
                 _lookingForDSR = false;
@@ -384,9 +390,11 @@ bool InputStateMachineEngine::ActionCsiDispatch(const wchar_t wch,
             fSuccess = _WriteSingleKey(vkey, dwModifierState);
             break;
         case CsiActionCodes::DTTERM_WindowManipulation:
+            fSuccess = _FlushPendingInput();
             fSuccess = _pDispatch->WindowManipulation(static_cast<DispatchTypes::WindowManipulationType>(uiFunction),
                                                       rgusRemainingArgs,
-                                                      cRemainingArgs);
+                                                      cRemainingArgs) &&
+                       fSuccess;
             break;
         default:
             fSuccess = false;
@@ -655,9 +663,7 @@ bool InputStateMachineEngine::_WriteSingleKey(const wchar_t wch, const short vke
     INPUT_RECORD rgInput[WRAPPED_SEQUENCE_MAX_LENGTH];
     size_t cInput = _GenerateWrappedSequence(wch, vkey, dwModifierState, rgInput, WRAPPED_SEQUENCE_MAX_LENGTH);
 
-    std::deque<std::unique_ptr<IInputEvent>> inputEvents = IInputEvent::Create(gsl::make_span(rgInput, cInput));
-
-    return _pDispatch->WriteInput(inputEvents);
+    return _QueueKeypress(gsl::make_span(rgInput, cInput));
 }
 
 // Method Description:
@@ -856,6 +862,77 @@ bool InputStateMachineEngine::_GenerateKeyFromChar(const wchar_t wch,
     return true;
 }
 
+// Method Description:
+// - Triggers the EndOfString action to indicate that the current call to
+//      ProcessString is done. Writes out the keypresses batched up from it.
+// Return Value:
+// - true iff we successfully wrote the batch to the input callback.
+bool InputStateMachineEngine::ActionEndOfString()
+{
+    return _FlushPendingInput();
+}
+
+// Method Description:
+// - Adds a keypress to the batch of input that will be written at the end of
+//      the string.
+// Arguments:
+// - sequence - the records for the keypress, as generated by
+//      _GenerateWrappedSequence.
+// Return Value:
+// - true iff we successfully queued the keypress.
+bool InputStateMachineEngine::_QueueKeypress(const gsl::span<const INPUT_RECORD> sequence)
+{
+    try
+    {
+        _metrics.keypresses++;
+        if (_pendingInput.empty())
+        {
+            _batchStart = std::chrono::steady_clock::now();
+        }
+        _pendingInput.insert(_pendingInput.end(), sequence.begin(), sequence.end());
+        return true;
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return false;
+    }
+}
+
+// Method Description:
+// - Writes the batched up keypresses to the input callback, if there are any.
+//      This has to happen before anything else is dispatched, so that the
+//      input stays in order.
+// Return Value:
+// - true iff we successfully wrote the batch to the input callback.
+bool InputStateMachineEngine::_FlushPendingInput()
+{
+    if (_pendingInput.empty())
+    {
+        return true;
+    }
+
+    std::deque<std::unique_ptr<IInputEvent>> inputEvents = IInputEvent::Create(gsl::make_span(_pendingInput));
+
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _batchStart);
+    _metrics.batchesWritten++;
+    _metrics.recordsWritten += _pendingInput.size();
+    _metrics.totalBatchLatency += latency;
+    _metrics.peakBatchLatency = std::max(_metrics.peakBatchLatency, latency);
+
+    // Empty the batch before writing it, in case writing it ends up back here.
+    _pendingInput.clear();
+
+    return _pDispatch->WriteInput(inputEvents);
+}
+
+// Method Description:
+// - Gets a snapshot of the batching counters. See Metrics.
+InputStateMachineEngine::Metrics InputStateMachineEngine::GetMetrics() const noexcept
+{
+    return _metrics;
+}
+
 // Method Description:
 // - Returns true if the engine should dispatch on the last charater of a string
 //      always, even if the sequence hasn't normally dispatched.
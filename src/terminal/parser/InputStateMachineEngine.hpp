@@ -9,6 +9,10 @@ Abstract:
 - This is the implementation of the client VT input state machine engine.
     This generates InputEvents from a stream of VT sequences emitted by a
     client "terminal" application.
+- The keypresses generated from one call to ProcessString are written to the
+    dispatch as a single batch when the string ends. Every keypress keeps its
+    own key down and key up in the batch, so that a client reading raw input
+    records sees exactly what the keyboard would have generated.
 
 Author(s):
 - Mike Griese (migrie) 18 Aug 2017
@@ -17,6 +21,7 @@ Author(s):
 
 #include "telemetry.hpp"
 #include "IStateMachineEngine.hpp"
+#include <chrono>
 #include <functional>
 #include "../../types/inc/IInputEvent.hpp"
 #include "../adapter/IInteractDispatch.hpp"
@@ -26,6 +31,19 @@ namespace Microsoft::Console::VirtualTerminal
     class InputStateMachineEngine : public IStateMachineEngine
     {
     public:
+        struct Metrics
+        {
+            // Number of keypresses generated from the input.
+            size_t keypresses;
+            // Number of batches written to the dispatch, and the records in them.
+            size_t batchesWritten;
+            size_t recordsWritten;
+            // Time from the first keypress of a batch being generated to the
+            //      batch being written. The total over all batches, and the longest.
+            std::chrono::microseconds totalBatchLatency;
+            std::chrono::microseconds peakBatchLatency;
+        };
+
         InputStateMachineEngine(IInteractDispatch* const pDispatch);
         InputStateMachineEngine(IInteractDispatch* const pDispatch,
                                 const bool lookingForDSR);
@@ -64,14 +82,23 @@ namespace Microsoft::Console::VirtualTerminal
                                _In_reads_(cParams) const unsigned short* const rgusParams,
                                const unsigned short cParams) override;
 
+        bool ActionEndOfString() override;
+
         bool FlushAtEndOfString() const override;
         bool DispatchControlCharsFromEscape() const override;
         bool DispatchIntermediatesFromEscape() const override;
 
+        Metrics GetMetrics() const noexcept;
+
     private:
         const std::unique_ptr<IInteractDispatch> _pDispatch;
         bool _lookingForDSR;
 
+        // Keypresses waiting to be written at the end of the string.
+        std::vector<INPUT_RECORD> _pendingInput;
+        std::chrono::steady_clock::time_point _batchStart;
+        Metrics _metrics;
+
         enum CsiActionCodes : wchar_t
         {
             ArrowUp = L'A',
@@ -165,6 +192,9 @@ namespace Microsoft::Console::VirtualTerminal
         bool _WriteSingleKey(const short vkey, const DWORD dwModifierState);
         bool _WriteSingleKey(const wchar_t wch, const short vkey, const DWORD dwModifierState);
 
+        bool _QueueKeypress(const gsl::span<const INPUT_RECORD> sequence);
+        bool _FlushPendingInput();
+
         size_t _GenerateWrappedSequence(const wchar_t wch,
                                         const short vkey,
                                         const DWORD dwModifierState,
@@ -1290,6 +1290,17 @@ _Success_(return ) bool OutputStateMachineEngine::_GetDesignateType(const wchar_
     return fSuccess;
 }
 
+// Routine Description:
+// - Triggers the EndOfString action to indicate that the current call to
+//      ProcessString is done. Output is dispatched as it's parsed, so there's
+//      nothing to do here.
+// Return Value:
+// - true
+bool OutputStateMachineEngine::ActionEndOfString()
+{
+    return true;
+}
+
 // Routine Description:
 // - Returns true if the engine should dispatch on the last charater of a string
 //      always, even if the sequence hasn't normally dispatched.
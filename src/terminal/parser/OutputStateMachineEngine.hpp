@@ -56,6 +56,8 @@ namespace Microsoft::Console::VirtualTerminal
                                _In_reads_(cParams) const unsigned short* const rgusParams,
                                const unsigned short cParams) override;
 
+        bool ActionEndOfString() override;
+
         bool FlushAtEndOfString() const override;
         bool DispatchControlCharsFromEscape() const override;
         bool DispatchIntermediatesFromEscape() const override;
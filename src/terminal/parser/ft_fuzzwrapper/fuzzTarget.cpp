@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "fuzzTarget.hpp"
+#include "..\stateMachine.hpp"
+#include "..\OutputStateMachineEngine.hpp"
+#include "..\InputStateMachineEngine.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+// Routine Description:
+// - Splits a fuzz input into its control byte and text. See fuzzTarget.hpp.
+// Arguments:
+// - data - the fuzz input
+// - size - the size of data, in bytes
+// Return Value:
+// - The engine, chunk size and text to run. An odd trailing byte is dropped.
+FuzzInput Microsoft::Console::VirtualTerminal::ParseFuzzInput(_In_reads_bytes_(size) const uint8_t* const data, const size_t size)
+{
+    FuzzInput input{ FuzzEngine::Output, 0, {} };
+    if (size == 0)
+    {
+        return input;
+    }
+
+    input.engine = (data[0] & 1) ? FuzzEngine::Input : FuzzEngine::Output;
+    input.chunkSize = data[0] >> 1;
+
+    // The text isn't necessarily aligned for wchar_t, so it's copied.
+    input.text.resize((size - 1) / sizeof(wchar_t));
+    memcpy(input.text.data(), data + 1, input.text.size() * sizeof(wchar_t));
+    return input;
+}
+
+// Routine Description:
+// - Feeds the text of a fuzz input through a fresh state machine with the
+//      engine it asks for.
+// Arguments:
+// - input - the engine, chunk size and text to run.
+// Return Value:
+// - The tally of what reached the dispatch.
+DispatchRecord Microsoft::Console::VirtualTerminal::RunParser(const FuzzInput& input)
+{
+    DispatchRecord record{};
+
+    std::unique_ptr<IStateMachineEngine> engine;
+    if (input.engine == FuzzEngine::Input)
+    {
+        engine = std::make_unique<InputStateMachineEngine>(new RecordingInteractDispatch(record));
+    }
+    else
+    {
+        engine = std::make_unique<OutputStateMachineEngine>(new RecordingDispatch(record));
+    }
+    StateMachine machine(engine.release());
+
+    const size_t chunkSize = input.chunkSize == 0 ? input.text.size() : input.chunkSize;
+    for (size_t offset = 0; offset < input.text.size(); offset += chunkSize)
+    {
+        machine.ProcessString(input.text.data() + offset, (std::min)(chunkSize, input.text.size() - offset));
+    }
+
+    return record;
+}
+
+// Routine Description:
+// - The libFuzzer entry point. Runs one input and expects it not to crash.
+// - The parser doesn't throw on bad input, so nothing is caught here: anything
+//   that escapes is a bug, and libFuzzer reports it with the input that caused it.
+extern "C" int LLVMFuzzerTestOneInput(_In_reads_bytes_(size) const uint8_t* data, size_t size)
+{
+    RunParser(ParseFuzzInput(data, size));
+    return 0;
+}
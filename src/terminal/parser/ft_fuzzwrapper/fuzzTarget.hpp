@@ -0,0 +1,40 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- fuzzTarget.hpp
+
+Abstract:
+- The entry point for coverage guided fuzzers (libFuzzer, or AFL through its
+    libFuzzer driver), and the same code path for replaying a saved corpus as
+    a throughput benchmark.
+- A fuzz input is one control byte followed by UTF-16LE text. The low bit of
+    the control byte picks the engine (0 for output, 1 for input). The rest of
+    it is the size of the chunks the text is fed to ProcessString in, so that
+    sequences split across calls get exercised too. 0 feeds it all at once.
+--*/
+#pragma once
+
+#include "recordingDispatch.hpp"
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    enum class FuzzEngine
+    {
+        Output,
+        Input
+    };
+
+    struct FuzzInput
+    {
+        FuzzEngine engine;
+        size_t chunkSize;
+        std::wstring text;
+    };
+
+    FuzzInput ParseFuzzInput(_In_reads_bytes_(size) const uint8_t* const data, const size_t size);
+    DispatchRecord RunParser(const FuzzInput& input);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(_In_reads_bytes_(size) const uint8_t* data, size_t size);
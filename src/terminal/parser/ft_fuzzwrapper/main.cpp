@@ -4,15 +4,27 @@
 #include "precomp.h"
 
 #include "echoDispatch.hpp"
+#include "fuzzTarget.hpp"
 #include "..\stateMachine.hpp"
 #include "..\OutputStateMachineEngine.hpp"
 
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
 using namespace Microsoft::Console::VirtualTerminal;
 
+// When this is linked into a libFuzzer (or AFL) build, the fuzzer provides main,
+//      and LLVMFuzzerTestOneInput in fuzzTarget.cpp is all that's needed.
+#ifndef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
+
 void PrintUsage()
 {
     wprintf(L"Usage: conterm.parser.fuzzwrapper.exe <input file name> <codepage>\r\n");
     wprintf(L"Use codepage 1200 for Unicode. 437 for US English. 0 for reading straight as ASCII.\r\n");
+    wprintf(L"   or: conterm.parser.fuzzwrapper.exe -corpus <corpus directory> [iterations]\r\n");
+    wprintf(L"Replays every fuzz input in the directory, and reports the parse throughput of each engine.\r\n");
 }
 
 UINT const UNICODE_CP = 1200;
@@ -42,11 +54,86 @@ bool GetChar(wchar_t* pwch)
     }
 }
 
+// Routine Description:
+// - Runs every file in a fuzz corpus through the parser, the same way the fuzz
+//      target does, a number of times over. Reports the throughput of each
+//      engine, so that a parser change can be checked for speed as well as
+//      for surviving the corpus.
+// Arguments:
+// - pwszDirectory - the corpus directory
+// - iterations - how many times to replay the corpus
+// Return Value:
+// - 0, or an error if the corpus couldn't be read.
+int RunCorpus(const wchar_t* const pwszDirectory, const size_t iterations)
+{
+    std::vector<FuzzInput> inputs;
+    const std::wstring directory{ pwszDirectory };
+    WIN32_FIND_DATAW findData;
+    wil::unique_hfind hFind{ FindFirstFileW((directory + L"\\*").c_str(), &findData) };
+    if (!hFind)
+    {
+        wprintf(L"Couldn't open corpus '%s'\r\n", pwszDirectory);
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+    do
+    {
+        if (WI_IsFlagClear(findData.dwFileAttributes, FILE_ATTRIBUTE_DIRECTORY))
+        {
+            std::ifstream file{ directory + L"\\" + findData.cFileName, std::ios::binary };
+            const std::vector<uint8_t> bytes{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+            inputs.push_back(ParseFuzzInput(bytes.data(), bytes.size()));
+        }
+    } while (FindNextFileW(hFind.get(), &findData));
+
+    wprintf(L"Replaying %zu inputs %zu times...\r\n", inputs.size(), iterations);
+
+    struct EngineResult
+    {
+        const wchar_t* name;
+        size_t bytes;
+        std::chrono::nanoseconds elapsed;
+        size_t hash;
+    };
+    EngineResult results[] = { { L"output", 0, {}, 0 }, { L"input", 0, {}, 0 } };
+
+    for (size_t i = 0; i < iterations; i++)
+    {
+        for (const auto& input : inputs)
+        {
+            EngineResult& result = results[input.engine == FuzzEngine::Input ? 1 : 0];
+            const auto start = std::chrono::steady_clock::now();
+            const DispatchRecord record = RunParser(input);
+            result.elapsed += std::chrono::steady_clock::now() - start;
+            result.bytes += input.text.size() * sizeof(wchar_t);
+            result.hash ^= record.hash;
+        }
+    }
+
+    for (const auto& result : results)
+    {
+        const double seconds = std::chrono::duration<double>(result.elapsed).count();
+        const double megabytes = result.bytes / (1024.0 * 1024.0);
+        wprintf(L"%s engine: %.2f MB in %.3f s, %.2f MB/s (hash %zx)\r\n",
+                result.name,
+                megabytes,
+                seconds,
+                seconds > 0 ? megabytes / seconds : 0.0,
+                result.hash);
+    }
+
+    return 0;
+}
+
 int __cdecl wmain(int argc, wchar_t* argv[])
 {
     int ret = 0;
 
-    if (argc != 3)
+    if ((argc == 3 || argc == 4) && wcscmp(argv[1], L"-corpus") == 0)
+    {
+        const size_t iterations = argc == 4 ? static_cast<size_t>((std::max)(_wtoi(argv[3]), 1)) : 1;
+        ret = RunCorpus(argv[2], iterations);
+    }
+    else if (argc != 3)
     {
         PrintUsage();
         ret = E_INVALIDARG;
@@ -79,3 +166,5 @@ int __cdecl wmain(int argc, wchar_t* argv[])
 
     return ret;
 }
+
+#endif // FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
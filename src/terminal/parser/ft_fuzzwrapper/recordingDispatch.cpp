@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "recordingDispatch.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+void DispatchRecord::Add(const wchar_t wch) noexcept
+{
+    chars++;
+    hash = (hash * 31) + wch;
+}
+
+RecordingDispatch::RecordingDispatch(DispatchRecord& record) noexcept :
+    _record(record)
+{
+}
+
+void RecordingDispatch::Print(const wchar_t wchPrintable)
+{
+    _record.Add(wchPrintable);
+}
+
+void RecordingDispatch::PrintString(const wchar_t* const rgwch, const size_t cch)
+{
+    for (size_t i = 0; i < cch; i++)
+    {
+        _record.Add(rgwch[i]);
+    }
+}
+
+void RecordingDispatch::Execute(const wchar_t wchControl)
+{
+    _record.controls++;
+    _record.hash = (_record.hash * 31) + wchControl;
+}
+
+RecordingInteractDispatch::RecordingInteractDispatch(DispatchRecord& record) noexcept :
+    _record(record)
+{
+}
+
+bool RecordingInteractDispatch::WriteInput(_In_ std::deque<std::unique_ptr<IInputEvent>>& inputEvents)
+{
+    _record.inputEvents += inputEvents.size();
+    for (const auto& event : inputEvents)
+    {
+        if (event->EventType() == InputEventType::KeyEvent)
+        {
+            _record.hash = (_record.hash * 31) + static_cast<const KeyEvent&>(*event).GetVirtualKeyCode();
+        }
+    }
+    return true;
+}
+
+bool RecordingInteractDispatch::WriteCtrlC()
+{
+    _record.controls++;
+    return true;
+}
+
+bool RecordingInteractDispatch::WriteString(_In_reads_(cch) const wchar_t* const pws, const size_t cch)
+{
+    for (size_t i = 0; i < cch; i++)
+    {
+        _record.Add(pws[i]);
+    }
+    return true;
+}
+
+bool RecordingInteractDispatch::WindowManipulation(const DispatchTypes::WindowManipulationType /*uiFunction*/,
+                                                   _In_reads_(cParams) const unsigned short* const /*rgusParams*/,
+                                                   const size_t /*cParams*/)
+{
+    _record.otherCalls++;
+    return true;
+}
+
+bool RecordingInteractDispatch::MoveCursor(const unsigned int /*row*/, const unsigned int /*col*/)
+{
+    _record.otherCalls++;
+    return true;
+}
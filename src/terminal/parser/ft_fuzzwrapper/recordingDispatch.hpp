@@ -0,0 +1,66 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- recordingDispatch.hpp
+
+Abstract:
+- Dispatches for the fuzz targets and the corpus benchmark. They don't act on
+    anything, they just keep a tally of what reached them, so that the parser's
+    output is consumed (and can be compared between runs) without the cost of
+    a real console getting in the way of the measurement.
+--*/
+#pragma once
+
+#include "../../adapter/termDispatch.hpp"
+#include "../../adapter/IInteractDispatch.hpp"
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    struct DispatchRecord
+    {
+        // Number of characters printed or written as input.
+        size_t chars;
+        // Number of control characters executed.
+        size_t controls;
+        // Number of input events written.
+        size_t inputEvents;
+        // Number of other calls that reached the dispatch.
+        size_t otherCalls;
+        // A running hash of the characters, to tell runs apart.
+        size_t hash;
+
+        void Add(const wchar_t wch) noexcept;
+    };
+
+    class RecordingDispatch final : public TermDispatch
+    {
+    public:
+        RecordingDispatch(DispatchRecord& record) noexcept;
+
+        void Print(const wchar_t wchPrintable) override;
+        void PrintString(const wchar_t* const rgwch, const size_t cch) override;
+        void Execute(const wchar_t wchControl) override;
+
+    private:
+        DispatchRecord& _record;
+    };
+
+    class RecordingInteractDispatch final : public IInteractDispatch
+    {
+    public:
+        RecordingInteractDispatch(DispatchRecord& record) noexcept;
+
+        bool WriteInput(_In_ std::deque<std::unique_ptr<IInputEvent>>& inputEvents) override;
+        bool WriteCtrlC() override;
+        bool WriteString(_In_reads_(cch) const wchar_t* const pws, const size_t cch) override;
+        bool WindowManipulation(const DispatchTypes::WindowManipulationType uiFunction,
+                                _In_reads_(cParams) const unsigned short* const rgusParams,
+                                const size_t cParams) override;
+        bool MoveCursor(const unsigned int row, const unsigned int col) override;
+
+    private:
+        DispatchRecord& _record;
+    };
+}
@@ -6,6 +6,7 @@
 #include "stateMachine.hpp"
 
 #include "ascii.hpp"
+#include "../../types/inc/ConsoleMetrics.hpp"
 
 using namespace Microsoft::Console::VirtualTerminal;
 
@@ -298,6 +299,7 @@ bool StateMachine::s_IsNumber(const wchar_t wch)
 void StateMachine::_ActionExecute(const wchar_t wch)
 {
     _trace.TraceOnExecute(wch);
+    Metrics::Add(Metrics::Counter::ParserExecute);
     _pEngine->ActionExecute(wch);
 }
 
@@ -312,6 +314,7 @@ void StateMachine::_ActionExecute(const wchar_t wch)
 void StateMachine::_ActionExecuteFromEscape(const wchar_t wch)
 {
     _trace.TraceOnExecuteFromEscape(wch);
+    Metrics::Add(Metrics::Counter::ParserExecute);
     _pEngine->ActionExecuteFromEscape(wch);
 }
 
@@ -324,6 +327,7 @@ void StateMachine::_ActionExecuteFromEscape(const wchar_t wch)
 void StateMachine::_ActionPrint(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Print");
+    Metrics::Add(Metrics::Counter::ParserPrintCharacters);
     _pEngine->ActionPrint(wch);
 }
 
@@ -337,6 +341,7 @@ void StateMachine::_ActionPrint(const wchar_t wch)
 void StateMachine::_ActionEscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"EscDispatch");
+    Metrics::Add(Metrics::Counter::ParserEscDispatch);
 
     bool fSuccess = _pEngine->ActionEscDispatch(wch, _cIntermediate, _wchIntermediate);
 
@@ -360,6 +365,7 @@ void StateMachine::_ActionEscDispatch(const wchar_t wch)
 void StateMachine::_ActionCsiDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"CsiDispatch");
+    Metrics::Add(Metrics::Counter::ParserCsiDispatch);
 
     bool fSuccess = _pEngine->ActionCsiDispatch(wch, _cIntermediate, _wchIntermediate, _rgusParams, _cParams);
 
@@ -581,6 +587,7 @@ void StateMachine::_ActionOscPut(const wchar_t wch)
 void StateMachine::_ActionOscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscDispatch");
+    Metrics::Add(Metrics::Counter::ParserOscDispatch);
 
     bool fSuccess = _pEngine->ActionOscDispatch(wch, _sOscParam, _pwchOscStringBuffer, _sOscNextChar);
 
@@ -604,6 +611,7 @@ void StateMachine::_ActionOscDispatch(const wchar_t wch)
 void StateMachine::_ActionSs3Dispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Ss3Dispatch");
+    Metrics::Add(Metrics::Counter::ParserSs3Dispatch);
 
     bool fSuccess = _pEngine->ActionSs3Dispatch(wch, _rgusParams, _cParams);
 
@@ -1346,6 +1354,8 @@ void StateMachine::ProcessString(const wchar_t* const rgwch, const size_t cch)
     _pwchSequenceStart = rgwch;
     _currRunLength = 0;
 
+    Metrics::Add(Metrics::Counter::ParserCharacters, cch);
+
     // This should be static, because if one string starts a sequence, and the next finishes it,
     //   we want the partial sequence state to persist.
     static bool s_fProcessIndividually = false;
@@ -1371,6 +1381,8 @@ void StateMachine::ProcessString(const wchar_t* const rgwch, const size_t cch)
                 FAIL_FAST_IF(!(_pwchSequenceStart + _currRunLength <= rgwch + cch));
                 _pEngine->ActionPrintString(_pwchSequenceStart, _currRunLength); // ... print all the chars leading up to it as part of the run...
                 _trace.DispatchPrintRunTrace(_pwchSequenceStart, _currRunLength);
+                Metrics::Add(Metrics::Counter::ParserPrintRuns);
+                Metrics::Add(Metrics::Counter::ParserPrintCharacters, _currRunLength);
                 s_fProcessIndividually = true; // begin processing future characters individually...
                 _currRunLength = 0;
                 _pwchSequenceStart = _pwchCurr;
@@ -1396,6 +1408,8 @@ void StateMachine::ProcessString(const wchar_t* const rgwch, const size_t cch)
         // print the rest of the characters in the string
         _pEngine->ActionPrintString(_pwchSequenceStart, _currRunLength);
         _trace.DispatchPrintRunTrace(_pwchSequenceStart, _currRunLength);
+        Metrics::Add(Metrics::Counter::ParserPrintRuns);
+        Metrics::Add(Metrics::Counter::ParserPrintCharacters, _currRunLength);
     }
     else if (s_fProcessIndividually)
     {
@@ -1413,27 +1427,36 @@ void StateMachine::ProcessString(const wchar_t* const rgwch, const size_t cch)
             switch (_state)
             {
             case VTStates::Ground:
-                return _ActionExecute(*pwch);
+                _ActionExecute(*pwch);
+                break;
             case VTStates::Escape:
             case VTStates::EscapeIntermediate:
-                return _ActionEscDispatch(*pwch);
+                _ActionEscDispatch(*pwch);
+                break;
             case VTStates::CsiEntry:
             case VTStates::CsiIntermediate:
             case VTStates::CsiIgnore:
             case VTStates::CsiParam:
-                return _ActionCsiDispatch(*pwch);
+                _ActionCsiDispatch(*pwch);
+                break;
             case VTStates::OscParam:
             case VTStates::OscString:
             case VTStates::OscTermination:
-                return _ActionOscDispatch(*pwch);
+                _ActionOscDispatch(*pwch);
+                break;
             case VTStates::Ss3Entry:
             case VTStates::Ss3Param:
-                return _ActionSs3Dispatch(*pwch);
+                _ActionSs3Dispatch(*pwch);
+                break;
             default:
-                return;
+                break;
             }
         }
     }
+
+    // Let the engine know that this is all there is for now, in case it's
+    //      holding on to anything.
+    _pEngine->ActionEndOfString();
 }
 
 void StateMachine::ProcessString(const std::wstring& wstr)
@@ -16,6 +16,7 @@
 #include <sstream>
 #include <string>
 #include <algorithm>
+#include <chrono>
 
 #ifdef BUILD_ONECORE_INTERACTIVITY
 #include "../../../interactivity/inc/VtApiRedirection.hpp"
@@ -230,6 +231,9 @@ class Microsoft::Console::VirtualTerminal::InputEngineTest
     TEST_METHOD(AltBackspaceTest);
     TEST_METHOD(AltCtrlDTest);
     TEST_METHOD(AltIntermediateTest);
+    TEST_METHOD(RepeatedKeysKeepEveryRecordTest);
+    TEST_METHOD(BatchingKeepsInputInOrderTest);
+    TEST_METHOD(KeyRepeatStormBenchmark);
 
     friend class TestInteractDispatch;
 };
@@ -826,3 +830,152 @@ void InputEngineTest::AltIntermediateTest()
     Log::Comment(NoThrowString().Format(L"Processing \"\\x05\""));
     stateMachine->ProcessString(seq);
 }
+
+void InputEngineTest::RepeatedKeysKeepEveryRecordTest()
+{
+    TestState testState;
+    std::vector<std::vector<INPUT_RECORD>> batches;
+    auto pfn = [&](std::deque<std::unique_ptr<IInputEvent>>& inEvents) {
+        batches.push_back(IInputEvent::ToInputRecords(inEvents));
+    };
+
+    auto inputEngine = std::make_unique<InputStateMachineEngine>(new TestInteractDispatch(pfn, &testState));
+    auto _stateMachine = std::make_unique<StateMachine>(inputEngine.release());
+    VERIFY_IS_NOT_NULL(_stateMachine);
+    testState._stateMachine = _stateMachine.get();
+
+    // A client reading raw input records has to see a key down and a key up
+    // for every keypress, in order, just like it would from the keyboard.
+    const auto verifyKeypresses = [](const std::vector<INPUT_RECORD>& records, const WORD vkey, const size_t expected) {
+        size_t keyDowns = 0;
+        bool lastWasDown = false;
+        for (const auto& record : records)
+        {
+            VERIFY_ARE_EQUAL(KEY_EVENT, record.EventType);
+            VERIFY_ARE_EQUAL(1, record.Event.KeyEvent.wRepeatCount);
+            if (record.Event.KeyEvent.wVirtualKeyCode != vkey)
+            {
+                continue;
+            }
+
+            const bool isDown = !!record.Event.KeyEvent.bKeyDown;
+            VERIFY_ARE_NOT_EQUAL(lastWasDown, isDown);
+            lastWasDown = isDown;
+            if (isDown)
+            {
+                keyDowns++;
+            }
+        }
+        VERIFY_IS_FALSE(lastWasDown);
+        VERIFY_ARE_EQUAL(expected, keyDowns);
+    };
+
+    Log::Comment(L"Three presses of the up arrow should be written as three key downs, each followed by its key up.");
+    _stateMachine->ProcessString(L"\x1b[A\x1b[A\x1b[A");
+    VERIFY_ARE_EQUAL(1u, batches.size());
+    VERIFY_ARE_EQUAL(6u, batches[0].size());
+    verifyKeypresses(batches[0], VK_UP, 3);
+
+    Log::Comment(L"A held shift+up should press and release shift around every up arrow.");
+    batches.clear();
+    _stateMachine->ProcessString(L"\x1b[1;2A\x1b[1;2A");
+    VERIFY_ARE_EQUAL(1u, batches.size());
+    VERIFY_ARE_EQUAL(8u, batches[0].size());
+    verifyKeypresses(batches[0], VK_UP, 2);
+    verifyKeypresses(batches[0], VK_SHIFT, 2);
+
+    Log::Comment(L"Repeated control characters are written as separate keypresses too.");
+    batches.clear();
+    _stateMachine->ProcessString(L"\t\t\t");
+    VERIFY_ARE_EQUAL(1u, batches.size());
+    VERIFY_ARE_EQUAL(6u, batches[0].size());
+    verifyKeypresses(batches[0], VK_TAB, 3);
+
+    const auto metrics = static_cast<InputStateMachineEngine&>(_stateMachine->Engine()).GetMetrics();
+    VERIFY_ARE_EQUAL(8u, metrics.keypresses);
+    VERIFY_ARE_EQUAL(3u, metrics.batchesWritten);
+    VERIFY_ARE_EQUAL(20u, metrics.recordsWritten);
+}
+
+void InputEngineTest::BatchingKeepsInputInOrderTest()
+{
+    TestState testState;
+    std::vector<std::vector<INPUT_RECORD>> batches;
+    auto pfn = [&](std::deque<std::unique_ptr<IInputEvent>>& inEvents) {
+        batches.push_back(IInputEvent::ToInputRecords(inEvents));
+    };
+
+    auto inputEngine = std::make_unique<InputStateMachineEngine>(new TestInteractDispatch(pfn, &testState));
+    auto _stateMachine = std::make_unique<StateMachine>(inputEngine.release());
+    VERIFY_IS_NOT_NULL(_stateMachine);
+    testState._stateMachine = _stateMachine.get();
+
+    Log::Comment(L"Keys before and after a run of text must be written around it, not batched across it.");
+    _stateMachine->ProcessString(L"\x1b[Aabc\x1b[A");
+    VERIFY_ARE_EQUAL(3u, batches.size());
+    VERIFY_ARE_EQUAL(VK_UP, batches[0][0].Event.KeyEvent.wVirtualKeyCode);
+    VERIFY_ARE_EQUAL(1, batches[0][0].Event.KeyEvent.wRepeatCount);
+    VERIFY_ARE_EQUAL(L'a', batches[1][0].Event.KeyEvent.uChar.UnicodeChar);
+    VERIFY_ARE_EQUAL(VK_UP, batches[2][0].Event.KeyEvent.wVirtualKeyCode);
+    VERIFY_ARE_EQUAL(1, batches[2][0].Event.KeyEvent.wRepeatCount);
+
+    Log::Comment(L"Nothing is held over from one string to the next.");
+    batches.clear();
+    _stateMachine->ProcessString(L"\x1b[A");
+    _stateMachine->ProcessString(L"\x1b[A");
+    VERIFY_ARE_EQUAL(2u, batches.size());
+    VERIFY_ARE_EQUAL(1, batches[1][0].Event.KeyEvent.wRepeatCount);
+}
+
+void InputEngineTest::KeyRepeatStormBenchmark()
+{
+    Log::Comment(L"Replays a storm of held arrow keys, the way a terminal sends them, "
+                 L"in reads of up to 128 characters like the VtInputThread does. "
+                 L"Logs the time taken and the batching counters as a benchmark.");
+
+    TestState testState;
+    size_t recordsWritten = 0;
+    auto pfn = [&](std::deque<std::unique_ptr<IInputEvent>>& inEvents) {
+        recordsWritten += inEvents.size();
+    };
+
+    auto inputEngine = std::make_unique<InputStateMachineEngine>(new TestInteractDispatch(pfn, &testState));
+    auto _stateMachine = std::make_unique<StateMachine>(inputEngine.release());
+    VERIFY_IS_NOT_NULL(_stateMachine);
+    testState._stateMachine = _stateMachine.get();
+
+    // Hold each direction for a while, like someone scrolling around in an
+    // editor, with the occasional modified key thrown in.
+    const std::wstring_view keys[] = { L"\x1b[A", L"\x1b[B", L"\x1b[C", L"\x1b[D", L"\x1b[1;5C", L"\x1b[6~" };
+    // Reads are cut at key boundaries, so that no sequence is split between two of them.
+    const size_t readSize = 128;
+    std::vector<std::wstring> reads(1);
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        const auto& key = keys[(i / 40) % ARRAYSIZE(keys)];
+        if (reads.back().size() + key.size() > readSize)
+        {
+            reads.emplace_back();
+        }
+        reads.back().append(key);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& read : reads)
+    {
+        _stateMachine->ProcessString(read);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto metrics = static_cast<InputStateMachineEngine&>(_stateMachine->Engine()).GetMetrics();
+    VERIFY_ARE_EQUAL(recordsWritten, metrics.recordsWritten);
+
+    Log::Comment(NoThrowString().Format(L"%zu keypresses written as %zu records in %zu batches in %lldus",
+                                        metrics.keypresses,
+                                        metrics.recordsWritten,
+                                        metrics.batchesWritten,
+                                        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    Log::Comment(NoThrowString().Format(L"batch latency: %lldus total, %lldus peak",
+                                        metrics.totalBatchLatency.count(),
+                                        metrics.peakBatchLatency.count()));
+}
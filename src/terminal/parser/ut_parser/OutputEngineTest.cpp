@@ -9,6 +9,7 @@
 #include "OutputStateMachineEngine.hpp"
 
 #include "ascii.hpp"
+#include "../../../types/inc/ConsoleMetrics.hpp"
 
 using namespace Microsoft::Console::VirtualTerminal;
 
@@ -595,6 +596,23 @@ class Microsoft::Console::VirtualTerminal::OutputEngineTest final
         mach.ProcessCharacter(L'J');
         VERIFY_ARE_EQUAL(mach._state, StateMachine::VTStates::Ground);
     }
+
+    TEST_METHOD(TestPrintMetricsCountRunsAndCharacters)
+    {
+        using namespace Microsoft::Console::Metrics;
+
+        StateMachine mach(new OutputStateMachineEngine(new DummyDispatch));
+
+        // Two runs, either side of the sequence, and then one character on its own.
+        const auto before = TakeSnapshot();
+        const std::wstring_view runs{ L"abc\x1b[mdefg" };
+        mach.ProcessString(runs.data(), runs.size());
+        mach.ProcessCharacter(L'h');
+        const auto after = TakeSnapshot();
+
+        VERIFY_ARE_EQUAL(2ull, after.Get(Counter::ParserPrintRuns) - before.Get(Counter::ParserPrintRuns));
+        VERIFY_ARE_EQUAL(8ull, after.Get(Counter::ParserPrintCharacters) - before.Get(Counter::ParserPrintCharacters));
+    }
 };
 
 class StatefulDispatch final : public TermDispatch
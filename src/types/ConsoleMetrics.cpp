@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "inc/ConsoleMetrics.hpp"
+
+using namespace Microsoft::Console::Metrics;
+using namespace Microsoft::Console::Metrics::details;
+
+namespace
+{
+    // Every thread that has recorded something, and the totals of the ones
+    // that have since exited.
+    struct Registry
+    {
+        std::mutex lock;
+        std::vector<const ThreadMetrics*> threads;
+        Snapshot retired{};
+    };
+
+    // Threads can exit (and unregister) while the process is shutting down,
+    // so the registry is deliberately never destroyed.
+    Registry& GetRegistry()
+    {
+        static Registry* const registry = new Registry();
+        return *registry;
+    }
+}
+
+// Routine Description:
+// - Registers this thread's counters, so that snapshots include them.
+// Note:
+// - If registering fails, the thread's counts are silently left out of
+//   snapshots. Metrics are never worth failing the caller for.
+ThreadMetrics::ThreadMetrics() noexcept
+{
+    try
+    {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock{ registry.lock };
+        registry.threads.push_back(this);
+    }
+    CATCH_LOG();
+}
+
+// Routine Description:
+// - Folds this thread's counts into the retired totals and unregisters it.
+ThreadMetrics::~ThreadMetrics()
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock{ registry.lock };
+    const auto it = std::find(registry.threads.begin(), registry.threads.end(), this);
+    if (it != registry.threads.end())
+    {
+        registry.threads.erase(it);
+        AddTo(registry.retired);
+    }
+}
+
+// Routine Description:
+// - Adds this thread's counts to a snapshot.
+// Arguments:
+// - snapshot - the snapshot to add to
+void ThreadMetrics::AddTo(Snapshot& snapshot) const noexcept
+{
+    for (size_t i = 0; i < CounterCount; ++i)
+    {
+        snapshot.counters[i] += _counters[i].load(std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < HistogramCount; ++i)
+    {
+        const auto& data = _histograms[i];
+        auto& total = snapshot.histograms[i];
+        total.count += data.count.load(std::memory_order_relaxed);
+        total.sum += data.sum.load(std::memory_order_relaxed);
+        for (size_t bucket = 0; bucket < HistogramBucketCount; ++bucket)
+        {
+            total.buckets[bucket] += data.buckets[bucket].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Routine Description:
+// - Adds up everything recorded so far, by every thread. Threads that are
+//   recording while this runs may or may not have their latest few values
+//   included, and a histogram's count, sum and buckets are each read
+//   separately, so they can be momentarily out of step with each other.
+// Return Value:
+// - the totals
+Snapshot Microsoft::Console::Metrics::TakeSnapshot()
+{
+    Snapshot snapshot{};
+    if constexpr (Enabled)
+    {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock{ registry.lock };
+        snapshot = registry.retired;
+        for (const auto thread : registry.threads)
+        {
+            thread->AddTo(snapshot);
+        }
+    }
+    return snapshot;
+}
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "inc/DelimiterClassTable.hpp"
+#include "../inc/unicode.hpp"
+
+using namespace Microsoft::Console::Types;
+
+// Routine Description:
+// - Creates a table where the space is the only delimiter.
+DelimiterClassTable::DelimiterClassTable() :
+    DelimiterClassTable(std::wstring_view{})
+{
+}
+
+// Routine Description:
+// - Creates a table for the given delimiters. The space character is always
+//   a delimiter, whether or not it's in the list.
+// Arguments:
+// - delimiters - the user configured word delimiters
+// Note:
+// - will throw if the table couldn't be allocated
+DelimiterClassTable::DelimiterClassTable(const std::wstring_view delimiters) :
+    _table(size_t{ std::numeric_limits<wchar_t>::max() } + 1, CharClass::Word)
+{
+    for (const auto wch : delimiters)
+    {
+        _table.at(wch) = CharClass::Delimiter;
+    }
+    _table.at(UNICODE_SPACE) = CharClass::Space;
+}
+
+// Routine Description:
+// - Gets the character class of the given code unit.
+DelimiterClassTable::CharClass DelimiterClassTable::ClassOf(const wchar_t wch) const noexcept
+{
+    return _table[wch];
+}
+
+// Routine Description:
+// - Returns true if the code unit ends a word. That's a space or a delimiter.
+bool DelimiterClassTable::IsDelimiter(const wchar_t wch) const noexcept
+{
+    return ClassOf(wch) != CharClass::Word;
+}
+
+// Routine Description:
+// - Finds the word around a position in a row of text. The word runs left
+//   from position until just after a delimiter, and right from position until
+//   (not including) a delimiter. If position is on a delimiter, that means the
+//   word ends there and only extends to the left of it.
+// Arguments:
+// - text - the row of text. Each code unit is one column.
+// - position - where to look for a word. Clamped to the end of the text.
+// Return Value:
+// - the columns of the word, as a half-open range [first, second)
+std::pair<size_t, size_t> DelimiterClassTable::FindWord(const std::wstring_view text, const size_t position) const noexcept
+{
+    const size_t clamped = std::min(position, text.size());
+
+    size_t start = clamped;
+    while (start > 0 && !IsDelimiter(text[start - 1]))
+    {
+        --start;
+    }
+
+    size_t end = clamped;
+    while (end < text.size() && !IsDelimiter(text[end]))
+    {
+        ++end;
+    }
+
+    return { start, end };
+}
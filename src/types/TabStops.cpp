@@ -0,0 +1,193 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "inc/TabStops.hpp"
+
+using namespace Microsoft::Console::Types;
+
+TabStops::TabStops() noexcept :
+    _words{},
+    _count{ 0 }
+{
+}
+
+// Routine Description:
+// - Sets a tab stop in the given column. Does nothing if there already is one.
+// Arguments:
+// - column - the column to set a stop in
+// Note:
+// - will throw if the set needed to grow and couldn't
+void TabStops::Set(const size_t column)
+{
+    _Reserve(column);
+
+    auto& word = _words.at(column / _bitsPerWord);
+    const uint32_t bit = 1u << (column % _bitsPerWord);
+    if (WI_IsAnyFlagClear(word, bit))
+    {
+        word |= bit;
+        ++_count;
+    }
+}
+
+// Routine Description:
+// - Clears the tab stop in the given column, if there is one.
+// Arguments:
+// - column - the column to clear the stop from
+void TabStops::Clear(const size_t column) noexcept
+{
+    const auto index = column / _bitsPerWord;
+    if (index < _words.size())
+    {
+        auto& word = _words[index];
+        const uint32_t bit = 1u << (column % _bitsPerWord);
+        if (WI_IsAnyFlagSet(word, bit))
+        {
+            word &= ~bit;
+            --_count;
+        }
+    }
+}
+
+// Routine Description:
+// - Clears every tab stop.
+void TabStops::ClearAll() noexcept
+{
+    std::fill(_words.begin(), _words.end(), 0u);
+    _count = 0;
+}
+
+// Routine Description:
+// - Sets a stop every interval columns, starting at the first multiple of
+//   interval that is at or after start and stopping before end.
+// - Stops that are already set are kept.
+// Arguments:
+// - interval - the distance between stops. Must not be 0.
+// - start - the first column that may get a stop
+// - end - the column after the last one that may get a stop
+// Note:
+// - will throw if the set needed to grow and couldn't
+void TabStops::SetEvery(const size_t interval, const size_t start, const size_t end)
+{
+    FAIL_FAST_IF(interval == 0);
+    if (start >= end)
+    {
+        return;
+    }
+
+    _Reserve(end - 1);
+
+    const auto first = (start + interval - 1) / interval * interval;
+    for (auto column = first; column < end; column += interval)
+    {
+        auto& word = _words[column / _bitsPerWord];
+        const uint32_t bit = 1u << (column % _bitsPerWord);
+        if (WI_IsAnyFlagClear(word, bit))
+        {
+            word |= bit;
+            ++_count;
+        }
+    }
+}
+
+// Routine Description:
+// - Returns true if there is a tab stop in the given column.
+bool TabStops::IsSet(const size_t column) const noexcept
+{
+    const auto index = column / _bitsPerWord;
+    return index < _words.size() && WI_IsAnyFlagSet(_words[index], 1u << (column % _bitsPerWord));
+}
+
+// Routine Description:
+// - Returns true if any tab stop is set.
+bool TabStops::Any() const noexcept
+{
+    return _count != 0;
+}
+
+// Routine Description:
+// - Finds the first tab stop to the right of the given column.
+// Arguments:
+// - column - the column to start looking after
+// Return Value:
+// - the column of the stop, or nullopt if there is no stop after column.
+std::optional<size_t> TabStops::Next(const size_t column) const noexcept
+{
+    const auto start = column + 1;
+    auto index = start / _bitsPerWord;
+    if (index >= _words.size())
+    {
+        return std::nullopt;
+    }
+
+    // Ignore the stops at or before column in the first word we look at.
+    const auto shift = start % _bitsPerWord;
+    uint32_t word = _words[index] & (~0u << shift);
+    for (;;)
+    {
+        unsigned long bit;
+        if (_BitScanForward(&bit, word))
+        {
+            return index * _bitsPerWord + bit;
+        }
+
+        if (++index >= _words.size())
+        {
+            return std::nullopt;
+        }
+        word = _words[index];
+    }
+}
+
+// Routine Description:
+// - Finds the first tab stop to the left of the given column.
+// Arguments:
+// - column - the column to start looking before
+// Return Value:
+// - the column of the stop, or nullopt if there is no stop before column.
+std::optional<size_t> TabStops::Previous(const size_t column) const noexcept
+{
+    if (column == 0 || _words.empty())
+    {
+        return std::nullopt;
+    }
+
+    // Start from the column right before this one, or from the last column
+    // we store if column is beyond that.
+    const auto last = std::min(column - 1, _words.size() * _bitsPerWord - 1);
+    auto index = last / _bitsPerWord;
+
+    // Ignore the stops after that column in the first word we look at.
+    const auto shift = _bitsPerWord - 1 - (last % _bitsPerWord);
+    uint32_t word = _words[index] & (~0u >> shift);
+    for (;;)
+    {
+        unsigned long bit;
+        if (_BitScanReverse(&bit, word))
+        {
+            return index * _bitsPerWord + bit;
+        }
+
+        if (index == 0)
+        {
+            return std::nullopt;
+        }
+        word = _words[--index];
+    }
+}
+
+// Routine Description:
+// - Grows the set so that it can hold a stop in the given column.
+// Arguments:
+// - column - the column that needs to fit
+// Note:
+// - will throw on allocation failure
+void TabStops::_Reserve(const size_t column)
+{
+    const auto needed = column / _bitsPerWord + 1;
+    if (needed > _words.size())
+    {
+        _words.resize(needed, 0u);
+    }
+}
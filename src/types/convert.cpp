@@ -16,6 +16,7 @@
 // runtime without breaking compatibility?
 static const WORD altScanCode = 0x38;
 static const WORD leftShiftScanCode = 0x2A;
+static const short invalidKey = -1;
 
 // Routine Description:
 // - Takes a multibyte string, allocates the appropriate amount of memory for the conversion, performs the conversion,
@@ -132,10 +133,16 @@ static const WORD leftShiftScanCode = 0x2A;
     return cchTarget;
 }
 
-std::deque<std::unique_ptr<KeyEvent>> CharToKeyEvents(const wchar_t wch,
-                                                      const unsigned int codepage)
+// Routine Description:
+// - Gets the VkKeyScan result for the key that types wch on the current
+//   keyboard layout.
+// Arguments:
+// - wch - the character to look up
+// Return Value:
+// - the virtual key in the low byte and the modifier state in the high byte,
+//   or invalidKey if the character has to be typed with alt+numpad
+static short _CharToKeyState(const wchar_t wch) noexcept
 {
-    const short invalidKey = -1;
     short keyState = VkKeyScanW(wch);
 
     if (keyState == invalidKey)
@@ -152,6 +159,46 @@ std::deque<std::unique_ptr<KeyEvent>> CharToKeyEvents(const wchar_t wch,
         }
     }
 
+    return keyState;
+}
+
+// Routine Description:
+// - Creates the key down event for the key that types wch, with the
+//   modifiers that need to be held for it.
+// Arguments:
+// - wch - the character
+// - keyState - the VkKeyScan result for wch
+// Return Value:
+// - the key down event
+static KeyEvent _MakeCharKeyEvent(const wchar_t wch, const short keyState) noexcept
+{
+    const byte modifierState = HIBYTE(keyState);
+
+    const WORD virtualScanCode = gsl::narrow_cast<WORD>(MapVirtualKeyW(wch, MAPVK_VK_TO_VSC));
+    KeyEvent keyEvent{ true, 1, LOBYTE(keyState), virtualScanCode, wch, 0 };
+
+    // add modifier flags if necessary
+    if (WI_IsFlagSet(modifierState, VkKeyScanModState::ShiftPressed))
+    {
+        keyEvent.ActivateModifierKey(ModifierKeyState::Shift);
+    }
+    if (WI_IsFlagSet(modifierState, VkKeyScanModState::CtrlPressed))
+    {
+        keyEvent.ActivateModifierKey(ModifierKeyState::LeftCtrl);
+    }
+    if (WI_AreAllFlagsSet(modifierState, VkKeyScanModState::CtrlAndAltPressed))
+    {
+        keyEvent.ActivateModifierKey(ModifierKeyState::RightAlt);
+    }
+
+    return keyEvent;
+}
+
+std::deque<std::unique_ptr<KeyEvent>> CharToKeyEvents(const wchar_t wch,
+                                                      const unsigned int codepage)
+{
+    const short keyState = _CharToKeyState(wch);
+
     std::deque<std::unique_ptr<KeyEvent>> convertedEvents;
     if (keyState == invalidKey)
     {
@@ -167,6 +214,62 @@ std::deque<std::unique_ptr<KeyEvent>> CharToKeyEvents(const wchar_t wch,
     return convertedEvents;
 }
 
+// Routine Description:
+// - Gets the one event out of those CharToKeyEvents would generate that a
+//   stream (ReadConsole/ReadFile) reader acts on: the key down that carries
+//   the character. Unlike CharToKeyEvents, this doesn't allocate.
+// - Characters that have to be typed with alt+numpad are reported as a key
+//   down without a virtual key, which reads back as the same character.
+// Arguments:
+// - wch - the character
+// Return Value:
+// - the key down event for wch
+KeyEvent CharToKeyDownEvent(const wchar_t wch) noexcept
+{
+    const short keyState = _CharToKeyState(wch);
+    if (keyState == invalidKey)
+    {
+        return KeyEvent{ true, 1, 0, 0, wch, 0 };
+    }
+    return _MakeCharKeyEvent(wch, keyState);
+}
+
+// Routine Description:
+// - Counts the events CharToKeyEvents would generate for a character,
+//   without generating them.
+// Arguments:
+// - wch - the character
+// - codepage - the codepage CharToKeyEvents would be given
+// Return Value:
+// - the number of key events that type wch
+size_t CharToKeyEventCount(const wchar_t wch, const unsigned int codepage) noexcept
+{
+    const short keyState = _CharToKeyState(wch);
+    if (keyState != invalidKey)
+    {
+        // The key down and up, plus a down and up for shift or AltGr if
+        // either is needed. See SynthesizeKeyboardEvents.
+        const byte modifierState = HIBYTE(keyState);
+        const bool needsModifier = WI_AreAllFlagsSet(modifierState, VkKeyScanModState::CtrlAndAltPressed) ||
+                                   WI_IsFlagSet(modifierState, VkKeyScanModState::ShiftPressed);
+        return needsModifier ? 4 : 2;
+    }
+
+    // Alt down and up, with a numpad key down and up for each digit of the
+    // character's value in the codepage, if it has a single byte one. See
+    // SynthesizeNumpadEvents.
+    char converted[4];
+    const int convertedLength = WideCharToMultiByte(codepage, 0, &wch, 1, converted, ARRAYSIZE(converted), nullptr, nullptr);
+    if (convertedLength != 1)
+    {
+        return 2;
+    }
+
+    const unsigned char uch = static_cast<unsigned char>(converted[0]);
+    const size_t digits = uch >= 100 ? 3 : (uch >= 10 ? 2 : 1);
+    return 2 + 2 * digits;
+}
+
 // Routine Description:
 // - converts a wchar_t into a series of KeyEvents as if it was typed
 // using the keyboard
@@ -206,22 +309,7 @@ std::deque<std::unique_ptr<KeyEvent>> SynthesizeKeyboardEvents(const wchar_t wch
                                                        SHIFT_PRESSED));
     }
 
-    const WORD virtualScanCode = gsl::narrow<WORD>(MapVirtualKeyW(wch, MAPVK_VK_TO_VSC));
-    KeyEvent keyEvent{ true, 1, LOBYTE(keyState), virtualScanCode, wch, 0 };
-
-    // add modifier flags if necessary
-    if (WI_IsFlagSet(modifierState, VkKeyScanModState::ShiftPressed))
-    {
-        keyEvent.ActivateModifierKey(ModifierKeyState::Shift);
-    }
-    if (WI_IsFlagSet(modifierState, VkKeyScanModState::CtrlPressed))
-    {
-        keyEvent.ActivateModifierKey(ModifierKeyState::LeftCtrl);
-    }
-    if (WI_AreAllFlagsSet(modifierState, VkKeyScanModState::CtrlAndAltPressed))
-    {
-        keyEvent.ActivateModifierKey(ModifierKeyState::RightAlt);
-    }
+    KeyEvent keyEvent = _MakeCharKeyEvent(wch, keyState);
 
     // add key event down and up
     keyEvents.push_back(std::make_unique<KeyEvent>(keyEvent));
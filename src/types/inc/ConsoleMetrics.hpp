@@ -0,0 +1,199 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- ConsoleMetrics.hpp
+
+Abstract:
+- In-process counters and histograms for the parser, the text buffer and the
+  renderers, that can be read back at any time with TakeSnapshot. Unlike the
+  ETW tracing, they don't need a trace session (or Windows) to be useful.
+- Every thread records into its own block of counters, so recording is a
+  plain load and store with no locks and no shared cache lines. A lock is
+  only taken when a thread records for the first time, when it exits (its
+  counts are folded into a total for retired threads), and for a snapshot.
+- Defining CONSOLE_METRICS_DISABLED compiles all of it down to nothing.
+--*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace Microsoft::Console::Metrics
+{
+#ifdef CONSOLE_METRICS_DISABLED
+    static constexpr bool Enabled = false;
+#else
+    static constexpr bool Enabled = true;
+#endif
+
+    enum class Counter : size_t
+    {
+        ParserCharacters, // characters given to the VT state machine
+        ParserExecute, // C0 controls executed
+        ParserPrintRuns, // runs of printable characters dispatched together
+        ParserPrintCharacters, // printable characters dispatched, in runs or one at a time
+        ParserEscDispatch,
+        ParserCsiDispatch,
+        ParserOscDispatch,
+        ParserSs3Dispatch,
+        BufferRowsWritten, // rows that had cells written into them
+        BufferCircularIncrements, // times the text buffer scrolled its circular storage
+        RenderFrames, // frames painted, counted once per engine
+        VtBytesEmitted, // bytes written out by the VT renderer
+        Count
+    };
+
+    enum class Histogram : size_t
+    {
+        RenderPaintMicroseconds, // time to paint one frame on one engine
+        RenderDirtyCells, // cells in the dirty area of one frame
+        Count
+    };
+
+    static constexpr size_t CounterCount = static_cast<size_t>(Counter::Count);
+    static constexpr size_t HistogramCount = static_cast<size_t>(Histogram::Count);
+
+    // Bucket 0 holds zeroes, and bucket n holds values in [2^(n-1), 2^n).
+    static constexpr size_t HistogramBucketCount = 65;
+
+    struct HistogramSnapshot
+    {
+        uint64_t count;
+        uint64_t sum;
+        std::array<uint64_t, HistogramBucketCount> buckets;
+    };
+
+    struct Snapshot
+    {
+        std::array<uint64_t, CounterCount> counters;
+        std::array<HistogramSnapshot, HistogramCount> histograms;
+
+        uint64_t Get(const Counter counter) const noexcept
+        {
+            return counters[static_cast<size_t>(counter)];
+        }
+
+        const HistogramSnapshot& Get(const Histogram histogram) const noexcept
+        {
+            return histograms[static_cast<size_t>(histogram)];
+        }
+    };
+
+    // Returns the totals of everything recorded so far, across all threads.
+    Snapshot TakeSnapshot();
+
+    namespace details
+    {
+        // The counters for one thread. Only the owning thread writes to them,
+        // so an increment doesn't need an atomic read-modify-write; they're
+        // atomic only so that a snapshot can read them while they change.
+        class ThreadMetrics final
+        {
+        public:
+            ThreadMetrics() noexcept;
+            ~ThreadMetrics();
+
+            ThreadMetrics(const ThreadMetrics&) = delete;
+            ThreadMetrics& operator=(const ThreadMetrics&) = delete;
+
+            void Add(const Counter counter, const uint64_t amount) noexcept
+            {
+                _Bump(_counters[static_cast<size_t>(counter)], amount);
+            }
+
+            void Record(const Histogram histogram, const uint64_t value) noexcept
+            {
+                auto& data = _histograms[static_cast<size_t>(histogram)];
+                _Bump(data.count, 1);
+                _Bump(data.sum, value);
+                _Bump(data.buckets[_BucketOf(value)], 1);
+            }
+
+            void AddTo(Snapshot& snapshot) const noexcept;
+
+        private:
+            struct HistogramData
+            {
+                std::atomic<uint64_t> count;
+                std::atomic<uint64_t> sum;
+                std::array<std::atomic<uint64_t>, HistogramBucketCount> buckets;
+            };
+
+            static void _Bump(std::atomic<uint64_t>& value, const uint64_t amount) noexcept
+            {
+                value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+            }
+
+            static size_t _BucketOf(uint64_t value) noexcept
+            {
+                size_t bucket = 0;
+                while (value != 0)
+                {
+                    ++bucket;
+                    value >>= 1;
+                }
+                return bucket;
+            }
+
+            std::array<std::atomic<uint64_t>, CounterCount> _counters{};
+            std::array<HistogramData, HistogramCount> _histograms{};
+        };
+
+#ifndef CONSOLE_METRICS_DISABLED
+        inline thread_local ThreadMetrics t_threadMetrics;
+#endif
+    }
+
+    // Adds amount to a counter.
+    inline void Add([[maybe_unused]] const Counter counter, [[maybe_unused]] const uint64_t amount = 1) noexcept
+    {
+#ifndef CONSOLE_METRICS_DISABLED
+        details::t_threadMetrics.Add(counter, amount);
+#endif
+    }
+
+    // Adds one value to a histogram.
+    inline void Record([[maybe_unused]] const Histogram histogram, [[maybe_unused]] const uint64_t value) noexcept
+    {
+#ifndef CONSOLE_METRICS_DISABLED
+        details::t_threadMetrics.Record(histogram, value);
+#endif
+    }
+
+    // Records the time between its construction and destruction, in
+    // microseconds, into a histogram.
+    class ScopedTimer final
+    {
+    public:
+        explicit ScopedTimer([[maybe_unused]] const Histogram histogram) noexcept
+#ifndef CONSOLE_METRICS_DISABLED
+            :
+            _histogram{ histogram },
+            _start{ std::chrono::steady_clock::now() }
+#endif
+        {
+        }
+
+        ~ScopedTimer()
+        {
+#ifndef CONSOLE_METRICS_DISABLED
+            const auto elapsed = std::chrono::steady_clock::now() - _start;
+            Record(_histogram, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+#endif
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+#ifndef CONSOLE_METRICS_DISABLED
+        const Histogram _histogram;
+        const std::chrono::steady_clock::time_point _start;
+#endif
+    };
+}
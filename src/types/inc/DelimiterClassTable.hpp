@@ -0,0 +1,42 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- DelimiterClassTable.hpp
+
+Abstract:
+- Sorts every UTF-16 code unit into a character class for word selection:
+  part of a word, a space, or one of the configured delimiters.
+- The classes live in a table with one byte per code unit that is built once
+  from the delimiter list, so classifying a character is a single load and a
+  row of text can be scanned for a boundary in one pass.
+--*/
+
+#pragma once
+
+namespace Microsoft::Console::Types
+{
+    class DelimiterClassTable final
+    {
+    public:
+        enum class CharClass : uint8_t
+        {
+            Word,
+            Space,
+            Delimiter
+        };
+
+        DelimiterClassTable();
+        DelimiterClassTable(const std::wstring_view delimiters);
+
+        CharClass ClassOf(const wchar_t wch) const noexcept;
+        bool IsDelimiter(const wchar_t wch) const noexcept;
+
+        std::pair<size_t, size_t> FindWord(const std::wstring_view text, const size_t position) const noexcept;
+
+    private:
+        // Indexed by code unit.
+        std::vector<CharClass> _table;
+    };
+}
@@ -0,0 +1,47 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- TabStops.hpp
+
+Abstract:
+- A set of VT tab stops for one screen buffer.
+- Stops are kept as a bitset with one bit per column, so setting or clearing a
+  stop doesn't have to keep anything sorted, and finding the next or previous
+  stop only looks at one word for every 32 columns it skips over.
+--*/
+
+#pragma once
+
+namespace Microsoft::Console::Types
+{
+    class TabStops final
+    {
+    public:
+        TabStops() noexcept;
+
+        void Set(const size_t column);
+        void Clear(const size_t column) noexcept;
+        void ClearAll() noexcept;
+        void SetEvery(const size_t interval, const size_t start, const size_t end);
+
+        bool IsSet(const size_t column) const noexcept;
+        bool Any() const noexcept;
+
+        std::optional<size_t> Next(const size_t column) const noexcept;
+        std::optional<size_t> Previous(const size_t column) const noexcept;
+
+        // The distance between the stops a buffer starts out with.
+        static constexpr size_t DefaultInterval = 8;
+
+    private:
+        static constexpr size_t _bitsPerWord = 32;
+
+        void _Reserve(const size_t column);
+
+        // Bit n of word w is the stop for column w * 32 + n.
+        std::vector<uint32_t> _words;
+        size_t _count;
+    };
+}
@@ -37,6 +37,10 @@ enum class CodepointWidth : BYTE
 
 std::deque<std::unique_ptr<KeyEvent>> CharToKeyEvents(const wchar_t wch, const unsigned int codepage);
 
+KeyEvent CharToKeyDownEvent(const wchar_t wch) noexcept;
+
+size_t CharToKeyEventCount(const wchar_t wch, const unsigned int codepage) noexcept;
+
 std::deque<std::unique_ptr<KeyEvent>> SynthesizeKeyboardEvents(const wchar_t wch,
                                                                const short keyState);
 
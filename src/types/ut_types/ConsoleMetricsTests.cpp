@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "..\..\inc\consoletaeftemplates.hpp"
+
+#include "..\inc\ConsoleMetrics.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Metrics;
+
+class ConsoleMetricsTests
+{
+    TEST_CLASS(ConsoleMetricsTests);
+
+    // Other tests in the process may record too, so everything here is
+    // checked as the difference between two snapshots.
+
+    TEST_METHOD(CountersAddUp)
+    {
+        const auto before = TakeSnapshot();
+
+        Add(Counter::ParserCharacters, 10);
+        Add(Counter::ParserCharacters, 5);
+        Add(Counter::ParserCsiDispatch);
+
+        const auto after = TakeSnapshot();
+        VERIFY_ARE_EQUAL(15ull, after.Get(Counter::ParserCharacters) - before.Get(Counter::ParserCharacters));
+        VERIFY_ARE_EQUAL(1ull, after.Get(Counter::ParserCsiDispatch) - before.Get(Counter::ParserCsiDispatch));
+    }
+
+    TEST_METHOD(HistogramsBucketByPowerOfTwo)
+    {
+        const auto before = TakeSnapshot().Get(Histogram::RenderDirtyCells);
+
+        for (const uint64_t value : { 0ull, 1ull, 2ull, 3ull, 4ull, 1000ull })
+        {
+            Record(Histogram::RenderDirtyCells, value);
+        }
+
+        const auto after = TakeSnapshot().Get(Histogram::RenderDirtyCells);
+        VERIFY_ARE_EQUAL(6ull, after.count - before.count);
+        VERIFY_ARE_EQUAL(1010ull, after.sum - before.sum);
+
+        // 0 | 1 | 2, 3 | 4 | ... | 1000 is in [512, 1024)
+        VERIFY_ARE_EQUAL(1ull, after.buckets[0] - before.buckets[0]);
+        VERIFY_ARE_EQUAL(1ull, after.buckets[1] - before.buckets[1]);
+        VERIFY_ARE_EQUAL(2ull, after.buckets[2] - before.buckets[2]);
+        VERIFY_ARE_EQUAL(1ull, after.buckets[3] - before.buckets[3]);
+        VERIFY_ARE_EQUAL(1ull, after.buckets[10] - before.buckets[10]);
+    }
+
+    TEST_METHOD(ThreadsAreIncludedBeforeAndAfterTheyExit)
+    {
+        const auto before = TakeSnapshot();
+
+        std::atomic<bool> recorded{ false };
+        std::atomic<bool> exit{ false };
+        std::thread worker{ [&]() {
+            Add(Counter::VtBytesEmitted, 100);
+            recorded = true;
+            while (!exit)
+            {
+                std::this_thread::yield();
+            }
+        } };
+
+        while (!recorded)
+        {
+            std::this_thread::yield();
+        }
+
+        Log::Comment(L"A running thread's counts are in the snapshot.");
+        auto after = TakeSnapshot();
+        VERIFY_ARE_EQUAL(100ull, after.Get(Counter::VtBytesEmitted) - before.Get(Counter::VtBytesEmitted));
+
+        exit = true;
+        worker.join();
+
+        Log::Comment(L"They stay there once it has exited.");
+        after = TakeSnapshot();
+        VERIFY_ARE_EQUAL(100ull, after.Get(Counter::VtBytesEmitted) - before.Get(Counter::VtBytesEmitted));
+    }
+
+    TEST_METHOD(ScopedTimerRecordsOnce)
+    {
+        const auto before = TakeSnapshot().Get(Histogram::RenderPaintMicroseconds);
+        {
+            ScopedTimer timer{ Histogram::RenderPaintMicroseconds };
+        }
+        const auto after = TakeSnapshot().Get(Histogram::RenderPaintMicroseconds);
+        VERIFY_ARE_EQUAL(1ull, after.count - before.count);
+    }
+};
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "..\..\inc\consoletaeftemplates.hpp"
+
+#include "..\inc\DelimiterClassTable.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Types;
+
+class DelimiterClassTableTests
+{
+    TEST_CLASS(DelimiterClassTableTests);
+
+    void _VerifyRange(const size_t first, const size_t second, const std::pair<size_t, size_t> actual)
+    {
+        VERIFY_ARE_EQUAL(first, actual.first);
+        VERIFY_ARE_EQUAL(second, actual.second);
+    }
+
+    TEST_METHOD(ClassifiesConfiguredDelimiters)
+    {
+        const DelimiterClassTable defaultTable;
+        VERIFY_IS_TRUE(defaultTable.ClassOf(L' ') == DelimiterClassTable::CharClass::Space);
+        VERIFY_IS_TRUE(defaultTable.ClassOf(L'a') == DelimiterClassTable::CharClass::Word);
+        VERIFY_IS_FALSE(defaultTable.IsDelimiter(L'/'));
+
+        const DelimiterClassTable table{ L"/\\." };
+        VERIFY_IS_TRUE(table.ClassOf(L'/') == DelimiterClassTable::CharClass::Delimiter);
+        VERIFY_IS_TRUE(table.ClassOf(L'.') == DelimiterClassTable::CharClass::Delimiter);
+        VERIFY_IS_TRUE(table.IsDelimiter(L' '));
+        VERIFY_IS_TRUE(table.IsDelimiter(L'\\'));
+        VERIFY_IS_FALSE(table.IsDelimiter(L'z'));
+        VERIFY_IS_FALSE(table.IsDelimiter(L'\xffff'));
+    }
+
+    TEST_METHOD(FindWord)
+    {
+        const DelimiterClassTable table{ L"/" };
+        const std::wstring_view text{ L"cd /usr/local bin" };
+
+        Log::Comment(L"From the front, middle and end of a word.");
+        _VerifyRange(8, 13, table.FindWord(text, 8));
+        _VerifyRange(8, 13, table.FindWord(text, 10));
+        _VerifyRange(8, 13, table.FindWord(text, 12));
+
+        Log::Comment(L"On a delimiter, the word ends there.");
+        _VerifyRange(4, 7, table.FindWord(text, 7));
+        _VerifyRange(3, 3, table.FindWord(text, 3));
+
+        Log::Comment(L"The ends of the text are word boundaries too.");
+        _VerifyRange(0, 2, table.FindWord(text, 0));
+        _VerifyRange(14, 17, table.FindWord(text, 17));
+        _VerifyRange(14, 17, table.FindWord(text, 100));
+    }
+};
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "..\..\inc\consoletaeftemplates.hpp"
+
+#include "..\inc\TabStops.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Types;
+
+class TabStopsTests
+{
+    TEST_CLASS(TabStopsTests);
+
+    TEST_METHOD(NextAndPreviousCrossWords)
+    {
+        TabStops stops;
+        VERIFY_IS_FALSE(stops.Any());
+        VERIFY_IS_FALSE(stops.Next(0).has_value());
+        VERIFY_IS_FALSE(stops.Previous(100).has_value());
+
+        // Put stops on both sides of word boundaries, and far enough apart
+        // that the searches have to skip over whole empty words.
+        for (const size_t column : { 3u, 31u, 32u, 200u })
+        {
+            stops.Set(column);
+        }
+        VERIFY_IS_TRUE(stops.Any());
+
+        VERIFY_ARE_EQUAL(size_t{ 3 }, stops.Next(0).value());
+        VERIFY_ARE_EQUAL(size_t{ 31 }, stops.Next(3).value());
+        VERIFY_ARE_EQUAL(size_t{ 32 }, stops.Next(31).value());
+        VERIFY_ARE_EQUAL(size_t{ 200 }, stops.Next(32).value());
+        VERIFY_IS_FALSE(stops.Next(200).has_value());
+        VERIFY_IS_FALSE(stops.Next(5000).has_value());
+
+        VERIFY_IS_FALSE(stops.Previous(3).has_value());
+        VERIFY_ARE_EQUAL(size_t{ 3 }, stops.Previous(31).value());
+        VERIFY_ARE_EQUAL(size_t{ 31 }, stops.Previous(32).value());
+        VERIFY_ARE_EQUAL(size_t{ 32 }, stops.Previous(200).value());
+        VERIFY_ARE_EQUAL(size_t{ 200 }, stops.Previous(5000).value());
+
+        stops.Clear(31);
+        VERIFY_IS_FALSE(stops.IsSet(31));
+        VERIFY_ARE_EQUAL(size_t{ 32 }, stops.Next(3).value());
+        VERIFY_ARE_EQUAL(size_t{ 3 }, stops.Previous(32).value());
+
+        stops.ClearAll();
+        VERIFY_IS_FALSE(stops.Any());
+        VERIFY_IS_FALSE(stops.Next(0).has_value());
+    }
+
+    TEST_METHOD(SetEveryKeepsExistingStops)
+    {
+        TabStops stops;
+        stops.Set(5);
+        stops.SetEvery(TabStops::DefaultInterval, 0, 80);
+
+        VERIFY_IS_TRUE(stops.IsSet(0));
+        VERIFY_IS_TRUE(stops.IsSet(5));
+        VERIFY_IS_TRUE(stops.IsSet(72));
+        VERIFY_IS_FALSE(stops.IsSet(80));
+        VERIFY_ARE_EQUAL(size_t{ 5 }, stops.Next(0).value());
+        VERIFY_ARE_EQUAL(size_t{ 8 }, stops.Next(5).value());
+
+        // Only the new columns get stops when the range is extended.
+        stops.Clear(8);
+        stops.SetEvery(TabStops::DefaultInterval, 80, 100);
+        VERIFY_IS_FALSE(stops.IsSet(8));
+        VERIFY_IS_TRUE(stops.IsSet(80));
+        VERIFY_IS_TRUE(stops.IsSet(96));
+        VERIFY_IS_FALSE(stops.Next(96).has_value());
+    }
+};